@@ -14,7 +14,10 @@
 
 package com.eprosima.fastrtps.idl.parser.typecode;
 
+import com.eprosima.idl.parser.typecode.ContainerTypeCode;
+import com.eprosima.idl.parser.typecode.Kind;
 import com.eprosima.idl.parser.typecode.Member;
+import com.eprosima.idl.parser.typecode.TypeCode;
 import com.eprosima.idl.parser.tree.Annotation;
 
 public class StructTypeCode extends com.eprosima.idl.parser.typecode.StructTypeCode
@@ -58,6 +61,57 @@ public class StructTypeCode extends com.eprosima.idl.parser.typecode.StructTypeC
         return returnedValue;
     }
 
+    /*!
+     * A structure is plain when all its members have a fixed size, so the CDR representation of every sample has
+     * the same size and layout.
+     */
+    public boolean isIsPlain()
+    {
+        if (getInheritances() != null && !getInheritances().isEmpty())
+        {
+            return false;
+        }
+
+        for (Member member : getMembers())
+        {
+            if (!isPlainType(member.getTypecode()))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    private static boolean isPlainType(TypeCode typecode)
+    {
+        switch (typecode.getKind())
+        {
+            case Kind.KIND_BOOLEAN:
+            case Kind.KIND_CHAR:
+            case Kind.KIND_WCHAR:
+            case Kind.KIND_OCTET:
+            case Kind.KIND_SHORT:
+            case Kind.KIND_USHORT:
+            case Kind.KIND_LONG:
+            case Kind.KIND_ULONG:
+            case Kind.KIND_LONGLONG:
+            case Kind.KIND_ULONGLONG:
+            case Kind.KIND_FLOAT:
+            case Kind.KIND_DOUBLE:
+            case Kind.KIND_LONGDOUBLE:
+            case Kind.KIND_ENUM:
+                return true;
+            case Kind.KIND_ARRAY:
+            case Kind.KIND_ALIAS:
+                return isPlainType(((ContainerTypeCode)typecode).getContentTypeCode());
+            case Kind.KIND_STRUCT:
+                return (typecode instanceof StructTypeCode) && ((StructTypeCode)typecode).isIsPlain();
+            default:
+                return false;
+        }
+    }
+
     public void setIsTopic(boolean value)
     {
         istopic_ = value;
@@ -81,6 +81,14 @@ class  TopicDataType {
          */
         RTPS_DllAPI virtual bool getKey(void* data, rtps::InstanceHandle_t* ihandle, bool force_md5 = false) = 0;
 
+        /**
+         * Indicates whether the type is plain, i.e. all its members have a fixed size, so the CDR representation of
+         * every sample has the same size and layout. Samples of plain types can be loaned by a Publisher and written
+         * directly in the payload of the change.
+         * @return True if the type is plain.
+         */
+        RTPS_DllAPI virtual bool is_plain() const { return false; }
+
         /**
          * Set topic data type name
          * @param nam Topic data type name
@@ -16,12 +16,20 @@
 #ifndef _FASTRTPS_LOG_LOG_H_
 #define _FASTRTPS_LOG_LOG_H_
 
-#include <fastrtps/utils/DBQueue.h>
 #include <fastrtps/fastrtps_dll.h>
-#include <thread>
-#include <sstream>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 /**
  * eProsima log layer. Logging categories and verbosities can be specified dynamically at runtime. However, even on a category
@@ -33,6 +41,15 @@
  * * #define LOG_NO_INFO
  *
  * Additionally. the lowest level (Info) is disabled by default on release branches.
+ *
+ * The verbosity level and the category filter are checked before the message is formatted, so a disabled log call
+ * only costs a function call and a couple of atomic loads. Entries are passed to the logging thread through a
+ * lock-free ring buffer of fixed size entries. When the ring buffer is full the entries are dropped, and the logging
+ * thread reports how many were lost.
+ *
+ * The deferred variants of the macros (logErrorDeferred, logWarningDeferred and logInfoDeferred) take the parts of
+ * the message as separate arguments. The arguments are copied into the ring buffer and only formatted by the
+ * logging thread, so they should not be pointers to data that may change or be destroyed, other than string literals.
  */
 
 // Logging API:
@@ -44,6 +61,13 @@
 //! Logs an error. Disable reporting through #define LOG_NO_ERROR
 #define logError(cat, msg) logError_(cat, msg)
 
+//! Logs an info message, formatting its arguments in the logging thread.
+#define logInfoDeferred(cat, ...) logInfoDeferred_(cat, __VA_ARGS__)
+//! Logs a warning, formatting its arguments in the logging thread.
+#define logWarningDeferred(cat, ...) logWarningDeferred_(cat, __VA_ARGS__)
+//! Logs an error, formatting its arguments in the logging thread.
+#define logErrorDeferred(cat, ...) logErrorDeferred_(cat, __VA_ARGS__)
+
 namespace eprosima {
 namespace fastrtps {
 
@@ -96,6 +120,7 @@ class Log
         RTPS_DllAPI static Log::Kind GetVerbosity();
 
         //! Sets a filter that will pattern-match against log categories, dropping any unmatched categories.
+        //! The filter is applied before the messages are formatted.
         RTPS_DllAPI static void SetCategoryFilter(const std::regex&);
 
         //! Sets a filter that will pattern-match against filenames, dropping any unmatched categories.
@@ -140,17 +165,112 @@ class Log
                 const Log::Context&,
                 Log::Kind);
 
+        /**
+        * Not recommended to call this method directly! Use the following macros:
+        *  * logInfoDeferred(cat, args...);
+        *  * logWarningDeferred(cat, args...);
+        *  * logErrorDeferred(cat, args...);
+        */
+        template<typename... Args>
+        static void QueueLogDeferred(
+                const Log::Context& context,
+                Log::Kind kind,
+                Args&&... args)
+        {
+            using Arguments = std::tuple<typename std::decay<Args>::type...>;
+            Arguments arguments(std::forward<Args>(args)...);
+            QueueDeferred(context, kind, &arguments, GetFormatter<Arguments>());
+        }
+
+        /**
+        * Returns the bit of a category in the mask of enabled categories, registering the category if needed.
+        * Used by the log macros, that call it once for each call site.
+        */
+        RTPS_DllAPI static uint64_t CategoryBit(const char* category);
+
+        /**
+        * Returns whether an entry of a kind and a category, given by CategoryBit, passes the pre-filters.
+        * Defined out of line so the log macros expanded in client code do not access the internal resources.
+        */
+        RTPS_DllAPI static bool IsEnabled(Log::Kind kind, uint64_t category_bit);
+
     private:
+        //! Type erased operations on the arguments of a deferred entry.
+        struct Formatter
+        {
+            size_t size;
+            size_t alignment;
+            void (*move)(void* destination, void* source);
+            void (*format)(std::ostream& stream, const void* arguments);
+            void (*destroy)(void* arguments);
+        };
+
+        template<size_t Index, size_t Count>
+        struct TupleFormatter
+        {
+            template<typename Arguments>
+            static void format(std::ostream& stream, const Arguments& arguments)
+            {
+                stream << std::get<Index>(arguments);
+                TupleFormatter<Index + 1, Count>::format(stream, arguments);
+            }
+        };
+
+        template<size_t Count>
+        struct TupleFormatter<Count, Count>
+        {
+            template<typename Arguments>
+            static void format(std::ostream&, const Arguments&)
+            {
+            }
+        };
+
+        template<typename Arguments>
+        static const Formatter* GetFormatter()
+        {
+            static const Formatter formatter =
+            {
+                sizeof(Arguments),
+                std::alignment_of<Arguments>::value,
+                [](void* destination, void* source)
+                {
+                    new (destination) Arguments(std::move(*static_cast<Arguments*>(source)));
+                },
+                [](std::ostream& stream, const void* arguments)
+                {
+                    TupleFormatter<0, std::tuple_size<Arguments>::value>::format(stream,
+                            *static_cast<const Arguments*>(arguments));
+                },
+                [](void* arguments)
+                {
+                    static_cast<Arguments*>(arguments)->~Arguments();
+                }
+            };
+            return &formatter;
+        }
+
+        RTPS_DllAPI static void QueueDeferred(
+                const Log::Context& context,
+                Log::Kind kind,
+                void* arguments,
+                const Formatter* formatter);
+
+        struct Slot;
+        struct RingBuffer;
+
         struct Resources
         {
-            DBQueue<Entry> mLogs;
+            std::unique_ptr<RingBuffer> mRing;
             std::vector<std::unique_ptr<LogConsumer>> mConsumers;
             std::unique_ptr<std::thread> mLoggingThread;
 
             // Condition variable segment.
             std::condition_variable mCv;
             std::mutex mCvMutex;
-            bool mLogging;
+            std::atomic<bool> mLogging;
+            //! Whether the logging thread is waiting for entries.
+            std::atomic<bool> mSleeping;
+            //! Whether the logging thread is consuming entries.
             bool mWork;
 
             // Context configuration.
@@ -160,8 +280,11 @@ class Log
             std::unique_ptr<std::regex> mCategoryFilter;
             std::unique_ptr<std::regex> mFilenameFilter;
             std::unique_ptr<std::regex> mErrorStringFilter;
+            //! Categories of the call sites, in the order of their bits in mEnabledCategories.
+            std::vector<std::string> mCategories;
 
             std::atomic<Log::Kind> mVerbosity;
+            std::atomic<uint64_t> mEnabledCategories;
 
             Resources();
 
@@ -175,11 +298,20 @@ class Log
         // if the log entry is blacklisted.
         static bool Preprocess(Entry&);
 
+        //! Reserves a slot of the ring buffer and fills its context. Returns nullptr if the ring buffer is full.
+        static Slot* ReserveSlot(const Log::Context& context, Log::Kind kind);
+
+        //! Makes a reserved slot available to the logging thread, launching or waking it up if needed.
+        static void CommitSlot(Slot* slot);
+
+        //! Updates mEnabledCategories after a change of the category filter. mConfigMutex should be locked.
+        static void UpdateEnabledCategories();
+
         static void LaunchThread();
 
         static void Run();
 
-        static void GetTimestamp(std::string&);
+        static void GetTimestamp(std::string&, const std::chrono::system_clock::time_point&);
 };
 
 /**
@@ -225,40 +357,76 @@ class LogConsumer
 #ifndef LOG_NO_ERROR
 #define logError_(cat, msg)                                                                          \
     {                                                                                                \
-        std::stringstream ss;                                                                        \
-        ss << msg;                                                                                   \
-        Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Error); \
+        static const uint64_t log_category_bit = Log::CategoryBit(#cat);                             \
+        if (Log::IsEnabled(Log::Kind::Error, log_category_bit))                                      \
+        {                                                                                            \
+            std::stringstream ss;                                                                    \
+            ss << msg;                                                                               \
+            Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Error); \
+        }                                                                                            \
+    }
+#define logErrorDeferred_(cat, ...)                                                                  \
+    {                                                                                                \
+        static const uint64_t log_category_bit = Log::CategoryBit(#cat);                             \
+        if (Log::IsEnabled(Log::Kind::Error, log_category_bit))                                      \
+        {                                                                                            \
+            Log::QueueLogDeferred(Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Error,  \
+                    __VA_ARGS__);                                                                    \
+        }                                                                                            \
     }
 #else
 #define logError_(cat, msg)
+#define logErrorDeferred_(cat, ...)
 #endif
 
 #ifndef LOG_NO_WARNING
 #define logWarning_(cat, msg)                                                                              \
     {                                                                                                      \
-        if (Log::GetVerbosity() >= Log::Kind::Warning)                                                     \
+        static const uint64_t log_category_bit = Log::CategoryBit(#cat);                                   \
+        if (Log::IsEnabled(Log::Kind::Warning, log_category_bit))                                          \
         {                                                                                                  \
             std::stringstream ss;                                                                          \
             ss << msg;                                                                                     \
             Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Warning); \
         }                                                                                                  \
     }
+#define logWarningDeferred_(cat, ...)                                                                      \
+    {                                                                                                      \
+        static const uint64_t log_category_bit = Log::CategoryBit(#cat);                                   \
+        if (Log::IsEnabled(Log::Kind::Warning, log_category_bit))                                          \
+        {                                                                                                  \
+            Log::QueueLogDeferred(Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Warning,    \
+                    __VA_ARGS__);                                                                          \
+        }                                                                                                  \
+    }
 #else
 #define logWarning_(cat, msg)
+#define logWarningDeferred_(cat, ...)
 #endif
 
 #if (defined(__INTERNALDEBUG) || defined(_INTERNALDEBUG)) && (defined(_DEBUG) || defined(__DEBUG)) && (!defined(LOG_NO_INFO))
 #define logInfo_(cat, msg)                                                                              \
     {                                                                                                   \
-        if (Log::GetVerbosity() >= Log::Kind::Info)                                                     \
+        static const uint64_t log_category_bit = Log::CategoryBit(#cat);                                \
+        if (Log::IsEnabled(Log::Kind::Info, log_category_bit))                                          \
         {                                                                                               \
             std::stringstream ss;                                                                       \
             ss << msg;                                                                                  \
             Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Info); \
         }                                                                                               \
     }
+#define logInfoDeferred_(cat, ...)                                                                      \
+    {                                                                                                   \
+        static const uint64_t log_category_bit = Log::CategoryBit(#cat);                                \
+        if (Log::IsEnabled(Log::Kind::Info, log_category_bit))                                          \
+        {                                                                                               \
+            Log::QueueLogDeferred(Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Info,    \
+                    __VA_ARGS__);                                                                       \
+        }                                                                                               \
+    }
 #else
 #define logInfo_(cat, msg)
+#define logInfoDeferred_(cat, ...)
 #endif
 
 } // namespace fastrtps
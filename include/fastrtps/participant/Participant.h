@@ -95,6 +95,13 @@ class RTPS_DllAPI Participant
                 const rtps::GUID_t& readerGuid,
                 rtps::ReaderProxyData& returnedInfo);
 
+        /**
+         * Waits until the operations sent to the persistence service by any of the endpoints are stored.
+         * Endpoints must not be removed while waiting.
+         * @return True if all of them were successfully stored since the last call.
+         */
+        bool flush_persistence();
+
     private:
         Participant();
 
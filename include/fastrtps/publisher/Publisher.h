@@ -75,6 +75,31 @@ public:
             void* Data,
             rtps::WriteParams& wparams);
 
+    /**
+     * Loan a sample of a plain type, to be filled in place and written without serialization.
+     * The loaned buffer is inside the payload of a change of the history. It holds the CDR representation of the
+     * sample, in the native endianness, and is published with write_loan() or returned with discard_loan().
+     * Loans still outstanding when the publisher is removed are returned to the history.
+     * @param[out] sample Pointer to the loaned buffer, of getType()->m_typeSize - 4 bytes.
+     * @return True if correct. False if the type is not plain, the topic has key or no change can be reserved.
+     */
+    bool loan_sample(void*& sample);
+
+    /**
+     * Write a loaned sample to the topic, without serializing it.
+     * @param[in,out] sample Pointer to the loaned buffer. It is set to nullptr if the sample is written.
+     * @return True if correct. False if the sample was not loaned by this publisher or could not be written,
+     * in which case it remains loaned.
+     */
+    bool write_loan(void*& sample);
+
+    /**
+     * Return a loaned sample without writing it.
+     * @param[in,out] sample Pointer to the loaned buffer. It is set to nullptr.
+     * @return True if correct. False if the sample was not loaned by this publisher.
+     */
+    bool discard_loan(void*& sample);
+
     /**
      * Dispose of a previously written data.
      * @param Data Pointer to the data.
@@ -211,6 +211,7 @@ class RTPSParticipantAttributes
             listenSocketBufferSize = 0;
             participantID = -1;
             useBuiltinTransports = true;
+            asyncWriterThreads = 1;
         }
 
         virtual ~RTPSParticipantAttributes() {}
@@ -228,6 +229,7 @@ class RTPSParticipantAttributes
                    (this->participantID == b.participantID) &&
                    (this->throughputController == b.throughputController) &&
                    (this->useBuiltinTransports == b.useBuiltinTransports) &&
+                   (this->asyncWriterThreads == b.asyncWriterThreads) &&
                    (this->properties == b.properties);
         }
 
@@ -275,6 +277,13 @@ class RTPSParticipantAttributes
         //!Set as false to disable the default UDPv4 implementation.
         bool useBuiltinTransports;
 
+        /*!
+         * @brief Number of threads performing the asynchronous writes of the writers of this RTPSParticipant.
+         * Each writer is always served by the same thread, and every thread serves its writers in turns.
+         * Default value: 1.
+         */
+        uint32_t asyncWriterThreads;
+
         //! Property policies
         PropertyPolicy properties;
 
@@ -23,6 +23,7 @@
 
 #include "../../../attributes/RTPSParticipantAttributes.h"
 #include "../../../common/Guid.h"
+#include "../../../../utils/PartitionMatcher.h"
 
 namespace eprosima {
 namespace fastrtps{
@@ -216,6 +217,9 @@ class EDP
 
     private:
 
+        //! Matches the partitions of the endpoints, caching the results.
+        PartitionMatcher m_partitionMatcher;
+
         /**
          * Try to pair/unpair a local Reader against all possible writerProxy Data.
          * @param R Pointer to the Reader
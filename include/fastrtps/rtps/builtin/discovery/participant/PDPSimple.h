@@ -22,6 +22,9 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "../../../common/Guid.h"
 #include "../../../attributes/RTPSParticipantAttributes.h"
 
@@ -124,6 +127,47 @@ class PDPSimple
      * @return True if found.
      */
     bool lookupParticipantProxyData(const GUID_t& pguid, ParticipantProxyData& pdata);
+
+    /**
+     * Get the ReaderProxyData of a registered reader (including the local ones) without copying it.
+     * The PDP mutex should be locked while the returned object is used.
+     * @param reader GUID_t of the reader we are looking for.
+     * @return Pointer to the ReaderProxyData object, or nullptr if not found.
+     */
+    ReaderProxyData* findReaderProxyData(const GUID_t& reader);
+
+    /**
+     * Get the WriterProxyData of a registered writer (including the local ones) without copying it.
+     * The PDP mutex should be locked while the returned object is used.
+     * @param writer GUID_t of the writer we are looking for.
+     * @return Pointer to the WriterProxyData object, or nullptr if not found.
+     */
+    WriterProxyData* findWriterProxyData(const GUID_t& writer);
+
+    /**
+     * Get the ParticipantProxyData of a registered RTPSParticipant (including the local one) without copying it.
+     * The PDP mutex should be locked while the returned object is used.
+     * @param prefix GuidPrefix_t of the RTPSParticipant we are looking for.
+     * @return Pointer to the ParticipantProxyData object, or nullptr if not found.
+     */
+    ParticipantProxyData* findParticipantProxyData(const GuidPrefix_t& prefix);
+
+    /**
+     * Get the readers of all the registered RTPSParticipants (including the local one) on a topic.
+     * The PDP mutex should be locked while the returned collection is used.
+     * @param topic_name Name of the topic.
+     * @return Readers on the topic.
+     */
+    const std::vector<ReaderProxyData*>& readersOnTopic(const std::string& topic_name) const;
+
+    /**
+     * Get the writers of all the registered RTPSParticipants (including the local one) on a topic.
+     * The PDP mutex should be locked while the returned collection is used.
+     * @param topic_name Name of the topic.
+     * @return Writers on the topic.
+     */
+    const std::vector<WriterProxyData*>& writersOnTopic(const std::string& topic_name) const;
+
     /**
      * This method removes and deletes a ReaderProxyData object from its corresponding RTPSParticipant.
      * @return true if found and deleted.
@@ -234,6 +278,16 @@ class PDPSimple
     EDP* mp_EDP;
     //!Registered RTPSParticipants (including the local one, that is the first one.)
     std::vector<ParticipantProxyData*> m_participantProxies;
+    //!Registered RTPSParticipants indexed by their GuidPrefix_t.
+    std::unordered_map<GuidPrefix_t, ParticipantProxyData*> m_participantsByPrefix;
+    //!Readers of the registered RTPSParticipants indexed by their GUID_t.
+    std::unordered_map<GUID_t, ReaderProxyData*> m_readersByGuid;
+    //!Writers of the registered RTPSParticipants indexed by their GUID_t.
+    std::unordered_map<GUID_t, WriterProxyData*> m_writersByGuid;
+    //!Readers of the registered RTPSParticipants grouped by topic name.
+    std::unordered_map<std::string, std::vector<ReaderProxyData*>> m_readersByTopic;
+    //!Writers of the registered RTPSParticipants grouped by topic name.
+    std::unordered_map<std::string, std::vector<WriterProxyData*>> m_writersByTopic;
     //!Variable to indicate if any parameter has changed.
     std::atomic_bool m_hasChangedLocalPDP;
     //!TimedEvent to periodically resend the local RTPSParticipant information.
@@ -250,6 +304,27 @@ class PDPSimple
      * @return True if correct.
      */
     bool createSPDPEndpoints();
+
+    /**
+     * Add a RTPSParticipant to the registered ones and to the indexes. The PDP mutex should be locked.
+     * @param pdata Pointer to the ParticipantProxyData object. Its ownership is taken.
+     */
+    void registerParticipantProxyData(ParticipantProxyData* pdata);
+
+    /**
+     * Remove a RTPSParticipant and all its endpoints from the registered ones and from the indexes.
+     * The PDP mutex should be locked.
+     * @param prefix GuidPrefix_t of the RTPSParticipant.
+     * @return Pointer to the removed ParticipantProxyData object, owned by the caller, or nullptr if not found.
+     */
+    ParticipantProxyData* unregisterParticipantProxyData(const GuidPrefix_t& prefix);
+
+    //!Remove a reader from the indexes. The PDP mutex should be locked.
+    void unindexReaderProxyData(ReaderProxyData* rdata);
+
+    //!Remove a writer from the indexes. The PDP mutex should be locked.
+    void unindexWriterProxyData(WriterProxyData* wdata);
+
     std::recursive_mutex* mp_mutex;
 
 
@@ -26,6 +26,7 @@
 #include "InstanceHandle.h"
 #include <fastrtps/rtps/common/FragmentNumber.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace eprosima
@@ -87,8 +88,14 @@ namespace eprosima
                     kind(ALIVE),
                     isRead(false),
                     is_untyped_(true),
-                    dataFragments_(new std::vector<uint32_t>()),
-                    fragment_size_(0)
+                    fragment_count_(0),
+                    fragment_size_(0),
+                    received_fragments_(0),
+                    contiguous_fragments_(0),
+                    fragment_bitmap_(nullptr),
+                    fragment_bitmap_capacity_(0),
+                    fragment_bitmap_in_use_(false),
+                    pool_index_(0)
                 {
                 }
 
@@ -108,8 +115,14 @@ namespace eprosima
                     serializedPayload(payload_size),
                     isRead(false),
                     is_untyped_(is_untyped),
-                    dataFragments_(new std::vector<uint32_t>()),
-                    fragment_size_(0)
+                    fragment_count_(0),
+                    fragment_size_(0),
+                    received_fragments_(0),
+                    contiguous_fragments_(0),
+                    fragment_bitmap_(nullptr),
+                    fragment_bitmap_capacity_(0),
+                    fragment_bitmap_in_use_(false),
+                    pool_index_(0)
                 {
                 }
 
@@ -129,8 +142,7 @@ namespace eprosima
 
                     bool ret = serializedPayload.copy(&ch_ptr->serializedPayload, (ch_ptr->is_untyped_ ? false : true));
 
-                    setFragmentSize(ch_ptr->fragment_size_);
-                    dataFragments_->assign(ch_ptr->dataFragments_->begin(), ch_ptr->dataFragments_->end());
+                    copy_fragments(ch_ptr);
 
                     isRead = ch_ptr->isRead;
 
@@ -149,51 +161,170 @@ namespace eprosima
                     // Copy certain values from serializedPayload
                     serializedPayload.encapsulation = ch_ptr->serializedPayload.encapsulation;
 
-                    setFragmentSize(ch_ptr->fragment_size_);
-                    dataFragments_->assign(ch_ptr->dataFragments_->begin(), ch_ptr->dataFragments_->end());
+                    copy_fragments(ch_ptr);
 
                     isRead = ch_ptr->isRead;
                 }
 
                 ~CacheChange_t()
                 {
-                    if (dataFragments_)
-                        delete dataFragments_;
+                    delete[] fragment_bitmap_;
                 }
 
                 uint32_t getFragmentCount() const
                 {
-                    return (uint32_t)dataFragments_->size();
+                    return fragment_count_;
                 }
 
-                std::vector<uint32_t>* getDataFragments() { return dataFragments_; }
-
                 uint16_t getFragmentSize() const { return fragment_size_; }
 
+                /*!
+                 * Sets the fragment size, and computes the number of fragments from the length of the payload.
+                 * All the fragments are marked as not received.
+                 * @param fragment_size Size of each fragment. 0 when the change is not fragmented.
+                 */
                 void setFragmentSize(uint16_t fragment_size)
                 {
-                    this->fragment_size_ = fragment_size;
+                    //TODO Mirar si cuando se compatibilice con RTI funciona el calculo, porque ellos
+                    //en el sampleSize incluyen el padding.
+                    setFragmentSize(fragment_size, fragment_size == 0 ? 0 :
+                            (serializedPayload.length + fragment_size - 1) / fragment_size);
+                }
+
+                /*!
+                 * Sets the fragment size and the number of fragments, regardless of the length of the payload.
+                 * All the fragments are marked as not received.
+                 * @param fragment_size Size of each fragment.
+                 * @param fragment_count Number of fragments.
+                 */
+                void setFragmentSize(uint16_t fragment_size, uint32_t fragment_count)
+                {
+                    fragment_size_ = fragment_size;
+                    fragment_count_ = fragment_size == 0 ? 0 : fragment_count;
+                    received_fragments_ = 0;
+                    contiguous_fragments_ = 0;
+                    fragment_bitmap_in_use_ = false;
+                }
+
+                //! Checks whether all the fragments of the change have been received.
+                bool is_fully_assembled() const
+                {
+                    return received_fragments_ == fragment_count_;
+                }
+
+                //! Returns the index (starting at 0) of the first fragment not received yet.
+                uint32_t first_missing_fragment() const
+                {
+                    return contiguous_fragments_;
+                }
+
+                /*!
+                 * Checks whether a fragment has been received.
+                 * @param fragment_index Index of the fragment, starting at 0.
+                 */
+                bool is_fragment_received(uint32_t fragment_index) const
+                {
+                    return fragment_index < contiguous_fragments_ || (fragment_bitmap_in_use_ &&
+                            fragment_index < fragment_count_ &&
+                            (fragment_bitmap_[fragment_index >> 5] & (1u << (fragment_index & 31))) != 0);
+                }
+
+                /*!
+                 * Marks a fragment as received.
+                 * Fragments received in order only advance a counter. The bitmap of received fragments is only used
+                 * after a fragment arrives out of order, and it is created the first time this happens.
+                 * @param fragment_index Index of the fragment, starting at 0.
+                 * @return False when the fragment was already received or does not exist.
+                 */
+                bool mark_fragment_received(uint32_t fragment_index)
+                {
+                    if (fragment_index >= fragment_count_ || is_fragment_received(fragment_index))
+                    {
+                        return false;
+                    }
+
+                    ++received_fragments_;
 
-                    if (fragment_size == 0) {
-                        dataFragments_->clear();
+                    if (fragment_index == contiguous_fragments_)
+                    {
+                        ++contiguous_fragments_;
+                        // Absorb the fragments received before out of order.
+                        while (fragment_bitmap_in_use_ && is_fragment_received(contiguous_fragments_))
+                        {
+                            ++contiguous_fragments_;
+                        }
                     }
                     else
                     {
-                        //TODO Mirar si cuando se compatibilice con RTI funciona el calculo, porque ellos
-                        //en el sampleSize incluyen el padding.
-                        uint32_t size = (serializedPayload.length + fragment_size - 1) / fragment_size;
-                        dataFragments_->assign(size, ChangeFragmentStatus_t::NOT_PRESENT);
+                        use_fragment_bitmap();
+                        fragment_bitmap_[fragment_index >> 5] |= 1u << (fragment_index & 31);
                     }
-                }
 
+                    return true;
+                }
 
                 private:
 
-                // Data fragments
-                std::vector<uint32_t>* dataFragments_;
+                friend class CacheChangePool;
+
+                //! Starts using the bitmap of received fragments, allocating it when it is not big enough.
+                void use_fragment_bitmap()
+                {
+                    if (fragment_bitmap_in_use_)
+                    {
+                        return;
+                    }
+
+                    uint32_t words = (fragment_count_ + 31) / 32;
+                    if (fragment_bitmap_capacity_ < words)
+                    {
+                        delete[] fragment_bitmap_;
+                        fragment_bitmap_ = new uint32_t[words];
+                        fragment_bitmap_capacity_ = words;
+                    }
+
+                    std::fill(fragment_bitmap_, fragment_bitmap_ + words, 0u);
+                    fragment_bitmap_in_use_ = true;
+                }
+
+                //! Copies the fragment size and the fragments received from another change.
+                void copy_fragments(const CacheChange_t* ch_ptr)
+                {
+                    setFragmentSize(ch_ptr->fragment_size_, ch_ptr->fragment_count_);
+                    received_fragments_ = ch_ptr->received_fragments_;
+                    contiguous_fragments_ = ch_ptr->contiguous_fragments_;
+
+                    if (ch_ptr->fragment_bitmap_in_use_)
+                    {
+                        use_fragment_bitmap();
+                        std::copy(ch_ptr->fragment_bitmap_, ch_ptr->fragment_bitmap_ + (fragment_count_ + 31) / 32,
+                                fragment_bitmap_);
+                    }
+                }
+
+                // Number of fragments
+                uint32_t fragment_count_;
 
                 // Fragment size
                 uint16_t fragment_size_;
+
+                // Number of fragments received
+                uint32_t received_fragments_;
+
+                // Fragments before this index have all been received
+                uint32_t contiguous_fragments_;
+
+                // Bitmap of the fragments received out of order. Kept while the change is reused.
+                uint32_t* fragment_bitmap_;
+
+                // Number of words allocated for the bitmap
+                uint32_t fragment_bitmap_capacity_;
+
+                // Whether the bitmap holds the fragments received after contiguous_fragments_
+                bool fragment_bitmap_in_use_;
+
+                // Position of the change in the list of changes in use of its pool (DYNAMIC_RESERVE_MEMORY_MODE)
+                uint32_t pool_index_;
             };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
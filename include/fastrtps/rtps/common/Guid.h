@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 
 namespace eprosima{
 namespace fastrtps{
@@ -481,5 +482,47 @@ inline std::ostream& operator<<(std::ostream& output,const GUID_t& guid)
 }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+namespace std {
+
+template<>
+struct hash<eprosima::fastrtps::rtps::EntityId_t>
+{
+    std::size_t operator()(const eprosima::fastrtps::rtps::EntityId_t& k) const
+    {
+        uint32_t value;
+        memcpy(&value, k.value, sizeof(value));
+        return static_cast<std::size_t>(value);
+    }
+};
+
+template<>
+struct hash<eprosima::fastrtps::rtps::GuidPrefix_t>
+{
+    std::size_t operator()(const eprosima::fastrtps::rtps::GuidPrefix_t& k) const
+    {
+        // Guid prefixes usually differ only on their last octets (host id, process id and participant id).
+        uint64_t low;
+        uint32_t high;
+        memcpy(&low, k.value, sizeof(low));
+        memcpy(&high, k.value + sizeof(low), sizeof(high));
+        return static_cast<std::size_t>(low * 31 + high);
+    }
+};
+
+template<>
+struct hash<eprosima::fastrtps::rtps::GUID_t>
+{
+    std::size_t operator()(const eprosima::fastrtps::rtps::GUID_t& k) const
+    {
+        return hash<eprosima::fastrtps::rtps::GuidPrefix_t>()(k.guidPrefix) * 31 +
+            hash<eprosima::fastrtps::rtps::EntityId_t>()(k.entityId);
+    }
+};
+
+} // namespace std
+
+#endif
 
 #endif /* RTPS_GUID_H_ */
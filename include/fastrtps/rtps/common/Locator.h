@@ -40,6 +40,8 @@ namespace rtps {
 #define LOCATOR_KIND_UDPv6 2
 #define LOCATOR_KIND_TCPv4 4
 #define LOCATOR_KIND_TCPv6 8
+//! Vendor-specific kind of the shared-memory transport. The address identifies the host.
+#define LOCATOR_KIND_SHM 16777216
 
 //!@brief Class Locator_t, uniquely identifies a communication channel for a particular transport.
 //For example, an address+port combination in the case of UDP.
@@ -54,6 +56,7 @@ public:
         * LOCATOR_KIND_UDPv6
         * LOCATOR_KIND_TCPv4
         * LOCATOR_KIND_TCPv6
+        * LOCATOR_KIND_SHM
         */
     int32_t kind;
     uint32_t port;
@@ -197,6 +200,12 @@ inline std::ostream& operator<<(std::ostream& output, const Locator_t& loc)
         }
         output << ":" << loc.port;
     }
+    else if (loc.kind == LOCATOR_KIND_SHM)
+    {
+        output << "SHM:" << (int)loc.address[12] << "." << (int)loc.address[13]
+            << "." << (int)loc.address[14] << "." << (int)loc.address[15]
+            << ":" << loc.port;
+    }
     return output;
 }
 
@@ -20,6 +20,7 @@
 #define SERIALIZEDPAYLOAD_H_
 #include "../../fastrtps_dll.h"
 #include "Types.h"
+#include <atomic>
 #include <cstring>
 #include <new>
 #include <stdexcept>
@@ -41,6 +42,77 @@ namespace eprosima{
 #define PL_CDR_BE 0x0002
 #define PL_CDR_LE 0x0003
 
+            /*!
+             * @brief Reference counted buffer holding the data of a serialized payload, which can be shared by
+             * several SerializedPayload_t.
+             * The data is stored right after the structure, in the same memory block.
+             * @ingroup COMMON_MODULE
+             */
+            struct SharedPayloadBuffer
+            {
+                /*!
+                 * Create a new buffer with a copy of the given data.
+                 * @param data Pointer to the data to copy.
+                 * @param length Length of the data.
+                 * @return Pointer to the buffer, with a reference count of 1.
+                 */
+                static SharedPayloadBuffer* create(const octet* data, uint32_t length)
+                {
+                    void* memory = malloc(sizeof(SharedPayloadBuffer) + length);
+                    if (!memory)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    SharedPayloadBuffer* buffer = new(memory) SharedPayloadBuffer(length);
+                    memcpy(buffer->data(), data, length);
+                    return buffer;
+                }
+
+                //!Pointer to the data.
+                octet* data()
+                {
+                    return reinterpret_cast<octet*>(this + 1);
+                }
+
+                //!Length of the data.
+                uint32_t length() const
+                {
+                    return length_;
+                }
+
+                //!Add a reference to the buffer.
+                void acquire()
+                {
+                    ref_count_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                //!Remove a reference to the buffer. The buffer is freed when the last reference is removed.
+                void release()
+                {
+                    if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        this->~SharedPayloadBuffer();
+                        free(this);
+                    }
+                }
+
+                private:
+
+                SharedPayloadBuffer(uint32_t length)
+                    : ref_count_(1)
+                    , length_(length)
+                {
+                }
+
+                ~SharedPayloadBuffer() = default;
+
+                SharedPayloadBuffer(const SharedPayloadBuffer&) = delete;
+                SharedPayloadBuffer& operator=(const SharedPayloadBuffer&) = delete;
+
+                std::atomic<uint32_t> ref_count_;
+                uint32_t length_;
+            };
+
 
             //!@brief Structure SerializedPayload_t.
             //!@ingroup COMMON_MODULE
@@ -60,7 +132,8 @@ namespace eprosima{
                 //!Default constructor
                 SerializedPayload_t() : encapsulation(CDR_BE),
                 length(0), data(nullptr), max_size(0),
-                pos(0)
+                pos(0), shared_buffer_(nullptr), owned_data_(nullptr),
+                owned_max_size_(0)
                 {
                 }
 
@@ -80,12 +153,27 @@ namespace eprosima{
 
                 /*!
                  * Copy another structure (including allocating new space for the data.)
+                 * When the data of the other structure is held in a SharedPayloadBuffer, the buffer is shared
+                 * instead of copied.
                  * @param[in] serData Pointer to the structure to copy
                  * @param with_limit if true, the function will fail when providing a payload too big
                  * @return True if correct
                  */
                 bool copy(const SerializedPayload_t* serData, bool with_limit = true)
                 {
+                    stop_sharing();
+
+                    if(serData->shared_buffer_ != nullptr)
+                    {
+                        if(with_limit && serData->length > max_size)
+                        {
+                            return false;
+                        }
+                        share(serData->shared_buffer_);
+                        encapsulation = serData->encapsulation;
+                        return true;
+                    }
+
                     length = serData->length;
 
                     if(serData->length > max_size)
@@ -100,6 +188,46 @@ namespace eprosima{
                     return true;
                 }
 
+                /*!
+                 * Make this payload point to the data of a shared buffer, adding a reference to it.
+                 * The data of the payload must not be modified while it is being shared.
+                 * @param buffer Pointer to the shared buffer.
+                 */
+                void share(SharedPayloadBuffer* buffer)
+                {
+                    stop_sharing();
+                    buffer->acquire();
+                    shared_buffer_ = buffer;
+                    owned_data_ = data;
+                    owned_max_size_ = max_size;
+                    data = buffer->data();
+                    length = buffer->length();
+                    max_size = buffer->length();
+                }
+
+                /*!
+                 * Stop sharing a buffer, removing the reference to it and recovering the data owned by this payload.
+                 * Does nothing if the payload is not sharing a buffer.
+                 */
+                void stop_sharing()
+                {
+                    if(shared_buffer_ != nullptr)
+                    {
+                        shared_buffer_->release();
+                        shared_buffer_ = nullptr;
+                        data = owned_data_;
+                        max_size = owned_max_size_;
+                        length = 0;
+                        owned_data_ = nullptr;
+                        owned_max_size_ = 0;
+                    }
+                }
+
+                //!Whether the data is held in a shared buffer.
+                bool is_shared() const
+                {
+                    return shared_buffer_ != nullptr;
+                }
 
                 /*!
                  * Allocate new space for fragmented data
@@ -108,6 +236,7 @@ namespace eprosima{
                  */
                 bool reserve_fragmented(SerializedPayload_t* serData)
                 {
+                    stop_sharing();
                     length = serData->length;
                     max_size = serData->length;
                     encapsulation = serData->encapsulation;
@@ -118,6 +247,7 @@ namespace eprosima{
                 //! Empty the payload
                 void empty()
                 {
+                    stop_sharing();
                     length= 0;
                     encapsulation = CDR_BE;
                     max_size = 0;
@@ -128,6 +258,7 @@ namespace eprosima{
 
                 void reserve(uint32_t new_size)
                 {
+                    stop_sharing();
                     if (new_size <= this->max_size) {
                         return;
                     }
@@ -152,6 +283,14 @@ namespace eprosima{
                     max_size = new_size;
                 }
 
+                private:
+
+                //!Buffer shared with other payloads, or nullptr when the data is owned by this payload.
+                SharedPayloadBuffer* shared_buffer_;
+                //!Data owned by this payload, kept while a buffer is being shared.
+                octet* owned_data_;
+                //!Maximum size of the data owned by this payload, kept while a buffer is being shared.
+                uint32_t owned_max_size_;
             };
         }
     }
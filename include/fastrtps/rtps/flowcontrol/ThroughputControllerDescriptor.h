@@ -33,6 +33,17 @@ struct ThroughputControllerDescriptor
     uint32_t bytesPerPeriod;
     //! Window of time in which no more than 'bytesPerPeriod' bytes are allowed.
     uint32_t periodMillisecs;
+    /*!
+     * Maximum number of bytes this controller will allow at once after an idle time. It is only used when bigger
+     * than 'bytesPerPeriod'. Default value: 0.
+     */
+    uint32_t burstBytes;
+    /*!
+     * Priority of a writer when sharing the throughput controller of its participant with other writers.
+     * Writers with a higher priority take the available throughput first. Only used on writer descriptors.
+     * Default value: 0.
+     */
+    uint32_t priority;
 
     RTPS_DllAPI ThroughputControllerDescriptor();
     RTPS_DllAPI ThroughputControllerDescriptor(uint32_t size, uint32_t time);
@@ -40,7 +51,9 @@ struct ThroughputControllerDescriptor
     bool operator==(const ThroughputControllerDescriptor& b) const
     {
         return (this->bytesPerPeriod == b.bytesPerPeriod) &&
-               (this->periodMillisecs == b.periodMillisecs);
+               (this->periodMillisecs == b.periodMillisecs) &&
+               (this->burstBytes == b.burstBytes) &&
+               (this->priority == b.priority);
     }
 };
 
@@ -87,8 +87,14 @@ class CacheChangePool {
         uint32_t m_max_pool_size;
         std::vector<CacheChange_t*> m_freeCaches;
         std::vector<CacheChange_t*> m_allCaches;
+        //!Released changes kept for reuse in DYNAMIC_RESERVE_MEMORY_MODE, indexed by the size class of their payload.
+        std::vector<std::vector<CacheChange_t*>> m_recycledCaches;
+        //!Number of changes in m_recycledCaches.
+        uint32_t m_recycled_count;
         bool allocateGroup(uint32_t pool_size);
         CacheChange_t* allocateSingle(uint32_t dataSize);
+        void releaseSingle(CacheChange_t* ch);
+        static void resetCache(CacheChange_t* ch);
         MemoryManagementPolicy_t memoryMode;
 };
 }
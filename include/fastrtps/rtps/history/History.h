@@ -31,6 +31,7 @@
 #include "../attributes/HistoryAttributes.h"
 
 #include <cassert>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps{
@@ -91,7 +92,7 @@ class History
         RTPS_DllAPI size_t getHistorySize() 
         { 
             std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
-            return m_changes.size();
+            return m_changes.size() - m_changesHead;
         }
 
         /**
@@ -116,7 +117,7 @@ class History
          * Get the beginning of the changes history iterator.
          * @return Iterator to the beginning of the vector.
          */
-        RTPS_DllAPI std::vector<CacheChange_t*>::iterator changesBegin(){ return m_changes.begin(); }
+        RTPS_DllAPI std::vector<CacheChange_t*>::iterator changesBegin(){ return m_changes.begin() + m_changesHead; }
         /**
          * Get the end of the changes history iterator.
          * @return Iterator to the end of the vector.
@@ -162,9 +163,17 @@ class History
 
     protected:
 
-        //!Vector of pointers to the CacheChange_t.
+        /**
+         * Vector of pointers to the CacheChange_t.
+         * The first m_changesHead pointers belong to changes already removed, so removing the oldest change does not
+         * shift the whole vector. Use changesBegin() instead of m_changes.begin(), and remove changes with
+         * erase_change_nts().
+         */
         std::vector<CacheChange_t*> m_changes;
 
+        //!Number of pointers at the beginning of m_changes whose changes were already removed.
+        size_t m_changesHead;
+
         //!Variable to know if the history is full without needing to block the History mutex.
         bool m_isHistoryFull;
 
@@ -183,6 +192,17 @@ class History
         //!Print the seqNum of the changes in the History (for debugging purposes).
         void print_changes_seqNum2();
 
+        /**
+         * Remove a pointer from m_changes. Removing the oldest one takes constant time.
+         * The history mutex must be locked.
+         * @param position Iterator to the pointer, from changesBegin() to changesEnd().
+         * @return Iterator following the removed pointer.
+         */
+        std::vector<CacheChange_t*>::iterator erase_change_nts(std::vector<CacheChange_t*>::iterator position);
+
+        //!Remove all the pointers from m_changes. The history mutex must be locked.
+        void clear_changes_nts();
+
         //!Mutex for the History.
         std::recursive_timed_mutex* mp_mutex;
 
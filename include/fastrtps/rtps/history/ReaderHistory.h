@@ -57,6 +57,7 @@ public:
 
     /**
      * Add a CacheChange_t to the ReaderHistory.
+     * The change is inserted in its position by timestamp, so the history is always kept sorted.
      * @param a_change Pointer to the CacheChange to add.
      * @return True if added.
      */
@@ -76,7 +77,8 @@ public:
      * */
     RTPS_DllAPI bool remove_changes_with_guid(const GUID_t& a_guid);
     /**
-     * Sort the CacheChange_t from the History by timestamp
+     * Sort the CacheChange_t from the History by timestamp.
+     * add_change already keeps the history sorted, so this is only needed when timestamps are modified externally.
      */
     RTPS_DllAPI void sortCacheChanges();
     /**
@@ -93,10 +95,19 @@ public:
     RTPS_DllAPI bool get_min_change_from(CacheChange_t** min_change, const GUID_t& writerGuid);
 
 protected:
+    /**
+     * Return a change removed from the history to the pool. Histories that lend the payloads of their changes
+     * override it to keep the change until the loan is returned.
+     * @param a_change Pointer to the removed change.
+     */
+    RTPS_DllAPI virtual void release_removed_change(CacheChange_t* a_change);
+
     //!Pointer to the reader
     RTPSReader* mp_reader;
     //!Pointer to the semaphore, used to halt execution until new message arrives.
     Semaphore* mp_semaphore;
+    //!Whether the changes are also sorted by sequence number, so the minimum and maximum are the first and last ones.
+    bool m_isSortedBySeqNum;
 };
 
 }
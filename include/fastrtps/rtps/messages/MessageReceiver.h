@@ -26,6 +26,8 @@
 #include <fastrtps/rtps/writer/StatelessWriter.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 
+#include <unordered_map>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps{
@@ -78,6 +80,12 @@ class MessageReceiver
     private:
         std::vector<RTPSWriter *> AssociatedWriters;
         std::vector<RTPSReader *> AssociatedReaders;
+        //!Associated writers indexed by their EntityId_t.
+        std::unordered_map<EntityId_t, std::vector<RTPSWriter*>> writers_by_entity_id_;
+        //!Associated readers indexed by their EntityId_t.
+        std::unordered_map<EntityId_t, std::vector<RTPSReader*>> readers_by_entity_id_;
+        //!Associated readers that accept messages directed to ENTITYID_UNKNOWN.
+        std::vector<RTPSReader*> readers_accepting_unknown_;
         std::mutex mtx;
         //!Protocol version of the message
         ProtocolVersion_t sourceVersion;
@@ -122,6 +130,20 @@ class MessageReceiver
          * @return True if correctly read.
          */
         bool readSubmessageHeader(CDRMessage_t*msg, SubmessageHeader_t* smh);
+        /**
+         * Find the associated readers that accept a submessage directed to an entity.
+         * Must be called with mtx locked.
+         * @param readerId EntityId_t the submessage is directed to.
+         * @return Pointer to the list of readers, or nullptr when no reader accepts the submessage.
+         */
+        const std::vector<RTPSReader*>* find_readers_directed_to(const EntityId_t& readerId) const;
+        /**
+         * Find the associated writers with a given entity id.
+         * Must be called with mtx locked.
+         * @param writerId EntityId_t of the writers.
+         * @return Pointer to the list of writers, or nullptr when there is no such writer.
+         */
+        const std::vector<RTPSWriter*>* find_writers_with_id(const EntityId_t& writerId) const;
         /**
          *
          * @param msg
@@ -45,7 +45,6 @@ class RTPSMessageGroup_t
     public:
 
         RTPSMessageGroup_t(uint32_t payload, GuidPrefix_t participant_guid):
-            rtpsmsg_submessage_(payload),
             rtpsmsg_fullmsg_(payload)
 #if HAVE_SECURITY
             , rtpsmsg_encrypt_(payload)
@@ -55,8 +54,6 @@ class RTPSMessageGroup_t
             RTPSMessageCreator::addHeader(&rtpsmsg_fullmsg_, participant_guid);
         }
 
-        CDRMessage_t rtpsmsg_submessage_;
-
         CDRMessage_t rtpsmsg_fullmsg_;
 
 #if HAVE_SECURITY
@@ -242,11 +239,31 @@ class RTPSMessageGroup
         void check_and_maybe_flush(const LocatorList_t& locator_list,
                 const std::vector<GUID_t>& remote_endpoints);
 
-        bool insert_submessage(const std::vector<GUID_t>& remote_endpoints);
+        /**
+         * Serializes a submessage in place at the end of the message being built, preceded by the INFO_DST
+         * submessage when needed. If it does not fit, the message is sent and the submessage is serialized at the
+         * beginning of a new one.
+         * @param remote_endpoints List of destination GUIDs.
+         * @param serialize Functor serializing the submessage into the CDRMessage_t* it receives. It may be called
+         * twice, and it should return false when the submessage could not be serialized.
+         * @return True when the submessage was added to the group.
+         */
+        template<typename SerializeFunctor>
+        bool add_submessage(const std::vector<GUID_t>& remote_endpoints, SerializeFunctor serialize);
 
         bool add_info_dst_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_endpoints);
 
-        bool add_info_ts_in_buffer(const std::vector<GUID_t>& remote_readers, const Time_t& timestamp);
+        bool add_info_ts_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_readers,
+                const Time_t& timestamp);
+
+#if HAVE_SECURITY
+        /**
+         * Replaces the submessage serialized in a buffer from a position by its protected version.
+         * @return False when the submessage could not be encoded or the encoded submessage does not fit.
+         */
+        bool encode_submessage_in_buffer(CDRMessage_t* buffer, uint32_t from_buffer_position,
+                const std::vector<GUID_t>& remote_endpoints, ENDPOINT_TYPE type);
+#endif
 
         RTPSParticipantImpl* participant_;
 
@@ -254,8 +271,6 @@ class RTPSMessageGroup
 
         CDRMessage_t* full_msg_;
 
-        CDRMessage_t* submessage_msg_;
-
         uint32_t currentBytesSent_;
 
         LocatorList_t current_locators_;
@@ -83,6 +83,10 @@ class NetworkFactory
 
         void NormalizeLocators(LocatorList_t& locators);
 
+        /**
+         * Selects the locators to send to a set of remote endpoints, given the locators of each of them.
+         * Endpoints of this host announcing a shared-memory locator are only reached through shared memory.
+         */
         LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists);
 
         bool is_local_locator(const Locator_t& locator) const;
@@ -147,6 +151,9 @@ class NetworkFactory
 
     private:
 
+        //! Checks whether the list contains a shared-memory locator of this host supported by a registered transport.
+        bool has_local_shared_memory_locator(const LocatorList_t& locators) const;
+
         std::vector<std::unique_ptr<TransportInterface> > mRegisteredTransports;
 
         uint32_t maxMessageSizeBetweenTransports_;
@@ -15,6 +15,8 @@
 #ifndef SENDER_RESOURCE_H
 #define SENDER_RESOURCE_H
 
+#include "../common/Locator.h"
+
 #include <functional>
 #include <vector>
 
@@ -26,7 +28,6 @@ class RTPSParticipantImpl;
 class MessageReceiver;
 class ChannelResource;
 class TransportInterface;
-class Locator_t;
 
 /**
  * RAII object that encapsulates the Send operation over one chanel in an unknown transport.
@@ -59,6 +60,33 @@ public:
         return returned_value;
     }
 
+    /**
+     * Sends to a list of destination locators, through the channel managed by this resource.
+     * Transports able to send to several destinations with one operation provide their own implementation.
+     * Otherwise the data is sent to each destination in turn.
+     * @param data Raw data slice to be sent.
+     * @param dataLength Length of the data to be sent. Will be used as a boundary for
+     * the previous parameter.
+     * @param destination_locators List of locators describing the destination endpoints.
+     * @return True when the data was sent to at least one of the destinations.
+     */
+    bool send(const octet* data, uint32_t dataLength, const LocatorList_t& destination_locators)
+    {
+        if (send_list_lambda_)
+        {
+            return send_list_lambda_(data, dataLength, destination_locators);
+        }
+
+        bool returned_value = false;
+
+        for (const Locator_t& destination_locator : destination_locators)
+        {
+            returned_value |= send(data, dataLength, destination_locator);
+        }
+
+        return returned_value;
+    }
+
     /**
      * Resources can only be transfered through move semantics. Copy, assignment, and
      * construction outside of the factory are forbidden.
@@ -67,6 +95,7 @@ public:
     {
         clean_up.swap(rValueResource.clean_up);
         send_lambda_.swap(rValueResource.send_lambda_);
+        send_list_lambda_.swap(rValueResource.send_list_lambda_);
     }
 
     virtual ~SenderResource() = default;
@@ -81,6 +110,7 @@ protected:
 
     std::function<void()> clean_up;
     std::function<bool(const octet*, uint32_t, const Locator_t&)> send_lambda_;
+    std::function<bool(const octet*, uint32_t, const LocatorList_t&)> send_list_lambda_;
 
 private:
 
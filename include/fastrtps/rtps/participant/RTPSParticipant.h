@@ -196,6 +196,13 @@ public:
 
     ResourceEvent& get_resource_event() const;
 
+    /**
+     * Waits until the operations sent to the persistence service by any of the endpoints are stored.
+     * Endpoints must not be removed while waiting.
+     * @return True if all of them were successfully stored since the last call.
+     */
+    bool flush_persistence();
+
 private:
 
     //!Pointer to the implementation.
@@ -151,6 +151,13 @@ public:
             CacheChange_t* change,
             WriterProxy* prox = nullptr) = 0;
 
+    /**
+     * Waits until all the notified sequence numbers sent to the persistence service were stored.
+     * Readers without persistence return true straight away.
+     * @return True if all the sequence numbers were successfully stored since the last call.
+     */
+    RTPS_DllAPI virtual bool flush_persistence() { return true; }
+
     /**
      * Get the associated listener, secondary attached Listener in case it is of coumpound type
      * @return Pointer to the associated reader listener.
@@ -43,6 +43,12 @@ class StatefulPersistentReader : public StatefulReader
     public:
     virtual ~StatefulPersistentReader();
 
+    /**
+     * Wait until all the notified sequence numbers sent to the persistence service are stored.
+     * @return True if all the sequence numbers were successfully stored since the last call.
+     */
+    bool flush_persistence() override;
+
     protected:
     virtual void set_last_notified(const GUID_t& persistence_guid, const SequenceNumber_t& seq) override;
 
@@ -27,7 +27,11 @@
 #include "../common/CacheChange.h"
 #include "../attributes/ReaderAttributes.h"
 
-#include<set>
+#include <vector>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
 
 // Testing purpose
 #ifndef TEST_FRIENDS
@@ -110,10 +114,45 @@ namespace eprosima
                     bool areThereMissing();
 
                     /**
-                     * The method returns a vector containing all missing changes.
-                     * @return Vector of missing changes..
+                     * Apply a function on the sequence number of every missing change, in ascending order.
+                     * No memory is allocated, and the window of received changes is traversed a word at a time.
+                     * @param f Function to apply on each missing sequence number.
                      */
-                    const std::vector<ChangeFromWriter_t>  missing_changes();
+                    template<class UnaryFunc>
+                    void for_each_missing_change(UnaryFunc f) const
+                    {
+                        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+
+                        // All changes not received from the low mark up to the last announced as missing are MISSING.
+                        if(missing_changes_max_ <= changesFromWLowMark_)
+                        {
+                            return;
+                        }
+
+                        SequenceNumber_t first = changesFromWLowMark_ + 1;
+                        uint64_t offset = first.to64long() - received_bitmap_base_.to64long();
+                        uint64_t end_offset = missing_changes_max_.to64long() - received_bitmap_base_.to64long() + 1;
+                        while(offset < end_offset)
+                        {
+                            uint32_t bit = static_cast<uint32_t>(offset & 31u);
+                            uint64_t word_base = offset - bit;
+                            // Missing bits of the current word, starting at offset
+                            uint32_t missing = ~received_word_nts(offset >> 5) & (~0u << bit);
+                            if(end_offset - word_base < 32u)
+                            {
+                                missing &= (1u << (end_offset - word_base)) - 1u;
+                            }
+
+                            while(missing != 0u)
+                            {
+                                uint32_t index = count_trailing_zeros(missing);
+                                f(received_bitmap_base_ + static_cast<uint32_t>(word_base + index));
+                                missing &= missing - 1u;
+                            }
+
+                            offset = word_base + 32u;
+                        }
+                    }
 
                     size_t unknown_missing_changes_up_to(const SequenceNumber_t& seqNum);
 
@@ -172,18 +211,64 @@ namespace eprosima
                 private:
 
                     /*!
-                     * @brief Add ChangeFromWriter_t up to the sequenceNumber passed, but not including this.
-                     * Ex: If you have seqNums 1,2,3 and you receive seqNum 6, you need to add 4 and 5.
-                     * @param sequence_number
-                     * @param default_status ChangeFromWriter_t added will be created with this ChangeFromWriterStatus_t.
-                     * @return True if sequence_number will be the next after last element in the m_changesFromW container.
+                     * @brief Set a change as RECEIVED. Received changes are not distinguished by their relevance.
+                     * @param seq_num Sequence number of the change.
+                     * @return True if the change was not received before.
+                     */
+                    bool mark_change_as_received(const SequenceNumber_t& seq_num);
+
+                    void cleanup();
+
+                    /*!
+                     * @brief Get the status of a change from the window of changes.
+                     * @param seq_num Sequence number of a change above the low mark.
+                     * @return RECEIVED, MISSING or UNKNOWN.
+                     * @remarks No thread-safe.
+                     */
+                    ChangeFromWriterStatus_t change_status_nts(const SequenceNumber_t& seq_num) const;
+
+                    /*!
+                     * @brief Get a word of the window of received changes.
+                     * @param word Index of the word, counting from the word holding received_bitmap_base_.
+                     * @return Bits of the word. Bit n is set when received_bitmap_base_ + 32 * word + n was received.
                      * @remarks No thread-safe.
                      */
-                    bool maybe_add_changes_from_writer_up_to(const SequenceNumber_t& sequence_number, const ChangeFromWriterStatus_t default_status = ChangeFromWriterStatus_t::UNKNOWN);
+                    uint32_t received_word_nts(uint64_t word) const
+                    {
+                        return word < received_bitmap_.size() ?
+                            received_bitmap_[(received_bitmap_head_ + word) & (received_bitmap_.size() - 1)] : 0u;
+                    }
 
-                    bool received_change_set(const SequenceNumber_t& seqNum, bool is_relevance);
+                    bool change_is_received_nts(const SequenceNumber_t& seq_num) const;
 
-                    void cleanup();
+                    void set_change_received_nts(const SequenceNumber_t& seq_num);
+
+                    /*!
+                     * @brief Moves the low mark, releasing the words of the window below it.
+                     * @param seq_num New low mark.
+                     * @remarks No thread-safe.
+                     */
+                    void advance_low_mark_nts(const SequenceNumber_t& seq_num);
+
+                    static uint32_t count_trailing_zeros(uint32_t bits)
+                    {
+#if _MSC_VER
+                        unsigned long index;
+                        _BitScanForward(&index, bits);
+                        return static_cast<uint32_t>(index);
+#else
+                        return static_cast<uint32_t>(__builtin_ctz(bits));
+#endif
+                    }
+
+                    static uint32_t count_ones(uint32_t bits)
+                    {
+#if _MSC_VER
+                        return static_cast<uint32_t>(__popcnt(bits));
+#else
+                        return static_cast<uint32_t>(__builtin_popcount(bits));
+#endif
+                    }
 
                     //!Is the writer alive
                     bool m_isAlive;
@@ -193,23 +278,22 @@ namespace eprosima
                     //!Mutex Pointer
                     std::recursive_mutex* mp_mutex;
 
-                    //!Vector containing the ChangeFromWriter_t objects.
-                    std::set<ChangeFromWriter_t, ChangeFromWriterCmp> m_changesFromW;
+                    //! Highest sequence number such that it and all the previous ones were received or lost.
                     SequenceNumber_t changesFromWLowMark_;
+                    //! Highest sequence number known to be available in the writer.
+                    SequenceNumber_t changes_from_writer_max_;
+                    //! Highest sequence number announced as missing. Changes above it not received are UNKNOWN.
+                    SequenceNumber_t missing_changes_max_;
+                    //! Ring bitmap of the received changes above the low mark. Its size is a power of two.
+                    std::vector<uint32_t> received_bitmap_;
+                    //! Position in received_bitmap_ of the word holding the bit of received_bitmap_base_.
+                    size_t received_bitmap_head_;
+                    //! Sequence number of the first bit of the head word. The low mark is always in this word or
+                    //! just before it.
+                    SequenceNumber_t received_bitmap_base_;
 
                     //! Store last ChacheChange_t notified.
                     SequenceNumber_t lastNotified_;
-
-                    void for_each_set_status_from(decltype(m_changesFromW)::iterator first,
-                            decltype(m_changesFromW)::iterator last,
-                            ChangeFromWriterStatus_t status,
-                            ChangeFromWriterStatus_t new_status);
-
-                    void for_each_set_status_from_and_maybe_remove(decltype(m_changesFromW)::iterator first,
-                            decltype(m_changesFromW)::iterator last,
-                            ChangeFromWriterStatus_t status,
-                            ChangeFromWriterStatus_t orstatus,
-                            ChangeFromWriterStatus_t new_status);
             };
 
         } /* namespace rtps */
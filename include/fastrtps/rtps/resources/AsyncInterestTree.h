@@ -23,6 +23,11 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+/**
+ * Set of writers with pending asynchronous work.
+ * @deprecated Asynchronous writes are served by the scheduler of each participant, which no longer uses this class.
+ * It is kept for compatibility and will be removed in the next major version.
+ */
 class AsyncInterestTree
 {
 public:
@@ -19,75 +19,62 @@
 #ifndef _RTPS_RESOURCES_ASYNCWRITERTHREAD_H_
 #define _RTPS_RESOURCES_ASYNCWRITERTHREAD_H_
 
-#include <thread>
-#include <atomic>
-#include <mutex>
-#include <condition_variable>
-#include <list>
-
-#include <fastrtps/rtps/resources/AsyncInterestTree.h>
-
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 class RTPSWriter;
+class RTPSParticipantImpl;
 
 /**
- * @brief This static class owns a thread that manages asynchronous writes.
+ * @brief This static class dispatches asynchronous writes to the scheduler of the participant of each writer.
  * Asynchronous writes happen directly (when using an async writer) and
  * indirectly (when responding to a NACK).
+ * Each participant serves its writers with its own worker threads, whose number is set with
+ * RTPSParticipantAttributes::asyncWriterThreads.
  * @ingroup COMMON_MODULE
  */
 class AsyncWriterThread
 {
 public:
     /**
-     * @brief Adds a writer to be managed by this thread.
-     * Only asynchronous writers are permitted.
-     * @param writer Asynchronous writer to be added.
+     * @brief Adds a writer to be managed by the scheduler of its participant.
+     * @param writer Writer to be added.
      * @return Result of the operation.
      */
     static bool addWriter(RTPSWriter& writer);
 
     /**
      * @brief Removes a writer.
-     * @param writer Asynchronous writer to be removed.
+     * @param writer Writer to be removed.
      * @return Result of the operation.
      */
     static bool removeWriter(RTPSWriter& writer);
 
     /**
-     * Wakes the thread up.
+     * Wakes up all the writers of a participant.
      * @param interestedParticipant The participant interested in an async write.
      */
     static void wakeUp(const RTPSParticipantImpl* interestedParticipant);
 
     /**
-     * Wakes the thread up.
+     * Wakes up a writer.
      * @param interestedWriter The writer interested in an async write.
      */
     static void wakeUp(const RTPSWriter* interestedWriter);
 
+    /**
+     * Wakes up a writer of a participant.
+     * The writer is only used as a key, so it may have been destroyed already.
+     * @param participant The participant of the writer.
+     * @param interestedWriter The writer interested in an async write.
+     */
+    static void wakeUp(const RTPSParticipantImpl* participant, const RTPSWriter* interestedWriter);
+
 private:
     AsyncWriterThread() = delete;
     ~AsyncWriterThread() = delete;
     AsyncWriterThread(const AsyncWriterThread&) = delete;
     const AsyncWriterThread& operator=(const AsyncWriterThread&) = delete;
-
-    //! @brief runs main method
-    static void run();
-
-    static std::thread* thread_;
-    static std::mutex data_structure_mutex_;
-    static std::mutex condition_variable_mutex_;
-
-    //! List of asynchronous writers.
-    static std::list<RTPSWriter*> async_writers;
-    static AsyncInterestTree interestTree;
-
-    static bool running_;
-    static bool run_scheduled_;
-    static std::condition_variable cv_;
 };
 
 } // namespace rtps
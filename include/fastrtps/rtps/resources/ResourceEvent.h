@@ -22,6 +22,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include <thread>
+#include <memory>
 #include <asio.hpp>
 
 namespace eprosima {
@@ -29,6 +30,7 @@ namespace fastrtps{
 namespace rtps {
 
 class RTPSParticipantImpl;
+class TimerWheel;
 
 /**
  * Class ResourceEvent used to manage the temporal events.
@@ -72,6 +74,9 @@ private:
 
 	//!Pointer to the RTPSParticipantImpl.
 	RTPSParticipantImpl* mp_RTPSParticipantImpl;
+
+	//!Timer wheel of the IO service, kept for as long as the service exists.
+	std::shared_ptr<TimerWheel> mp_timer_wheel;
 };
 }
 }
@@ -55,6 +55,12 @@ class PersistentWriter
      */
     void remove_persistent_change(CacheChange_t* change);
 
+    /**
+     * Wait until all the changes sent to storage are stored.
+     * @return True if all the changes were successfully stored.
+     */
+    bool flush_persistent_changes();
+
     private:
     //!Persistence service
     IPersistenceService* persistence_;
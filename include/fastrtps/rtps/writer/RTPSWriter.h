@@ -34,6 +34,7 @@ namespace rtps {
 
 class WriterListener;
 class WriterHistory;
+class RTPSReader;
 class FlowController;
 struct CacheChange_t;
 
@@ -112,6 +113,13 @@ public:
     */
     RTPS_DllAPI virtual bool wait_for_all_acked(const Duration_t& /*max_wait*/) { return true; }
 
+    /**
+    * Waits until all the changes sent to the persistence service were stored.
+    * Writers without persistence return true straight away.
+    * @return True if all the changes were successfully stored since the last call.
+    */
+    RTPS_DllAPI virtual bool flush_persistence() { return true; }
+
     /**
      * Update the Attributes of the Writer.
      * @param att New attributes
@@ -202,6 +210,12 @@ public:
      */
     inline RTPSParticipantImpl* getRTPSParticipant() const { return mp_RTPSParticipant; }
 
+    /**
+     * Get the priority of the writer when sharing the flow controllers of its participant with other writers.
+     * @return Priority of the writer.
+     */
+    inline uint32_t getFlowControllerPriority() const { return m_flowControllerPriority; }
+
     /**
      * Enable or disable sending data to readers separately
      * NOTE: This will only work for synchronous writers
@@ -281,6 +295,8 @@ protected:
     bool is_async_;
     //!Separate sending activated
     bool m_separateSendingEnabled;
+    //!Priority when sharing the flow controllers of the participant
+    uint32_t m_flowControllerPriority;
 
     LocatorList_t mAllShrinkedLocatorList;
 
@@ -288,6 +304,33 @@ protected:
 
     void update_cached_info_nts(std::vector<LocatorList_t>& allLocatorLists);
 
+    /**
+     * Look for a matched reader to which changes can be handed directly, because it belongs to the participant of
+     * this writer. Protected endpoints always go through the transports.
+     * @param reader_guid GUID of the matched reader.
+     * @return Pointer to the reader, or nullptr when changes have to be sent through the transports.
+     */
+    RTPSReader* find_local_reader(const GUID_t& reader_guid);
+
+    /**
+     * Queue a delivery to a reader of the participant of this writer.
+     * It is run afterwards by the participant, without the mutex of this writer taken, so the reader and its
+     * listener are free to use this and other writers.
+     * @param reader Pointer to the local reader.
+     * @param delivery Function doing the delivery.
+     */
+    void push_local_delivery(
+            RTPSReader* reader,
+            std::function<void()>&& delivery);
+
+    /**
+     * Copy a change to be delivered to local readers, which may run after the change was removed from the history.
+     * Shared payloads are not copied, but referenced.
+     * @param change Pointer to the change.
+     * @return Copy of the change, to be shared by all the deliveries of the change.
+     */
+    static std::shared_ptr<CacheChange_t> copy_for_local_delivery(const CacheChange_t* change);
+
     /**
      * Initialize the header of hte CDRMessages.
      */
@@ -37,6 +37,7 @@ namespace rtps {
 
 class StatefulWriter;
 class NackSupressionDuration;
+class RTPSReader;
 
 /**
  * ReaderProxy class that helps to keep the state of a specific Reader with respect to the RTPSWriter.
@@ -44,6 +45,8 @@ class NackSupressionDuration;
  */
 class ReaderProxy
 {
+    friend class StatefulWriter;
+
 public:
     ~ReaderProxy();
 
@@ -59,8 +62,11 @@ public:
     /**
      * Activate this proxy associating it to a remote reader.
      * @param reader_attributes RemoteReaderAttributes of the reader for which to keep state.
+     * @param local_reader Pointer to the reader when it belongs to the participant of the writer, nullptr otherwise.
      */
-    void start(const RemoteReaderAttributes& reader_attributes);
+    void start(
+            const RemoteReaderAttributes& reader_attributes,
+            RTPSReader* local_reader = nullptr);
 
     /**
      * Disable this proxy.
@@ -237,6 +243,25 @@ public:
         return reader_attributes_.endpoint.reliabilityKind == RELIABLE;
     }
 
+    /**
+     * Check if the reader represented by this proxy belongs to the participant of the writer.
+     * Changes are then handed directly to the reader, instead of being sent through the transports.
+     * @return true if the reader represented by this proxy is local.
+     */
+    inline bool is_local_reader() const
+    {
+        return local_reader_ != nullptr;
+    }
+
+    /**
+     * Get the reader represented by this proxy, when it belongs to the participant of the writer.
+     * @return Pointer to the local reader, or nullptr if the reader is remote.
+     */
+    inline RTPSReader* local_reader() const
+    {
+        return local_reader_;
+    }
+
     /**
      * Get the attributes of the reader represented by this proxy.
      * @return the attributes of the reader represented by this proxy.
@@ -339,6 +364,8 @@ private:
     RemoteReaderAttributes reader_attributes_;
     //!Pointer to the associated StatefulWriter.
     StatefulWriter* writer_;
+    //!Pointer to the reader when it belongs to the participant of the writer.
+    RTPSReader* local_reader_;
     //!To fool RTPSMessageGroup when using this proxy as single destination
     ResourceLimitedVector<GUID_t> guid_as_vector_;
     //!Set of the changes and its state.
@@ -353,6 +380,10 @@ private:
     uint32_t last_nackfrag_count_;
 
     SequenceNumber_t changes_low_mark_;
+    //! Position of this proxy in the heap of low marks kept by the writer.
+    size_t low_mark_heap_index_;
+    //! Whether the writer counts this proxy as having changes pending acknowledgement.
+    bool counted_with_changes_;
 
     using ChangeIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::iterator;
     using ChangeConstIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::const_iterator;
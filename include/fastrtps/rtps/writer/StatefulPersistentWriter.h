@@ -57,6 +57,12 @@ class StatefulPersistentWriter : public StatefulWriter, private PersistentWriter
      * @return True if removed correctly.
      */
     bool change_removed_by_history(CacheChange_t* a_change) override;
+
+    /**
+     * Wait until all the changes sent to the persistence service are stored.
+     * @return True if all the changes were successfully stored since the last call.
+     */
+    bool flush_persistence() override;
 };
 }
 } /* namespace rtps */
@@ -26,6 +26,8 @@
 #include "../../utils/collections/ResourceLimitedVector.hpp"
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
+#include <set>
 
 namespace eprosima {
 namespace fastrtps {
@@ -70,6 +72,12 @@ private:
     ResourceLimitedVector<ReaderProxy*> matched_readers_;
     //! Vector containing all the inactive, ready for reuse, ReaderProxies.
     ResourceLimitedVector<ReaderProxy*> matched_readers_pool_;
+    //! Index of the active ReaderProxies by the GUID of their remote reader.
+    std::unordered_map<GUID_t, ReaderProxy*> matched_readers_index_;
+    //! Binary min-heap of the active ReaderProxies, ordered by their changes low mark.
+    ResourceLimitedVector<ReaderProxy*> low_mark_heap_;
+    //! Number of active ReaderProxies with changes pending acknowledgement.
+    size_t readers_with_changes_;
 
     using ReaderProxyIterator = ResourceLimitedVector<ReaderProxy*>::iterator;
     using ReaderProxyConstIterator = ResourceLimitedVector<ReaderProxy*>::const_iterator;
@@ -274,6 +282,111 @@ private:
 
     void check_acked_status();
 
+    /**
+     * Queue a change to be handed directly to a reader of this participant.
+     * All the deliveries to local readers run once the mutex of this writer is released.
+     * @param reader Pointer to the ReaderProxy of a local reader.
+     * @param change Copy of the change made for local readers.
+     */
+    void deliver_to_local_reader_nts(
+            ReaderProxy* reader,
+            const std::shared_ptr<CacheChange_t>& change);
+
+    /**
+     * Queue the unsent changes of a local reader to be handed directly to it, informing it of the irrelevant ones.
+     * @param reader Pointer to the ReaderProxy of a local reader.
+     * @param max_sequence Sequence number following the last change of the history.
+     * @return True if the reader is reliable and some change was queued for it.
+     */
+    bool send_unsent_changes_to_local_reader_nts(
+            ReaderProxy* reader,
+            const SequenceNumber_t& max_sequence);
+
+    /**
+     * Queue a GAP informing a local reader that some changes are irrelevant.
+     * @param reader Pointer to the ReaderProxy of a local reader.
+     * @param irrelevant Sequence numbers of the irrelevant changes.
+     */
+    void send_gap_to_local_reader_nts(
+            ReaderProxy* reader,
+            const std::set<SequenceNumber_t>& irrelevant);
+
+    /**
+     * Queue a heartbeat to a local reader, unless it already acknowledged every change.
+     * @param reader Pointer to the ReaderProxy of a local reader.
+     */
+    void send_heartbeat_to_local_reader_nts(ReaderProxy* reader);
+
+    /**
+     * Queue a change to be handed to a local reader.
+     * @param reader Pointer to the ReaderProxy of a local reader.
+     * @param change Copy of the change made for local readers. Nothing is queued if it is empty.
+     */
+    void push_local_data_nts(
+            ReaderProxy* reader,
+            const std::shared_ptr<CacheChange_t>& change);
+
+    /**
+     * Queue the acknowledgement of the changes a local reliable reader has received.
+     * @param reader Pointer to the ReaderProxy of a local reader.
+     */
+    void push_local_acknowledgement_nts(ReaderProxy* reader);
+
+    /**
+     * Acknowledge the changes a local reliable reader has already received, as an ACKNACK would do.
+     * Called from the local deliveries, it takes the mutex of the reader and then, once released, the one of this
+     * writer.
+     * @param local_reader Pointer to the local reader.
+     */
+    void acknowledge_local_reader(RTPSReader* local_reader);
+
+    /**
+     * Find an active ReaderProxy.
+     * @param reader_guid GUID of the remote reader.
+     * @return Pointer to the ReaderProxy, or nullptr if the reader is not matched.
+     */
+    ReaderProxy* find_matched_reader_nts(const GUID_t& reader_guid) const;
+
+    /**
+     * Get the lowest changes low mark of all active ReaderProxies.
+     * @return The lowest low mark, or SequenceNumber_t() when there are no matched readers.
+     */
+    SequenceNumber_t min_low_mark_nts() const;
+
+    /**
+     * Add an active ReaderProxy to the heap of low marks.
+     * @param reader Pointer to the ReaderProxy.
+     */
+    void low_mark_heap_add_nts(ReaderProxy* reader);
+
+    /**
+     * Remove an active ReaderProxy from the heap of low marks.
+     * @param reader Pointer to the ReaderProxy.
+     */
+    void low_mark_heap_remove_nts(ReaderProxy* reader);
+
+    /**
+     * Update the acknowledgement status kept for a ReaderProxy after its changes have been modified.
+     * @param reader Pointer to the ReaderProxy.
+     */
+    void update_acked_status_nts(ReaderProxy* reader);
+
+    void low_mark_heap_sift_nts(size_t index);
+
+    void low_mark_heap_swap_nts(
+            size_t first,
+            size_t second);
+
+    /**
+     * Check whether a change is acknowledged by the readers in a subtree of the heap of low marks.
+     * @param seq_num Sequence number of the change.
+     * @param index Position of the root of the subtree.
+     * @return True if all readers in the subtree acknowledged the change.
+     */
+    bool change_is_acked_by_subtree_nts(
+            const SequenceNumber_t& seq_num,
+            size_t index) const;
+
     /**
      * @brief A method called when the ack timer expires
      * @details Only used if disable positive ACKs QoS is enabled
@@ -133,9 +133,28 @@ private:
 
     void update_locators_nts();
 
+    /**
+     * Check whether a matched reader belongs to the participant of this writer.
+     * @param reader_guid GUID of the matched reader.
+     * @return True if changes are handed directly to the reader.
+     */
+    bool is_local_reader_nts(const GUID_t& reader_guid) const;
+
+    /**
+     * Queue a change to be handed directly to a reader of this participant.
+     * All the deliveries to local readers run once the mutex of this writer is released.
+     * @param reader Pointer to the local reader.
+     * @param change Copy of the change made for local readers. Nothing is queued if it is empty.
+     */
+    void deliver_to_local_reader_nts(
+            RTPSReader* reader,
+            const std::shared_ptr<CacheChange_t>& change);
+
     bool is_inline_qos_expected_ = false;
     LocatorList_t fixed_locators_;
     ResourceLimitedVector<RemoteReaderAttributes> matched_readers_;
+    //! Matched readers of the participant of this writer, which get the changes directly.
+    ResourceLimitedVector<RTPSReader*> local_readers_;
     ResourceLimitedVector<ChangeForReader_t, std::true_type> unsent_changes_;
     std::vector<std::unique_ptr<FlowController> > flow_controllers_;
 };
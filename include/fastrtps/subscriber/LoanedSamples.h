@@ -0,0 +1,125 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoanedSamples.h
+ */
+
+#ifndef LOANEDSAMPLES_H_
+#define LOANEDSAMPLES_H_
+
+#include "../fastrtps_dll.h"
+#include "SampleInfo.h"
+
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+
+class SubscriberHistory;
+
+/**
+ * Class LoanedSamples, sequence of samples loaned by a Subscriber.
+ * The samples reference the payloads of the changes in the history of the Subscriber, without any copy, and remain
+ * valid until the loan is returned with Subscriber::return_loan, or the sequence is destroyed, which returns the loan
+ * automatically. Loaned samples still count towards the resource limits of the Subscriber. The sequence can be moved
+ * but not copied. When the Subscriber is removed first, its outstanding sequences are left empty.
+ * @ingroup FASTRTPS_MODULE
+ */
+class RTPS_DllAPI LoanedSamples
+{
+    friend class SubscriberHistory;
+
+public:
+
+    LoanedSamples() = default;
+
+    //! Returns the loan, if any, to the Subscriber.
+    ~LoanedSamples();
+
+    LoanedSamples(const LoanedSamples&) = delete;
+
+    LoanedSamples& operator=(const LoanedSamples&) = delete;
+
+    //! Takes over the loan of other, which is left empty.
+    LoanedSamples(LoanedSamples&& other);
+
+    //! Returns the current loan, if any, and takes over the loan of other, which is left empty.
+    LoanedSamples& operator=(LoanedSamples&& other);
+
+    /**
+     * Get the number of loaned samples.
+     * @return Number of samples.
+     */
+    size_t size() const
+    {
+        return changes_.size();
+    }
+
+    /**
+     * Check whether there is any loaned sample.
+     * @return True if there are no samples.
+     */
+    bool empty() const
+    {
+        return changes_.empty();
+    }
+
+    /**
+     * Get the serialized payload of a sample, which can be deserialized with the TopicDataType.
+     * @param index Position of the sample.
+     * @return Reference to the payload.
+     */
+    const rtps::SerializedPayload_t& payload(size_t index) const
+    {
+        return changes_[index]->serializedPayload;
+    }
+
+    /**
+     * Get a sample of a plain type, whose CDR representation is in the native endianness.
+     * @param index Position of the sample.
+     * @return Pointer to the CDR representation of the sample, after the encapsulation. nullptr when the type is
+     * not plain, the sample is not ALIVE or its endianness is not the native one.
+     */
+    const void* sample(size_t index) const
+    {
+        return samples_[index];
+    }
+
+    /**
+     * Get the information of a sample.
+     * @param index Position of the sample.
+     * @return Reference to the SampleInfo_t.
+     */
+    const SampleInfo_t& info(size_t index) const
+    {
+        return infos_[index];
+    }
+
+private:
+
+    //! Subscriber history that loaned the samples
+    SubscriberHistory* history_ = nullptr;
+
+    std::vector<rtps::CacheChange_t*> changes_;
+
+    std::vector<const void*> samples_;
+
+    std::vector<SampleInfo_t> infos_;
+};
+
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif /* LOANEDSAMPLES_H_ */
@@ -30,6 +30,7 @@ namespace fastrtps {
 
 class SubscriberImpl;
 class SampleInfo_t;
+class LoanedSamples;
 
 /**
  * Class Subscriber, contains the public API that allows the user to control the reception of messages.
@@ -82,6 +83,36 @@ public:
             void* data,
             SampleInfo_t* info);
 
+    /**
+     * Read unread samples from the Subscriber, lending the payloads in its history instead of deserializing them.
+     * All the samples are read in a single acquisition of the history mutex.
+     * @param[out] samples Sequence where the samples are loaned. It must not hold a previous loan.
+     * @param max_samples Maximum number of samples to read. 0 reads all the unread samples.
+     * @return True if any sample was read.
+     */
+    bool read_loaned(
+            LoanedSamples& samples,
+            size_t max_samples = 0);
+
+    /**
+     * Take samples from the Subscriber, lending the payloads in its history instead of deserializing them.
+     * The samples are removed from the subscriber, and their payloads are released when the loan is returned.
+     * All the samples are taken in a single acquisition of the history mutex.
+     * @param[out] samples Sequence where the samples are loaned. It must not hold a previous loan.
+     * @param max_samples Maximum number of samples to take. 0 takes all the available samples.
+     * @return True if any sample was taken.
+     */
+    bool take_loaned(
+            LoanedSamples& samples,
+            size_t max_samples = 0);
+
+    /**
+     * Return the samples loaned by read_loaned or take_loaned.
+     * @param samples Sequence holding the loan. It is left empty.
+     * @return True if correct. False if the samples were not loaned by this Subscriber.
+     */
+    bool return_loan(LoanedSamples& samples);
+
     /**
      * Update the Attributes of the subscriber;
      * @param att Reference to a SubscriberAttributes object to update the parameters;
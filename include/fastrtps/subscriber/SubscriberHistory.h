@@ -26,6 +26,10 @@
 #include "../qos/QosPolicies.h"
 #include "../common/KeyedChanges.h"
 #include "SampleInfo.h"
+#include "LoanedSamples.h"
+
+#include <map>
+#include <set>
 
 namespace eprosima {
 namespace fastrtps {
@@ -42,6 +46,8 @@ class SubscriberImpl;
  */
 class SubscriberHistory: public rtps::ReaderHistory
 {
+    friend class LoanedSamples;
+
     public:
 
         /**
@@ -86,6 +92,26 @@ class SubscriberHistory: public rtps::ReaderHistory
         bool readNextBuffer(rtps::SerializedPayload_t* data, SampleInfo_t* info);
         bool takeNextBuffer(rtps::SerializedPayload_t* data, SampleInfo_t* info);
 
+        /** @name Loaned read or take methods.
+         * Methods to read or take samples lending the payloads of the changes, instead of deserializing them.
+         * All the samples are obtained in a single acquisition of the history mutex.
+         * @param[out] samples Sequence where the samples are loaned. It must not hold a previous loan.
+         * @param max_samples Maximum number of samples. 0 means no limit.
+         * @return True if any sample was loaned.
+         */
+        ///@{
+        bool read_loaned(LoanedSamples& samples, size_t max_samples);
+        bool take_loaned(LoanedSamples& samples, size_t max_samples);
+        ///@}
+
+        /**
+         * Return the samples loaned by read_loaned or take_loaned. The changes that were removed from the history
+         * while loaned are released.
+         * @param samples Sequence holding the loan. It is left empty.
+         * @return True if correct.
+         */
+        bool return_loan(LoanedSamples& samples);
+
 
         /**
          * This method is called to remove a change from the SubscriberHistory.
@@ -123,10 +149,23 @@ class SubscriberHistory: public rtps::ReaderHistory
                 rtps::InstanceHandle_t& handle,
                 std::chrono::steady_clock::time_point& next_deadline_us);
 
+    protected:
+
+        void release_removed_change(rtps::CacheChange_t* a_change) override;
+
     private:
 
         typedef std::map<rtps::InstanceHandle_t, KeyedChanges> t_m_Inst_Caches;
 
+        //!Loans of a change
+        struct ChangeLoan
+        {
+            //!Number of sequences holding the change
+            uint32_t count = 0;
+            //!Whether the change was removed from the history while loaned
+            bool removed = false;
+        };
+
         //!Number of unread CacheChange_t.
         uint64_t m_unreadCacheCount;
         //!Map where keys are instance handles and values vectors of cache changes
@@ -143,6 +182,22 @@ class SubscriberHistory: public rtps::ReaderHistory
         //!Type object to deserialize Key
         void * mp_getKeyObject;
 
+        //!Changes whose payload is loaned
+        std::map<rtps::CacheChange_t*, ChangeLoan> loaned_changes_;
+
+        //!Sequences holding a loan, detached when the history is destroyed
+        std::set<LoanedSamples*> loaned_sequences_;
+
+        //!Replaces a sequence holding a loan by the one it was moved to
+        void move_loan(
+                LoanedSamples* from,
+                LoanedSamples* to);
+
+        bool loan_samples(
+                LoanedSamples& samples,
+                size_t max_samples,
+                bool take);
+
         /**
          * @brief Method that finds a key in m_keyedChanges or tries to add it if not found
          * @param a_change The change to get the key from
@@ -0,0 +1,168 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_H
+#define SHAREDMEM_TRANSPORT_H
+
+#include "TransportInterface.h"
+#include "SharedMemTransportDescriptor.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class SharedMemSegment;
+class SharedMemChannelResource;
+
+/**
+ * Transport between the participants of the same host, through POSIX shared memory.
+ *    - Opening an input channel creates a shared-memory segment named after the port, holding a ring buffer in
+ *       which the participants of the host write the messages sent to that port. A thread per port delivers the
+ *       messages straight from the shared memory, without copying them.
+ *
+ *    - The locators of this transport have kind LOCATOR_KIND_SHM, and identify the host on their address with a
+ *       random token, shared by the participants that see the same shared-memory objects. Hence, participants
+ *       announce them next to their UDP locators, and the remote endpoints on the same host are reached through the
+ *       shared memory instead of the network stack. The locators of other hosts are ignored.
+ *
+ *    - There is no multicast, so discovery needs another transport or initial peers using this transport.
+ *
+ *    - The segments can be written by any local user, as the participants of other users send to them, and the
+ *       messages are parsed in place. They are as trustworthy as UDP datagrams sent from the same host.
+ *
+ *    - Only supported on POSIX systems. Registering it on other platforms fails.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemTransport : public TransportInterface
+{
+public:
+
+    RTPS_DllAPI SharedMemTransport(const SharedMemTransportDescriptor&);
+
+    virtual ~SharedMemTransport() override;
+
+    bool init() override;
+
+    //! Checks whether there is a listening channel for the given port.
+    virtual bool IsInputChannelOpen(const Locator_t&) const override;
+
+    //! Checks for LOCATOR_KIND_SHM kind.
+    virtual bool IsLocatorSupported(const Locator_t&) const override;
+
+    //! Checks whether the locator refers to this host.
+    virtual bool is_locator_allowed(const Locator_t&) const override;
+
+    virtual Locator_t RemoteToMainLocal(const Locator_t&) const override;
+
+    //! Creates the only sender resource this transport needs, which reaches every port of this host.
+    virtual bool OpenOutputChannel(
+            SendResourceList& sender_resource_list,
+            const Locator_t&) override;
+
+    //! Creates the shared-memory segment of the port and starts listening on it.
+    virtual bool OpenInputChannel(const Locator_t&, TransportReceiverInterface*, uint32_t) override;
+
+    //! Stops listening on the port and removes its shared-memory segment.
+    virtual bool CloseInputChannel(const Locator_t&) override;
+
+    //! Reports whether Locators correspond to the same port.
+    virtual bool DoInputLocatorsMatch(const Locator_t&, const Locator_t&) const override;
+
+    //! Sets the address of the locators with no address to the one of this host.
+    virtual LocatorList_t NormalizeLocator(const Locator_t& locator) override;
+
+    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
+
+    //! Checks whether the locator refers to this host.
+    virtual bool is_local_locator(const Locator_t& locator) const override;
+
+    TransportDescriptorInterface* get_configuration() override { return &configuration_; }
+
+    virtual void AddDefaultOutputLocator(LocatorList_t &defaultList) override;
+
+    //! There are no multicast locators on this transport.
+    virtual bool getDefaultMetatrafficMulticastLocators(LocatorList_t &locators,
+        uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool getDefaultMetatrafficUnicastLocators(LocatorList_t &locators,
+        uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool getDefaultUnicastLocators(LocatorList_t &locators, uint32_t unicast_port) const override;
+
+    virtual bool fillMetatrafficMulticastLocator(Locator_t &locator,
+        uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool fillMetatrafficUnicastLocator(Locator_t &locator, uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool configureInitialPeerLocator(Locator_t &locator, const PortParameters &port_params, uint32_t domainId,
+        LocatorList_t& list) const override;
+
+    virtual bool fillUnicastLocator(Locator_t &locator, uint32_t well_known_port) const override;
+
+    virtual void shutdown() override;
+
+    /**
+     * Copies the data into the ring buffer of the destination port.
+     * @param send_buffer Slice into the raw data to send.
+     * @param send_buffer_size Size of the raw data. It must not exceed the maximum message size of this transport.
+     * @param remote_locator Locator describing the remote destination we're sending to.
+     * @return False when the locator refers to another host, nobody listens on the port, or the ring buffer of the
+     * port is full and SharedMemTransportDescriptor::non_blocking_send is set or the listener does not free space in
+     * time.
+     */
+    bool send(
+            const octet* send_buffer,
+            uint32_t send_buffer_size,
+            const Locator_t& remote_locator);
+
+private:
+
+    SharedMemTransportDescriptor configuration_;
+
+    //! Identifies the shared-memory namespace of this host on the address of the locators. Set by init().
+    uint32_t host_id_;
+
+    mutable std::mutex input_mutex_;
+    std::map<uint32_t, SharedMemChannelResource*> input_channels_;
+
+    //! Segments of the ports this transport has sent messages to.
+    std::mutex output_mutex_;
+    std::map<uint32_t, std::shared_ptr<SharedMemSegment>> output_segments_;
+
+    //! Fills the address of the locator with the identifier of this host.
+    void fill_host_address(Locator_t& locator) const;
+
+    //! Returns the segment of the given port, opening it if needed.
+    std::shared_ptr<SharedMemSegment> output_segment(uint32_t port);
+
+    //! Drops the segment of the given port, when it is still the one cached.
+    void release_output_segment(uint32_t port, const std::shared_ptr<SharedMemSegment>& segment);
+
+    /**
+     * Function to be called from a new thread, which delivers the messages pushed into the segment of the port.
+     * @param p_channel_resource - Associated ChannelResource
+     * @param input_locator - Locator that triggered the creation of the resource
+    */
+    void perform_listen_operation(SharedMemChannelResource* p_channel_resource, Locator_t input_locator);
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHAREDMEM_TRANSPORT_H
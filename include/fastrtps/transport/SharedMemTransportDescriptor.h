@@ -0,0 +1,62 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_DESCRIPTOR
+#define SHAREDMEM_TRANSPORT_DESCRIPTOR
+
+#include "./TransportDescriptorInterface.h"
+#include <fastrtps/fastrtps_dll.h>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class TransportInterface;
+
+/**
+ * Shared-memory transport configuration
+ *
+ * - segment_size:      size in bytes of the ring buffer created for each listening port. It is rounded up to a
+ *                      power of two, and limits the size of the messages that can be sent.
+ *
+ * - non_blocking_send: when the ring buffer of a destination is full, whether to drop the message (as if it had
+ *                      been lost, like UDP does) instead of waiting until the listener frees enough space. True by
+ *                      default. Even when false, the message is dropped if the listener does not free space in
+ *                      about a second, so a stopped listener cannot block the senders of the host.
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct SharedMemTransportDescriptor: public TransportDescriptorInterface
+{
+    virtual ~SharedMemTransportDescriptor(){}
+
+    virtual TransportInterface* create_transport() const override;
+
+    virtual uint32_t min_send_buffer_size() const override { return segment_size; }
+
+    RTPS_DllAPI SharedMemTransportDescriptor();
+
+    RTPS_DllAPI SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t);
+
+    //! Size of the ring buffer of each listening port.
+    uint32_t segment_size;
+
+    //! Whether to drop the messages sent to a full ring buffer.
+    bool non_blocking_send;
+} SharedMemTransportDescriptor;
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
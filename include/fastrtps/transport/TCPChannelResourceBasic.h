@@ -16,8 +16,12 @@
 #define _TCP_CHANNEL_RESOURCE_BASIC_
 
 #include <asio.hpp>
+#include <asio/strand.hpp>
 #include <fastrtps/transport/TCPChannelResource.h>
 
+#include <condition_variable>
+#include <vector>
+
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
@@ -25,6 +29,8 @@ namespace rtps{
 class TCPChannelResourceBasic : public TCPChannelResource
 {
     asio::io_service& service_;
+    // Serializes the handlers of this connection when several threads run the io_service.
+    asio::io_service::strand strand_;
     std::shared_ptr<asio::ip::tcp::socket> socket_;
 public:
     // Constructor called when trying to connect to a remote server
@@ -77,6 +83,34 @@ public:
 private:
     TCPChannelResourceBasic(const TCPChannelResourceBasic&) = delete;
     TCPChannelResourceBasic& operator=(const TCPChannelResourceBasic&) = delete;
+
+    //! Message waiting to be written by the thread currently writing on the socket.
+    struct PendingWrite
+    {
+        const octet* header;
+        size_t header_size;
+        const octet* data;
+        size_t size;
+        asio::error_code ec;
+        size_t bytes_sent;
+        bool done;
+    };
+
+    //! Maximum number of messages written on the socket with a single gather write.
+    static constexpr size_t max_coalesced_writes_ = 32;
+
+    /**
+     * Writes the oldest pending messages on the socket with a single gather write.
+     * @param write_lock Lock of write_mutex_. It is released while writing.
+     */
+    void write_pending(std::unique_lock<std::mutex>& write_lock);
+
+    // Must be accessed after lock write_mutex_
+    std::vector<PendingWrite*> pending_writes_;
+    bool writing_;
+    std::condition_variable write_cond_;
+    // Only accessed by the thread writing on the socket
+    std::vector<asio::const_buffer> write_buffers_;
 };
 
 
@@ -164,6 +164,8 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     bool calculate_crc;
     bool check_crc;
     bool apply_security;
+    //! Number of threads running the handlers of the connections. At least one is used.
+    uint32_t io_service_threads;
 
     TLSConfig tls_config;
 
@@ -28,6 +28,8 @@
 
 
 #include <asio.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <thread>
 #include <vector>
 #include <map>
@@ -59,15 +61,60 @@ class TCPKeepAliveEvent;
  */
 class TCPTransportInterface : public TransportInterface
 {
+    //! Receiver of a logical port, with the count of threads delivering messages to it.
     class ReceiverInUseCV
     {
         public:
 
-            bool in_use = false;
-
+            ReceiverInUseCV(TransportReceiverInterface* receiver_)
+                : receiver(receiver_)
+                , in_use(0)
+                , closed(false)
+            {
+            }
+
+            //! Registers a thread delivering a message. Returns false if the logical port was closed.
+            bool acquire()
+            {
+                in_use.fetch_add(1);
+                if (closed.load())
+                {
+                    release();
+                    return false;
+                }
+                return true;
+            }
+
+            void release()
+            {
+                if (in_use.fetch_sub(1) == 1 && closed.load())
+                {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    cv.notify_all();
+                }
+            }
+
+            //! Closes the logical port and waits until no thread is delivering messages to the receiver.
+            void close_and_wait()
+            {
+                closed.store(true);
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this]() { return in_use.load() == 0; });
+            }
+
+            TransportReceiverInterface* const receiver;
+
+        private:
+
+            std::atomic<uint32_t> in_use;
+            std::atomic<bool> closed;
+            std::mutex mutex;
             std::condition_variable cv;
     };
 
+    //! Logical port to receiver table. Never modified after being published.
+    typedef std::map<uint16_t, std::shared_ptr<ReceiverInUseCV>> ReceiverMap;
+
     std::atomic<bool> alive_;
 
 protected:
@@ -78,7 +125,7 @@ protected:
 #if TLS_FOUND
     asio::ssl::context ssl_context_;
 #endif
-    std::shared_ptr<std::thread> io_service_thread_;
+    std::vector<std::thread> io_service_threads_;
     std::shared_ptr<std::thread> io_service_timers_thread_;
     std::shared_ptr<RTCPMessageManager> rtcp_message_manager_;
     std::mutex rtcp_message_manager_mutex_;
@@ -88,8 +135,10 @@ protected:
 
     std::map<Locator_t, std::shared_ptr<TCPChannelResource>> channel_resources_; // The key is the "Physical locator"
     std::vector<std::shared_ptr<TCPChannelResource>> unbound_channel_resources_;
-    // The key is the logical port
-    std::map<uint16_t, std::pair<TransportReceiverInterface*, ReceiverInUseCV*>> receiver_resources_;
+    // The key is the logical port. A new table is published under sockets_map_mutex_ on each change, so the
+    // listening threads read it without locking, reloading it only when receiver_resources_version_ changes.
+    std::shared_ptr<const ReceiverMap> receiver_resources_;
+    std::atomic<uint32_t> receiver_resources_version_;
 
     std::vector<std::pair<TCPChannelResource*, uint64_t>> sockets_timestamp_;
     eClock my_clock_;
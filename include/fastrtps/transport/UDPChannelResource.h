@@ -17,6 +17,7 @@
 
 #include <fastrtps/transport/ChannelResource.h>
 #include <asio.hpp>
+#include <atomic>
 
 namespace eprosima{
 namespace fastrtps{
@@ -132,12 +133,29 @@ public:
         return message_receiver_;
     }
 
+    //! Number of datagrams dropped by the kernel on the socket, as last reported by the kernel.
+    inline uint32_t dropped_datagrams() const
+    {
+        return dropped_datagrams_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Updates the number of datagrams dropped by the kernel on the socket.
+     * @param dropped New number of dropped datagrams.
+     * @return Previous number of dropped datagrams.
+     */
+    inline uint32_t dropped_datagrams(uint32_t dropped)
+    {
+        return dropped_datagrams_.exchange(dropped, std::memory_order_relaxed);
+    }
+
 private:
 
     TransportReceiverInterface* message_receiver_; //Associated Readers/Writers inside of MessageReceiver
     eProsimaUDPSocket socket_;
     bool only_multicast_purpose_;
     std::string interface_;
+    std::atomic<uint32_t> dropped_datagrams_;
     UDPChannelResource(const UDPChannelResource&) = delete;
     UDPChannelResource& operator=(const UDPChannelResource&) = delete;
 };
@@ -55,6 +55,18 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
     * datagram. This may hinder performance on high-frequency writers.
     */
    bool non_blocking_send = false;
+
+   /**
+    * Maximum number of datagrams received on each receive operation.
+    *
+    * When greater than 1, each listening thread receives up to this number of datagrams with a single recvmmsg()
+    * call into a set of buffers, and then processes them in order. This reduces the number of system calls on
+    * bursty traffic, so the kernel receive queue is drained faster. It also enables reporting the number of
+    * datagrams dropped by the kernel on each socket (see UDPTransportInterface::dropped_datagrams()).
+    *
+    * Only supported on Linux. On other platforms datagrams are always received one by one.
+    */
+   uint32_t receive_batch_size = 1;
 } UDPTransportDescriptor;
 
 } // namespace rtps
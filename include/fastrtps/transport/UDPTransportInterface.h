@@ -76,6 +76,13 @@ public:
    bool Receive(UDPChannelResource* p_channel_resource, octet* receive_buffer,
        uint32_t receive_buffer_capacity, uint32_t& receive_buffer_size, Locator_t& remote_locator);
 
+   /**
+   * Number of datagrams dropped by the kernel on the listening sockets of this transport, because their receive
+   * queue was full. It is only reported when UDPTransportDescriptor::receive_batch_size is greater than 1 on Linux.
+   * Otherwise 0 is returned.
+   */
+   uint64_t dropped_datagrams() const;
+
    //! Release the listening socket for the specified port.
    bool ReleaseInputChannel(const Locator_t& locator, const asio::ip::address& interface_address);
 
@@ -103,6 +110,26 @@ public:
            const Locator_t& remote_locator,
            bool only_multicast_purpose);
 
+   /**
+   * Blocking Send through the specified channel to a list of destinations.
+   * On Linux the datagrams for all the destinations are handed to the kernel with a single sendmmsg call for each
+   * batch of destinations. On other platforms, the data is sent to each destination in turn.
+   * @param send_buffer Slice into the raw data to send.
+   * @param send_buffer_size Size of the raw data. It will be used as a bounds check for the previous argument.
+   * It must not exceed the send_buffer_size fed to this class during construction.
+   * @param socket channel we're sending from.
+   * @param remote_locators List of locators describing the remote destinations we're sending to. Locators not
+   * supported by this transport are ignored.
+   * @param only_multicast_purpose
+   * @return True when the data was sent to at least one of the destinations.
+   */
+   virtual bool send(
+           const octet* send_buffer,
+           uint32_t send_buffer_size,
+           eProsimaUDPSocket& socket,
+           const LocatorList_t& remote_locators,
+           bool only_multicast_purpose);
+
    virtual LocatorList_t ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists) override;
 
     virtual bool fillMetatrafficMulticastLocator(Locator_t &locator,
@@ -170,6 +197,14 @@ protected:
     */
     void perform_listen_operation(UDPChannelResource* p_channel_resource, Locator_t input_locator);
 
+    /**
+     * Listening loop used instead of perform_listen_operation when UDPTransportDescriptor::receive_batch_size is
+     * greater than 1. Each iteration receives up to that number of datagrams with a single system call.
+     * @param p_channel_resource - Associated ChannelResource
+     * @param input_locator - Locator that triggered the creation of the resource
+    */
+    void perform_batched_listen_operation(UDPChannelResource* p_channel_resource, Locator_t input_locator);
+
     virtual void set_receive_buffer_size(uint32_t size) = 0;
     virtual void set_send_buffer_size(uint32_t size) = 0;
     virtual void SetSocketOutboundInterface(eProsimaUDPSocket&, const std::string&) = 0;
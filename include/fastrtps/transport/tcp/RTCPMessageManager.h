@@ -141,6 +141,19 @@ public:
 
     static uint32_t& addToCRC(uint32_t &crc, octet data);
 
+    /**
+     * Adds a block of bytes to a CRC, several bytes at a time.
+     * The result is the same as adding the bytes one by one.
+     * @param crc CRC to add the bytes to.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     * @return Resulting CRC.
+     */
+    static uint32_t addToCRC(
+            uint32_t crc,
+            const octet* data,
+            size_t size);
+
     void dispose()
     {
         alive_.store(false);
@@ -43,6 +43,14 @@ public:
            const Locator_t& remote_locator,
            bool only_multicast_purpose) override;
 
+    //! Sends to each destination in turn, so every datagram goes through the drop criteria.
+    virtual bool send(
+           const octet* send_buffer,
+           uint32_t send_buffer_size,
+           eProsimaUDPSocket& socket,
+           const LocatorList_t& remote_locators,
+           bool only_multicast_purpose) override;
+
     RTPS_DllAPI static bool test_UDPv4Transport_ShutdownAllNetwork;
     // Handle to a persistent log of dropped packets. Defaults to length 0 (no logging) to prevent wasted resources.
     RTPS_DllAPI static std::vector<std::vector<octet> > test_UDPv4Transport_DropLog;
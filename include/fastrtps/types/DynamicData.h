@@ -26,6 +26,7 @@ namespace fastrtps {
 namespace types {
 
 class DynamicType;
+class DynamicTypeLayout;
 class MemberDescriptor;
 
 class DynamicData
@@ -49,6 +50,14 @@ protected:
 
     void clean_members();
 
+    // Stores the flat members of a structure in a single buffer, following the layout of its type.
+    void create_flat_storage();
+
+    // Moves the value of a primitive into the buffer of the structure that contains it.
+    void bind_flat_value(
+            octet* storage,
+            uint32_t size);
+
     void* clone_value(
             MemberId id,
             TypeKind kind) const;
@@ -111,6 +120,15 @@ protected:
 
     void serializeKey(eprosima::fastcdr::Cdr& cdr) const;
 
+    // Serializes and deserializes a structure following the plan of its flat layout.
+    void serialize_flat(eprosima::fastcdr::Cdr& cdr) const;
+
+    bool deserialize_flat(eprosima::fastcdr::Cdr& cdr);
+
+    static size_t getFlatCdrSerializedSize(
+            const DynamicData* data,
+            size_t current_alignment);
+
     DynamicType_ptr type_;
     std::map<MemberId, MemberDescriptor*> descriptors_;
 
@@ -133,6 +151,11 @@ protected:
     std::map<MemberId, DynamicData*> complex_values_;
 #else
     std::map<MemberId, void*> values_;
+    // Layout of the flat members of a structure, and the buffer that stores their values.
+    std::shared_ptr<const DynamicTypeLayout> layout_;
+    octet* flat_storage_;
+    // Whether the value is stored in the buffer of the structure that contains it.
+    bool flat_value_;
 #endif
     std::vector<MemberId> loaned_values_;
     bool key_element_;
@@ -26,6 +26,7 @@ class AnnotationDescriptor;
 class TypeDescriptor;
 class DynamicTypeMember;
 class DynamicTypeBuilder;
+class DynamicTypeLayout;
 
 class DynamicType
 {
@@ -103,6 +104,8 @@ protected:
     std::string name_;
     TypeKind kind_;
     bool is_key_defined_;
+    // Shared with the data created before the layout is rebuilt.
+    std::shared_ptr<const DynamicTypeLayout> layout_;
 
 public:
     bool equals(const DynamicType* other) const;
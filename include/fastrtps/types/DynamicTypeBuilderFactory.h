@@ -39,12 +39,17 @@ class AnnotationParameterValue;
 class DynamicTypeBuilderFactory
 {
 protected:
+    friend class DynamicType;
+
     DynamicTypeBuilderFactory();
 
     inline void add_builder_to_list(DynamicTypeBuilder* pBuilder);
 
     DynamicType_ptr build_type(DynamicType_ptr other);
 
+    // Builds the flat layout and serialization plan of a structure. Types without flat members don't get one.
+    void build_layout(DynamicType* type) const;
+
     void build_alias_type_code(const TypeDescriptor* descriptor, TypeObject& object, bool complete = true) const;
 
     void build_enum_type_code(
@@ -0,0 +1,100 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPES_DYNAMIC_TYPE_LAYOUT_H
+#define TYPES_DYNAMIC_TYPE_LAYOUT_H
+
+#include <fastrtps/types/TypesBase.h>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace types {
+
+// Flat layout of the members of a structure and plan to serialize them. The members whose CDR representation is
+// their memory representation (integers, float32, float64, char8 and byte) are stored in a single buffer, where each
+// run of consecutive members keeps the same padding as in CDR. With the native endianness, the first member of a run
+// is serialized on its own to align the stream, and the rest of the run is copied at once.
+class DynamicTypeLayout
+{
+public:
+    // Member stored in the buffer.
+    struct FlatMember
+    {
+        MemberId id;
+        TypeKind kind;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    // Step of the serialization. Members outside the buffer have a length of zero.
+    struct Step
+    {
+        // Member serialized on its own, or first member of the run.
+        MemberId id;
+        TypeKind kind;
+        uint32_t offset;
+        uint32_t size;
+        // Bytes of the run, from the start of its first member to the end of its last member.
+        uint32_t length;
+    };
+
+    DynamicTypeLayout();
+
+    // Size of the memory representation of the kinds that can be stored in the buffer, or zero for the rest.
+    RTPS_DllAPI static uint32_t get_flat_size(TypeKind kind);
+
+    uint32_t get_buffer_size() const
+    {
+        return buffer_size_;
+    }
+
+    const std::vector<FlatMember>& get_flat_members() const
+    {
+        return flat_members_;
+    }
+
+    const std::vector<Step>& get_steps() const
+    {
+        return steps_;
+    }
+
+    // Returns the member stored in the buffer with the given id, or nullptr if it isn't stored in the buffer.
+    RTPS_DllAPI const FlatMember* find_flat_member(MemberId id) const;
+
+protected:
+    friend class DynamicTypeBuilderFactory;
+
+    // The members must be added in the order of serialization.
+    void add_flat_member(
+            MemberId id,
+            TypeKind kind);
+
+    void add_member(MemberId id);
+
+    // Members that aren't serialized only end the current run.
+    void add_non_serialized_member();
+
+    uint32_t buffer_size_;
+    std::vector<FlatMember> flat_members_;
+    std::vector<Step> steps_;
+    // Whether the last step is a run that can be extended with the next flat member.
+    bool run_open_;
+};
+
+} // namespace types
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // TYPES_DYNAMIC_TYPE_LAYOUT_H
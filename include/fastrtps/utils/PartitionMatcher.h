@@ -0,0 +1,115 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*!
+ * @file PartitionMatcher.h
+ *
+ */
+
+#ifndef PARTITIONMATCHER_H_
+#define PARTITIONMATCHER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+/**
+ * Class PartitionMatcher, used to check whether two lists of partition names match, with the same results as
+ * comparing every pair of names with StringMatching::matchString.
+ * Each distinct list is compiled once, splitting the names without wildcards, that are compared through a hash set,
+ * from the expressions. The expressions whose only wildcard is a trailing '*' are compared as prefixes, and the rest with
+ * StringMatching. The result of matching two lists is also cached.
+ * @ingroup UTILITIES_MODULE
+ */
+class PartitionMatcher
+{
+    public:
+
+        PartitionMatcher();
+
+        /**
+         * Check whether two lists of partition names match.
+         * An empty list only matches an empty list or a list containing the empty name.
+         * Two non empty lists match if any name of one of them matches any name of the other one.
+         * This method is thread safe.
+         * @param partitions1 First list of partition names.
+         * @param partitions2 Second list of partition names.
+         * @return True if the lists match.
+         */
+        bool match(const std::vector<std::string>& partitions1, const std::vector<std::string>& partitions2);
+
+    private:
+
+        struct Expression
+        {
+            std::string text;
+            //! Whether the only wildcard is a trailing '*', so it matches the names starting with the rest of it.
+            bool prefix;
+        };
+
+        struct CompiledPartitions
+        {
+            //! Identifier of the list, used to cache the results.
+            uint32_t id;
+            //! Whether the list is empty.
+            bool empty;
+            //! Whether the list contains the empty name.
+            bool has_empty_name;
+            //! Names without wildcards.
+            std::unordered_set<std::string> literals;
+            //! Names with wildcards.
+            std::vector<Expression> expressions;
+        };
+
+        struct PartitionsHash
+        {
+            size_t operator()(const std::vector<std::string>& partitions) const;
+        };
+
+        PartitionMatcher(const PartitionMatcher&) = delete;
+        PartitionMatcher& operator=(const PartitionMatcher&) = delete;
+
+        //! Get the compiled form of a list of partition names, compiling it if needed. mutex_ should be locked.
+        const CompiledPartitions& compile(const std::vector<std::string>& partitions);
+
+        //! Check whether a name matches an expression, or the expression matches the name when it is another one.
+        static bool match_expression(const Expression& expression, const std::string& name);
+
+        //! Check whether two expressions match.
+        static bool match_expressions(const Expression& expression1, const Expression& expression2);
+
+        //! Check whether two compiled lists of partition names match.
+        static bool match_compiled(const CompiledPartitions& partitions1, const CompiledPartitions& partitions2);
+
+        std::mutex mutex_;
+        uint32_t next_id_;
+        //! Compiled lists, indexed by their names.
+        std::unordered_map<std::vector<std::string>, CompiledPartitions, PartitionsHash> compiled_;
+        //! Cached results, indexed by the identifiers of the lists.
+        std::unordered_map<uint64_t, bool> results_;
+};
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
+#endif
+#endif /* PARTITIONMATCHER_H_ */
@@ -56,6 +56,7 @@ extern const char* RECEIVE_BUFFER_SIZE;
 extern const char* SEND_BUFFER_SIZE;
 extern const char* TTL;
 extern const char* NON_BLOCKING_SEND;
+extern const char* RECEIVE_BATCH_SIZE;
 extern const char* WHITE_LIST;
 extern const char* MAX_MESSAGE_SIZE;
 extern const char* MAX_INITIAL_PEERS_RANGE;
@@ -69,6 +70,7 @@ extern const char* METADATA_LOGICAL_PORT;
 extern const char* LISTENING_PORTS;
 extern const char* CALCULATE_CRC;
 extern const char* CHECK_CRC;
+extern const char* IO_SERVICE_THREADS;
 
 extern const char* QOS_PROFILE;
 extern const char* APPLICATION;
@@ -94,6 +96,7 @@ extern const char* IP6_TO_SEND;
 extern const char* THROUGHPUT_CONT;
 extern const char* USER_TRANS;
 extern const char* USE_BUILTIN_TRANS;
+extern const char* ASYNC_WRITER_THREADS;
 extern const char* PROPERTIES_POLICY;
 extern const char* NAME;
 
@@ -211,6 +214,8 @@ extern const char* DEPTH;
 extern const char* ALLOCATED_SAMPLES;
 extern const char* BYTES_PER_SECOND;
 extern const char* PERIOD_MILLISECS;
+extern const char* BURST_BYTES;
+extern const char* PRIORITY;
 extern const char* PORT_BASE;
 extern const char* DOMAIN_ID_GAIN;
 extern const char* PARTICIPANT_ID_GAIN;
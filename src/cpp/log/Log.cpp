@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <iomanip>
 #include <mutex>
 
@@ -11,13 +14,111 @@ using namespace std;
 namespace eprosima {
 namespace fastrtps {
 
+//! Number of entries of the ring buffer. Must be a power of two.
+static const size_t RING_BUFFER_SIZE = 2048;
+//! Space of each entry for the message, or the arguments of a deferred entry, before using the heap.
+static const size_t SLOT_DATA_SIZE = 192;
+//! Bit of the categories that do not fit in the mask. They are always enabled, and filtered by the logging thread.
+static const uint64_t OVERFLOW_CATEGORY_BIT = 1ULL << 63;
+
+/*
+ * An entry of the ring buffer. The sequence tells whether the slot is free for a producer to take it, when it equals
+ * the position of the producer, or holds an entry ready for the logging thread, when it equals its position plus one.
+ */
+struct Log::Slot
+{
+    std::atomic<size_t> sequence;
+    size_t position;
+    Log::Context context;
+    Log::Kind kind;
+    std::chrono::system_clock::time_point time;
+    //! Operations on the arguments stored in data, for deferred entries.
+    const Formatter* formatter;
+    //! Length of the message stored in data.
+    size_t length;
+    //! Message that did not fit in data.
+    std::string* long_message;
+    std::aligned_storage<SLOT_DATA_SIZE, alignof(std::max_align_t)>::type data;
+
+    //! Builds the message of the entry and releases what it holds.
+    std::string take_message()
+    {
+        std::string message;
+        if (long_message != nullptr)
+        {
+            message = std::move(*long_message);
+            delete long_message;
+            long_message = nullptr;
+        }
+        else if (formatter != nullptr)
+        {
+            std::stringstream stream;
+            formatter->format(stream, &data);
+            formatter->destroy(&data);
+            formatter = nullptr;
+            message = stream.str();
+        }
+        else
+        {
+            message.assign(reinterpret_cast<const char*>(&data), length);
+        }
+        return message;
+    }
+};
+
+/*
+ * Bounded multiple producer, single consumer queue. Producers take a position with an atomic increment and fill the
+ * slot without locking, and the logging thread reads the slots in order.
+ */
+struct Log::RingBuffer
+{
+    RingBuffer() : slots(new Slot[RING_BUFFER_SIZE]), mask(RING_BUFFER_SIZE - 1), enqueue_position(0),
+        dequeue_position(0), consumed_position(0), dropped(0)
+    {
+        for (size_t i = 0; i < RING_BUFFER_SIZE; ++i)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+            slots[i].formatter = nullptr;
+            slots[i].long_message = nullptr;
+        }
+    }
+
+    ~RingBuffer()
+    {
+        // Release the entries that were not consumed. There are no producers at this point.
+        for (size_t i = 0; i < RING_BUFFER_SIZE; ++i)
+        {
+            delete slots[i].long_message;
+            if (slots[i].formatter != nullptr)
+            {
+                slots[i].formatter->destroy(&slots[i].data);
+            }
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    const size_t mask;
+    // Padded so producers and consumer update them on different cache lines.
+    std::atomic<size_t> enqueue_position;
+    char padding[64];
+    std::atomic<size_t> dequeue_position;
+    //! Position of the next entry to be passed to the consumers. It lags behind dequeue_position while the
+    //! consumers of an entry whose slot was already freed are running.
+    std::atomic<size_t> consumed_position;
+    //! Entries discarded because the ring buffer was full.
+    std::atomic<uint64_t> dropped;
+};
+
 struct Log::Resources Log::mResources;
 
-Log::Resources::Resources() : mLogging(false),
+Log::Resources::Resources() : mRing(new RingBuffer),
+        mLogging(false),
+        mSleeping(false),
         mWork(false),
         mFilenames(false),
         mFunctions(true),
-        mVerbosity(Log::Error)
+        mVerbosity(Log::Error),
+        mEnabledCategories(~0ULL)
 {
     mResources.mConsumers.emplace_back(new StdoutConsumer);
 }
@@ -35,10 +136,14 @@ void Log::RegisterConsumer(std::unique_ptr<LogConsumer> &&consumer)
 
 void Log::ClearConsumers()
 {
+    // Wait until the entries queued so far were passed to the consumers, not only taken from the ring buffer.
+    RingBuffer& ring = *mResources.mRing;
     std::unique_lock<std::mutex> working(mResources.mCvMutex);
+    size_t target = ring.enqueue_position.load(std::memory_order_acquire);
     mResources.mCv.wait(working, [&]()
     {
-        return mResources.mLogs.BothEmpty();
+        return static_cast<intptr_t>(ring.consumed_position.load(std::memory_order_acquire) - target) >= 0 ||
+            !mResources.mLogging;
     });
     std::unique_lock<std::mutex> guard(mResources.mConfigMutex);
     mResources.mConsumers.clear();
@@ -55,41 +160,87 @@ void Log::Reset()
     mResources.mVerbosity = Log::Error;
     mResources.mConsumers.clear();
     mResources.mConsumers.emplace_back(new StdoutConsumer);
+    UpdateEnabledCategories();
 }
 
 void Log::Run()
 {
+    RingBuffer& ring = *mResources.mRing;
     std::unique_lock<std::mutex> guard(mResources.mCvMutex);
     while (mResources.mLogging)
     {
-        while (mResources.mWork)
+        guard.unlock();
+        for (;;)
         {
-            mResources.mWork = false;
-            guard.unlock();
+            size_t position = ring.dequeue_position.load(std::memory_order_relaxed);
+            Slot& slot = ring.slots[position & ring.mask];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                break;
+            }
+
+            std::string timestamp;
+            GetTimestamp(timestamp, slot.time);
+            Log::Entry entry{slot.take_message(), slot.context, slot.kind, timestamp};
+
+            // Free the slot before calling the consumers, that may be slow.
+            slot.sequence.store(position + ring.mask + 1, std::memory_order_release);
+            ring.dequeue_position.store(position + 1, std::memory_order_release);
+
             {
-                mResources.mLogs.Swap();
-                while (!mResources.mLogs.Empty())
+                std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+                if (Preprocess(entry))
                 {
-                    std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
-                    if (Preprocess(mResources.mLogs.Front()))
+                    for (auto &consumer : mResources.mConsumers)
                     {
-                        for (auto &consumer : mResources.mConsumers)
-                        {
-                            consumer->Consume(mResources.mLogs.Front());
-                        }
+                        consumer->Consume(entry);
                     }
-
-                    mResources.mLogs.Pop();
                 }
             }
-            guard.lock();
+            ring.consumed_position.store(position + 1, std::memory_order_release);
+        }
+
+        uint64_t dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0 && Log::Kind::Warning <= mResources.mVerbosity)
+        {
+            std::string timestamp;
+            GetTimestamp(timestamp, std::chrono::system_clock::now());
+            Log::Entry entry{std::to_string(dropped) + " log entries were dropped because the log queue was full",
+                Log::Context{nullptr, 0, nullptr, "LOG"}, Log::Kind::Warning, timestamp};
+            std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+            for (auto &consumer : mResources.mConsumers)
+            {
+                consumer->Consume(entry);
+            }
+        }
+
+        guard.lock();
+        // Tell the producers to wake this thread up, and check again for entries committed before they could see it.
+        mResources.mSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t position = ring.dequeue_position.load(std::memory_order_relaxed);
+        if (ring.slots[position & ring.mask].sequence.load(std::memory_order_acquire) == position + 1)
+        {
+            mResources.mSleeping.store(false);
+            continue;
         }
-        mResources.mCv.notify_one();
-        if (mResources.mLogging)
-            mResources.mCv.wait(guard);
+
+        mResources.mCv.notify_all();
+        mResources.mCv.wait(guard, [&]()
+        {
+            return mResources.mWork || !mResources.mLogging;
+        });
+        mResources.mWork = false;
+        mResources.mSleeping.store(false);
     }
 }
 
+bool Log::IsEnabled(Log::Kind kind, uint64_t category_bit)
+{
+    return kind <= mResources.mVerbosity.load(std::memory_order_relaxed) &&
+        (mResources.mEnabledCategories.load(std::memory_order_relaxed) & category_bit) != 0;
+}
+
 void Log::ReportFilenames(bool report)
 {
     std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
@@ -139,25 +290,145 @@ void Log::KillThread()
     }
 }
 
-void Log::QueueLog(const std::string &message, const Log::Context &context, Log::Kind kind)
+void Log::LaunchThread()
 {
+    std::unique_lock<std::mutex> guard(mResources.mCvMutex);
+    if (!mResources.mLogging && !mResources.mLoggingThread)
     {
-        std::unique_lock<std::mutex> guard(mResources.mCvMutex);
-        if (!mResources.mLogging && !mResources.mLoggingThread)
+        mResources.mLogging = true;
+        mResources.mLoggingThread.reset(new thread(Log::Run));
+    }
+}
+
+Log::Slot* Log::ReserveSlot(const Log::Context &context, Log::Kind kind)
+{
+    RingBuffer& ring = *mResources.mRing;
+    size_t position = ring.enqueue_position.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;)
+    {
+        slot = &ring.slots[position & ring.mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0)
         {
-            mResources.mLogging = true;
-            mResources.mLoggingThread.reset(new thread(Log::Run));
+            if (ring.enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The logging thread has not freed this slot yet, so the ring buffer is full.
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
         }
+        else
+        {
+            position = ring.enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->position = position;
+    slot->context = context;
+    slot->kind = kind;
+    slot->time = std::chrono::system_clock::now();
+    slot->formatter = nullptr;
+    slot->length = 0;
+    slot->long_message = nullptr;
+    return slot;
+}
+
+void Log::CommitSlot(Log::Slot* slot)
+{
+    slot->sequence.store(slot->position + 1, std::memory_order_release);
+
+    if (!mResources.mLogging.load(std::memory_order_acquire))
+    {
+        LaunchThread();
     }
 
-    std::string timestamp;
-    GetTimestamp(timestamp);
-    mResources.mLogs.Push(Log::Entry{message, context, kind, timestamp});
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mResources.mSleeping.load(std::memory_order_relaxed))
     {
-        std::unique_lock<std::mutex> guard(mResources.mCvMutex);
-        mResources.mWork = true;
+        {
+            std::unique_lock<std::mutex> guard(mResources.mCvMutex);
+            mResources.mWork = true;
+        }
+        mResources.mCv.notify_all();
+    }
+}
+
+void Log::QueueLog(const std::string &message, const Log::Context &context, Log::Kind kind)
+{
+    Slot* slot = ReserveSlot(context, kind);
+    if (slot == nullptr)
+    {
+        return;
+    }
+
+    if (message.size() <= SLOT_DATA_SIZE)
+    {
+        memcpy(&slot->data, message.data(), message.size());
+        slot->length = message.size();
+    }
+    else
+    {
+        slot->long_message = new std::string(message);
+    }
+
+    CommitSlot(slot);
+}
+
+void Log::QueueDeferred(const Log::Context &context, Log::Kind kind, void* arguments, const Formatter* formatter)
+{
+    Slot* slot = ReserveSlot(context, kind);
+    if (slot == nullptr)
+    {
+        return;
+    }
+
+    if (formatter->size <= SLOT_DATA_SIZE && formatter->alignment <= alignof(std::max_align_t))
+    {
+        formatter->move(&slot->data, arguments);
+        slot->formatter = formatter;
+    }
+    else
+    {
+        std::stringstream stream;
+        formatter->format(stream, arguments);
+        slot->long_message = new std::string(stream.str());
+    }
+
+    CommitSlot(slot);
+}
+
+uint64_t Log::CategoryBit(const char* category)
+{
+    std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+    std::vector<std::string>& categories = mResources.mCategories;
+    size_t index = std::find(categories.begin(), categories.end(), category) - categories.begin();
+    if (index == categories.size())
+    {
+        categories.emplace_back(category);
+        UpdateEnabledCategories();
+    }
+
+    return index < 63 ? (1ULL << index) : OVERFLOW_CATEGORY_BIT;
+}
+
+void Log::UpdateEnabledCategories()
+{
+    uint64_t enabled = OVERFLOW_CATEGORY_BIT;
+    const std::vector<std::string>& categories = mResources.mCategories;
+    for (size_t i = 0; i < categories.size() && i < 63; ++i)
+    {
+        if (!mResources.mCategoryFilter || regex_search(categories[i], *mResources.mCategoryFilter))
+        {
+            enabled |= 1ULL << i;
+        }
     }
-    mResources.mCv.notify_all();
+    mResources.mEnabledCategories.store(enabled, std::memory_order_relaxed);
 }
 
 Log::Kind Log::GetVerbosity()
@@ -175,6 +446,7 @@ void Log::SetCategoryFilter(const std::regex &filter)
 {
     std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
     mResources.mCategoryFilter.reset(new std::regex(filter));
+    UpdateEnabledCategories();
 }
 
 void Log::SetFilenameFilter(const std::regex &filter)
@@ -189,10 +461,9 @@ void Log::SetErrorStringFilter(const std::regex &filter)
     mResources.mErrorStringFilter.reset(new std::regex(filter));
 }
 
-void Log::GetTimestamp(std::string &timestamp)
+void Log::GetTimestamp(std::string &timestamp, const std::chrono::system_clock::time_point& now)
 {
     std::stringstream stream;
-    auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
     std::chrono::system_clock::duration tp = now.time_since_epoch();
     tp -= std::chrono::duration_cast<std::chrono::seconds>(tp);
@@ -70,3 +70,8 @@ bool Participant::get_remote_reader_info(
 {
     return mp_impl->get_remote_reader_info(readerGuid, returnedInfo);
 }
+
+bool Participant::flush_persistence()
+{
+    return mp_impl->flush_persistence();
+}
@@ -512,3 +512,8 @@ ResourceEvent& ParticipantImpl::get_resource_event() const
 {
     return mp_rtpsParticipant->get_resource_event();
 }
+
+bool ParticipantImpl::flush_persistence()
+{
+    return mp_rtpsParticipant->flush_persistence();
+}
@@ -160,6 +160,8 @@ class ParticipantImpl
 
     rtps::ResourceEvent& get_resource_event() const;
 
+    bool flush_persistence();
+
     private:
     //!Participant Attributes
     ParticipantAttributes m_att;
@@ -44,6 +44,22 @@ bool Publisher::write(void* Data, WriteParams &wparams) {
     return mp_impl->create_new_change_with_params(ALIVE, Data, wparams);
 }
 
+bool Publisher::loan_sample(void*& sample)
+{
+    return mp_impl->loan_sample(sample);
+}
+
+bool Publisher::write_loan(void*& sample)
+{
+    logInfo(PUBLISHER,"Writing loaned data");
+    return mp_impl->write_loan(sample);
+}
+
+bool Publisher::discard_loan(void*& sample)
+{
+    return mp_impl->discard_loan(sample);
+}
+
 bool Publisher::dispose(void* Data)
 {
     logInfo(PUBLISHER,"Disposing of Data");
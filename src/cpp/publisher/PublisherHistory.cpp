@@ -193,9 +193,9 @@ bool PublisherHistory::removeAllChange(size_t* removed)
     size_t rem = 0;
     std::lock_guard<std::recursive_timed_mutex> guard(*this->mp_mutex);
 
-    while(m_changes.size()>0)
+    while(changesBegin() != changesEnd())
     {
-        if(remove_change_pub(m_changes.front()))
+        if(remove_change_pub(*changesBegin()))
             ++rem;
         else
             break;
@@ -221,8 +221,8 @@ bool PublisherHistory::removeMinChange()
     }
 
     std::lock_guard<std::recursive_timed_mutex> guard(*this->mp_mutex);
-    if(m_changes.size()>0)
-        return remove_change_pub(m_changes.front());
+    if(changesBegin() != changesEnd())
+        return remove_change_pub(*changesBegin());
     return false;
 }
 
@@ -89,6 +89,13 @@ PublisherImpl::~PublisherImpl()
         logInfo(PUBLISHER, this->getGuid().entityId << " in topic: " << this->m_att.topic.topicName);
     }
 
+    // Return the samples the user did not write nor discard
+    for(CacheChange_t* ch : loaned_changes_)
+    {
+        m_history.release_Cache(ch);
+    }
+    loaned_changes_.clear();
+
     RTPSDomain::removeRTPSWriter(mp_writer);
     delete(this->mp_userPublisher);
 }
@@ -108,6 +115,15 @@ bool PublisherImpl::create_new_change_with_params(
         void* data,
         WriteParams& wparams)
 {
+    return create_new_change_with_params(changeKind, data, wparams, nullptr);
+}
+
+bool PublisherImpl::create_new_change_with_params(
+        ChangeKind_t changeKind,
+        void* data,
+        WriteParams& wparams,
+        CacheChange_t* loaned_change)
+{
 
     /// Preconditions
     if (data == nullptr)
@@ -143,10 +159,11 @@ bool PublisherImpl::create_new_change_with_params(
 
     if(lock.try_lock_until(max_blocking_time))
     {
-        CacheChange_t* ch = mp_writer->new_change(mp_type->getSerializedSizeProvider(data), changeKind, handle);
+        CacheChange_t* ch = loaned_change != nullptr ? loaned_change :
+            mp_writer->new_change(mp_type->getSerializedSizeProvider(data), changeKind, handle);
         if(ch != nullptr)
         {
-            if(changeKind == ALIVE)
+            if(changeKind == ALIVE && loaned_change == nullptr)
             {
                 //If these two checks are correct, we asume the cachechange is valid and thwn we can write to it.
                 if(!mp_type->serialize(data, &ch->serializedPayload))
@@ -192,7 +209,7 @@ bool PublisherImpl::create_new_change_with_params(
                     logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
                             ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
                             final_high_mark_for_frag << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
-                    m_history.release_Cache(ch);
+                    release_change(ch, loaned_change != nullptr);
                     return false;
                 }
 
@@ -204,7 +221,7 @@ bool PublisherImpl::create_new_change_with_params(
 
             if(!this->m_history.add_pub_change(ch, wparams, lock, max_blocking_time))
             {
-                m_history.release_Cache(ch);
+                release_change(ch, loaned_change != nullptr);
                 return false;
             }
 
@@ -235,10 +252,128 @@ bool PublisherImpl::create_new_change_with_params(
             return true;
         }
     }
+    else if(loaned_change != nullptr)
+    {
+        return_loan(loaned_change);
+    }
 
     return false;
 }
 
+bool PublisherImpl::loan_sample(void*& sample)
+{
+    sample = nullptr;
+
+    if(!mp_type->is_plain())
+    {
+        logError(PUBLISHER, "Samples of type " << mp_type->getName() << " cannot be loaned, it is not a plain type");
+        return false;
+    }
+
+    // The key of a loaned sample cannot be obtained without deserializing it.
+    if(m_att.topic.topicKind == WITH_KEY)
+    {
+        logError(PUBLISHER, "Samples cannot be loaned on a WITH_KEY topic");
+        return false;
+    }
+
+    uint32_t type_size = mp_type->m_typeSize;
+    CacheChange_t* ch = mp_writer->new_change([type_size]() -> uint32_t { return type_size; }, ALIVE);
+    if(ch == nullptr)
+    {
+        return false;
+    }
+
+    if(ch->serializedPayload.max_size < type_size)
+    {
+        logError(PUBLISHER, "Payload of the reserved change is smaller than the type size");
+        m_history.release_Cache(ch);
+        return false;
+    }
+
+    // Encapsulation for a CDR representation in the native endianness, as TopicDataType::serialize would write it.
+    octet* encapsulation = ch->serializedPayload.data;
+    encapsulation[0] = 0;
+    encapsulation[1] = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+    encapsulation[2] = 0;
+    encapsulation[3] = 0;
+    ch->serializedPayload.encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+    ch->serializedPayload.length = type_size;
+
+    sample = ch->serializedPayload.data + 4;
+    return_loan(ch);
+    return true;
+}
+
+bool PublisherImpl::write_loan(void*& sample)
+{
+    // A loaned sample is already in the payload of its change
+    CacheChange_t* ch = take_loan(sample);
+    if(ch == nullptr)
+    {
+        logError(PUBLISHER, "Sample was not loaned by this publisher");
+        return false;
+    }
+
+    WriteParams wparams;
+    if(!create_new_change_with_params(ALIVE, sample, wparams, ch))
+    {
+        return false;
+    }
+
+    sample = nullptr;
+    return true;
+}
+
+bool PublisherImpl::discard_loan(void*& sample)
+{
+    CacheChange_t* ch = take_loan(sample);
+    if(ch == nullptr)
+    {
+        logError(PUBLISHER, "Sample was not loaned by this publisher");
+        return false;
+    }
+
+    m_history.release_Cache(ch);
+    sample = nullptr;
+    return true;
+}
+
+CacheChange_t* PublisherImpl::take_loan(void* sample)
+{
+    std::lock_guard<std::mutex> guard(loans_mutex_);
+    for(auto it = loaned_changes_.begin(); it != loaned_changes_.end(); ++it)
+    {
+        if((*it)->serializedPayload.data + 4 == sample)
+        {
+            CacheChange_t* ch = *it;
+            loaned_changes_.erase(it);
+            return ch;
+        }
+    }
+
+    return nullptr;
+}
+
+void PublisherImpl::return_loan(CacheChange_t* change)
+{
+    std::lock_guard<std::mutex> guard(loans_mutex_);
+    loaned_changes_.push_back(change);
+}
+
+void PublisherImpl::release_change(CacheChange_t* change, bool loaned)
+{
+    // A loaned sample that could not be written remains loaned
+    if(loaned)
+    {
+        return_loan(change);
+    }
+    else
+    {
+        m_history.release_Cache(change);
+    }
+}
+
 
 bool PublisherImpl::removeMinSeqChange()
 {
@@ -33,6 +33,9 @@
 #include <fastrtps/rtps/timedevent/TimedCallback.h>
 #include <fastrtps/qos/DeadlineMissedStatus.h>
 
+#include <mutex>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps
@@ -90,6 +93,27 @@ class PublisherImpl
         void* Data,
         rtps::WriteParams& wparams);
 
+    /**
+     * Loan a sample of a plain type, inside the payload of a change of the history.
+     * @param[out] sample Pointer to the loaned buffer.
+     * @return True if correct.
+     */
+    bool loan_sample(void*& sample);
+
+    /**
+     * Write a loaned sample without serializing it.
+     * @param[in,out] sample Pointer to the loaned buffer. It is set to nullptr if the sample is written.
+     * @return True if correct.
+     */
+    bool write_loan(void*& sample);
+
+    /**
+     * Return a loaned sample to the history without writing it.
+     * @param[in,out] sample Pointer to the loaned buffer. It is set to nullptr.
+     * @return True if correct.
+     */
+    bool discard_loan(void*& sample);
+
     /**
      * Removes the cache change with the minimum sequence number
      * @return True if correct.
@@ -164,6 +188,34 @@ class PublisherImpl
 
     uint32_t high_mark_for_frag_;
 
+    //! Changes whose payload is loaned to the user
+    std::vector<rtps::CacheChange_t*> loaned_changes_;
+    //! Protects loaned_changes_
+    std::mutex loans_mutex_;
+
+    /**
+     * Write a new change, taking the payload from a loaned change instead of serializing the data.
+     * @param loaned_change Change holding a loaned sample, or nullptr to serialize the data.
+     */
+    bool create_new_change_with_params(
+        rtps::ChangeKind_t kind,
+        void* Data,
+        rtps::WriteParams& wparams,
+        rtps::CacheChange_t* loaned_change);
+
+    /**
+     * Remove a sample from the list of loaned samples.
+     * @param sample Pointer to the loaned buffer.
+     * @return The change holding the sample, or nullptr if it was not loaned.
+     */
+    rtps::CacheChange_t* take_loan(void* sample);
+
+    //! Add a change back to the list of loaned samples
+    void return_loan(rtps::CacheChange_t* change);
+
+    //! Release a change that could not be added to the history, or return it to the user if it was loaned
+    void release_change(rtps::CacheChange_t* change, bool loaned);
+
     //! A timer used to check for deadlines
     rtps::TimedCallback deadline_timer_;
     //! Deadline duration in microseconds
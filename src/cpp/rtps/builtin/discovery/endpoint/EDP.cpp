@@ -36,7 +36,6 @@
 #include <fastrtps/attributes/TopicAttributes.h>
 #include <fastrtps/rtps/common/MatchingInfo.h>
 
-#include <fastrtps/utils/StringMatching.h>
 #include <fastrtps/log/Log.h>
 
 #include <fastrtps/types/TypeObjectFactory.h>
@@ -447,53 +446,8 @@ bool EDP::validMatching(const WriterProxyData* wdata, const ReaderProxyData* rda
 #endif
 
     //Partition check:
-    bool matched = false;
-    if(wdata->m_qos.m_partition.names.empty() && rdata->m_qos.m_partition.names.empty())
-    {
-        matched = true;
-    }
-    else if(wdata->m_qos.m_partition.names.empty() && rdata->m_qos.m_partition.names.size()>0)
-    {
-        for(std::vector<std::string>::const_iterator rnameit = rdata->m_qos.m_partition.names.begin();
-                rnameit!=rdata->m_qos.m_partition.names.end();++rnameit)
-        {
-            if(rnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else if(wdata->m_qos.m_partition.names.size()>0 && rdata->m_qos.m_partition.names.empty() )
-    {
-        for(std::vector<std::string>::const_iterator wnameit = wdata->m_qos.m_partition.names.begin();
-                wnameit !=  wdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            if(wnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else
-    {
-        for(std::vector<std::string>::const_iterator wnameit = wdata->m_qos.m_partition.names.begin();
-                wnameit !=  wdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            for(std::vector<std::string>::const_iterator rnameit = rdata->m_qos.m_partition.names.begin();
-                    rnameit!=rdata->m_qos.m_partition.names.end();++rnameit)
-            {
-                if(StringMatching::matchString(wnameit->c_str(),rnameit->c_str()))
-                {
-                    matched = true;
-                    break;
-                }
-            }
-            if(matched)
-                break;
-        }
-    }
+    bool matched = m_partitionMatcher.match(wdata->m_qos.m_partition.names,
+            rdata->m_qos.m_partition.names);
     if(!matched) //Different partitions
         logWarning(RTPS_EDP,"INCOMPATIBLE QOS (topic: "<< rdata->topicName() <<"): Different Partitions");
     return matched;
@@ -560,53 +514,8 @@ bool EDP::validMatching(const ReaderProxyData* rdata, const WriterProxyData* wda
 #endif
 
     //Partition check:
-    bool matched = false;
-    if(rdata->m_qos.m_partition.names.empty() && wdata->m_qos.m_partition.names.empty())
-    {
-        matched = true;
-    }
-    else if(rdata->m_qos.m_partition.names.empty() && wdata->m_qos.m_partition.names.size()>0)
-    {
-        for(std::vector<std::string>::const_iterator rnameit = wdata->m_qos.m_partition.names.begin();
-                rnameit!=wdata->m_qos.m_partition.names.end();++rnameit)
-        {
-            if(rnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else if(rdata->m_qos.m_partition.names.size()>0 && wdata->m_qos.m_partition.names.empty() )
-    {
-        for(std::vector<std::string>::const_iterator wnameit = rdata->m_qos.m_partition.names.begin();
-                wnameit !=  rdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            if(wnameit->size()==0)
-            {
-                matched = true;
-                break;
-            }
-        }
-    }
-    else
-    {
-        for(std::vector<std::string>::const_iterator wnameit = rdata->m_qos.m_partition.names.begin();
-                wnameit !=  rdata->m_qos.m_partition.names.end();++wnameit)
-        {
-            for(std::vector<std::string>::const_iterator rnameit = wdata->m_qos.m_partition.names.begin();
-                    rnameit!=wdata->m_qos.m_partition.names.end();++rnameit)
-            {
-                if(StringMatching::matchString(wnameit->c_str(),rnameit->c_str()))
-                {
-                    matched = true;
-                    break;
-                }
-            }
-            if(matched)
-                break;
-        }
-    }
+    bool matched = m_partitionMatcher.match(rdata->m_qos.m_partition.names,
+            wdata->m_qos.m_partition.names);
     if(!matched) //Different partitions
         logWarning(RTPS_EDP, "INCOMPATIBLE QOS (topic: " <<  wdata->topicName() << "): Different Partitions");
 
@@ -623,56 +532,55 @@ bool EDP::pairingReader(RTPSReader* R, const ParticipantProxyData& pdata, const
     logInfo(RTPS_EDP, rdata.guid() <<" in topic: \"" << rdata.topicName() <<"\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
 
-    for(std::vector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-            pit!=mp_PDP->ParticipantProxiesEnd(); ++pit)
+    // Only the writers on the same topic can match. The candidates are copied, as matching may modify the index.
+    std::vector<WriterProxyData*> writers = mp_PDP->writersOnTopic(rdata.topicName().to_string());
+    for(std::vector<WriterProxyData*>::iterator wdatait = writers.begin();
+            wdatait != writers.end(); ++wdatait)
     {
-        for(std::vector<WriterProxyData*>::iterator wdatait = (*pit)->m_writers.begin();
-                wdatait != (*pit)->m_writers.end(); ++wdatait)
-        {
-            bool valid = validMatching(&rdata, *wdatait);
+        bool valid = validMatching(&rdata, *wdatait);
 
-            if(valid)
-            {
+        if(valid)
+        {
 #if HAVE_SECURITY
-                if(!mp_RTPSParticipant->security_manager().discovered_writer(R->m_guid, (*pit)->m_guid,
-                            **wdatait, R->getAttributes().security_attributes()))
-                {
-                    logError(RTPS_EDP, "Security manager returns an error for reader " << R->getGuid());
-                }
+            GUID_t participant_guid((*wdatait)->guid().guidPrefix, c_EntityId_RTPSParticipant);
+            if(!mp_RTPSParticipant->security_manager().discovered_writer(R->m_guid, participant_guid,
+                        **wdatait, R->getAttributes().security_attributes()))
+            {
+                logError(RTPS_EDP, "Security manager returns an error for reader " << R->getGuid());
+            }
 #else
 				RemoteWriterAttributes rwatt = (*wdatait)->toRemoteWriterAttributes();
-                if(R->matched_writer_add(rwatt))
+            if(R->matched_writer_add(rwatt))
+            {
+                logInfo(RTPS_EDP, "Valid Matching to writerProxy: " << (*wdatait)->guid());
+                //MATCHED AND ADDED CORRECTLY:
+                if(R->getListener()!=nullptr)
                 {
-                    logInfo(RTPS_EDP, "Valid Matching to writerProxy: " << (*wdatait)->guid());
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(R->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = MATCHED_MATCHING;
-                        info.remoteEndpointGuid = (*wdatait)->guid();
-                        R->getListener()->onReaderMatched(R,info);
-                    }
+                    MatchingInfo info;
+                    info.status = MATCHED_MATCHING;
+                    info.remoteEndpointGuid = (*wdatait)->guid();
+                    R->getListener()->onReaderMatched(R,info);
                 }
-#endif
             }
-            else
+#endif
+        }
+        else
+        {
+            //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
+            if(R->matched_writer_is_matched((*wdatait)->toRemoteWriterAttributes())
+                    && R->matched_writer_remove((*wdatait)->toRemoteWriterAttributes()))
             {
-                //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
-                if(R->matched_writer_is_matched((*wdatait)->toRemoteWriterAttributes())
-                        && R->matched_writer_remove((*wdatait)->toRemoteWriterAttributes()))
-                {
 #if HAVE_SECURITY
-                    mp_RTPSParticipant->security_manager().remove_writer(R->getGuid(), pdata.m_guid, (*wdatait)->guid());
+                mp_RTPSParticipant->security_manager().remove_writer(R->getGuid(), pdata.m_guid, (*wdatait)->guid());
 #endif
 
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(R->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = REMOVED_MATCHING;
-                        info.remoteEndpointGuid = (*wdatait)->guid();
-                        R->getListener()->onReaderMatched(R,info);
-                    }
+                //MATCHED AND ADDED CORRECTLY:
+                if(R->getListener()!=nullptr)
+                {
+                    MatchingInfo info;
+                    info.status = REMOVED_MATCHING;
+                    info.remoteEndpointGuid = (*wdatait)->guid();
+                    R->getListener()->onReaderMatched(R,info);
                 }
             }
         }
@@ -688,55 +596,54 @@ bool EDP::pairingWriter(RTPSWriter* W, const ParticipantProxyData& pdata, const
     logInfo(RTPS_EDP, W->getGuid() << " in topic: \"" << wdata.topicName() <<"\"");
     std::lock_guard<std::recursive_mutex> pguard(*mp_PDP->getMutex());
 
-    for(std::vector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-            pit!=mp_PDP->ParticipantProxiesEnd(); ++pit)
+    // Only the readers on the same topic can match. The candidates are copied, as matching may modify the index.
+    std::vector<ReaderProxyData*> readers = mp_PDP->readersOnTopic(wdata.topicName().to_string());
+    for(std::vector<ReaderProxyData*>::iterator rdatait = readers.begin();
+            rdatait!=readers.end(); ++rdatait)
     {
-        for(std::vector<ReaderProxyData*>::iterator rdatait = (*pit)->m_readers.begin();
-                rdatait!=(*pit)->m_readers.end(); ++rdatait)
-        {
-            bool valid = validMatching(&wdata, *rdatait);
+        bool valid = validMatching(&wdata, *rdatait);
 
-            if(valid)
-            {
+        if(valid)
+        {
 #if HAVE_SECURITY
-                if(!mp_RTPSParticipant->security_manager().discovered_reader(W->getGuid(), (*pit)->m_guid,
-                            **rdatait, W->getAttributes().security_attributes()))
-                {
-                    logError(RTPS_EDP, "Security manager returns an error for writer " << W->getGuid());
-                }
+            GUID_t participant_guid((*rdatait)->guid().guidPrefix, c_EntityId_RTPSParticipant);
+            if(!mp_RTPSParticipant->security_manager().discovered_reader(W->getGuid(), participant_guid,
+                        **rdatait, W->getAttributes().security_attributes()))
+            {
+                logError(RTPS_EDP, "Security manager returns an error for writer " << W->getGuid());
+            }
 #else
 				RemoteReaderAttributes rratt = (*rdatait)->toRemoteReaderAttributes();
 				if(W->matched_reader_add(rratt))
+            {
+                logInfo(RTPS_EDP,"Valid Matching to readerProxy: " << (*rdatait)->guid());
+                //MATCHED AND ADDED CORRECTLY:
+                if(W->getListener()!=nullptr)
                 {
-                    logInfo(RTPS_EDP,"Valid Matching to readerProxy: " << (*rdatait)->guid());
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(W->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = MATCHED_MATCHING;
-                        info.remoteEndpointGuid = (*rdatait)->guid();
-                        W->getListener()->onWriterMatched(W,info);
-                    }
+                    MatchingInfo info;
+                    info.status = MATCHED_MATCHING;
+                    info.remoteEndpointGuid = (*rdatait)->guid();
+                    W->getListener()->onWriterMatched(W,info);
                 }
-#endif
             }
-            else
+#endif
+        }
+        else
+        {
+            //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
+            if(W->matched_reader_is_matched((*rdatait)->toRemoteReaderAttributes()) &&
+                    W->matched_reader_remove((*rdatait)->toRemoteReaderAttributes()))
             {
-                //logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
-                if(W->matched_reader_is_matched((*rdatait)->toRemoteReaderAttributes()) &&
-                        W->matched_reader_remove((*rdatait)->toRemoteReaderAttributes()))
-                {
 #if HAVE_SECURITY
-                    mp_RTPSParticipant->security_manager().remove_reader(W->getGuid(), pdata.m_guid, (*rdatait)->guid());
+                mp_RTPSParticipant->security_manager().remove_reader(W->getGuid(), pdata.m_guid, (*rdatait)->guid());
 #endif
-                    //MATCHED AND ADDED CORRECTLY:
-                    if(W->getListener()!=nullptr)
-                    {
-                        MatchingInfo info;
-                        info.status = REMOVED_MATCHING;
-                        info.remoteEndpointGuid = (*rdatait)->guid();
-                        W->getListener()->onWriterMatched(W,info);
-                    }
+                //MATCHED AND ADDED CORRECTLY:
+                if(W->getListener()!=nullptr)
+                {
+                    MatchingInfo info;
+                    info.status = REMOVED_MATCHING;
+                    info.remoteEndpointGuid = (*rdatait)->guid();
+                    W->getListener()->onWriterMatched(W,info);
                 }
             }
         }
@@ -757,11 +664,10 @@ bool EDP::pairing_reader_proxy_with_any_local_writer(ParticipantProxyData* pdata
         (*wit)->getMutex().lock();
         GUID_t writerGUID = (*wit)->getGuid();
         (*wit)->getMutex().unlock();
-        ParticipantProxyData wpdata;
-        WriterProxyData wdata;
-        if(mp_PDP->lookupWriterProxyData(writerGUID, wdata, wpdata))
+        WriterProxyData* wdata = mp_PDP->findWriterProxyData(writerGUID);
+        if(wdata != nullptr)
         {
-            bool valid = validMatching(&wdata, rdata);
+            bool valid = validMatching(wdata, rdata);
 
             if(valid)
             {
@@ -827,11 +733,10 @@ bool EDP::pairing_reader_proxy_with_local_writer(const GUID_t& local_writer, con
 
         if(local_writer == writerGUID)
         {
-            ParticipantProxyData wpdata;
-            WriterProxyData wdata;
-            if(mp_PDP->lookupWriterProxyData(writerGUID, wdata, wpdata))
+            WriterProxyData* wdata = mp_PDP->findWriterProxyData(writerGUID);
+            if(wdata != nullptr)
             {
-                bool valid = validMatching(&wdata, &rdata);
+                bool valid = validMatching(wdata, &rdata);
 
                 if(valid)
                 {
@@ -916,11 +821,10 @@ bool EDP::pairing_writer_proxy_with_any_local_reader(ParticipantProxyData *pdata
         (*rit)->getMutex().lock();
         readerGUID = (*rit)->getGuid();
         (*rit)->getMutex().unlock();
-        ParticipantProxyData rpdata;
-        ReaderProxyData rdata;
-        if(mp_PDP->lookupReaderProxyData(readerGUID, rdata, rpdata))
+        ReaderProxyData* rdata = mp_PDP->findReaderProxyData(readerGUID);
+        if(rdata != nullptr)
         {
-            bool valid = validMatching(&rdata, wdata);
+            bool valid = validMatching(rdata, wdata);
 
             if(valid)
             {
@@ -986,11 +890,10 @@ bool EDP::pairing_writer_proxy_with_local_reader(const GUID_t& local_reader, con
 
         if(local_reader == readerGUID)
         {
-            ParticipantProxyData rpdata;
-            ReaderProxyData rdata;
-            if(mp_PDP->lookupReaderProxyData(readerGUID, rdata, rpdata))
+            ReaderProxyData* rdata = mp_PDP->findReaderProxyData(readerGUID);
+            if(rdata != nullptr)
             {
-                bool valid = validMatching(&rdata, &wdata);
+                bool valid = validMatching(rdata, &wdata);
 
                 if(valid)
                 {
@@ -53,6 +53,7 @@
 
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace eprosima::fastrtps;
@@ -224,8 +225,11 @@ bool PDPSimple::initPDP(RTPSParticipantImpl* part)
     }
     //UPDATE METATRAFFIC.
     mp_builtin->updateMetatrafficLocators(this->mp_SPDPReader->getAttributes().unicastLocatorList);
-    m_participantProxies.push_back(new ParticipantProxyData());
-    initializeParticipantProxyData(m_participantProxies.front());
+    ParticipantProxyData* local_pdata = new ParticipantProxyData();
+    initializeParticipantProxyData(local_pdata);
+    mp_mutex->lock();
+    registerParticipantProxyData(local_pdata);
+    mp_mutex->unlock();
 
     //INIT EDP
     if(m_discovery.use_STATIC_EndpointDiscoveryProtocol)
@@ -364,19 +368,12 @@ void PDPSimple::announceParticipantState(bool new_change, bool dispose)
 bool PDPSimple::lookupReaderProxyData(const GUID_t& reader, ReaderProxyData& rdata, ParticipantProxyData& pdata)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end();++pit)
+    ReaderProxyData* found = findReaderProxyData(reader);
+    if(found != nullptr)
     {
-        for (auto rit = (*pit)->m_readers.begin();
-                rit != (*pit)->m_readers.end();++rit)
-        {
-            if((*rit)->guid() == reader)
-            {
-                rdata.copy(*rit);
-                pdata.copy(**pit);
-                return true;
-            }
-        }
+        rdata.copy(found);
+        pdata.copy(*m_participantsByPrefix.at(reader.guidPrefix));
+        return true;
     }
     return false;
 }
@@ -384,55 +381,76 @@ bool PDPSimple::lookupReaderProxyData(const GUID_t& reader, ReaderProxyData& rda
 bool PDPSimple::lookupWriterProxyData(const GUID_t& writer, WriterProxyData& wdata, ParticipantProxyData& pdata)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
+    WriterProxyData* found = findWriterProxyData(writer);
+    if(found != nullptr)
     {
-        for (auto wit = (*pit)->m_writers.begin();
-                wit != (*pit)->m_writers.end(); ++wit)
-        {
-            if((*wit)->guid() == writer)
-            {
-                wdata.copy(*wit);
-                pdata.copy(**pit);
-                return true;
-            }
-        }
+        wdata.copy(found);
+        pdata.copy(*m_participantsByPrefix.at(writer.guidPrefix));
+        return true;
     }
     return false;
 }
 
+ReaderProxyData* PDPSimple::findReaderProxyData(const GUID_t& reader)
+{
+    auto it = m_readersByGuid.find(reader);
+    return it != m_readersByGuid.end() ? it->second : nullptr;
+}
+
+WriterProxyData* PDPSimple::findWriterProxyData(const GUID_t& writer)
+{
+    auto it = m_writersByGuid.find(writer);
+    return it != m_writersByGuid.end() ? it->second : nullptr;
+}
+
+ParticipantProxyData* PDPSimple::findParticipantProxyData(const GuidPrefix_t& prefix)
+{
+    auto it = m_participantsByPrefix.find(prefix);
+    return it != m_participantsByPrefix.end() ? it->second : nullptr;
+}
+
+const std::vector<ReaderProxyData*>& PDPSimple::readersOnTopic(const std::string& topic_name) const
+{
+    static const std::vector<ReaderProxyData*> no_readers;
+    auto it = m_readersByTopic.find(topic_name);
+    return it != m_readersByTopic.end() ? it->second : no_readers;
+}
+
+const std::vector<WriterProxyData*>& PDPSimple::writersOnTopic(const std::string& topic_name) const
+{
+    static const std::vector<WriterProxyData*> no_writers;
+    auto it = m_writersByTopic.find(topic_name);
+    return it != m_writersByTopic.end() ? it->second : no_writers;
+}
+
 bool PDPSimple::removeReaderProxyData(const GUID_t& reader_guid)
 {
     logInfo(RTPS_PDP, "Removing reader proxy data " << reader_guid);
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
+    ReaderProxyData* rdata = findReaderProxyData(reader_guid);
+    if(rdata == nullptr)
     {
-        for (auto rit = (*pit)->m_readers.begin();
-                rit != (*pit)->m_readers.end(); ++rit)
-        {
-            if((*rit)->guid() == reader_guid)
-            {
-                mp_EDP->unpairReaderProxy((*pit)->m_guid, reader_guid);
+        return false;
+    }
 
-                RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
-                if(listener)
-                {
-                    ReaderDiscoveryInfo info;
-                    info.status = ReaderDiscoveryInfo::REMOVED_READER;
-                    info.info = std::move(**rit);
-                    listener->onReaderDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
-                }
+    ParticipantProxyData* pdata = m_participantsByPrefix.at(reader_guid.guidPrefix);
+    unindexReaderProxyData(rdata);
+    pdata->m_readers.erase(std::find(pdata->m_readers.begin(), pdata->m_readers.end(), rdata));
 
-                delete *rit;
-                (*pit)->m_readers.erase(rit);
-                return true;
-            }
-        }
+    mp_EDP->unpairReaderProxy(pdata->m_guid, reader_guid);
+
+    RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
+    if(listener)
+    {
+        ReaderDiscoveryInfo info;
+        info.status = ReaderDiscoveryInfo::REMOVED_READER;
+        info.info = std::move(*rdata);
+        listener->onReaderDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
     }
 
-    return false;
+    delete rdata;
+    return true;
 }
 
 bool PDPSimple::removeWriterProxyData(const GUID_t& writer_guid)
@@ -440,33 +458,29 @@ bool PDPSimple::removeWriterProxyData(const GUID_t& writer_guid)
     logInfo(RTPS_PDP, "Removing writer proxy data " << writer_guid);
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
+    WriterProxyData* wdata = findWriterProxyData(writer_guid);
+    if(wdata == nullptr)
     {
-        for (auto wit = (*pit)->m_writers.begin();
-                wit != (*pit)->m_writers.end(); ++wit)
-        {
-            if((*wit)->guid() == writer_guid)
-            {
-                mp_EDP->unpairWriterProxy((*pit)->m_guid, writer_guid);
+        return false;
+    }
 
-                RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
-                if(listener)
-                {
-                    WriterDiscoveryInfo info;
-                    info.status = WriterDiscoveryInfo::REMOVED_WRITER;
-                    info.info = std::move(**wit);
-                    listener->onWriterDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
-                }
+    ParticipantProxyData* pdata = m_participantsByPrefix.at(writer_guid.guidPrefix);
+    unindexWriterProxyData(wdata);
+    pdata->m_writers.erase(std::find(pdata->m_writers.begin(), pdata->m_writers.end(), wdata));
 
-                delete *wit;
-                (*pit)->m_writers.erase(wit);
-                return true;
-            }
-        }
+    mp_EDP->unpairWriterProxy(pdata->m_guid, writer_guid);
+
+    RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
+    if(listener)
+    {
+        WriterDiscoveryInfo info;
+        info.status = WriterDiscoveryInfo::REMOVED_WRITER;
+        info.info = std::move(*wdata);
+        listener->onWriterDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
     }
 
-    return false;
+    delete wdata;
+    return true;
 }
 
 
@@ -474,16 +488,73 @@ bool PDPSimple::lookupParticipantProxyData(const GUID_t& pguid, ParticipantProxy
 {
     logInfo(RTPS_PDP,pguid);
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* found = findParticipantProxyData(pguid.guidPrefix);
+    if(found != nullptr && found->m_guid == pguid)
+    {
+        pdata.copy(*found);
+        return true;
+    }
+    return false;
+}
+
+void PDPSimple::registerParticipantProxyData(ParticipantProxyData* pdata)
+{
+    m_participantProxies.push_back(pdata);
+    m_participantsByPrefix[pdata->m_guid.guidPrefix] = pdata;
+}
+
+ParticipantProxyData* PDPSimple::unregisterParticipantProxyData(const GuidPrefix_t& prefix)
+{
+    auto it = m_participantsByPrefix.find(prefix);
+    if(it == m_participantsByPrefix.end())
     {
-        if((*pit)->m_guid == pguid)
+        return nullptr;
+    }
+
+    ParticipantProxyData* pdata = it->second;
+    m_participantsByPrefix.erase(it);
+    m_participantProxies.erase(std::find(m_participantProxies.begin(), m_participantProxies.end(), pdata));
+
+    for(ReaderProxyData* rdata : pdata->m_readers)
+    {
+        unindexReaderProxyData(rdata);
+    }
+    for(WriterProxyData* wdata : pdata->m_writers)
+    {
+        unindexWriterProxyData(wdata);
+    }
+
+    return pdata;
+}
+
+void PDPSimple::unindexReaderProxyData(ReaderProxyData* rdata)
+{
+    m_readersByGuid.erase(rdata->guid());
+
+    auto topic = m_readersByTopic.find(rdata->topicName().to_string());
+    if(topic != m_readersByTopic.end())
+    {
+        topic->second.erase(std::find(topic->second.begin(), topic->second.end(), rdata));
+        if(topic->second.empty())
         {
-            pdata.copy(**pit);
-            return true;
+            m_readersByTopic.erase(topic);
+        }
+    }
+}
+
+void PDPSimple::unindexWriterProxyData(WriterProxyData* wdata)
+{
+    m_writersByGuid.erase(wdata->guid());
+
+    auto topic = m_writersByTopic.find(wdata->topicName().to_string());
+    if(topic != m_writersByTopic.end())
+    {
+        topic->second.erase(std::find(topic->second.begin(), topic->second.end(), wdata));
+        if(topic->second.empty())
+        {
+            m_writersByTopic.erase(topic);
         }
     }
-    return false;
 }
 
 bool PDPSimple::createSPDPEndpoints()
@@ -592,61 +663,57 @@ bool PDPSimple::addReaderProxyData(ReaderProxyData* rdata, ParticipantProxyData&
 
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* ppd = findParticipantProxyData(rdata->guid().guidPrefix);
+    if(ppd == nullptr)
     {
-        if((*pit)->m_guid.guidPrefix == rdata->guid().guidPrefix)
-        {
-            // Set locators information if not defined by ReaderProxyData.
-            if(rdata->unicastLocatorList().empty() && rdata->multicastLocatorList().empty())
-            {
-                rdata->unicastLocatorList((*pit)->m_defaultUnicastLocatorList);
-                rdata->multicastLocatorList((*pit)->m_defaultMulticastLocatorList);
-            }
-            // Set as alive.
-            rdata->isAlive(true);
+        return false;
+    }
 
-            // Copy participant data to be used outside.
-            pdata.copy(**pit);
+    // Set locators information if not defined by ReaderProxyData.
+    if(rdata->unicastLocatorList().empty() && rdata->multicastLocatorList().empty())
+    {
+        rdata->unicastLocatorList(ppd->m_defaultUnicastLocatorList);
+        rdata->multicastLocatorList(ppd->m_defaultMulticastLocatorList);
+    }
+    // Set as alive.
+    rdata->isAlive(true);
 
-            // Check that it is not already there:
-            for(std::vector<ReaderProxyData*>::iterator rit = (*pit)->m_readers.begin();
-                    rit!=(*pit)->m_readers.end();++rit)
-            {
-                if((*rit)->guid().entityId == rdata->guid().entityId)
-                {
-                    (*rit)->update(rdata);
+    // Copy participant data to be used outside.
+    pdata.copy(*ppd);
 
-                    RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
-                    if(listener)
-                    {
-                        ReaderDiscoveryInfo info;
-                        info.status = ReaderDiscoveryInfo::CHANGED_QOS_READER;
-                        info.info = *rdata;
-                        listener->onReaderDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
-                    }
+    // Check that it is not already there:
+    ReaderProxyData* existing = findReaderProxyData(rdata->guid());
+    if(existing != nullptr)
+    {
+        existing->update(rdata);
 
-                    return true;
-                }
-            }
+        RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
+        if(listener)
+        {
+            ReaderDiscoveryInfo info;
+            info.status = ReaderDiscoveryInfo::CHANGED_QOS_READER;
+            info.info = *rdata;
+            listener->onReaderDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
+        }
 
-            ReaderProxyData* newRPD = new ReaderProxyData(*rdata);
-            (*pit)->m_readers.push_back(newRPD);
+        return true;
+    }
 
-            RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
-            if(listener)
-            {
-                ReaderDiscoveryInfo info;
-                info.status = ReaderDiscoveryInfo::DISCOVERED_READER;
-                info.info = *rdata;
-                listener->onReaderDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
-            }
+    ReaderProxyData* newRPD = new ReaderProxyData(*rdata);
+    ppd->m_readers.push_back(newRPD);
+    m_readersByGuid[newRPD->guid()] = newRPD;
+    m_readersByTopic[newRPD->topicName().to_string()].push_back(newRPD);
 
-            return true;
-        }
+    RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
+    if(listener)
+    {
+        ReaderDiscoveryInfo info;
+        info.status = ReaderDiscoveryInfo::DISCOVERED_READER;
+        info.info = *rdata;
+        listener->onReaderDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
     }
 
-    return false;
+    return true;
 }
 
 bool PDPSimple::addWriterProxyData(WriterProxyData* wdata, ParticipantProxyData& pdata)
@@ -655,60 +722,57 @@ bool PDPSimple::addWriterProxyData(WriterProxyData* wdata, ParticipantProxyData&
 
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
 
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* ppd = findParticipantProxyData(wdata->guid().guidPrefix);
+    if(ppd == nullptr)
     {
-        if((*pit)->m_guid.guidPrefix == wdata->guid().guidPrefix)
-        {
-            // Set locators information if not defined by ReaderProxyData.
-            if(wdata->unicastLocatorList().empty() && wdata->multicastLocatorList().empty())
-            {
-                wdata->unicastLocatorList((*pit)->m_defaultUnicastLocatorList);
-                wdata->multicastLocatorList((*pit)->m_defaultMulticastLocatorList);
-            }
-            // Set as alive.
-            wdata->isAlive(true);
+        return false;
+    }
 
-            // Copy participant data to be used outside.
-            pdata.copy(**pit);
+    // Set locators information if not defined by WriterProxyData.
+    if(wdata->unicastLocatorList().empty() && wdata->multicastLocatorList().empty())
+    {
+        wdata->unicastLocatorList(ppd->m_defaultUnicastLocatorList);
+        wdata->multicastLocatorList(ppd->m_defaultMulticastLocatorList);
+    }
+    // Set as alive.
+    wdata->isAlive(true);
 
-            //CHECK THAT IT IS NOT ALREADY THERE:
-            for(std::vector<WriterProxyData*>::iterator wit = (*pit)->m_writers.begin();
-                    wit!=(*pit)->m_writers.end();++wit)
-            {
-                if((*wit)->guid().entityId == wdata->guid().entityId)
-                {
-                    (*wit)->update(wdata);
+    // Copy participant data to be used outside.
+    pdata.copy(*ppd);
 
-                    RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
-                    if(listener)
-                    {
-                        WriterDiscoveryInfo info;
-                        info.status = WriterDiscoveryInfo::CHANGED_QOS_WRITER;
-                        info.info = *wdata;
-                        listener->onWriterDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
-                    }
+    //CHECK THAT IT IS NOT ALREADY THERE:
+    WriterProxyData* existing = findWriterProxyData(wdata->guid());
+    if(existing != nullptr)
+    {
+        existing->update(wdata);
 
-                    return true;
-                }
-            }
+        RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
+        if(listener)
+        {
+            WriterDiscoveryInfo info;
+            info.status = WriterDiscoveryInfo::CHANGED_QOS_WRITER;
+            info.info = *wdata;
+            listener->onWriterDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
+        }
 
-            WriterProxyData* newWPD = new WriterProxyData(*wdata);
-            (*pit)->m_writers.push_back(newWPD);
+        return true;
+    }
 
-            RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
-            if(listener)
-            {
-                WriterDiscoveryInfo info;
-                info.status = WriterDiscoveryInfo::DISCOVERED_WRITER;
-                info.info = *wdata;
-                listener->onWriterDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
-            }
+    WriterProxyData* newWPD = new WriterProxyData(*wdata);
+    ppd->m_writers.push_back(newWPD);
+    m_writersByGuid[newWPD->guid()] = newWPD;
+    m_writersByTopic[newWPD->topicName().to_string()].push_back(newWPD);
 
-            return true;
-        }
+    RTPSParticipantListener* listener = mp_RTPSParticipant->getListener();
+    if(listener)
+    {
+        WriterDiscoveryInfo info;
+        info.status = WriterDiscoveryInfo::DISCOVERED_WRITER;
+        info.info = *wdata;
+        listener->onWriterDiscovery(mp_RTPSParticipant->getUserRTPSParticipant(), std::move(info));
     }
-    return false;
+
+    return true;
 }
 
 void PDPSimple::assignRemoteEndpoints(ParticipantProxyData* pdata)
@@ -804,15 +868,10 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
 
     //Remove it from our vector or RTPSParticipantProxies:
     this->mp_mutex->lock();
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* found = findParticipantProxyData(partGUID.guidPrefix);
+    if(found != nullptr && found->m_guid == partGUID)
     {
-        if((*pit)->m_guid == partGUID)
-        {
-            pdata = *pit;
-            m_participantProxies.erase(pit);
-            break;
-        }
+        pdata = unregisterParticipantProxyData(partGUID.guidPrefix);
     }
     this->mp_mutex->unlock();
 
@@ -881,20 +940,16 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
 void PDPSimple::assertRemoteParticipantLiveliness(const GuidPrefix_t& guidP)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator it = this->m_participantProxies.begin();
-            it!=this->m_participantProxies.end();++it)
+    ParticipantProxyData* pdata = findParticipantProxyData(guidP);
+    if(pdata != nullptr)
     {
-        if((*it)->m_guid.guidPrefix == guidP)
+        logInfo(RTPS_LIVELINESS,"RTPSParticipant "<< pdata->m_guid << " is Alive");
+        // TODO Ricardo: Study if isAlive attribute is necessary.
+        pdata->isAlive = true;
+        if(pdata->mp_leaseDurationTimer != nullptr)
         {
-            logInfo(RTPS_LIVELINESS,"RTPSParticipant "<< (*it)->m_guid << " is Alive");
-            // TODO Ricardo: Study if isAlive attribute is necessary.
-            (*it)->isAlive = true;
-            if((*it)->mp_leaseDurationTimer != nullptr)
-            {
-                (*it)->mp_leaseDurationTimer->cancel_timer();
-                (*it)->mp_leaseDurationTimer->restart_timer();
-            }
-            break;
+            pdata->mp_leaseDurationTimer->cancel_timer();
+            pdata->mp_leaseDurationTimer->restart_timer();
         }
     }
 }
@@ -922,34 +977,30 @@ void PDPSimple::assertRemoteWritersLiveliness(GuidPrefix_t& guidP,LivelinessQosP
     logInfo(RTPS_LIVELINESS,"of type " << (kind==AUTOMATIC_LIVELINESS_QOS?"AUTOMATIC":"")
             <<(kind==MANUAL_BY_PARTICIPANT_LIVELINESS_QOS?"MANUAL_BY_PARTICIPANT":""));
 
-    for(std::vector<ParticipantProxyData*>::iterator pit=this->m_participantProxies.begin();
-            pit!=this->m_participantProxies.end();++pit)
+    ParticipantProxyData* pdata = findParticipantProxyData(guidP);
+    if(pdata != nullptr)
     {
-        if((*pit)->m_guid.guidPrefix == guidP)
+        for(std::vector<WriterProxyData*>::iterator wit = pdata->m_writers.begin();
+                wit != pdata->m_writers.end();++wit)
         {
-            for(std::vector<WriterProxyData*>::iterator wit = (*pit)->m_writers.begin();
-                    wit != (*pit)->m_writers.end();++wit)
+            if((*wit)->m_qos.m_liveliness.kind == kind)
             {
-                if((*wit)->m_qos.m_liveliness.kind == kind)
+                (*wit)->isAlive(true);
+                for(std::vector<RTPSReader*>::iterator rit = mp_RTPSParticipant->userReadersListBegin();
+                        rit!=mp_RTPSParticipant->userReadersListEnd();++rit)
                 {
-                    (*wit)->isAlive(true);
-                    for(std::vector<RTPSReader*>::iterator rit = mp_RTPSParticipant->userReadersListBegin();
-                            rit!=mp_RTPSParticipant->userReadersListEnd();++rit)
+                    if((*rit)->getAttributes().reliabilityKind == RELIABLE)
                     {
-                        if((*rit)->getAttributes().reliabilityKind == RELIABLE)
+                        StatefulReader* sfr = (StatefulReader*)(*rit);
+                        WriterProxy* WP;
+                        if(sfr->matched_writer_lookup((*wit)->guid(), &WP))
                         {
-                            StatefulReader* sfr = (StatefulReader*)(*rit);
-                            WriterProxy* WP;
-                            if(sfr->matched_writer_lookup((*wit)->guid(), &WP))
-                            {
-                                WP->assertLiveliness();
-                                continue;
-                            }
+                            WP->assertLiveliness();
+                            continue;
                         }
                     }
                 }
             }
-            break;
         }
     }
 }
@@ -78,17 +78,8 @@ void PDPSimpleListener::onNewCacheChangeAdded(
             reader->getMutex().unlock();
 
             //LOOK IF IS AN UPDATED INFORMATION
-            ParticipantProxyData* pdata = nullptr;
             std::unique_lock<std::recursive_mutex> lock(*mp_SPDP->getMutex());
-            for (auto it = mp_SPDP->m_participantProxies.begin();
-                    it != mp_SPDP->m_participantProxies.end();++it)
-            {
-                if(participant_data.m_key == (*it)->m_key)
-                {
-                    pdata = (*it);
-                    break;
-                }
-            }
+            ParticipantProxyData* pdata = mp_SPDP->findParticipantProxyData(participant_data.m_guid.guidPrefix);
 
             auto status = (pdata == nullptr) ? ParticipantDiscoveryInfo::DISCOVERED_PARTICIPANT :
                 ParticipantDiscoveryInfo::CHANGED_QOS_PARTICIPANT;
@@ -102,7 +93,7 @@ void PDPSimpleListener::onNewCacheChangeAdded(
                         pdata,
                         TimeConv::Duration_t2MilliSecondsDouble(pdata->m_leaseDuration));
                 pdata->mp_leaseDurationTimer->restart_timer();
-                this->mp_SPDP->m_participantProxies.push_back(pdata);
+                this->mp_SPDP->registerParticipantProxyData(pdata);
                 lock.unlock();
 
                 mp_SPDP->announceParticipantState(false);
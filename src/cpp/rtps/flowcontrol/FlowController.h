@@ -31,6 +31,7 @@ namespace rtps{
 
 class ReaderLocator;
 class ReaderProxy;
+class RTPSWriter;
 
 /**
  * Flow Controllers take a vector of cache changes (by reference) and return a filtered
@@ -48,6 +49,19 @@ class FlowController
         virtual void operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend) = 0;
         virtual void operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend) = 0;
 
+        /*!
+         * Controller operator used when the controller is shared by several writers, like the controllers of a
+         * participant. By default the writer is ignored.
+         */
+        virtual void operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend, const RTPSWriter*)
+        {
+            (*this)(changesToSend);
+        }
+        virtual void operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend, const RTPSWriter*)
+        {
+            (*this)(changesToSend);
+        }
+
         virtual ~FlowController();
         FlowController();
 
@@ -14,8 +14,10 @@
 
 #include "ThroughputController.h"
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
 #include <asio.hpp>
 #include <asio/steady_timer.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -23,53 +25,117 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+// Periods in a row the tokens can be reserved for higher priority writers while lower priority ones are waiting.
+static const uint32_t s_max_reserved_periods = 3;
+
 ThroughputController::ThroughputController(const ThroughputControllerDescriptor& descriptor, const RTPSWriter* associatedWriter):
     mBytesPerPeriod(descriptor.bytesPerPeriod),
-    mAccumulatedPayloadSize(0),
+    mBucketSize(std::max(descriptor.bytesPerPeriod, descriptor.burstBytes)),
+    mAvailableBytes(mBucketSize),
     mPeriodMillisecs(descriptor.periodMillisecs),
     mAssociatedParticipant(nullptr),
-    mAssociatedWriter(associatedWriter)
+    mAssociatedWriter(associatedWriter),
+    mReservedPriority(0),
+    mHeldBackLowerPriority(false),
+    mReservedPeriods(0),
+    mRefreshTimer(*FlowController::ControllerService),
+    mRefreshScheduled(false),
+    mDestroying(false)
 {
 }
 
 ThroughputController::ThroughputController(const ThroughputControllerDescriptor& descriptor, const RTPSParticipantImpl* associatedParticipant):
     mBytesPerPeriod(descriptor.bytesPerPeriod),
-    mAccumulatedPayloadSize(0),
+    mBucketSize(std::max(descriptor.bytesPerPeriod, descriptor.burstBytes)),
+    mAvailableBytes(mBucketSize),
     mPeriodMillisecs(descriptor.periodMillisecs),
     mAssociatedParticipant(associatedParticipant),
-    mAssociatedWriter(nullptr)
+    mAssociatedWriter(nullptr),
+    mReservedPriority(0),
+    mHeldBackLowerPriority(false),
+    mReservedPeriods(0),
+    mRefreshTimer(*FlowController::ControllerService),
+    mRefreshScheduled(false),
+    mDestroying(false)
 {
 }
 
-void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend)
+ThroughputController::~ThroughputController()
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    mDestroying = true;
 
-    auto it = changesToSend.items().begin();
-
-    while(it != changesToSend.items().end())
+    // Wait for the refresh handler, as it uses this object.
+    if (mRefreshScheduled)
     {
-        if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
-            break;
-
-        ++it;
+        mRefreshTimer.cancel();
+        mRefreshCondition.wait(scopedLock, [this]() { return !mRefreshScheduled; });
     }
+}
 
-    changesToSend.items().erase(it, changesToSend.items().end());
+void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    filter_nts_(changesToSend, mAssociatedWriter);
 }
 
 void ThroughputController::operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend)
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    filter_nts_(changesToSend, mAssociatedWriter);
+}
+
+void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend, const RTPSWriter* writer)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    filter_nts_(changesToSend, writer);
+}
+
+void ThroughputController::operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend, const RTPSWriter* writer)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    filter_nts_(changesToSend, writer);
+}
+
+template<typename T>
+void ThroughputController::filter_nts_(RTPSWriterCollector<T>& changesToSend, const RTPSWriter* writer)
+{
+    uint32_t priority = writer != nullptr ? writer->getFlowControllerPriority() : 0;
 
     auto it = changesToSend.items().begin();
 
-    while(it != changesToSend.items().end())
+    // Without a refresh scheduled the bucket is full, so the writers the tokens were reserved for did not take any
+    // since the last refill. No refill would age the reservation, so it is dropped.
+    if (!mRefreshScheduled)
+    {
+        mReservedPriority = 0;
+    }
+
+    // The available tokens are reserved for writers with a priority not lower than mReservedPriority.
+    if (priority >= mReservedPriority)
+    {
+        while(it != changesToSend.items().end())
+        {
+            if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
+                break;
+
+            ++it;
+        }
+
+        // This writer has nothing else to send, including when it had nothing at all.
+        if (it == changesToSend.items().end())
+        {
+            mReservedPriority = 0;
+        }
+    }
+    else if (it != changesToSend.items().end())
     {
-        if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
-            break;
+        mHeldBackLowerPriority = true;
+    }
 
-        ++it;
+    if (it != changesToSend.items().end())
+    {
+        add_waiting_writer_nts_(writer, priority);
     }
 
     changesToSend.items().erase(it, changesToSend.items().end());
@@ -86,38 +152,106 @@ bool ThroughputController::process_change_nts_(CacheChange_t* change, const Sequ
         dataLength = (fragNum + 1) != change->getFragmentCount() ?
             change->getFragmentSize() : change->serializedPayload.length - (fragNum * change->getFragmentSize());
 
-    if((mAccumulatedPayloadSize + dataLength) <= mBytesPerPeriod)
+    if(dataLength <= mAvailableBytes)
     {
-        mAccumulatedPayloadSize += dataLength;
-        ScheduleRefresh(dataLength);
+        mAvailableBytes -= dataLength;
+        ScheduleRefresh();
         return true;
     }
 
     return false;
 }
 
-void ThroughputController::ScheduleRefresh(uint32_t sizeToRestore)
+void ThroughputController::add_waiting_writer_nts_(const RTPSWriter* writer, uint32_t priority)
 {
-    std::shared_ptr<asio::steady_timer> throwawayTimer(std::make_shared<asio::steady_timer>(*FlowController::ControllerService));
-    auto refresh = [throwawayTimer, this, sizeToRestore]
-        (const asio::error_code& error)
+    auto it = mWaitingWriters.begin();
+    for (; it != mWaitingWriters.end() && it->priority >= priority; ++it)
+    {
+        if (it->writer == writer)
+            return;
+    }
+
+    // Writers with a lower priority cannot be this one, as it has always the same priority.
+    mWaitingWriters.insert(it, WaitingWriter{writer, priority});
+}
+
+void ThroughputController::ScheduleRefresh()
+{
+    if (!mRefreshScheduled && !mDestroying)
+    {
+        mRefreshScheduled = true;
+        mRefreshTimer.expires_from_now(std::chrono::milliseconds(mPeriodMillisecs));
+        mRefreshTimer.async_wait([this](const asio::error_code& error) { Refresh(error); });
+    }
+}
+
+void ThroughputController::Refresh(const asio::error_code& error)
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+
+    if ((error == asio::error::operation_aborted) || mDestroying)
+    {
+        mRefreshScheduled = false;
+        mRefreshCondition.notify_all();
+        return;
+    }
+
+    mAvailableBytes = (mBucketSize - mAvailableBytes) > mBytesPerPeriod ?
+        mAvailableBytes + mBytesPerPeriod : mBucketSize;
+
+    // Lower priority writers are not held back for more than s_max_reserved_periods in a row.
+    bool age_reservation = false;
+    if (mHeldBackLowerPriority)
+    {
+        age_reservation = ++mReservedPeriods > s_max_reserved_periods;
+    }
+    if (!mHeldBackLowerPriority || age_reservation)
+    {
+        mReservedPeriods = 0;
+    }
+    mHeldBackLowerPriority = false;
+
+    if (!mWaitingWriters.empty())
+    {
+        // Keep the new tokens for the waiting writers with the highest priority, unless the reservation ages.
+        mReservedPriority = age_reservation ? 0 : mWaitingWriters.front().priority;
+
+        if (mAssociatedWriter)
+        {
+            AsyncWriterThread::wakeUp(mAssociatedWriter);
+        }
+        else if (mAssociatedParticipant)
         {
-            if ((error != asio::error::operation_aborted) &&
-                    FlowController::IsListening(this))
+            if (!age_reservation)
             {
-                std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
-                throwawayTimer->cancel();
-                mAccumulatedPayloadSize = sizeToRestore > mAccumulatedPayloadSize ? 0 : mAccumulatedPayloadSize - sizeToRestore;
-
-                if (mAssociatedWriter)
-                    AsyncWriterThread::wakeUp(mAssociatedWriter);
-                else if (mAssociatedParticipant)
-                    AsyncWriterThread::wakeUp(mAssociatedParticipant);
+                // Wake up the writers with the highest priority first.
+                for (const WaitingWriter& waiting : mWaitingWriters)
+                {
+                    AsyncWriterThread::wakeUp(mAssociatedParticipant, waiting.writer);
+                }
             }
-        };
+            else
+            {
+                // Give this period to the writers that were held back.
+                for (auto waiting = mWaitingWriters.rbegin(); waiting != mWaitingWriters.rend(); ++waiting)
+                {
+                    AsyncWriterThread::wakeUp(mAssociatedParticipant, waiting->writer);
+                }
+            }
+        }
+
+        mWaitingWriters.clear();
+    }
 
-    throwawayTimer->expires_from_now(std::chrono::milliseconds(mPeriodMillisecs));
-    throwawayTimer->async_wait(refresh);
+    if (mAvailableBytes < mBucketSize)
+    {
+        mRefreshTimer.expires_at(mRefreshTimer.expires_at() + std::chrono::milliseconds(mPeriodMillisecs));
+        mRefreshTimer.async_wait([this](const asio::error_code& error) { Refresh(error); });
+    }
+    else
+    {
+        mRefreshScheduled = false;
+    }
 }
 
 } // namespace rtps
@@ -18,7 +18,9 @@
 #include "FlowController.h"
 #include <fastrtps/rtps/flowcontrol/ThroughputControllerDescriptor.h>
 
+#include <condition_variable>
 #include <thread>
+#include <vector>
 
 namespace eprosima{
 namespace fastrtps{
@@ -28,38 +30,74 @@ class RTPSWriter;
 class RTPSParticipantImpl;
 
 /**
- * Simple filter that only clears changes up to a certain accumulated payload size.
- * It refreshes after a given time in MS, in a staggered way (e.g. if it clears
- * 500kb at t=0 and 800 kb at t=10, it will refresh 500kb at t = 0 + period, and
- * then fully refresh at t = 10 + period).
+ * Token bucket filter that only clears changes while there are tokens (bytes) available.
+ * The bucket is refilled with 'bytesPerPeriod' bytes every period, by a single timer which is only active while the
+ * bucket is not full, and it can hold up to 'burstBytes' bytes (or 'bytesPerPeriod', if it is bigger).
+ * When the controller is shared by the writers of a participant, writers with a lower priority are not allowed to
+ * take tokens while a writer with a higher priority is waiting for them, and waiting writers are woken up on each
+ * refill in order of priority. The reservation is bounded: after a few periods holding back lower priority writers,
+ * the tokens of a period are not reserved and the waiting writers are woken up in reverse order. The reservation is
+ * also dropped when a writer it applies to has nothing else to send, or when the bucket gets full again.
  */
 class ThroughputController : public FlowController
 {
 public:
    ThroughputController(const ThroughputControllerDescriptor&, const RTPSWriter* associatedWriter);
    ThroughputController(const ThroughputControllerDescriptor&, const RTPSParticipantImpl* associatedParticipant);
+   virtual ~ThroughputController();
 
    virtual void operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend);
    virtual void operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend);
+   virtual void operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend, const RTPSWriter* writer);
+   virtual void operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend, const RTPSWriter* writer);
 
 private:
 
+   template<typename T>
+   void filter_nts_(RTPSWriterCollector<T>& changesToSend, const RTPSWriter* writer);
+
    bool process_change_nts_(CacheChange_t* change, const SequenceNumber_t& seqNum,
         const FragmentNumber_t fragNum);
 
+   //! Registers a writer as waiting for tokens, keeping mWaitingWriters sorted by decreasing priority.
+   void add_waiting_writer_nts_(const RTPSWriter* writer, uint32_t priority);
+
    uint32_t mBytesPerPeriod;
-   uint32_t mAccumulatedPayloadSize;
+   uint32_t mBucketSize;
+   uint32_t mAvailableBytes;
    uint32_t mPeriodMillisecs;
    std::recursive_mutex mThroughputControllerMutex;
 
    const RTPSParticipantImpl* mAssociatedParticipant;
    const RTPSWriter* mAssociatedWriter;
 
+   struct WaitingWriter
+   {
+      const RTPSWriter* writer;
+      uint32_t priority;
+   };
+
+   //! Writers that were denied tokens since the last refill.
+   std::vector<WaitingWriter> mWaitingWriters;
+   //! Writers with a lower priority are denied tokens until a writer with this priority takes them.
+   uint32_t mReservedPriority;
+   //! Whether a writer was denied tokens because of mReservedPriority since the last refill.
+   bool mHeldBackLowerPriority;
+   //! Consecutive periods in which lower priority writers were held back.
+   uint32_t mReservedPeriods;
+
+   asio::steady_timer mRefreshTimer;
+   bool mRefreshScheduled;
+   bool mDestroying;
+   std::condition_variable_any mRefreshCondition;
+
    /*
-    * Schedules the filter to be refreshed in period ms. When it does, its capacity
-    * will be partially restored, by "sizeToRestore" bytes.
+    * Schedules the bucket to be refilled in period ms, if it is not already scheduled.
     */
-   void ScheduleRefresh(uint32_t sizeToRestore);
+   void ScheduleRefresh();
+
+   //! Refills the bucket and wakes up the waiting writers.
+   void Refresh(const asio::error_code& error);
 };
 
 } // namespace rtps
@@ -30,6 +30,50 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+/*
+ * Released changes are recycled in DYNAMIC_RESERVE_MEMORY_MODE grouped by the size of their payload. Payloads up to
+ * 64 bytes share the first size class, and every power of two above it is split in four size classes, so a recycled
+ * payload is never more than 25% bigger than the requested size. Bigger payloads than MAX_RECYCLED_PAYLOAD_SIZE are
+ * not recycled.
+ */
+static const uint32_t MIN_SIZE_CLASS_EXPONENT = 6;
+static const uint32_t MAX_RECYCLED_PAYLOAD_SIZE = 1u << 30;
+static const size_t NO_SIZE_CLASS = static_cast<size_t>(-1);
+
+/*!
+ * Get the smallest size class able to hold a payload.
+ * @param size Size of the payload.
+ * @param class_size Returned size of the class.
+ * @return Index of the size class, or NO_SIZE_CLASS if the payload is too big to be recycled.
+ */
+static size_t size_class(uint32_t size, uint32_t& class_size)
+{
+    uint32_t exponent = MIN_SIZE_CLASS_EXPONENT;
+
+    if(size <= (1u << exponent))
+    {
+        class_size = 1u << exponent;
+        return 0;
+    }
+
+    if(size > MAX_RECYCLED_PAYLOAD_SIZE)
+    {
+        class_size = size;
+        return NO_SIZE_CLASS;
+    }
+
+    // Look for the range (2^exponent, 2^(exponent+1)] containing the size.
+    while((1u << (exponent + 1)) < size)
+    {
+        ++exponent;
+    }
+
+    uint32_t base = 1u << exponent;
+    uint32_t step = base >> 2;
+    uint32_t steps = (size - base + step - 1) / step;
+    class_size = base + steps * step;
+    return 1 + (exponent - MIN_SIZE_CLASS_EXPONENT) * 4 + (steps - 1);
+}
 
 CacheChangePool::~CacheChangePool()
 {
@@ -39,9 +83,17 @@ CacheChangePool::~CacheChangePool()
     {
         delete(*it);
     }
+    for(std::vector<CacheChange_t*>& recycled : m_recycledCaches)
+    {
+        for(CacheChange_t* ch : recycled)
+        {
+            delete(ch);
+        }
+    }
 }
 
 CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy) :
+    m_recycled_count(0),
     memoryMode(memoryPolicy)
 {
     //Common for all modes: Set the payload size (maximum allowed), size and size limit
@@ -151,51 +203,33 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
-            ch->kind = ALIVE;
-            ch->sequenceNumber.high = 0;
-            ch->sequenceNumber.low = 0;
-            ch->writerGUID = c_Guid_Unknown;
-            ch->serializedPayload.length = 0;
-            ch->serializedPayload.pos = 0;
-            for(uint8_t i=0;i<16;++i)
-                ch->instanceHandle.value[i] = 0;
-            ch->isRead = 0;
-            ch->sourceTimestamp.seconds(0);
-            ch->sourceTimestamp.fraction(0);
-            m_freeCaches.push_back(ch);
-            break;
         case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
-            ch->kind = ALIVE;
-            ch->sequenceNumber.high = 0;
-            ch->sequenceNumber.low = 0;
-            ch->writerGUID = c_Guid_Unknown;
-            ch->serializedPayload.length = 0;
-            ch->serializedPayload.pos = 0;
-            for(uint8_t i=0;i<16;++i)
-                ch->instanceHandle.value[i] = 0;
-            ch->isRead = 0;
-            ch->sourceTimestamp.seconds(0);
-            ch->sourceTimestamp.fraction(0);
+            resetCache(ch);
             m_freeCaches.push_back(ch);
             break;
         case DYNAMIC_RESERVE_MEMORY_MODE:
-            // Find pointer in CacheChange vector, remove element, then delete it
-            std::vector<CacheChange_t*>::iterator target = m_allCaches.begin();
-            target = find(m_allCaches.begin(),m_allCaches.end(), ch);
-            if(target != m_allCaches.end())
-            {
-                m_allCaches.erase(target);
-            }else{
-                logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
-                break;
-            }
-            delete(ch);
-            --m_pool_size;
+            releaseSingle(ch);
             break;
-
     }
 }
 
+void CacheChangePool::resetCache(CacheChange_t* ch)
+{
+    ch->kind = ALIVE;
+    ch->sequenceNumber.high = 0;
+    ch->sequenceNumber.low = 0;
+    ch->writerGUID = c_Guid_Unknown;
+    ch->serializedPayload.stop_sharing();
+    ch->serializedPayload.length = 0;
+    ch->serializedPayload.pos = 0;
+    for(uint8_t i=0;i<16;++i)
+        ch->instanceHandle.value[i] = 0;
+    ch->isRead = 0;
+    ch->sourceTimestamp.seconds(0);
+    ch->sourceTimestamp.fraction(0);
+    ch->setFragmentSize(0);
+}
+
 bool CacheChangePool::allocateGroup(uint32_t group_size)
 {
     // This method should only called from within PREALLOCATED_MEMORY_MODE
@@ -236,36 +270,90 @@ CacheChange_t* CacheChangePool::allocateSingle(uint32_t dataSize)
     /*
      *   In Dynamic Memory Mode CacheChanges are only allocated when they are needed.
      *   This means when the buffer of the message receiver is copied into this struct, the size is allocated.
-     *   When the change is released and comes back to the pool, it is deallocated correspondingly.
+     *   When the change is released and comes back to the pool, it is kept for reuse in m_recycledCaches under the
+     *   size class of its payload, as long as there are not more recycled changes than changes in use. Otherwise it
+     *   is deallocated.
      *
      *   In Preallocated mode, changes are allocated with a static maximum size and then they are dealt as
-     *   they are needed. In Dynamic mode, they are only allocated when they are needed. In Dynamic mode only
-     *   the m_allCaches vector is used, in order to keep track of all the changes that are dealt for destruction
-     *   purposes.
+     *   they are needed. In Dynamic mode, they are only allocated when they are needed. In Dynamic mode the
+     *   m_allCaches vector only keeps track of the changes in use, for destruction purposes. Each change stores its
+     *   position in this vector, so it can be removed in constant time.
      *
      */
-    bool added = false;
     CacheChange_t*ch = nullptr;
 
     // This method should only be called from within DYNAMIC_RESERVE_MEMORY_MODE
     assert(memoryMode == DYNAMIC_RESERVE_MEMORY_MODE);
 
-    if((m_max_pool_size == 0) | (m_pool_size < m_max_pool_size)) { //If no limit or curren changes < max changes
-        ++m_pool_size;
-        ch = new CacheChange_t(dataSize);
-        m_allCaches.push_back(ch);
-        added = true;
-    }
-
-    if(!added)
+    if((m_max_pool_size != 0) && (m_pool_size >= m_max_pool_size)) //If there is a limit and it has been reached
     {
         logWarning(RTPS_HISTORY, "Maximum number of allowed reserved caches reached");
         return NULL;
     }
 
+    uint32_t class_size = 0;
+    size_t index = size_class(dataSize, class_size);
+    if(index < m_recycledCaches.size() && !m_recycledCaches[index].empty())
+    {
+        ch = m_recycledCaches[index].back();
+        m_recycledCaches[index].pop_back();
+        --m_recycled_count;
+    }
+    else
+    {
+        ch = new CacheChange_t(class_size);
+    }
+
+    ++m_pool_size;
+    ch->pool_index_ = (uint32_t)m_allCaches.size();
+    m_allCaches.push_back(ch);
+
     return ch;
 }
 
+void CacheChangePool::releaseSingle(CacheChange_t* ch)
+{
+    // This method should only be called from within DYNAMIC_RESERVE_MEMORY_MODE
+    assert(memoryMode == DYNAMIC_RESERVE_MEMORY_MODE);
+
+    if(ch->pool_index_ >= m_allCaches.size() || m_allCaches[ch->pool_index_] != ch)
+    {
+        logInfo(RTPS_UTILS,"Tried to release a CacheChange that is not logged in the Pool");
+        return;
+    }
+
+    // Move the last change in use to the position of the released one.
+    CacheChange_t* last = m_allCaches.back();
+    last->pool_index_ = ch->pool_index_;
+    m_allCaches[ch->pool_index_] = last;
+    m_allCaches.pop_back();
+    --m_pool_size;
+
+    resetCache(ch);
+
+    // Recycle the change under the biggest size class its payload is able to hold.
+    uint32_t max_size = ch->serializedPayload.max_size;
+    uint32_t class_size = 0;
+    size_t index = size_class(max_size, class_size);
+    if(index != NO_SIZE_CLASS && class_size > max_size)
+    {
+        index = (index == 0) ? NO_SIZE_CLASS : index - 1;
+    }
+
+    if(index == NO_SIZE_CLASS || m_recycled_count > m_pool_size)
+    {
+        delete(ch);
+        return;
+    }
+
+    if(index >= m_recycledCaches.size())
+    {
+        m_recycledCaches.resize(index + 1);
+    }
+    m_recycledCaches[index].push_back(ch);
+    ++m_recycled_count;
+}
+
 }
 } /* namespace rtps */
 } /* namespace eprosima */
@@ -33,6 +33,7 @@ namespace rtps {
 
 History::History(const HistoryAttributes & att)
     : m_att(att)
+    , m_changesHead(0)
     , m_isHistoryFull(false)
     , mp_invalidCache(nullptr)
     , m_changePool(att.initialReservedCaches,att.payloadMaxSize,att.maximumReservedCaches,att.memoryPolicy)
@@ -66,13 +67,13 @@ bool History::remove_all_changes()
     }
 
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
-    if(!m_changes.empty())
+    if(changesBegin() != changesEnd())
     {
-        while(!m_changes.empty())
+        while(changesBegin() != changesEnd())
         {
-            remove_change(m_changes.front());
+            remove_change(*changesBegin());
         }
-        m_changes.clear();
+        clear_changes_nts();
         m_isHistoryFull = false;
         updateMaxMinSeqNum();
         return true;
@@ -114,7 +115,7 @@ bool History::get_change(
 
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
 
-    for (std::vector<CacheChange_t*>::iterator it = m_changes.begin(); it != m_changes.end(); ++it)
+    for (std::vector<CacheChange_t*>::iterator it = changesBegin(); it != changesEnd(); ++it)
     {
         if ((*it)->writerGUID == guid)
         {
@@ -143,15 +144,40 @@ bool History::get_earliest_change(CacheChange_t **change)
 
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
 
-    if (m_changes.empty())
+    if (changesBegin() == changesEnd())
     {
         return false;
     }
 
-    *change = m_changes.front();
+    *change = *changesBegin();
     return true;
 }
 
+std::vector<CacheChange_t*>::iterator History::erase_change_nts(std::vector<CacheChange_t*>::iterator position)
+{
+    if(position != changesBegin())
+    {
+        return m_changes.erase(position);
+    }
+
+    // The oldest pointer is left behind, and only the remaining ones are moved once they are no more than the
+    // removed ones. This keeps the removal of the oldest change in amortized constant time.
+    ++m_changesHead;
+    if(2 * m_changesHead >= m_changes.size())
+    {
+        m_changes.erase(m_changes.begin(), changesBegin());
+        m_changesHead = 0;
+    }
+
+    return changesBegin();
+}
+
+void History::clear_changes_nts()
+{
+    m_changes.clear();
+    m_changesHead = 0;
+}
+
 }
 }
 }
@@ -167,8 +193,8 @@ namespace rtps{
 void History::print_changes_seqNum2()
 {
     std::stringstream ss;
-    for(std::vector<CacheChange_t*>::iterator it = m_changes.begin();
-            it!=m_changes.end();++it)
+    for(std::vector<CacheChange_t*>::iterator it = changesBegin();
+            it!=changesEnd();++it)
     {
         ss << (*it)->sequenceNumber << "-";
     }
@@ -24,16 +24,32 @@
 #include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+static bool change_timestamp_cmp(
+        const CacheChange_t* c1,
+        const CacheChange_t* c2)
+{
+    return c1->sourceTimestamp < c2->sourceTimestamp;
+}
+
+static bool change_sequence_cmp(
+        const CacheChange_t* c1,
+        const CacheChange_t* c2)
+{
+    return c1->sequenceNumber < c2->sequenceNumber;
+}
+
 ReaderHistory::ReaderHistory(const HistoryAttributes& att)
     : History(att)
     , mp_reader(nullptr)
     , mp_semaphore(new Semaphore(0))
+    , m_isSortedBySeqNum(true)
 {
 }
 
@@ -70,9 +86,35 @@ bool ReaderHistory::add_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"The Writer GUID_t must be defined");
     }
 
-    m_changes.push_back(a_change);
-    sortCacheChanges();
-    updateMaxMinSeqNum();
+    // Changes usually arrive ordered by timestamp, so appending is the common case.
+    // Otherwise the insertion point is found with a binary search, keeping m_changes sorted.
+    std::vector<CacheChange_t*>::iterator position;
+    if(changesBegin() == changesEnd() || !change_timestamp_cmp(a_change, m_changes.back()))
+    {
+        m_changes.push_back(a_change);
+        position = changesEnd() - 1;
+    }
+    else
+    {
+        position = m_changes.insert(
+            std::upper_bound(changesBegin(), changesEnd(), a_change, change_timestamp_cmp), a_change);
+    }
+
+    if(m_isSortedBySeqNum &&
+            ((position != changesBegin() && change_sequence_cmp(a_change, *(position - 1))) ||
+            (position + 1 != changesEnd() && change_sequence_cmp(*(position + 1), a_change))))
+    {
+        m_isSortedBySeqNum = false;
+    }
+
+    if(mp_minSeqCacheChange == mp_invalidCache || a_change->sequenceNumber < mp_minSeqCacheChange->sequenceNumber)
+    {
+        mp_minSeqCacheChange = a_change;
+    }
+    if(mp_maxSeqCacheChange == mp_invalidCache || !(a_change->sequenceNumber < mp_maxSeqCacheChange->sequenceNumber))
+    {
+        mp_maxSeqCacheChange = a_change;
+    }
     logInfo(RTPS_HISTORY, "Change " << a_change->sequenceNumber << " added with " << a_change->serializedPayload.length << " bytes");
 
     return true;
@@ -92,25 +134,57 @@ bool ReaderHistory::remove_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"Pointer is not valid")
         return false;
     }
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    auto is_same_change = [a_change](const CacheChange_t* ch)
     {
-        if((*chit)->sequenceNumber == a_change->sequenceNumber &&
-                (*chit)->writerGUID == a_change->writerGUID)
+        return ch->sequenceNumber == a_change->sequenceNumber && ch->writerGUID == a_change->writerGUID;
+    };
+
+    // m_changes is sorted by timestamp, so first look only among the changes sharing its timestamp.
+    auto range = std::equal_range(changesBegin(), changesEnd(), a_change, change_timestamp_cmp);
+    auto chit = std::find_if(range.first, range.second, is_same_change);
+    if(chit == range.second)
+    {
+        chit = std::find_if(changesBegin(), changesEnd(), is_same_change);
+    }
+
+    if(chit != changesEnd())
+    {
+        bool update_min_max = (*chit == mp_minSeqCacheChange || *chit == mp_maxSeqCacheChange);
+
+        logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
+        mp_reader->change_removed_by_history(a_change);
+        release_removed_change(a_change);
+        erase_change_nts(chit);
+        if(changesBegin() == changesEnd())
+        {
+            mp_minSeqCacheChange = mp_invalidCache;
+            mp_maxSeqCacheChange = mp_invalidCache;
+            m_isSortedBySeqNum = true;
+        }
+        else if(update_min_max)
         {
-            logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
-            mp_reader->change_removed_by_history(a_change);
-            m_changePool.release_Cache(a_change);
-            m_changes.erase(chit);
-            sortCacheChanges();
-            updateMaxMinSeqNum();
-            return true;
+            if(m_isSortedBySeqNum)
+            {
+                // The neighbours of the removed change are the new minimum or maximum.
+                mp_minSeqCacheChange = *changesBegin();
+                mp_maxSeqCacheChange = m_changes.back();
+            }
+            else
+            {
+                updateMaxMinSeqNum();
+            }
         }
+        return true;
     }
     logWarning(RTPS_HISTORY,"SequenceNumber "<<a_change->sequenceNumber << " not found");
     return false;
 }
 
+void ReaderHistory::release_removed_change(CacheChange_t* a_change)
+{
+    m_changePool.release_Cache(a_change);
+}
+
 bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
 {
     std::vector<CacheChange_t*> changes_to_remove;
@@ -123,7 +197,7 @@ bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
 
     {//Lock scope
         std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
-        for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin(); chit!=m_changes.end();++chit)
+        for(std::vector<CacheChange_t*>::iterator chit = changesBegin(); chit!=changesEnd();++chit)
         {
             bool matches = true;
             unsigned int size = a_guid.guidPrefix.size;
@@ -156,25 +230,24 @@ bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
 
 void ReaderHistory::sortCacheChanges()
 {
-    std::sort(m_changes.begin(),
-              m_changes.end(),
-              [](CacheChange_t* c1, CacheChange_t* c2){ return c1->sourceTimestamp < c2->sourceTimestamp; });
+    std::sort(changesBegin(), changesEnd(), change_timestamp_cmp);
+    updateMaxMinSeqNum();
 }
 
 void ReaderHistory::updateMaxMinSeqNum()
 {
-    if(m_changes.size()==0)
+    if(changesBegin() == changesEnd())
     {
         mp_minSeqCacheChange = mp_invalidCache;
         mp_maxSeqCacheChange = mp_invalidCache;
+        m_isSortedBySeqNum = true;
     }
     else
     {
-        auto minmax = std::minmax_element(m_changes.begin(),
-                                          m_changes.end(),
-                                          [](CacheChange_t* c1, CacheChange_t* c2){ return c1->sequenceNumber < c2->sequenceNumber; });
+        auto minmax = std::minmax_element(changesBegin(), changesEnd(), change_sequence_cmp);
         mp_minSeqCacheChange = *(minmax.first);
         mp_maxSeqCacheChange = *(minmax.second);
+        m_isSortedBySeqNum = std::is_sorted(changesBegin(), changesEnd(), change_sequence_cmp);
     }
 }
 
@@ -195,7 +268,7 @@ bool ReaderHistory::get_min_change_from(
     bool ret = false;
     *min_change = nullptr;
 
-    for(auto it = m_changes.begin(); it != m_changes.end(); ++it)
+    for(auto it = changesBegin(); it != changesEnd(); ++it)
     {
         if((*it)->writerGUID == writerGuid)
         {
@@ -93,7 +93,7 @@ bool WriterHistory::add_change_(CacheChange_t* a_change, WriteParams &wparams,
 
     m_changes.push_back(a_change);
 
-    if(static_cast<int32_t>(m_changes.size()) == m_att.maximumReservedCaches)
+    if(static_cast<int32_t>(getHistorySize()) == m_att.maximumReservedCaches)
     {
         m_isHistoryFull = true;
     }
@@ -129,14 +129,14 @@ bool WriterHistory::remove_change(CacheChange_t* a_change)
         return false;
     }
 
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    for(std::vector<CacheChange_t*>::iterator chit = changesBegin();
+            chit!=changesEnd();++chit)
     {
         if((*chit)->sequenceNumber == a_change->sequenceNumber)
         {
             mp_writer->change_removed_by_history(a_change);
             m_changePool.release_Cache(a_change);
-            m_changes.erase(chit);
+            erase_change_nts(chit);
             updateMaxMinSeqNum();
             m_isHistoryFull = false;
             return true;
@@ -161,14 +161,14 @@ bool WriterHistory::remove_change(const SequenceNumber_t& sequence_number)
 
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
 
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    for(std::vector<CacheChange_t*>::iterator chit = changesBegin();
+            chit!=changesEnd();++chit)
     {
         if((*chit)->sequenceNumber == sequence_number)
         {
             mp_writer->change_removed_by_history(*chit);
             m_changePool.release_Cache(*chit);
-            m_changes.erase(chit);
+            erase_change_nts(chit);
             updateMaxMinSeqNum();
             m_isHistoryFull = false;
             return true;
@@ -189,14 +189,14 @@ CacheChange_t* WriterHistory::remove_change_and_reuse(const SequenceNumber_t& se
 
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
 
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+    for(std::vector<CacheChange_t*>::iterator chit = changesBegin();
+            chit!=changesEnd();++chit)
     {
         if((*chit)->sequenceNumber == sequence_number)
         {
             CacheChange_t* change = *chit;
             mp_writer->change_removed_by_history(change);
-            m_changes.erase(chit);
+            erase_change_nts(chit);
             updateMaxMinSeqNum();
             m_isHistoryFull = false;
             return change;
@@ -209,14 +209,14 @@ CacheChange_t* WriterHistory::remove_change_and_reuse(const SequenceNumber_t& se
 
 void WriterHistory::updateMaxMinSeqNum()
 {
-    if(m_changes.size()==0)
+    if(changesBegin() == changesEnd())
     {
         mp_minSeqCacheChange = mp_invalidCache;
         mp_maxSeqCacheChange = mp_invalidCache;
     }
     else
     {
-        mp_minSeqCacheChange = m_changes.front();
+        mp_minSeqCacheChange = *changesBegin();
         mp_maxSeqCacheChange = m_changes.back();
     }
 }
@@ -232,7 +232,7 @@ bool WriterHistory::remove_min_change()
     }
 
     std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
-    if(m_changes.size() > 0 && remove_change_g(mp_minSeqCacheChange))
+    if(changesBegin() != changesEnd() && remove_change_g(mp_minSeqCacheChange))
     {
         updateMaxMinSeqNum();
         return true;
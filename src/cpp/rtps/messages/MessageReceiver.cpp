@@ -34,6 +34,7 @@
 
 #include <mutex>
 
+#include <algorithm>
 #include <limits>
 #include <cassert>
 
@@ -81,6 +82,7 @@ MessageReceiver::~MessageReceiver()
 void MessageReceiver::associateEndpoint(Endpoint *to_add){
     bool found = false;
     std::lock_guard<std::mutex> guard(mtx);
+    const EntityId_t& entityId = to_add->getGuid().entityId;
     if(to_add->getAttributes().endpointKind == WRITER)
     {
         for(auto it = AssociatedWriters.begin(); it != AssociatedWriters.end(); ++it)
@@ -91,7 +93,11 @@ void MessageReceiver::associateEndpoint(Endpoint *to_add){
                 break;
             }
         }
-        if(!found) AssociatedWriters.push_back((RTPSWriter*)to_add);
+        if(!found)
+        {
+            AssociatedWriters.push_back((RTPSWriter*)to_add);
+            writers_by_entity_id_[entityId].push_back((RTPSWriter*)to_add);
+        }
     }
     else
     {
@@ -103,13 +109,42 @@ void MessageReceiver::associateEndpoint(Endpoint *to_add){
                 break;
             }
         }
-        if(!found) AssociatedReaders.push_back((RTPSReader*)to_add);
+        if(!found)
+        {
+            RTPSReader* reader = (RTPSReader*)to_add;
+            AssociatedReaders.push_back(reader);
+            readers_by_entity_id_[entityId].push_back(reader);
+
+            EntityId_t unknown = c_EntityId_Unknown;
+            if(reader->acceptMsgDirectedTo(unknown))
+            {
+                readers_accepting_unknown_.push_back(reader);
+            }
+        }
     }
     return;
 }
+
+template<typename T>
+static void remove_from_index(std::unordered_map<EntityId_t, std::vector<T*>>& index, const EntityId_t& entityId,
+        T* endpoint)
+{
+    auto index_it = index.find(entityId);
+    if(index_it != index.end())
+    {
+        std::vector<T*>& endpoints = index_it->second;
+        endpoints.erase(std::remove(endpoints.begin(), endpoints.end(), endpoint), endpoints.end());
+        if(endpoints.empty())
+        {
+            index.erase(index_it);
+        }
+    }
+}
+
 void MessageReceiver::removeEndpoint(Endpoint *to_remove){
 
     std::lock_guard<std::mutex> guard(mtx);
+    const EntityId_t& entityId = to_remove->getGuid().entityId;
     if(to_remove->getAttributes().endpointKind == WRITER){
         RTPSWriter* var = (RTPSWriter *)to_remove;
         for(auto it=AssociatedWriters.begin(); it !=AssociatedWriters.end(); ++it){
@@ -118,6 +153,7 @@ void MessageReceiver::removeEndpoint(Endpoint *to_remove){
                 break;
             }
         }
+        remove_from_index(writers_by_entity_id_, entityId, var);
     }else{
         RTPSReader *var = (RTPSReader *)to_remove;
         for(auto it=AssociatedReaders.begin(); it !=AssociatedReaders.end(); ++it){
@@ -126,10 +162,30 @@ void MessageReceiver::removeEndpoint(Endpoint *to_remove){
                 break;
             }
         }
+        remove_from_index(readers_by_entity_id_, entityId, var);
+        readers_accepting_unknown_.erase(
+                std::remove(readers_accepting_unknown_.begin(), readers_accepting_unknown_.end(), var),
+                readers_accepting_unknown_.end());
     }
     return;
 }
 
+const std::vector<RTPSReader*>* MessageReceiver::find_readers_directed_to(const EntityId_t& readerId) const
+{
+    if(readerId == c_EntityId_Unknown)
+    {
+        return readers_accepting_unknown_.empty() ? nullptr : &readers_accepting_unknown_;
+    }
+
+    auto it = readers_by_entity_id_.find(readerId);
+    return it != readers_by_entity_id_.end() ? &it->second : nullptr;
+}
+
+const std::vector<RTPSWriter*>* MessageReceiver::find_writers_with_id(const EntityId_t& writerId) const
+{
+    auto it = writers_by_entity_id_.find(writerId);
+    return it != writers_by_entity_id_.end() ? &it->second : nullptr;
+}
 
 void MessageReceiver::reset(){
     destVersion = c_ProtocolVersion;
@@ -451,25 +507,18 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
 
-    RTPSReader* firstReader = nullptr;
     if(AssociatedReaders.empty())
     {
-        logWarning(RTPS_MSG_IN,IDSTRING"Data received when NO readers are listening");
+        logWarningDeferred(RTPS_MSG_IN, "(ID:", std::this_thread::get_id(),
+                ") Data received when NO readers are listening");
         return false;
     }
 
-    for(std::vector<RTPSReader*>::iterator it=AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    const std::vector<RTPSReader*>* readers = find_readers_directed_to(readerID);
+    if(readers == nullptr) //Reader not found
     {
-        if((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-    if(firstReader == nullptr) //Reader not found
-    {
-        logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " <<readerID << ")");
+        logWarningDeferred(RTPS_MSG_IN, "(ID:", std::this_thread::get_id(),
+                ") No Reader accepts this message (directed to: ", readerID, ")");
         return false;
     }
     //FOUND THE READER.
@@ -566,16 +615,24 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
     logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<AssociatedReaders.size());
-    //Look for the correct reader to add the change
-    for(std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    // When several readers receive the change, they share a single copy of the payload instead of copying it
+    // from the receive buffer each one.
+    if(readers->size() > 1 && ch.serializedPayload.length > 0)
     {
-        if((*it)->acceptMsgDirectedTo(readerID))
-        {
-            (*it)->processDataMsg(&ch);
-        }
+        SharedPayloadBuffer* buffer = SharedPayloadBuffer::create(ch.serializedPayload.data,
+                ch.serializedPayload.length);
+        ch.serializedPayload.data = nullptr;
+        ch.serializedPayload.share(buffer);
+        buffer->release();
+    }
+
+    //Add the change to the readers it is directed to
+    for(RTPSReader* reader : *readers)
+    {
+        reader->processDataMsg(&ch);
     }
 
+    ch.serializedPayload.stop_sharing();
     //TODO(Ricardo) If a exception is thrown (ex, by fastcdr), this line is not executed -> segmentation fault
     ch.serializedPayload.data = nullptr;
 
@@ -619,24 +676,16 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
     if(AssociatedReaders.empty())
     {
-        logWarning(RTPS_MSG_IN, IDSTRING"Data received when NO readers are listening");
+        logWarningDeferred(RTPS_MSG_IN, "(ID:", std::this_thread::get_id(),
+                ") Data received when NO readers are listening");
         return false;
     }
 
-    RTPSReader* firstReader = nullptr;
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if ((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-
-    if (firstReader == nullptr) //Reader not found
+    const std::vector<RTPSReader*>* readers = find_readers_directed_to(readerID);
+    if (readers == nullptr) //Reader not found
     {
-        logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " << readerID << ")");
+        logWarningDeferred(RTPS_MSG_IN, "(ID:", std::this_thread::get_id(),
+                ") No Reader accepts this message (directed to: ", readerID, ")");
         return false;
     }
 
@@ -709,10 +758,8 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
         {
             ch.serializedPayload.length = payload_size;
 
-            // TODO Mejorar el reubicar el vector de fragmentos.
-            ch.setFragmentSize(fragmentSize);
-            ch.getDataFragments()->clear();
-            ch.getDataFragments()->resize(fragmentsInSubmessage, ChangeFragmentStatus_t::PRESENT);
+            // The change only carries the fragments of this submessage.
+            ch.setFragmentSize(fragmentSize, fragmentsInSubmessage);
 
             ch.serializedPayload.data = &msg->buffer[msg->pos];
             ch.serializedPayload.length = payload_size;
@@ -756,14 +803,10 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
     logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << AssociatedReaders.size());
-    //Look for the correct reader to add the change
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    //Add the fragments to the readers they are directed to
+    for (RTPSReader* reader : *readers)
     {
-        if ((*it)->acceptMsgDirectedTo(readerID))
-        {
-            (*it)->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
-        }
+        reader->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
     }
 
     ch.serializedPayload.data = nullptr;
@@ -804,12 +847,12 @@ bool MessageReceiver::proc_Submsg_Heartbeat(CDRMessage_t* msg,SubmessageHeader_t
 
     std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    const std::vector<RTPSReader*>* readers = find_readers_directed_to(readerGUID.entityId);
+    if(readers != nullptr)
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
+        for (RTPSReader* reader : *readers)
         {
-            (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+            reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
         }
     }
     return true;
@@ -838,17 +881,20 @@ bool MessageReceiver::proc_Submsg_Acknack(CDRMessage_t* msg,SubmessageHeader_t*
 
     std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    const std::vector<RTPSWriter*>* writers = find_writers_with_id(writerGUID.entityId);
+    if(writers != nullptr)
     {
-        bool result;
-        if ((*it)->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
+        for (RTPSWriter* writer : *writers)
         {
-            if (!result)
+            bool result;
+            if (writer->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
             {
-                logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                if (!result)
+                {
+                    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                }
+                return result;
             }
-            return result;
         }
     }
     logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer (I loooked through "
@@ -879,12 +925,12 @@ bool MessageReceiver::proc_Submsg_Gap(CDRMessage_t* msg,SubmessageHeader_t* smh)
         return false;
 
     std::lock_guard<std::mutex> guard(mtx);
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    const std::vector<RTPSReader*>* readers = find_readers_directed_to(readerGUID.entityId);
+    if(readers != nullptr)
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
+        for (RTPSReader* reader : *readers)
         {
-            (*it)->processGapMsg(writerGUID, gapStart, gapList);
+            reader->processGapMsg(writerGUID, gapStart, gapList);
         }
     }
 
@@ -980,17 +1026,20 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
 
     std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    const std::vector<RTPSWriter*>* writers = find_writers_with_id(writerGUID.entityId);
+    if(writers != nullptr)
     {
-        bool result;
-        if ((*it)->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
+        for (RTPSWriter* writer : *writers)
         {
-            if (!result)
+            bool result;
+            if (writer->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
             {
-                logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                if (!result)
+                {
+                    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                }
+                return result;
             }
-            return result;
         }
     }
     logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer (I looked through "
@@ -1026,16 +1075,16 @@ bool MessageReceiver::proc_Submsg_HeartbeatFrag(CDRMessage_t*msg, SubmessageHead
 
     std::lock_guard<std::mutex> guard(mtx);
     //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        /* XXX TODO PROCESS
-           if ((*it)->acceptMsgDirectedTo(readerGUID.entityId))
-           {
-           (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
-           }
-           */
-    }
+    /* XXX TODO PROCESS
+       const std::vector<RTPSReader*>* readers = find_readers_directed_to(readerGUID.entityId);
+       if (readers != nullptr)
+       {
+       for (RTPSReader* reader : *readers)
+       {
+       reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+       }
+       }
+       */
 
     return true;
 }
@@ -147,7 +147,6 @@ RTPSMessageGroup::RTPSMessageGroup(
     : participant_(participant)
     , endpoint_(endpoint)
     , full_msg_(&msg_group.rtpsmsg_fullmsg_)
-    , submessage_msg_(&msg_group.rtpsmsg_submessage_)
     , currentBytesSent_(0)
     , fixed_destination_(false)
     , fixed_destination_locators_(nullptr)
@@ -165,8 +164,6 @@ RTPSMessageGroup::RTPSMessageGroup(
     // Init RTPS message.
     reset_to_header();
 
-    CDRMessage::initCDRMsg(submessage_msg_);
-
 #if HAVE_SECURITY
     CDRMessage::initCDRMsg(encrypt_msg_);
 #endif
@@ -286,12 +283,9 @@ void RTPSMessageGroup::send()
 #endif
         const LocatorList_t & destinations =
             fixed_destination_ ? *fixed_destination_locators_ : current_locators_;
-        for(const auto& lit : destinations)
+        if(!participant_->sendSync(msgToSend, endpoint_, destinations, max_blocking_time_point_))
         {
-            if(!participant_->sendSync(msgToSend, endpoint_, lit, max_blocking_time_point_))
-            {
-                throw timeout();
-            }
+            throw timeout();
         }
 
         currentBytesSent_ += msgToSend->length;
@@ -324,37 +318,44 @@ void RTPSMessageGroup::flush_and_reset(const LocatorList_t& locator_list,
 void RTPSMessageGroup::check_and_maybe_flush(const LocatorList_t& locator_list,
         const std::vector<GUID_t>& remote_endpoints)
 {
-    CDRMessage::initCDRMsg(submessage_msg_);
-
     if(!check_preconditions(locator_list, remote_endpoints))
         flush_and_reset(locator_list, remote_endpoints);
-
-    add_info_dst_in_buffer(submessage_msg_, remote_endpoints);
 }
 
-bool RTPSMessageGroup::insert_submessage(const std::vector<GUID_t>& remote_endpoints)
+template<typename SerializeFunctor>
+bool RTPSMessageGroup::add_submessage(const std::vector<GUID_t>& remote_endpoints, SerializeFunctor serialize)
 {
-    if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+    // Submessages are serialized in place at the end of the message being built. On failure the message is
+    // restored to its previous length, sent, and the submessage is serialized again at the beginning of a new one.
+    uint32_t previous_length = full_msg_->length;
+    GuidPrefix_t previous_dst = current_dst_;
+
+    full_msg_->pos = previous_length;
+    if(add_info_dst_in_buffer(full_msg_, remote_endpoints) && serialize(full_msg_))
+    {
+        return true;
+    }
+
+    full_msg_->pos = previous_length;
+    full_msg_->length = previous_length;
+    current_dst_ = previous_dst;
+
+    if(previous_length > RTPSMESSAGE_HEADER_SIZE)
     {
         // Retry
         flush();
 
         current_dst_ = c_GuidPrefix_Unknown;
 
-        if(!add_info_dst_in_buffer(full_msg_, remote_endpoints))
+        if(add_info_dst_in_buffer(full_msg_, remote_endpoints) && serialize(full_msg_))
         {
-            logError(RTPS_WRITER,"Cannot add INFO_DST submessage to the CDRMessage. Buffer too small");
-            return false;
+            return true;
         }
 
-        if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
-        {
-            logError(RTPS_WRITER,"Cannot add RTPS submesage to the CDRMessage. Buffer too small");
-            return false;
-        }
+        reset_to_header();
     }
 
-    return true;
+    return false;
 }
 
 bool RTPSMessageGroup::add_info_dst_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_endpoints)
@@ -364,7 +365,11 @@ bool RTPSMessageGroup::add_info_dst_in_buffer(CDRMessage_t* buffer, const std::v
     if ( (full_msg_->length == RTPSMESSAGE_HEADER_SIZE) &&
         participant_->security_attributes().is_rtps_protected && endpoint_->supports_rtps_protection())
     {
-        RTPSMessageCreator::addSubmessageInfoSRC(buffer, c_ProtocolVersion, c_VendorId_eProsima, participant_->getGuid().guidPrefix);
+        if(!RTPSMessageCreator::addSubmessageInfoSRC(buffer, c_ProtocolVersion, c_VendorId_eProsima,
+                    participant_->getGuid().guidPrefix))
+        {
+            return false;
+        }
     }
 #endif
 
@@ -373,66 +378,85 @@ bool RTPSMessageGroup::add_info_dst_in_buffer(CDRMessage_t* buffer, const std::v
         if (current_dst_ != fixed_destination_prefix_)
         {
             current_dst_ = fixed_destination_prefix_;
-            RTPSMessageCreator::addSubmessageInfoDST(buffer, current_dst_);
+            return RTPSMessageCreator::addSubmessageInfoDST(buffer, current_dst_);
         }
     }
     else if(remote_endpoints.size() == 1 && current_dst_ != remote_endpoints.at(0).guidPrefix)
     {
         current_dst_ = remote_endpoints.at(0).guidPrefix;
-        RTPSMessageCreator::addSubmessageInfoDST(buffer, current_dst_);
+        return RTPSMessageCreator::addSubmessageInfoDST(buffer, current_dst_);
     }
     else if(remote_endpoints.size() != 1 && current_dst_ != c_GuidPrefix_Unknown)
     {
         current_dst_ = c_GuidPrefix_Unknown;
-        RTPSMessageCreator::addSubmessageInfoDST(buffer, current_dst_);
+        return RTPSMessageCreator::addSubmessageInfoDST(buffer, current_dst_);
     }
 
     return true;
 }
 
-bool RTPSMessageGroup::add_info_ts_in_buffer(const std::vector<GUID_t>& remote_readers, const Time_t &timestamp)
+bool RTPSMessageGroup::add_info_ts_in_buffer(CDRMessage_t* buffer, const std::vector<GUID_t>& remote_readers,
+        const Time_t &timestamp)
 {
     (void)remote_readers;
     logInfo(RTPS_WRITER, "Sending INFO_TS message");
 
 #if HAVE_SECURITY
-    uint32_t from_buffer_position = submessage_msg_->pos;
+    uint32_t from_buffer_position = buffer->pos;
 #endif
 
-    if (!RTPSMessageCreator::addSubmessageInfoTS(submessage_msg_, timestamp, false))
+    if (!RTPSMessageCreator::addSubmessageInfoTS(buffer, timestamp, false))
     {
-        logError(RTPS_WRITER, "Cannot add INFO_TS submsg to the CDRMessage. Buffer too small");
         return false;
     }
 
 #if HAVE_SECURITY
     if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
     {
-        submessage_msg_->pos = from_buffer_position;
-        CDRMessage::initCDRMsg(encrypt_msg_);
-        if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
-                    endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
-        {
-            logError(RTPS_WRITER, "Cannot encrypt DATA submessage for writer " << endpoint_->getGuid());
-            return false;
-        }
+        return encode_submessage_in_buffer(buffer, from_buffer_position, remote_readers, WRITER);
+    }
+#endif
 
-        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
+    return true;
+}
+
+#if HAVE_SECURITY
+bool RTPSMessageGroup::encode_submessage_in_buffer(CDRMessage_t* buffer, uint32_t from_buffer_position,
+        const std::vector<GUID_t>& remote_endpoints, ENDPOINT_TYPE type)
+{
+    buffer->pos = from_buffer_position;
+    CDRMessage::initCDRMsg(encrypt_msg_);
+
+    if(type == WRITER)
+    {
+        if(!participant_->security_manager().encode_writer_submessage(*buffer, *encrypt_msg_,
+                    endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_endpoints))
         {
-            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-            submessage_msg_->pos = submessage_msg_->length;
+            logError(RTPS_WRITER, "Cannot encrypt submessage for writer " << endpoint_->getGuid());
+            return false;
         }
-        else
+    }
+    else
+    {
+        if(!participant_->security_manager().encode_reader_submessage(*buffer, *encrypt_msg_,
+                    endpoint_->getGuid(), remote_endpoints))
         {
-            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
+            logError(RTPS_READER, "Cannot encrypt submessage for reader " << endpoint_->getGuid());
             return false;
         }
     }
-#endif
 
+    if((buffer->max_size - from_buffer_position) < encrypt_msg_->length)
+    {
+        return false;
+    }
+
+    memcpy(&buffer->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
+    buffer->length = from_buffer_position + encrypt_msg_->length;
+    buffer->pos = buffer->length;
     return true;
 }
+#endif
 
 bool RTPSMessageGroup::add_data(
         const CacheChange_t& change,
@@ -445,8 +469,6 @@ bool RTPSMessageGroup::add_data(
     // Check preconditions. If fail flush and reset.
     check_and_maybe_flush(locators, remote_readers);
 
-    add_info_ts_in_buffer(remote_readers, change.sourceTimestamp);
-
     InlineQosWriter* inlineQos = nullptr;
     if(expectsInlineQos)
     {
@@ -454,47 +476,42 @@ bool RTPSMessageGroup::add_data(
         //inlineQos = W->getInlineQos();
     }
 
-#if HAVE_SECURITY
-    uint32_t from_buffer_position = submessage_msg_->pos;
-#endif
     const EntityId_t& readerId = get_entity_id(remote_readers);
 
     // TODO (Ricardo). Check to create special wrapper.
 
-    if(!RTPSMessageCreator::addSubmessageData(submessage_msg_, &change, endpoint_->getAttributes().topicKind,
-                readerId, expectsInlineQos, inlineQos))
-    {
-        logError(RTPS_WRITER, "Cannot add DATA submsg to the CDRMessage. Buffer too small");
-        return false;
-    }
+    if(!add_submessage(remote_readers, [&](CDRMessage_t* msg)
+            {
+                if(!add_info_ts_in_buffer(msg, remote_readers, change.sourceTimestamp))
+                {
+                    return false;
+                }
 
 #if HAVE_SECURITY
-    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
-    {
-        submessage_msg_->pos = from_buffer_position;
-        CDRMessage::initCDRMsg(encrypt_msg_);
-        if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
-                    endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
-        {
-            logError(RTPS_WRITER, "Cannot encrypt DATA submessage for writer " << endpoint_->getGuid());
-            return false;
-        }
+                uint32_t from_buffer_position = msg->pos;
+#endif
 
-        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-        {
-            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-            submessage_msg_->pos = submessage_msg_->length;
-        }
-        else
-        {
-            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-            return false;
-        }
-    }
+                if(!RTPSMessageCreator::addSubmessageData(msg, &change, endpoint_->getAttributes().topicKind,
+                            readerId, expectsInlineQos, inlineQos))
+                {
+                    return false;
+                }
+
+#if HAVE_SECURITY
+                if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+                {
+                    return encode_submessage_in_buffer(msg, from_buffer_position, remote_readers, WRITER);
+                }
 #endif
 
-    return insert_submessage(remote_readers);
+                return true;
+            }))
+    {
+        logError(RTPS_WRITER, "Cannot add DATA submsg to the CDRMessage. Buffer too small");
+        return false;
+    }
+
+    return true;
 }
 
 bool RTPSMessageGroup::add_data_frag(
@@ -509,8 +526,6 @@ bool RTPSMessageGroup::add_data_frag(
     // Check preconditions. If fail flush and reset.
     check_and_maybe_flush(locators, remote_readers);
 
-    add_info_ts_in_buffer(remote_readers, change.sourceTimestamp);
-
     InlineQosWriter* inlineQos = NULL;
     if(expectsInlineQos)
     {
@@ -518,9 +533,6 @@ bool RTPSMessageGroup::add_data_frag(
         //inlineQos = W->getInlineQos();
     }
 
-#if HAVE_SECURITY
-    uint32_t from_buffer_position = submessage_msg_->pos;
-#endif
     const EntityId_t& readerId = get_entity_id(remote_readers);
 
     // Calculate fragment start
@@ -532,69 +544,70 @@ bool RTPSMessageGroup::add_data_frag(
     // TODO (Ricardo). Check to create special wrapper.
     CacheChange_t change_to_add;
     change_to_add.copy_not_memcpy(&change);
-    change_to_add.serializedPayload.data = change.serializedPayload.data + fragment_start;
-    change_to_add.serializedPayload.length = fragment_size;
+
+    bool added = add_submessage(remote_readers, [&](CDRMessage_t* msg)
+            {
+                if(!add_info_ts_in_buffer(msg, remote_readers, change.sourceTimestamp))
+                {
+                    return false;
+                }
 
 #if HAVE_SECURITY
-    if(endpoint_->getAttributes().security_attributes().is_payload_protected)
-    {
-        SerializedPayload_t encrypt_payload;
-        encrypt_payload.data = encrypt_msg_->buffer;
-        encrypt_payload.max_size = encrypt_msg_->max_size;
+                uint32_t from_buffer_position = msg->pos;
+#endif
 
-        // If payload protection, encode payload
-        if(!participant_->security_manager().encode_serialized_payload(change_to_add.serializedPayload,
-                    encrypt_payload, endpoint_->getGuid()))
-        {
-            logError(RTPS_WRITER, "Error encoding change " << change.sequenceNumber);
-            change_to_add.serializedPayload.data = nullptr;
-            encrypt_payload.data = nullptr;
-            return false;
-        }
+                change_to_add.serializedPayload.data = change.serializedPayload.data + fragment_start;
+                change_to_add.serializedPayload.length = fragment_size;
 
-        change_to_add.serializedPayload.data = encrypt_msg_->buffer;
-        encrypt_payload.data = nullptr;
-        change_to_add.serializedPayload.length = encrypt_payload.length;
-    }
+#if HAVE_SECURITY
+                // The payload is encoded on every attempt, as encrypt_msg_ is reused to encode the submessage.
+                if(endpoint_->getAttributes().security_attributes().is_payload_protected)
+                {
+                    SerializedPayload_t encrypt_payload;
+                    encrypt_payload.data = encrypt_msg_->buffer;
+                    encrypt_payload.max_size = encrypt_msg_->max_size;
+
+                    // If payload protection, encode payload
+                    bool encoded = participant_->security_manager().encode_serialized_payload(
+                            change_to_add.serializedPayload, encrypt_payload, endpoint_->getGuid());
+                    encrypt_payload.data = nullptr;
+                    if(!encoded)
+                    {
+                        logError(RTPS_WRITER, "Error encoding change " << change.sequenceNumber);
+                        return false;
+                    }
+
+                    change_to_add.serializedPayload.data = encrypt_msg_->buffer;
+                    change_to_add.serializedPayload.length = encrypt_payload.length;
+                }
 #endif
 
-    if(!RTPSMessageCreator::addSubmessageDataFrag(submessage_msg_, &change_to_add, fragment_number,
-                change.serializedPayload.length, endpoint_->getAttributes().topicKind, readerId,
-                expectsInlineQos, inlineQos))
-    {
-        logError(RTPS_WRITER, "Cannot add DATA_FRAG submsg to the CDRMessage. Buffer too small");
-        change_to_add.serializedPayload.data = NULL;
-        return false;
-    }
-    change_to_add.serializedPayload.data = NULL;
+                if(!RTPSMessageCreator::addSubmessageDataFrag(msg, &change_to_add, fragment_number,
+                            change.serializedPayload.length, endpoint_->getAttributes().topicKind, readerId,
+                            expectsInlineQos, inlineQos))
+                {
+                    return false;
+                }
 
 #if HAVE_SECURITY
-    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
-    {
-        submessage_msg_->pos = from_buffer_position;
-        CDRMessage::initCDRMsg(encrypt_msg_);
-        if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
-                    endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
-        {
-            logError(RTPS_WRITER, "Cannot encrypt DATA submessage for writer " << endpoint_->getGuid());
-            return false;
-        }
+                if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+                {
+                    return encode_submessage_in_buffer(msg, from_buffer_position, remote_readers, WRITER);
+                }
+#endif
 
-        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-        {
-            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-            submessage_msg_->pos = submessage_msg_->length;
-        }
-        else
-        {
-            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-            return false;
-        }
+                return true;
+            });
+
+    change_to_add.serializedPayload.data = NULL;
+
+    if(!added)
+    {
+        logError(RTPS_WRITER, "Cannot add DATA_FRAG submsg to the CDRMessage. Buffer too small");
+        return false;
     }
-#endif
 
-    return insert_submessage(remote_readers);
+    return true;
 }
 
 bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers, const SequenceNumber_t& firstSN,
@@ -603,46 +616,35 @@ bool RTPSMessageGroup::add_heartbeat(const std::vector<GUID_t>& remote_readers,
 {
     check_and_maybe_flush(locators, remote_readers);
 
+    const EntityId_t& readerId = get_entity_id(remote_readers);
+
+    if(!add_submessage(remote_readers, [&](CDRMessage_t* msg)
+            {
 #if HAVE_SECURITY
-    uint32_t from_buffer_position = submessage_msg_->pos;
+                uint32_t from_buffer_position = msg->pos;
 #endif
 
-    const EntityId_t& readerId = get_entity_id(remote_readers);
+                if(!RTPSMessageCreator::addSubmessageHeartbeat(msg, readerId, endpoint_->getGuid().entityId,
+                            firstSN, lastSN, count, isFinal, livelinessFlag))
+                {
+                    return false;
+                }
 
-    if(!RTPSMessageCreator::addSubmessageHeartbeat(submessage_msg_, readerId, endpoint_->getGuid().entityId,
-                firstSN, lastSN, count, isFinal, livelinessFlag))
+#if HAVE_SECURITY
+                if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+                {
+                    return encode_submessage_in_buffer(msg, from_buffer_position, remote_readers, WRITER);
+                }
+#endif
+
+                return true;
+            }))
     {
         logError(RTPS_WRITER, "Cannot add HEARTBEAT submsg to the CDRMessage. Buffer too small");
         return false;
     }
 
-#if HAVE_SECURITY
-    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
-    {
-        submessage_msg_->pos = from_buffer_position;
-        CDRMessage::initCDRMsg(encrypt_msg_);
-        if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
-                    endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
-        {
-            logError(RTPS_WRITER, "Cannot encrypt HEARTBEAT submessage for writer " << endpoint_->getGuid());
-            return false;
-        }
-
-        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-        {
-            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-            submessage_msg_->pos = submessage_msg_->length;
-        }
-        else
-        {
-            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-            return false;
-        }
-    }
-#endif
-
-    return insert_submessage(remote_readers);
+    return true;
 }
 
 // TODO (Ricardo) Check with standard 8.3.7.4.5
@@ -660,47 +662,33 @@ bool RTPSMessageGroup::add_gap(std::set<SequenceNumber_t>& changesSeqNum,
         // Check preconditions. If fail flush and reset.
         check_and_maybe_flush(locators, remote_readers);
 
+        const EntityId_t& readerId = get_entity_id(remote_readers);
+
+        if(!add_submessage(remote_readers, [&](CDRMessage_t* msg)
+                {
 #if HAVE_SECURITY
-        uint32_t from_buffer_position = submessage_msg_->pos;
+                    uint32_t from_buffer_position = msg->pos;
 #endif
 
-        const EntityId_t& readerId = get_entity_id(remote_readers);
-
-        if(!RTPSMessageCreator::addSubmessageGap(submessage_msg_, seqit->first, seqit->second,
-                readerId, endpoint_->getGuid().entityId))
-        {
-            logError(RTPS_WRITER, "Cannot add GAP submsg to the CDRMessage. Buffer too small");
-            break;
-        }
+                    if(!RTPSMessageCreator::addSubmessageGap(msg, seqit->first, seqit->second,
+                                readerId, endpoint_->getGuid().entityId))
+                    {
+                        return false;
+                    }
 
 #if HAVE_SECURITY
-        if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
-        {
-            submessage_msg_->pos = from_buffer_position;
-            CDRMessage::initCDRMsg(encrypt_msg_);
-            if(!participant_->security_manager().encode_writer_submessage(*submessage_msg_, *encrypt_msg_,
-                        endpoint_->getGuid(), fixed_destination_ ? *fixed_destination_guids_ : remote_readers))
-            {
-                logError(RTPS_WRITER, "Cannot encrypt DATA submessage for writer " << endpoint_->getGuid());
-                return false;
-            }
-
-            if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-            {
-                memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-                submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-                submessage_msg_->pos = submessage_msg_->length;
-            }
-            else
-            {
-                logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-                return false;
-            }
-        }
+                    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+                    {
+                        return encode_submessage_in_buffer(msg, from_buffer_position, remote_readers, WRITER);
+                    }
 #endif
 
-        if(!insert_submessage(remote_readers))
+                    return true;
+                }))
+        {
+            logError(RTPS_WRITER, "Cannot add GAP submsg to the CDRMessage. Buffer too small");
             break;
+        }
 
         ++gap_n;
         ++seqit;
@@ -717,44 +705,33 @@ bool RTPSMessageGroup::add_acknack(const std::vector<GUID_t>& remote_writers, Se
 
     check_and_maybe_flush(locators, remote_writers);
 
+    if(!add_submessage(remote_writers, [&](CDRMessage_t* msg)
+            {
 #if HAVE_SECURITY
-    uint32_t from_buffer_position = submessage_msg_->pos;
+                uint32_t from_buffer_position = msg->pos;
 #endif
 
-    if(!RTPSMessageCreator::addSubmessageAcknack(submessage_msg_, endpoint_->getGuid().entityId,
-                remote_writers.front().entityId, SNSet, count, finalFlag))
-    {
-        logError(RTPS_READER, "Cannot add ACKNACK submsg to the CDRMessage. Buffer too small");
-        return false;
-    }
+                if(!RTPSMessageCreator::addSubmessageAcknack(msg, endpoint_->getGuid().entityId,
+                            remote_writers.front().entityId, SNSet, count, finalFlag))
+                {
+                    return false;
+                }
 
 #if HAVE_SECURITY
-    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
-    {
-        submessage_msg_->pos = from_buffer_position;
-        CDRMessage::initCDRMsg(encrypt_msg_);
-        if(!participant_->security_manager().encode_reader_submessage(*submessage_msg_, *encrypt_msg_,
-                    endpoint_->getGuid(), remote_writers))
-        {
-            logError(RTPS_READER, "Cannot encrypt ACKNACK submessage for writer " << endpoint_->getGuid());
-            return false;
-        }
+                if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+                {
+                    return encode_submessage_in_buffer(msg, from_buffer_position, remote_writers, READER);
+                }
+#endif
 
-        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-        {
-            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-            submessage_msg_->pos = submessage_msg_->length;
-        }
-        else
-        {
-            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-            return false;
-        }
+                return true;
+            }))
+    {
+        logError(RTPS_READER, "Cannot add ACKNACK submsg to the CDRMessage. Buffer too small");
+        return false;
     }
-#endif
 
-    return insert_submessage(remote_writers);
+    return true;
 }
 
 bool RTPSMessageGroup::add_nackfrag(const std::vector<GUID_t>& remote_writers, SequenceNumber_t& writerSN,
@@ -765,44 +742,33 @@ bool RTPSMessageGroup::add_nackfrag(const std::vector<GUID_t>& remote_writers, S
 
     check_and_maybe_flush(locators, remote_writers);
 
+    if(!add_submessage(remote_writers, [&](CDRMessage_t* msg)
+            {
 #if HAVE_SECURITY
-    uint32_t from_buffer_position = submessage_msg_->pos;
+                uint32_t from_buffer_position = msg->pos;
 #endif
 
-    if(!RTPSMessageCreator::addSubmessageNackFrag(submessage_msg_, endpoint_->getGuid().entityId,
-                remote_writers.front().entityId, writerSN, fnState, count))
-    {
-        logError(RTPS_READER, "Cannot add ACKNACK submsg to the CDRMessage. Buffer too small");
-        return false;
-    }
+                if(!RTPSMessageCreator::addSubmessageNackFrag(msg, endpoint_->getGuid().entityId,
+                            remote_writers.front().entityId, writerSN, fnState, count))
+                {
+                    return false;
+                }
 
 #if HAVE_SECURITY
-    if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
-    {
-        submessage_msg_->pos = from_buffer_position;
-        CDRMessage::initCDRMsg(encrypt_msg_);
-        if(!participant_->security_manager().encode_reader_submessage(*submessage_msg_, *encrypt_msg_,
-                    endpoint_->getGuid(), remote_writers))
-        {
-            logError(RTPS_READER, "Cannot encrypt ACKNACK submessage for writer " << endpoint_->getGuid());
-            return false;
-        }
+                if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
+                {
+                    return encode_submessage_in_buffer(msg, from_buffer_position, remote_writers, READER);
+                }
+#endif
 
-        if((submessage_msg_->max_size - from_buffer_position) >= encrypt_msg_->length)
-        {
-            memcpy(&submessage_msg_->buffer[from_buffer_position], encrypt_msg_->buffer, encrypt_msg_->length);
-            submessage_msg_->length = from_buffer_position + encrypt_msg_->length;
-            submessage_msg_->pos = submessage_msg_->length;
-        }
-        else
-        {
-            logError(RTPS_OUT, "Not enough memory to copy encrypted data for " << endpoint_->getGuid());
-            return false;
-        }
+                return true;
+            }))
+    {
+        logError(RTPS_READER, "Cannot add NACKFRAG submsg to the CDRMessage. Buffer too small");
+        return false;
     }
-#endif
 
-    return insert_submessage(remote_writers);
+    return true;
 }
 
 } /* namespace rtps */
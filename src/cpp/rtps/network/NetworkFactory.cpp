@@ -128,17 +128,26 @@ LocatorList_t NetworkFactory::ShrinkLocatorLists(const std::vector<LocatorList_t
 {
     LocatorList_t returnedList;
 
+    // Endpoints reachable through shared memory are not sent to through the other transports.
+    std::vector<bool> shared_memory_only;
+    shared_memory_only.reserve(locatorLists.size());
+    for(auto& locatorList : locatorLists)
+    {
+        shared_memory_only.push_back(has_local_shared_memory_locator(locatorList));
+    }
+
     for(auto& transport : mRegisteredTransports)
     {
         std::vector<LocatorList_t> transportLocatorLists;
 
-        for(auto& locatorList : locatorLists)
+        for(size_t i = 0; i < locatorLists.size(); ++i)
         {
+            const LocatorList_t& locatorList = locatorLists[i];
             LocatorList_t resultList;
 
             for(auto it = locatorList.begin(); it != locatorList.end(); ++it)
             {
-                if(transport->IsLocatorSupported(*it))
+                if(transport->IsLocatorSupported(*it) && (!shared_memory_only[i] || it->kind == LOCATOR_KIND_SHM))
                 {
                     resultList.push_back(*it);
                 }
@@ -151,6 +160,19 @@ LocatorList_t NetworkFactory::ShrinkLocatorLists(const std::vector<LocatorList_t
     return returnedList;
 }
 
+bool NetworkFactory::has_local_shared_memory_locator(const LocatorList_t& locators) const
+{
+    for(auto it = locators.begin(); it != locators.end(); ++it)
+    {
+        if(it->kind == LOCATOR_KIND_SHM && is_local_locator(*it))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool NetworkFactory::is_local_locator(const Locator_t& locator) const
 {
     for(auto& transport : mRegisteredTransports)
@@ -120,6 +120,11 @@ ResourceEvent& RTPSParticipant::get_resource_event() const
     return mp_impl->getEventResource();
 }
 
+bool RTPSParticipant::flush_persistence()
+{
+    return mp_impl->flush_persistence();
+}
+
 } /* namespace rtps */
 } /* namespace fastrtps */
 } /* namespace eprosima */
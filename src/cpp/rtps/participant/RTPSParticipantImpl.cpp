@@ -84,6 +84,8 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     : m_att(PParam)
     , m_guid(guidP ,c_EntityId_RTPSParticipant)
     , mp_event_thr(nullptr)
+    , async_writer_scheduler_(new AsyncWriterScheduler(PParam.asyncWriterThreads))
+    , local_delivery_queue_(new LocalDeliveryQueue())
     , mp_builtinProtocols(nullptr)
     , mp_ResourceSemaphore(new Semaphore(0))
     , IdCounter(0)
@@ -278,6 +280,8 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     delete(this->mp_userParticipant);
     send_resource_list_.clear();
 
+    async_writer_scheduler_.reset();
+    local_delivery_queue_.reset();
     delete(this->mp_event_thr);
     delete(this->mp_mutex);
 }
@@ -666,6 +670,25 @@ bool RTPSParticipantImpl::existsEntityId(const EntityId_t& ent,EndpointKind_t ki
     return false;
 }
 
+RTPSReader* RTPSParticipantImpl::find_local_reader(const GUID_t& reader_guid) const
+{
+    if (reader_guid.guidPrefix != m_guid.guidPrefix)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    for (RTPSReader* reader : m_userReaderList)
+    {
+        if (reader->getGuid().entityId == reader_guid.entityId)
+        {
+            return reader;
+        }
+    }
+
+    return nullptr;
+}
+
 
 /*
  *
@@ -919,6 +942,9 @@ bool RTPSParticipantImpl::deleteUserEndpoint(Endpoint* p_endpoint)
 #endif
         }
     }
+    // Endpoints are unpaired at this point, so no more deliveries from or to this one can be queued.
+    local_delivery_queue_->remove_endpoint(p_endpoint);
+
     //	std::lock_guard<std::recursive_mutex> guardEndpoint(*p_endpoint->getMutex());
     delete(p_endpoint);
     return true;
@@ -981,6 +1007,28 @@ bool RTPSParticipantImpl::sendSync(
     return ret_code;
 }
 
+bool RTPSParticipantImpl::sendSync(
+        CDRMessage_t* msg,
+        Endpoint* /*pend*/,
+        const LocatorList_t& destination_locators,
+        std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    bool ret_code = false;
+    std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_, std::defer_lock);
+
+    if(lock.try_lock_until(max_blocking_time_point))
+    {
+        ret_code = true;
+
+        for (auto& send_resource : send_resource_list_)
+        {
+            send_resource->send(msg->buffer, msg->length, destination_locators);
+        }
+    }
+
+    return ret_code;
+}
+
 void RTPSParticipantImpl::setGuid(GUID_t& guid)
 {
     m_guid = guid;
@@ -1131,6 +1179,32 @@ bool RTPSParticipantImpl::get_remote_reader_info(const GUID_t& readerGuid, Reade
     return false;
 }
 
+bool RTPSParticipantImpl::flush_persistence()
+{
+    std::vector<RTPSWriter*> writers;
+    std::vector<RTPSReader*> readers;
+    {
+        std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+        writers = m_allWriterList;
+        readers = m_allReaderList;
+    }
+
+    // The endpoints wait for their persistence services without blocking the participant.
+    bool ret_val = true;
+
+    for (RTPSWriter* writer : writers)
+    {
+        ret_val = writer->flush_persistence() && ret_val;
+    }
+
+    for (RTPSReader* reader : readers)
+    {
+        ret_val = reader->flush_persistence() && ret_val;
+    }
+
+    return ret_val;
+}
+
 IPersistenceService* RTPSParticipantImpl::get_persistence_service(const EndpointAttributes& param)
 {
     IPersistenceService* ret_val;
@@ -45,6 +45,9 @@
 #include <fastrtps/rtps/network/SenderResource.h>
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 
+#include "../resources/AsyncWriterScheduler.h"
+#include "../resources/LocalDeliveryQueue.h"
+
 #if HAVE_SECURITY
 #include <fastrtps/rtps/security/accesscontrol/ParticipantSecurityAttributes.h>
 #include "../security/SecurityManager.h"
@@ -178,6 +181,22 @@ public:
             const Locator_t& destination_loc,
             std::chrono::steady_clock::time_point& max_blocking_time_point);
 
+    /**
+     * Send a message to a list of locators.
+     * Each send resource is given the whole list, so transports able to send to several destinations with one
+     * operation can do so.
+     * @param msg Message to be sent.
+     * @param pend Endpoint sending the message.
+     * @param destination_locators List of destination locators.
+     * @param max_blocking_time_point Maximum time to wait for the send resources to be available.
+     * @return False when the send resources were not available before max_blocking_time_point.
+     */
+    bool sendSync(
+            CDRMessage_t* msg,
+            Endpoint *pend,
+            const LocatorList_t& destination_locators,
+            std::chrono::steady_clock::time_point& max_blocking_time_point);
+
     //!Get the participant Mutex
     std::recursive_mutex* getParticipantMutex() const { return mp_mutex; };
 
@@ -207,6 +226,13 @@ public:
         */
     const std::vector<RTPSReader*>& getAllReaders() const;
 
+    /**
+     * Look for a user reader of this participant.
+     * @param reader_guid GUID of the reader.
+     * @return Pointer to the reader, or nullptr when it is not a user reader of this participant.
+     */
+    RTPSReader* find_local_reader(const GUID_t& reader_guid) const;
+
     uint32_t getMaxMessageSize() const;
 
     uint32_t getMaxDataSize();
@@ -236,10 +262,23 @@ public:
 
     bool get_remote_reader_info(const GUID_t& readerGuid, ReaderProxyData& returnedInfo);
 
+    /**
+     * Wait until the persistence services of all the endpoints have stored their pending operations.
+     * The participant mutex is not held while waiting, so the endpoints must not be deleted meanwhile.
+     * @return True if all the pending operations were successfully stored.
+     */
+    bool flush_persistence();
+
     NetworkFactory& network_factory() { return m_network_Factory; }
 
     uint32_t get_min_network_send_buffer_size() { return m_network_Factory.get_min_send_buffer_size(); }
 
+    //!Get the scheduler of the asynchronous writes of the writers of this participant.
+    AsyncWriterScheduler& async_writer_scheduler() const { return *async_writer_scheduler_; }
+
+    //!Get the queue of the deliveries of the writers of this participant to its readers.
+    LocalDeliveryQueue& local_delivery_queue() const { return *local_delivery_queue_; }
+
 private:
     //!Attributes of the RTPSParticipant
     RTPSParticipantAttributes m_att;
@@ -249,6 +288,10 @@ private:
     // ResourceSend* mp_send_thr;
     //! Event Resource
     ResourceEvent* mp_event_thr;
+    //! Scheduler of the asynchronous writes
+    std::unique_ptr<AsyncWriterScheduler> async_writer_scheduler_;
+    //! Deliveries to readers of this participant
+    std::unique_ptr<LocalDeliveryQueue> local_delivery_queue_;
     //! BuiltinProtocols of this RTPSParticipant
     BuiltinProtocols* mp_builtinProtocols;
     //!Semaphore to wait for the listen thread creation.
@@ -38,7 +38,7 @@ IPersistenceService* PersistenceFactory::create_persistence_service(const Proper
             const std::string* filename_property = PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.filename");
             const char* filename = (filename_property == nullptr) ?
                 "persistence.db" : filename_property->c_str();
-            ret_val = create_SQLite3_persistence_service(filename);
+            ret_val = create_SQLite3_persistence_service(filename, property_policy);
         }
     }
 
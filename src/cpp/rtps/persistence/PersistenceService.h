@@ -79,6 +79,13 @@ public:
      */
     virtual bool update_writer_seq_on_storage(const std::string& reader_guid, const GUID_t& writer_guid, const SequenceNumber_t& seq_number) = 0;
 
+    /**
+     * Wait until all the operations requested so far are stored.
+     * Implementations that store every operation before returning from it do not need to override this method.
+     * @return True if all the operations were successfully stored.
+     */
+    virtual bool flush() { return true; }
+
 };
 
 /**
@@ -23,6 +23,7 @@
 
 #include "sqlite3.h"
 
+#include <algorithm>
 #include <string.h>
 
 namespace eprosima {
@@ -82,19 +83,97 @@ static void finalize_statement(sqlite3_stmt*& stmt)
     }
 }
 
-IPersistenceService* create_SQLite3_persistence_service(const char* filename)
+static bool get_uint_property(const PropertyPolicy& property_policy, const char* name, uint32_t& value)
 {
+    const std::string* property = PropertyPolicyHelper::find_property(property_policy, name);
+    if (property != nullptr)
+    {
+        char* end = nullptr;
+        unsigned long parsed = strtoul(property->c_str(), &end, 10);
+        if (property->empty() || *end != '\0' || parsed > UINT32_MAX)
+        {
+            logError(RTPS_PERSISTENCE, "Invalid value '" << *property << "' for property " << name);
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+    }
+
+    return true;
+}
+
+static bool get_pragma_property(const PropertyPolicy& property_policy, const char* name,
+        const std::vector<std::string>& allowed_values, std::string& value)
+{
+    const std::string* property = PropertyPolicyHelper::find_property(property_policy, name);
+    if (property != nullptr)
+    {
+        std::string upper(*property);
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        if (std::find(allowed_values.begin(), allowed_values.end(), upper) == allowed_values.end())
+        {
+            logError(RTPS_PERSISTENCE, "Invalid value '" << *property << "' for property " << name);
+            return false;
+        }
+        value = upper;
+    }
+
+    return true;
+}
+
+IPersistenceService* create_SQLite3_persistence_service(const char* filename, const PropertyPolicy& property_policy)
+{
+    SQLite3PersistenceConfiguration config;
+    if (!get_uint_property(property_policy, "dds.persistence.sqlite3.batch_size", config.batch_size) ||
+        !get_uint_property(property_policy, "dds.persistence.sqlite3.batch_period_ms", config.batch_period_ms) ||
+        !get_uint_property(property_policy, "dds.persistence.sqlite3.max_queued", config.max_queued) ||
+        !get_pragma_property(property_policy, "dds.persistence.sqlite3.journal_mode",
+            {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"}, config.journal_mode) ||
+        !get_pragma_property(property_policy, "dds.persistence.sqlite3.synchronous",
+            {"OFF", "NORMAL", "FULL", "EXTRA"}, config.synchronous))
+    {
+        return nullptr;
+    }
+
     sqlite3* db = open_or_create_database(filename);
-    return (db == NULL) ? nullptr : new SQLite3PersistenceService(db);
+    if (db == NULL)
+    {
+        return nullptr;
+    }
+
+    if (!config.journal_mode.empty())
+    {
+        std::string pragma = "PRAGMA journal_mode=" + config.journal_mode + ";";
+        if (sqlite3_exec(db, pragma.c_str(), 0, 0, 0) != SQLITE_OK)
+        {
+            logWarning(RTPS_PERSISTENCE, "Cannot set journal mode " << config.journal_mode);
+        }
+    }
+
+    if (!config.synchronous.empty())
+    {
+        std::string pragma = "PRAGMA synchronous=" + config.synchronous + ";";
+        if (sqlite3_exec(db, pragma.c_str(), 0, 0, 0) != SQLITE_OK)
+        {
+            logWarning(RTPS_PERSISTENCE, "Cannot set synchronous level " << config.synchronous);
+        }
+    }
+
+    return new SQLite3PersistenceService(db, config);
 }
 
-SQLite3PersistenceService::SQLite3PersistenceService(sqlite3* db):
+SQLite3PersistenceService::SQLite3PersistenceService(sqlite3* db, const SQLite3PersistenceConfiguration& config):
     db_(db),
     load_writer_stmt_(NULL),
     add_writer_change_stmt_(NULL),
     remove_writer_change_stmt_(NULL),
     load_reader_stmt_(NULL),
-    update_reader_stmt_(NULL)
+    update_reader_stmt_(NULL),
+    config_(config),
+    queued_count_(0),
+    committed_count_(0),
+    flush_target_(0),
+    commit_ok_(true),
+    running_(false)
 {
     // Prepare writer statements
     sqlite3_prepare_v3(db_,"SELECT seq_num,instance,payload FROM writers WHERE guid=?;",-1,SQLITE_PREPARE_PERSISTENT,&load_writer_stmt_,NULL);
@@ -104,10 +183,30 @@ SQLite3PersistenceService::SQLite3PersistenceService(sqlite3* db):
     // Prepare reader statements
     sqlite3_prepare_v3(db_, "SELECT writer_guid_prefix,writer_guid_entity,seq_num FROM readers WHERE guid=?;", -1, SQLITE_PREPARE_PERSISTENT, &load_reader_stmt_, NULL);
     sqlite3_prepare_v3(db_, "INSERT OR REPLACE INTO readers VALUES(?,?,?,?);", -1, SQLITE_PREPARE_PERSISTENT, &update_reader_stmt_, NULL);
+
+    // Start the background thread on batched mode
+    if (config_.batch_size > 1)
+    {
+        config_.max_queued = (std::max)(config_.max_queued, config_.batch_size);
+        queue_.reserve(config_.max_queued);
+        running_ = true;
+        thread_ = std::thread(&SQLite3PersistenceService::run, this);
+    }
 }
 
 SQLite3PersistenceService::~SQLite3PersistenceService()
 {
+    // Commit the pending operations and stop the background thread
+    if (thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(queue_mutex_);
+            running_ = false;
+        }
+        work_cv_.notify_one();
+        thread_.join();
+    }
+
     // Finalize writer statements
     finalize_statement(load_writer_stmt_);
     finalize_statement(add_writer_change_stmt_);
@@ -130,6 +229,15 @@ bool SQLite3PersistenceService::load_writer_from_storage(const std::string& pers
 {
     logInfo(RTPS_PERSISTENCE, "Loading writer " << writer_guid);
 
+    // Queued operations should be taken into account. A failed commit is kept to be reported by flush().
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (!wait_for_commits(lock))
+        {
+            logError(RTPS_PERSISTENCE, "Loading writer " << writer_guid << " after a failed commit");
+        }
+    }
+
     if (load_writer_stmt_ != NULL)
     {
         sqlite3_reset(load_writer_stmt_);
@@ -169,20 +277,41 @@ bool SQLite3PersistenceService::add_writer_change_to_storage(const std::string&
 {
     logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " storing change for seq " << change.sequenceNumber);
 
+    if (thread_.joinable())
+    {
+        Operation operation;
+        operation.kind = Operation::ADD_WRITER_CHANGE;
+        operation.guid = persistence_guid;
+        operation.sequence_number = change.sequenceNumber;
+        operation.instance = change.instanceHandle;
+        operation.payload.assign(change.serializedPayload.data,
+                change.serializedPayload.data + change.serializedPayload.length);
+        enqueue(std::move(operation));
+        return true;
+    }
+
+    return store_writer_change(persistence_guid, change.sequenceNumber, change.instanceHandle,
+            change.serializedPayload.data, change.serializedPayload.length);
+}
+
+bool SQLite3PersistenceService::store_writer_change(const std::string& persistence_guid,
+        const SequenceNumber_t& sequence_number, const InstanceHandle_t& instance, const octet* payload,
+        uint32_t payload_length)
+{
     if (add_writer_change_stmt_ != NULL)
     {
         sqlite3_reset(add_writer_change_stmt_);
         sqlite3_bind_text(add_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(add_writer_change_stmt_, 2, change.sequenceNumber.to64long());
-        if (change.instanceHandle.isDefined())
+        sqlite3_bind_int64(add_writer_change_stmt_, 2, sequence_number.to64long());
+        if (instance.isDefined())
         {
-            sqlite3_bind_blob(add_writer_change_stmt_, 3, change.instanceHandle.value, 16, SQLITE_STATIC);
+            sqlite3_bind_blob(add_writer_change_stmt_, 3, instance.value, 16, SQLITE_STATIC);
         }
         else
         {
             sqlite3_bind_zeroblob(add_writer_change_stmt_, 3, 16);
         }
-        sqlite3_bind_blob(add_writer_change_stmt_, 4, change.serializedPayload.data, change.serializedPayload.length, SQLITE_STATIC);
+        sqlite3_bind_blob(add_writer_change_stmt_, 4, payload, payload_length, SQLITE_STATIC);
         return sqlite3_step(add_writer_change_stmt_) == SQLITE_DONE;
     }
 
@@ -198,11 +327,27 @@ bool SQLite3PersistenceService::remove_writer_change_from_storage(const std::str
 {
     logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " removing change for seq " << change.sequenceNumber);
 
+    if (thread_.joinable())
+    {
+        Operation operation;
+        operation.kind = Operation::REMOVE_WRITER_CHANGE;
+        operation.guid = persistence_guid;
+        operation.sequence_number = change.sequenceNumber;
+        enqueue(std::move(operation));
+        return true;
+    }
+
+    return delete_writer_change(persistence_guid, change.sequenceNumber);
+}
+
+bool SQLite3PersistenceService::delete_writer_change(const std::string& persistence_guid,
+        const SequenceNumber_t& sequence_number)
+{
     if (remove_writer_change_stmt_ != NULL)
     {
         sqlite3_reset(remove_writer_change_stmt_);
         sqlite3_bind_text(remove_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(remove_writer_change_stmt_, 2, change.sequenceNumber.to64long());
+        sqlite3_bind_int64(remove_writer_change_stmt_, 2, sequence_number.to64long());
         return sqlite3_step(remove_writer_change_stmt_) == SQLITE_DONE;
     }
 
@@ -218,6 +363,15 @@ bool SQLite3PersistenceService::load_reader_from_storage(const std::string& read
 {
     logInfo(RTPS_PERSISTENCE, "Loading reader " << reader_guid);
 
+    // Queued operations should be taken into account. A failed commit is kept to be reported by flush().
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (!wait_for_commits(lock))
+        {
+            logError(RTPS_PERSISTENCE, "Loading reader " << reader_guid << " after a failed commit");
+        }
+    }
+
     if (load_reader_stmt_ != NULL)
     {
         sqlite3_reset(load_reader_stmt_);
@@ -248,6 +402,23 @@ bool SQLite3PersistenceService::update_writer_seq_on_storage(const std::string&
 {
     logInfo(RTPS_PERSISTENCE, "Reader " << reader_guid << " setting seq for writer " << writer_guid << " to " << seq_number);
 
+    if (thread_.joinable())
+    {
+        Operation operation;
+        operation.kind = Operation::UPDATE_READER_SEQ;
+        operation.guid = reader_guid;
+        operation.writer_guid = writer_guid;
+        operation.sequence_number = seq_number;
+        enqueue(std::move(operation));
+        return true;
+    }
+
+    return store_writer_seq(reader_guid, writer_guid, seq_number);
+}
+
+bool SQLite3PersistenceService::store_writer_seq(const std::string& reader_guid, const GUID_t& writer_guid,
+        const SequenceNumber_t& seq_number)
+{
     if (update_reader_stmt_ != NULL)
     {
         sqlite3_reset(update_reader_stmt_);
@@ -261,6 +432,139 @@ bool SQLite3PersistenceService::update_writer_seq_on_storage(const std::string&
     return false;
 }
 
+bool SQLite3PersistenceService::flush()
+{
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+
+    bool ret_val = wait_for_commits(lock);
+    commit_ok_ = true;
+    return ret_val;
+}
+
+bool SQLite3PersistenceService::wait_for_commits(std::unique_lock<std::mutex>& lock)
+{
+    if (thread_.joinable())
+    {
+        uint64_t target = queued_count_;
+        if (committed_count_ < target)
+        {
+            flush_target_ = (std::max)(flush_target_, target);
+            work_cv_.notify_one();
+            done_cv_.wait(lock, [&]()
+                    {
+                        return committed_count_ >= target;
+                    });
+        }
+    }
+
+    return commit_ok_;
+}
+
+void SQLite3PersistenceService::enqueue(Operation&& operation)
+{
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+
+    done_cv_.wait(lock, [&]()
+            {
+                return queue_.size() < config_.max_queued;
+            });
+
+    if (queue_.empty())
+    {
+        oldest_queued_ = std::chrono::steady_clock::now();
+    }
+    queue_.push_back(std::move(operation));
+    ++queued_count_;
+
+    if (queue_.size() >= config_.batch_size)
+    {
+        work_cv_.notify_one();
+    }
+}
+
+void SQLite3PersistenceService::run()
+{
+    std::vector<Operation> batch;
+    batch.reserve(config_.max_queued);
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    while (running_ || !queue_.empty())
+    {
+        if (queue_.empty())
+        {
+            work_cv_.wait(lock);
+            continue;
+        }
+
+        // Wait for a full batch, the batch period to elapse, a flush or the destruction of the service.
+        auto deadline = oldest_queued_ + std::chrono::milliseconds(config_.batch_period_ms);
+        if (running_ && queue_.size() < config_.batch_size && committed_count_ >= flush_target_ &&
+                std::chrono::steady_clock::now() < deadline)
+        {
+            work_cv_.wait_until(lock, deadline);
+            continue;
+        }
+
+        // Commit all the queued operations. Callers waiting for room in the queue can go on meanwhile.
+        batch.swap(queue_);
+        done_cv_.notify_all();
+        lock.unlock();
+
+        bool ok = commit(batch);
+        size_t count = batch.size();
+        batch.clear();
+
+        lock.lock();
+        committed_count_ += count;
+        commit_ok_ = commit_ok_ && ok;
+        done_cv_.notify_all();
+    }
+}
+
+bool SQLite3PersistenceService::commit(std::vector<Operation>& batch)
+{
+    bool ret_val = true;
+
+    if (sqlite3_exec(db_, "BEGIN TRANSACTION;", 0, 0, 0) != SQLITE_OK)
+    {
+        logError(RTPS_PERSISTENCE, "Cannot begin transaction: " << sqlite3_errmsg(db_));
+        ret_val = false;
+    }
+
+    for (Operation& operation : batch)
+    {
+        bool ok = false;
+        switch (operation.kind)
+        {
+            case Operation::ADD_WRITER_CHANGE:
+                ok = store_writer_change(operation.guid, operation.sequence_number, operation.instance,
+                        operation.payload.data(), static_cast<uint32_t>(operation.payload.size()));
+                break;
+            case Operation::REMOVE_WRITER_CHANGE:
+                ok = delete_writer_change(operation.guid, operation.sequence_number);
+                break;
+            case Operation::UPDATE_READER_SEQ:
+                ok = store_writer_seq(operation.guid, operation.writer_guid, operation.sequence_number);
+                break;
+        }
+
+        if (!ok)
+        {
+            logError(RTPS_PERSISTENCE, "Cannot store operation for " << operation.guid << " seq " <<
+                operation.sequence_number << ": " << sqlite3_errmsg(db_));
+            ret_val = false;
+        }
+    }
+
+    if (sqlite3_exec(db_, "COMMIT;", 0, 0, 0) != SQLITE_OK)
+    {
+        logError(RTPS_PERSISTENCE, "Cannot commit transaction: " << sqlite3_errmsg(db_));
+        ret_val = false;
+    }
+
+    return ret_val;
+}
+
 } /* namespace rtps */
 } /* namespace fastrtps */
 } /* namespace eprosima */
@@ -22,15 +22,62 @@
 #include "PersistenceService.h"
 #include "sqlite3.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+* Configuration of the SQLite3 implementation of persistence service
+* @ingroup RTPS_PERSISTENCE_MODULE
+*/
+struct SQLite3PersistenceConfiguration
+{
+    /**
+     * Maximum number of operations committed in one transaction.
+     * When lower than 2, every operation is committed on its own before returning from it.
+     * Otherwise operations are queued and committed by a background thread.
+     * Property: dds.persistence.sqlite3.batch_size
+     */
+    uint32_t batch_size = 1;
+
+    /**
+     * Maximum time, in milliseconds, an operation waits in the queue before being committed.
+     * Property: dds.persistence.sqlite3.batch_period_ms
+     */
+    uint32_t batch_period_ms = 100;
+
+    /**
+     * Maximum number of operations waiting to be committed. Callers block while the queue is full.
+     * Property: dds.persistence.sqlite3.max_queued
+     */
+    uint32_t max_queued = 10000;
+
+    /**
+     * Journal mode of the database (DELETE, TRUNCATE, PERSIST, MEMORY, WAL or OFF). Empty keeps the default.
+     * Property: dds.persistence.sqlite3.journal_mode
+     */
+    std::string journal_mode;
+
+    /**
+     * Synchronous level of the database (OFF, NORMAL, FULL or EXTRA). Empty keeps the default.
+     * Property: dds.persistence.sqlite3.synchronous
+     */
+    std::string synchronous;
+};
+
 /**
 * Create a new SQLite3 implementation of persistence service
+* @param filename Name of the database file.
+* @param property_policy PropertyPolicy where the dds.persistence.sqlite3 configuration will be searched.
 * @ingroup RTPS_PERSISTENCE_MODULE
 */
-IPersistenceService* create_SQLite3_persistence_service(const char* filename);
+IPersistenceService* create_SQLite3_persistence_service(const char* filename, const PropertyPolicy& property_policy);
 
 
 /**
@@ -40,7 +87,7 @@ IPersistenceService* create_SQLite3_persistence_service(const char* filename);
 class SQLite3PersistenceService : public IPersistenceService
 {
 public:
-    SQLite3PersistenceService(sqlite3* db);
+    SQLite3PersistenceService(sqlite3* db, const SQLite3PersistenceConfiguration& config = SQLite3PersistenceConfiguration());
     virtual ~SQLite3PersistenceService() override;
 
     /**
@@ -80,7 +127,56 @@ public:
      */
     virtual bool update_writer_seq_on_storage(const std::string& reader_guid, const GUID_t& writer_guid, const SequenceNumber_t& seq_number) final;
 
+    /**
+     * Wait until all the queued operations are committed.
+     * @return True if all the operations committed so far were successful.
+     */
+    virtual bool flush() final;
+
 private:
+
+    //! Operation waiting to be committed in batched mode.
+    struct Operation
+    {
+        enum Kind
+        {
+            ADD_WRITER_CHANGE,
+            REMOVE_WRITER_CHANGE,
+            UPDATE_READER_SEQ
+        };
+
+        Kind kind;
+        std::string guid;
+        GUID_t writer_guid;
+        SequenceNumber_t sequence_number;
+        InstanceHandle_t instance;
+        std::vector<octet> payload;
+    };
+
+    bool store_writer_change(const std::string& persistence_guid, const SequenceNumber_t& sequence_number,
+            const InstanceHandle_t& instance, const octet* payload, uint32_t payload_length);
+
+    bool delete_writer_change(const std::string& persistence_guid, const SequenceNumber_t& sequence_number);
+
+    bool store_writer_seq(const std::string& reader_guid, const GUID_t& writer_guid,
+            const SequenceNumber_t& seq_number);
+
+    //! Queues an operation for the background thread, waiting while the queue is full.
+    void enqueue(Operation&& operation);
+
+    /**
+     * Waits until the operations queued so far are committed.
+     * The commit status is left untouched, so it is still reported by the next flush.
+     * @return True if all the operations committed since the last flush were successful.
+     */
+    bool wait_for_commits(std::unique_lock<std::mutex>& lock);
+
+    //! Main loop of the background thread.
+    void run();
+
+    //! Commits a batch of operations in one transaction.
+    bool commit(std::vector<Operation>& batch);
+
     sqlite3* db_;
 
     sqlite3_stmt* load_writer_stmt_;
@@ -89,6 +185,24 @@ private:
 
     sqlite3_stmt* load_reader_stmt_;
     sqlite3_stmt* update_reader_stmt_;
+
+    SQLite3PersistenceConfiguration config_;
+
+    std::mutex queue_mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::vector<Operation> queue_;
+    std::chrono::steady_clock::time_point oldest_queued_;
+    //! Number of operations queued since the creation of the service.
+    uint64_t queued_count_;
+    //! Number of operations committed since the creation of the service.
+    uint64_t committed_count_;
+    //! Number of queued operations a flush is waiting for.
+    uint64_t flush_target_;
+    //! False when some operation failed to be committed since the last flush.
+    bool commit_ok_;
+    bool running_;
+    std::thread thread_;
 };
 
 } /* namespace rtps */
@@ -16,34 +16,32 @@
 #include <fastrtps/rtps/common/CacheChange.h>
 #include <fastrtps/rtps/reader/RTPSReader.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace eprosima::fastrtps::rtps;
 
 CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change, uint32_t sampleSize, uint32_t fragmentStartingNum)
 {
-    CacheChange_t* returnedValue = nullptr;
-
-    // Search CacheChange_t with the sample sequence number.
-    auto range = changes_.equal_range(ChangeInPit(incoming_change));
+    if(incoming_change->getFragmentSize() == 0 || fragmentStartingNum == 0)
+        return nullptr;
 
-    auto original_change_cit = range.first;
+    CacheChange_t* original_change = nullptr;
 
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(original_change_cit != changes_.end())
+    // Consecutive fragments usually belong to the same change.
+    if(last_change_ != nullptr && last_change_->sequenceNumber == incoming_change->sequenceNumber &&
+            last_change_->writerGUID == incoming_change->writerGUID)
     {
-        for(; original_change_cit != range.second; ++original_change_cit)
-        {
-            if(original_change_cit->getChange()->writerGUID == incoming_change->writerGUID)
-                break;
-        }
+        original_change = last_change_;
     }
     else
-        original_change_cit = range.second;
+    {
+        original_change = find(incoming_change->sequenceNumber, incoming_change->writerGUID);
+    }
 
     // If not found an existing CacheChange_t, reserve one and insert.
-    if(original_change_cit == range.second)
+    if(original_change == nullptr)
     {
-        CacheChange_t* original_change = nullptr;
-
         if(!parent_->reserveCache(&original_change, sampleSize))
             return nullptr;
 
@@ -60,125 +58,128 @@ CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change,
         original_change->setFragmentSize(incoming_change->getFragmentSize());
 
         // Insert
-        original_change_cit = changes_.insert(ChangeInPit(original_change));
+        changes_[original_change->writerGUID][original_change->sequenceNumber] = original_change;
     }
 
+    last_change_ = original_change;
+
+    // Fragments of a different size than the first ones received cannot be placed.
+    uint32_t fragment_size = original_change->getFragmentSize();
+    if(incoming_change->getFragmentSize() != fragment_size)
+        return nullptr;
+
+    uint32_t first = fragmentStartingNum - 1;
+    uint32_t last = std::min(first + incoming_change->getFragmentCount(), original_change->getFragmentCount());
+
+    // The submessage has to carry all its fragments.
+    if(first >= last || std::min(last * fragment_size, original_change->serializedPayload.length) -
+            first * fragment_size > incoming_change->serializedPayload.length)
+        return nullptr;
+
+    // Consecutive fragments not received yet are copied at once. When fragments arrive in order, this is the whole
+    // submessage.
     bool was_updated = false;
-    for (uint32_t count = (fragmentStartingNum - 1); count < (fragmentStartingNum - 1) + incoming_change->getFragmentCount(); ++count)
+    uint32_t count = first;
+    while(count < last)
     {
-        if(original_change_cit->getChange()->getDataFragments()->at(count) == ChangeFragmentStatus_t::NOT_PRESENT)
+        if(!original_change->mark_fragment_received(count))
         {
-            // All cases minus last fragment.
-            if (count + 1 != original_change_cit->getChange()->getFragmentCount())
-            {
-                memcpy(original_change_cit->getChange()->serializedPayload.data + count * original_change_cit->getChange()->getFragmentSize(),
-                        incoming_change->serializedPayload.data + (count - (fragmentStartingNum - 1)) * incoming_change->getFragmentSize(), incoming_change->getFragmentSize());
-            }
-            // Last fragment is a special case when copying.
-            else
-            {
-                memcpy(original_change_cit->getChange()->serializedPayload.data + count * original_change_cit->getChange()->getFragmentSize(),
-                        incoming_change->serializedPayload.data + (count - (fragmentStartingNum - 1)) * incoming_change->getFragmentSize(), original_change_cit->getChange()->serializedPayload.length - (count * original_change_cit->getChange()->getFragmentSize()));
-            }
-
-            original_change_cit->getChange()->getDataFragments()->at(count) = ChangeFragmentStatus_t::PRESENT;
-
-            was_updated = true;
+            ++count;
+            continue;
         }
+
+        uint32_t run_end = count + 1;
+        while(run_end < last && original_change->mark_fragment_received(run_end))
+            ++run_end;
+
+        uint32_t offset = count * fragment_size;
+        memcpy(original_change->serializedPayload.data + offset,
+                incoming_change->serializedPayload.data + (count - first) * fragment_size,
+                std::min(run_end * fragment_size, original_change->serializedPayload.length) - offset);
+
+        was_updated = true;
+        count = run_end;
     }
 
-    // If was updated, check if it is completed.
-    if(was_updated)
+    // If it is completed, return CacheChange_t and remove information.
+    if(was_updated && original_change->is_fully_assembled())
     {
-        auto fit = original_change_cit->getChange()->getDataFragments()->begin();
-        for(; fit != original_change_cit->getChange()->getDataFragments()->end(); ++fit)
-        {
-            if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                break;
-        }
-
-        // If it is completed, return CacheChange_t and remove information.
-        if(fit == original_change_cit->getChange()->getDataFragments()->end())
-        {
-            returnedValue = original_change_cit->getChange();
-            changes_.erase(original_change_cit);
-        }
+        auto writer_changes = changes_.find(original_change->writerGUID);
+        remove(writer_changes, writer_changes->second.find(original_change->sequenceNumber), false);
+        return original_change;
     }
 
-    return returnedValue;
+    return nullptr;
 }
 
 CacheChange_t* FragmentedChangePitStop::find(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
-    CacheChange_t* returnedValue = nullptr;
-
-    auto range = changes_.equal_range(ChangeInPit(sequence_number));
+    auto writer_changes = changes_.find(writer_guid);
 
-    auto cit = range.first;
-
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(cit != changes_.end())
+    if(writer_changes != changes_.end())
     {
-        for(; cit != range.second; ++cit)
-        {
-            if(cit->getChange()->writerGUID == writer_guid)
-            {
-                returnedValue = cit->getChange();
-                break;
-            }
-        }
+        auto change_it = writer_changes->second.find(sequence_number);
+
+        if(change_it != writer_changes->second.end())
+            return change_it->second;
     }
 
-    return returnedValue;
+    return nullptr;
 }
 
 bool FragmentedChangePitStop::try_to_remove(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
-    bool returnedValue = false;
-
-    auto range = changes_.equal_range(ChangeInPit(sequence_number));
-
-    auto cit = range.first;
+    auto writer_changes = changes_.find(writer_guid);
 
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(cit != changes_.end())
+    if(writer_changes != changes_.end())
     {
-        for(; cit != range.second; ++cit)
+        auto change_it = writer_changes->second.find(sequence_number);
+
+        if(change_it != writer_changes->second.end())
         {
-            if(cit->getChange()->writerGUID == writer_guid)
-            {
-                // Destroy CacheChange_t.
-                parent_->releaseCache(cit->getChange());
-                changes_.erase(cit);
-                returnedValue = true;
-                break;
-            }
+            // Destroy CacheChange_t.
+            remove(writer_changes, change_it, true);
+            return true;
         }
     }
 
-    return returnedValue;
+    return false;
 }
 
 bool FragmentedChangePitStop::try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
     bool returnedValue = false;
 
-    auto cit = changes_.begin();
-    while(cit != changes_.end())
+    auto writer_changes = changes_.find(writer_guid);
+
+    // Changes are ordered, so only the first ones of the writer are checked.
+    while(writer_changes != changes_.end() && writer_changes->second.begin()->first < sequence_number)
     {
-        if(cit->getChange()->sequenceNumber < sequence_number &&
-                cit->getChange()->writerGUID == writer_guid)
-        {
-            // Destroy CacheChange_t.
-            parent_->releaseCache(cit->getChange());
-            cit = changes_.erase(cit);
-            returnedValue = true;
-        }
-        else
-        {
-            ++cit;
-        }
+        bool last_of_writer = writer_changes->second.size() == 1;
+
+        // Destroy CacheChange_t.
+        remove(writer_changes, writer_changes->second.begin(), true);
+        returnedValue = true;
+
+        if(last_of_writer)
+            break;
     }
 
     return returnedValue;
 }
+
+void FragmentedChangePitStop::remove(std::unordered_map<GUID_t, WriterChanges>::iterator writer_changes,
+        WriterChanges::iterator change_it, bool release)
+{
+    CacheChange_t* change = change_it->second;
+
+    if(change == last_change_)
+        last_change_ = nullptr;
+
+    writer_changes->second.erase(change_it);
+    if(writer_changes->second.empty())
+        changes_.erase(writer_changes);
+
+    if(release)
+        parent_->releaseCache(change);
+}
@@ -21,7 +21,8 @@
 #include <fastrtps/fastrtps_dll.h>
 #include <fastrtps/rtps/common/CacheChange.h>
 
-#include <unordered_set>
+#include <map>
+#include <unordered_map>
 
 namespace eprosima {
 namespace fastrtps {
@@ -32,71 +33,14 @@ class RTPSReader;
 
 /*!
  * @brief Manages not completed fragmented CacheChanges in reader side.
+ * Changes are indexed by writer GUID_t and SequenceNumber_t. The change which received the last fragment is looked
+ * up first, as consecutive fragments usually belong to the same sample.
  * @remarks This class is non thread-safe.
  */
 class FragmentedChangePitStop
 {
-    /*!
-     * @brief Objects used by FragmentedChangePitStop internally.
-     */
-    class ChangeInPit
-    {
-    public:
-
-        /*!
-         * @brief Relates a CacheChange_t with this ChangeInPit.
-         * This constructor has to be used if the ChangeInPit will be used to be stored in a container.
-         * @param change Related CacheChange_t.
-         */
-        ChangeInPit(CacheChange_t* change)
-            : sequence_number_(change->sequenceNumber)
-            , change_(change)
-        {
-        }
-
-        /*!
-         * @brief Constructor used to generated a simple key for searching in a container.
-         * @param sequence_number SequenceNumber_t used as key.
-         * @remarks Not use this constructor if the object will be stored in a container.
-         */
-        ChangeInPit(const SequenceNumber_t &sequence_number)
-            : sequence_number_(sequence_number)
-            , change_(nullptr)
-        {
-        }
-
-        ChangeInPit(const ChangeInPit& cip)
-            : sequence_number_(cip.sequence_number_)
-            , change_(cip.change_)
-        {
-        }
-
-        CacheChange_t* getChange() const { return change_; }
-
-        bool operator==(const ChangeInPit& cip) const
-        {
-            return sequence_number_ == cip.sequence_number_;
-        }
-
-    private:
-
-        ChangeInPit& operator=(const ChangeInPit& cip) = delete;
-
-        const SequenceNumber_t sequence_number_;
-        CacheChange_t* change_;
-
-    public:
-        /*!
-         * @brief Defined the STD hash function for ChangeInPit.
-         */
-        struct ChangeInPitHash
-        {
-            std::size_t operator()(const ChangeInPit& cip) const
-            {
-                return SequenceNumberHash{}(cip.sequence_number_);
-            }
-        };
-    };
+    //! Changes being reassembled for a writer, ordered by sequence number.
+    typedef std::map<SequenceNumber_t, CacheChange_t*> WriterChanges;
 
     public:
 
@@ -105,7 +49,7 @@ class FragmentedChangePitStop
  * @param parent RTPSReader managing this object.
  * It is necessary the access to reserve a new CacheChange_t.
  */
-FragmentedChangePitStop(RTPSReader *parent) : parent_(parent) {}
+FragmentedChangePitStop(RTPSReader *parent) : last_change_(nullptr), parent_(parent) {}
 
 /*!
  * @brief Process incomming fragments.
@@ -148,7 +92,19 @@ bool try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t&
 
 private:
 
-std::unordered_multiset<ChangeInPit, ChangeInPit::ChangeInPitHash> changes_;
+/*!
+ * @brief Removes a change from the indexes.
+ * @param writer_changes Iterator to the changes of the writer of the change.
+ * @param change_it Iterator to the change in writer_changes.
+ * @param release Whether the change has to be returned to the reader.
+ */
+void remove(std::unordered_map<GUID_t, WriterChanges>::iterator writer_changes, WriterChanges::iterator change_it,
+        bool release);
+
+std::unordered_map<GUID_t, WriterChanges> changes_;
+
+//! Change which received the last fragment.
+CacheChange_t* last_change_;
 
 RTPSReader* parent_;
 
@@ -53,6 +53,11 @@ void StatelessPersistentReader::set_last_notified(const GUID_t& writer_guid, con
     persistence_->update_writer_seq_on_storage(persistence_guid_, writer_guid, seq);
 }
 
+bool StatelessPersistentReader::flush_persistence()
+{
+    return persistence_->flush();
+}
+
 } /* namespace rtps */
 } /* namespace eprosima */
 }
@@ -23,7 +23,10 @@
 #include <fastrtps/log/Log.h>
 #include <fastrtps/utils/TimeConversion.h>
 
+#include <algorithm>
+#include <cassert>
 #include <mutex>
+#include <sstream>
 
 #include <fastrtps/rtps/reader/timedevent/HeartbeatResponseDelay.h>
 #include <fastrtps/rtps/reader/timedevent/WriterProxyLiveliness.h>
@@ -31,66 +34,9 @@
 
 using namespace eprosima::fastrtps::rtps;
 
-/*!
- * @brief Auxiliary function to change status in a range.
- */
-void WriterProxy::for_each_set_status_from(decltype(WriterProxy::m_changesFromW)::iterator first,
-        decltype(WriterProxy::m_changesFromW)::iterator last,
-        ChangeFromWriterStatus_t status,
-        ChangeFromWriterStatus_t new_status)
-{
-    auto it = first;
-    while(it != last)
-    {
-        if(it->getStatus() == status)
-        {
-            ChangeFromWriter_t newch(*it);
-            newch.setStatus(new_status);
-
-            auto hint = m_changesFromW.erase(it);
-
-            it = m_changesFromW.insert(hint, newch);
-        }
-
-        ++it;
-    }
-}
-
-void WriterProxy::for_each_set_status_from_and_maybe_remove(decltype(WriterProxy::m_changesFromW)::iterator first,
-        decltype(WriterProxy::m_changesFromW)::iterator last,
-        ChangeFromWriterStatus_t status,
-        ChangeFromWriterStatus_t orstatus,
-        ChangeFromWriterStatus_t new_status)
-{
-    auto it = first;
-    while(it != last)
-    {
-        if(it->getStatus() == status || it->getStatus() == orstatus)
-        {
-            if(it != m_changesFromW.begin())
-            {
-                ChangeFromWriter_t newch(*it);
-                newch.setStatus(new_status);
-
-                auto hint = m_changesFromW.erase(it);
-
-                it = m_changesFromW.insert(hint, newch);
-                ++it;
-                continue;
-            }
-        }
-
-        // UNKNOWN or MISSING at the beginning or
-        // LOST or RECEIVED at the beginning.
-        if(it == m_changesFromW.begin())
-        {
-            changesFromWLowMark_ = it->getSequenceNumber();
-            it = m_changesFromW.erase(it);
-        }
-    }
-}
-
 static const int WRITERPROXY_LIVELINESS_PERIOD_MULTIPLIER = 1;
+//! Initial number of words of the window of received changes. Enough for the bitmap of an ACKNACK.
+static const size_t WRITERPROXY_RECEIVED_BITMAP_INITIAL_WORDS = 8;
 
 
 WriterProxy::~WriterProxy()
@@ -114,10 +60,11 @@ WriterProxy::WriterProxy(const RemoteWriterAttributes& watt,
     mp_initialAcknack(nullptr),
     m_heartbeatFinalFlag(false),
     m_isAlive(true),
-    mp_mutex(new std::recursive_mutex())
-
+    mp_mutex(new std::recursive_mutex()),
+    received_bitmap_(WRITERPROXY_RECEIVED_BITMAP_INITIAL_WORDS, 0u),
+    received_bitmap_head_(0),
+    received_bitmap_base_(0, 1)
 {
-    m_changesFromW.clear();
     //Create Events
     mp_writerProxyLiveliness = new WriterProxyLiveliness(
         this,
@@ -139,6 +86,11 @@ void WriterProxy::loaded_from_storage_nts(const SequenceNumber_t& seqNum)
 {
     lastNotified_ = seqNum;
     changesFromWLowMark_ = seqNum;
+    changes_from_writer_max_ = seqNum;
+    missing_changes_max_ = seqNum;
+    std::fill(received_bitmap_.begin(), received_bitmap_.end(), 0u);
+    received_bitmap_head_ = 0;
+    received_bitmap_base_ = seqNum + 1;
 }
 
 void WriterProxy::missing_changes_update(const SequenceNumber_t& seqNum)
@@ -149,60 +101,19 @@ void WriterProxy::missing_changes_update(const SequenceNumber_t& seqNum)
     // Check was not removed from container.
     if(seqNum > changesFromWLowMark_)
     {
-        if(m_changesFromW.size() == 0 || m_changesFromW.rbegin()->getSequenceNumber() < seqNum)
+        // Changes not received up to seqNum become MISSING.
+        if(missing_changes_max_ < seqNum)
         {
-            // Set already values in container.
-            for_each_set_status_from(m_changesFromW.begin(), m_changesFromW.end(),
-                    ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING);
-
-            // Changes only already inserted values.
-            bool will_be_the_last = maybe_add_changes_from_writer_up_to(seqNum, ChangeFromWriterStatus_t::MISSING);
-            (void)will_be_the_last;
-            assert(will_be_the_last);
-
-            // Add requetes sequence number.
-            ChangeFromWriter_t newch(seqNum);
-            newch.setStatus(ChangeFromWriterStatus_t::MISSING);
-            m_changesFromW.insert(m_changesFromW.end(), newch);
+            missing_changes_max_ = seqNum;
         }
-        else
-        {
-            // Find it. Must be there.
-            auto last_it = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-            assert(last_it != m_changesFromW.end());
-            for_each_set_status_from(m_changesFromW.begin(), ++last_it,
-                    ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING);
-        }
-    }
-
-    //print_changes_fromWriter_test2();
-}
-
-bool WriterProxy::maybe_add_changes_from_writer_up_to(const SequenceNumber_t& sequence_number,
-        const ChangeFromWriterStatus_t default_status)
-{
-    bool returnedValue = false;
-    // Check if CacheChange_t is in the container or not.
-    SequenceNumber_t lastSeqNum = changesFromWLowMark_;
 
-    if(m_changesFromW.size() > 0)
-        lastSeqNum = m_changesFromW.rbegin()->getSequenceNumber();
-
-    if(sequence_number > lastSeqNum)
-    {
-        returnedValue = true;
-
-        // If it is not in the container, create info up to its sequence number.
-        ++lastSeqNum;
-        for(; lastSeqNum < sequence_number; ++lastSeqNum)
+        if(changes_from_writer_max_ < seqNum)
         {
-            ChangeFromWriter_t newch(lastSeqNum);
-            newch.setStatus(default_status);
-            m_changesFromW.insert(m_changesFromW.end(), newch);
+            changes_from_writer_max_ = seqNum;
         }
     }
 
-    return returnedValue;
+    //print_changes_fromWriter_test2();
 }
 
 void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
@@ -211,26 +122,12 @@ void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     // Check was not removed from container.
-    if(seqNum > changesFromWLowMark_)
+    if(seqNum > changesFromWLowMark_ + 1)
     {
-        if(m_changesFromW.size() == 0 || m_changesFromW.rbegin()->getSequenceNumber() < seqNum)
-        {
-            // Remove all because lost or received.
-            m_changesFromW.clear();
-            // Any in container, then not insert new lost.
-            changesFromWLowMark_ = seqNum - 1;
-        }
-        else
-        {
-            // Find it. Must be there.
-            auto last_it = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-            assert(last_it != m_changesFromW.end());
-            for_each_set_status_from_and_maybe_remove(m_changesFromW.begin(), last_it,
-                    ChangeFromWriterStatus_t::UNKNOWN, ChangeFromWriterStatus_t::MISSING,
-                    ChangeFromWriterStatus_t::LOST);
-            // Next could need to be removed.
-            cleanup();
-        }
+        // All changes before seqNum are either received or lost.
+        advance_low_mark_nts(seqNum - 1);
+        // Next could need to be removed.
+        cleanup();
     }
 
     //print_changes_fromWriter_test2();
@@ -239,74 +136,43 @@ void WriterProxy::lost_changes_update(const SequenceNumber_t& seqNum)
 bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum)
 {
     logInfo(RTPS_READER, m_att.guid.entityId << ": seqNum: " << seqNum);
-    return received_change_set(seqNum, true);
+    return mark_change_as_received(seqNum);
 }
 
 bool WriterProxy::irrelevant_change_set(const SequenceNumber_t& seqNum)
 {
-    return received_change_set(seqNum, false);
+    return mark_change_as_received(seqNum);
 }
 
-bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum, bool is_relevance)
+bool WriterProxy::mark_change_as_received(const SequenceNumber_t& seq_num)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
     // Check if CacheChange_t was already and it was already removed from changesFromW container.
-    if(seqNum <= changesFromWLowMark_)
+    if(seq_num <= changesFromWLowMark_)
     {
-        logInfo(RTPS_READER, "Change " << seqNum << " <= than max available sequence number " << changesFromWLowMark_);
+        logInfo(RTPS_READER, "Change " << seq_num << " <= than max available sequence number " << changesFromWLowMark_);
         return false;
     }
 
-    // Maybe create information because it is not in the m_changesFromW container.
-    bool will_be_the_last = maybe_add_changes_from_writer_up_to(seqNum);
+    if(change_is_received_nts(seq_num))
+    {
+        return false;
+    }
 
-    // If will be the last element, insert it at the end.
-    if(will_be_the_last)
+    if(changes_from_writer_max_ < seq_num)
     {
-        // There are others.
-        if(m_changesFromW.size() > 0)
-        {
-            ChangeFromWriter_t chfw(seqNum);
-            chfw.setStatus(RECEIVED);
-            chfw.setRelevance(is_relevance);
-            m_changesFromW.insert(m_changesFromW.end(), chfw);
-        }
-        // Else not insert
-        else
-            changesFromWLowMark_ = seqNum;
+        changes_from_writer_max_ = seq_num;
+    }
+
+    if(seq_num == changesFromWLowMark_ + 1)
+    {
+        advance_low_mark_nts(seq_num);
+        cleanup();
     }
-    // Else it has to be found and change state.
     else
     {
-        auto chit = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-
-        // Has to be in the container.
-        assert(chit != m_changesFromW.end());
-
-        if(chit != m_changesFromW.begin())
-        {
-            if(chit->getStatus() != RECEIVED)
-            {
-                ChangeFromWriter_t newch(*chit);
-                newch.setStatus(RECEIVED);
-                newch.setRelevance(is_relevance);
-
-                auto hint = m_changesFromW.erase(chit);
-
-                m_changesFromW.insert(hint, newch);
-            }
-            else
-                return false;
-        }
-        else
-        {
-            assert(chit->getStatus() != RECEIVED);
-            changesFromWLowMark_ = seqNum;
-            m_changesFromW.erase(chit);
-            cleanup();
-        }
-
+        set_change_received_nts(seq_num);
     }
 
     //print_changes_fromWriter_test2();
@@ -314,47 +180,96 @@ bool WriterProxy::received_change_set(const SequenceNumber_t& seqNum, bool is_re
     return true;
 }
 
+bool WriterProxy::change_was_received(const SequenceNumber_t& seq_num)
+{
+    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+
+    if(seq_num <= changesFromWLowMark_)
+        return true;
 
-const std::vector<ChangeFromWriter_t> WriterProxy::missing_changes()
+    return change_is_received_nts(seq_num);
+}
+
+const SequenceNumber_t WriterProxy::available_changes_max() const
 {
-    std::vector<ChangeFromWriter_t> returnedValue;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    return changesFromWLowMark_;
+}
+
+ChangeFromWriterStatus_t WriterProxy::change_status_nts(const SequenceNumber_t& seq_num) const
+{
+    assert(seq_num > changesFromWLowMark_);
 
-    for(auto ch : m_changesFromW)
+    if(change_is_received_nts(seq_num))
     {
-        if(ch.getStatus() == MISSING)
-        {
-            // If MISSING, then is relevant.
-            assert(ch.isRelevant());
-            returnedValue.push_back(ch);
-        }
+        return RECEIVED;
     }
 
-
-    //print_changes_fromWriter_test2();
-
-    return returnedValue;
+    return seq_num <= missing_changes_max_ ? MISSING : UNKNOWN;
 }
 
-bool WriterProxy::change_was_received(const SequenceNumber_t& seq_num)
+bool WriterProxy::change_is_received_nts(const SequenceNumber_t& seq_num) const
 {
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
+    uint64_t offset = seq_num.to64long() - received_bitmap_base_.to64long();
+    return (received_word_nts(offset >> 5) & (1u << (offset & 31u))) != 0u;
+}
 
-    if(seq_num <= changesFromWLowMark_)
-        return true;
+void WriterProxy::set_change_received_nts(const SequenceNumber_t& seq_num)
+{
+    uint64_t offset = seq_num.to64long() - received_bitmap_base_.to64long();
+    uint64_t word = offset >> 5;
+    size_t size = received_bitmap_.size();
 
-    auto chit = m_changesFromW.find(ChangeFromWriter_t(seq_num));
+    if(word >= size)
+    {
+        // Grow the window, keeping its size a power of two, and unroll the ring.
+        size_t new_size = size * 2;
+        while(new_size <= word)
+        {
+            new_size *= 2;
+        }
 
-    if(chit != m_changesFromW.end() && chit->getStatus() == RECEIVED)
-        return true;
+        std::vector<uint32_t> bitmap(new_size, 0u);
+        for(size_t i = 0; i < size; ++i)
+        {
+            bitmap[i] = received_bitmap_[(received_bitmap_head_ + i) & (size - 1)];
+        }
+        received_bitmap_.swap(bitmap);
+        received_bitmap_head_ = 0;
+        size = new_size;
+    }
 
-    return false;
+    received_bitmap_[(received_bitmap_head_ + word) & (size - 1)] |= 1u << (offset & 31u);
 }
 
-const SequenceNumber_t WriterProxy::available_changes_max() const
+void WriterProxy::advance_low_mark_nts(const SequenceNumber_t& seq_num)
 {
-    std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    return changesFromWLowMark_;
+    assert(seq_num > changesFromWLowMark_);
+
+    changesFromWLowMark_ = seq_num;
+    if(changes_from_writer_max_ < seq_num)
+    {
+        changes_from_writer_max_ = seq_num;
+    }
+
+    // Release the words before the one holding the first change after the low mark.
+    uint64_t words = (seq_num.to64long() + 1 - received_bitmap_base_.to64long()) >> 5;
+    size_t size = received_bitmap_.size();
+    if(words >= size)
+    {
+        std::fill(received_bitmap_.begin(), received_bitmap_.end(), 0u);
+        received_bitmap_head_ = 0;
+        received_bitmap_base_ = seq_num + 1;
+    }
+    else if(words > 0)
+    {
+        for(uint64_t i = 0; i < words; ++i)
+        {
+            received_bitmap_[received_bitmap_head_] = 0u;
+            received_bitmap_head_ = (received_bitmap_head_ + 1) & (size - 1);
+        }
+        received_bitmap_base_ = received_bitmap_base_ + static_cast<uint32_t>(words << 5);
+    }
 }
 
 void WriterProxy::print_changes_fromWriter_test2()
@@ -362,9 +277,9 @@ void WriterProxy::print_changes_fromWriter_test2()
     std::stringstream sstream;
     sstream << this->m_att.guid.entityId<<": ";
 
-    for(auto it = m_changesFromW.begin(); it != m_changesFromW.end(); ++it)
+    for(SequenceNumber_t seq = changesFromWLowMark_ + 1; seq <= changes_from_writer_max_; ++seq)
     {
-        sstream << it->getSequenceNumber() <<"("<<it->isRelevant()<<","<<it->getStatus()<<")-";
+        sstream << seq <<"("<<change_status_nts(seq)<<")-";
     }
 
     std::string auxstr = sstream.str();
@@ -388,56 +303,48 @@ void WriterProxy::setNotValid(const SequenceNumber_t& seqNum)
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    // Check sequence number is in the container, because it was not clean up.
+    // Check sequence number is in the window, because it was not clean up.
     if(seqNum <= changesFromWLowMark_)
         return;
 
-    auto chit = m_changesFromW.find(ChangeFromWriter_t(seqNum));
-
-    // Element must be in the container. In other case, bug.
-    assert(chit != m_changesFromW.end());
     // If the element will be set not valid, element must be received.
-    // In other case, bug.
-    assert(chit->getStatus() == RECEIVED);
-
-    // Cannot be in the beginning because process of cleanup
-    assert(chit != m_changesFromW.begin());
-
-    ChangeFromWriter_t newch(*chit);
-    newch.notValid();
-
-    auto hint = m_changesFromW.erase(chit);
-
-    m_changesFromW.insert(hint, newch);
+    // In other case, bug. The window keeps no more state of received changes.
+    assert(change_is_received_nts(seqNum));
+    (void)seqNum;
 }
 
 void WriterProxy::cleanup()
 {
-    auto chit = m_changesFromW.begin();
+    // Skip the received changes that follow the low mark, a word at a time.
+    uint64_t first_offset = changesFromWLowMark_.to64long() + 1 - received_bitmap_base_.to64long();
+    uint64_t offset = first_offset;
+    while(true)
+    {
+        uint32_t bit = static_cast<uint32_t>(offset & 31u);
+        uint32_t received = received_word_nts(offset >> 5) >> bit;
+        if(received == (~0u >> bit))
+        {
+            offset += 32u - bit;
+        }
+        else
+        {
+            offset += count_trailing_zeros(~received);
+            break;
+        }
+    }
 
-    while(chit != m_changesFromW.end() &&
-            (chit->getStatus() == RECEIVED || chit->getStatus() == LOST))
+    if(offset > first_offset)
     {
-        changesFromWLowMark_ = chit->getSequenceNumber();
-        chit = m_changesFromW.erase(chit);
+        advance_low_mark_nts(received_bitmap_base_ + static_cast<uint32_t>(offset - 1));
     }
 }
 
 bool WriterProxy::areThereMissing()
 {
-    bool returnedValue = false;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    for(auto ch : m_changesFromW)
-    {
-        if(ch.getStatus() == ChangeFromWriterStatus_t::MISSING)
-        {
-            returnedValue = true;
-            break;
-        }
-    }
-
-    return returnedValue;
+    // The change following the low mark is never received, so it is missing when announced.
+    return missing_changes_max_ > changesFromWLowMark_;
 }
 
 size_t WriterProxy::unknown_missing_changes_up_to(const SequenceNumber_t& seqNum)
@@ -445,13 +352,29 @@ size_t WriterProxy::unknown_missing_changes_up_to(const SequenceNumber_t& seqNum
     size_t returnedValue = 0;
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
 
-    if(seqNum > changesFromWLowMark_)
+    SequenceNumber_t last = seqNum - 1;
+    if(changes_from_writer_max_ < last)
+    {
+        last = changes_from_writer_max_;
+    }
+
+    if(last > changesFromWLowMark_)
     {
-        for(auto ch = m_changesFromW.begin(); ch != m_changesFromW.end() && ch->getSequenceNumber() < seqNum; ++ch)
+        // Count the changes in the window, and discount the received ones.
+        uint64_t offset = changesFromWLowMark_.to64long() + 1 - received_bitmap_base_.to64long();
+        uint64_t end_offset = last.to64long() + 1 - received_bitmap_base_.to64long();
+        returnedValue = static_cast<size_t>(end_offset - offset);
+        while(offset < end_offset)
         {
-            if(ch->getStatus() == ChangeFromWriterStatus_t::UNKNOWN ||
-                    ch->getStatus() == ChangeFromWriterStatus_t::MISSING)
-                ++returnedValue;
+            uint32_t bit = static_cast<uint32_t>(offset & 31u);
+            uint64_t word_base = offset - bit;
+            uint32_t received = received_word_nts(offset >> 5) & (~0u << bit);
+            if(end_offset - word_base < 32u)
+            {
+                received &= (1u << (end_offset - word_base)) - 1u;
+            }
+            returnedValue -= count_ones(received);
+            offset = word_base + 32u;
         }
     }
 
@@ -461,7 +384,8 @@ size_t WriterProxy::unknown_missing_changes_up_to(const SequenceNumber_t& seqNum
 size_t WriterProxy::numberOfChangeFromWriter() const
 {
     std::lock_guard<std::recursive_mutex> guard(*mp_mutex);
-    return m_changesFromW.size();
+    return changes_from_writer_max_ > changesFromWLowMark_ ?
+        static_cast<size_t>(changes_from_writer_max_.to64long() - changesFromWLowMark_.to64long()) : 0u;
 }
 
 SequenceNumber_t WriterProxy::nextCacheChangeToBeNotified()
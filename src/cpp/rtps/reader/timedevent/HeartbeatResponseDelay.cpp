@@ -28,6 +28,7 @@
 #include <fastrtps/rtps/messages/CDRMessage.h>
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
@@ -73,7 +74,6 @@ void HeartbeatResponseDelay::event(
         // Protect reader
         std::lock_guard<std::recursive_timed_mutex> guard(mp_WP->mp_SFR->getMutex());
 
-        const std::vector<ChangeFromWriter_t> missing_changes = mp_WP->missing_changes();
         // Stores missing changes but there is some fragments received.
         std::vector<CacheChange_t*> uncompleted_changes;
 
@@ -82,20 +82,20 @@ void HeartbeatResponseDelay::event(
             RTPSMessageGroup group(mp_WP->mp_SFR->getRTPSParticipant(), mp_WP->mp_SFR, RTPSMessageGroup::READER,
                     m_cdrmessages, m_destination_locators, m_remote_endpoints);
 
-            if(!missing_changes.empty() || !mp_WP->m_heartbeatFinalFlag)
+            if(mp_WP->areThereMissing() || !mp_WP->m_heartbeatFinalFlag)
             {
                 SequenceNumberSet_t sns(mp_WP->available_changes_max() + 1);
 
-                for(auto ch : missing_changes)
+                mp_WP->for_each_missing_change([&](const SequenceNumber_t& seq_num)
                 {
                     // Check if the CacheChange_t is uncompleted.
-                    CacheChange_t* uncomplete_change = mp_WP->mp_SFR->findCacheInFragmentedCachePitStop(ch.getSequenceNumber(), mp_WP->m_att.guid);
+                    CacheChange_t* uncomplete_change = mp_WP->mp_SFR->findCacheInFragmentedCachePitStop(seq_num, mp_WP->m_att.guid);
 
                     if(uncomplete_change == nullptr)
                     {
-                        if(!sns.add(ch.getSequenceNumber()))
+                        if(!sns.add(seq_num))
                         {
-                            logInfo(RTPS_READER,"Sequence number " << ch.getSequenceNumber()
+                            logInfo(RTPS_READER,"Sequence number " << seq_num
                                     << " exceeded bitmap limit of AckNack. SeqNumSet Base: " << sns.base());
                         }
                     }
@@ -103,7 +103,7 @@ void HeartbeatResponseDelay::event(
                     {
                         uncompleted_changes.push_back(uncomplete_change);
                     }
-                }
+                });
 
                 // TODO Protect
                 mp_WP->mp_SFR->m_acknackCount++;
@@ -121,29 +121,20 @@ void HeartbeatResponseDelay::event(
                     FragmentNumberSet_t frag_sns;
 
                     //  Search first fragment not present.
-                    uint32_t frag_num = 0;
-                    auto fit = cit->getDataFragments()->begin();
-                    for(; fit != cit->getDataFragments()->end(); ++fit)
-                    {
-                        ++frag_num;
-                        if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                            break;
-                    }
+                    uint32_t frag_num = cit->first_missing_fragment() + 1;
 
                     // Never should happend.
-                    assert(frag_num != 0);
-                    assert(fit != cit->getDataFragments()->end());
+                    assert(frag_num <= cit->getFragmentCount());
 
                     // Store FragmentNumberSet_t base.
                     frag_sns.base(frag_num);
 
-                    // Fill the FragmentNumberSet_t bitmap.
-                    for(; fit != cit->getDataFragments()->end(); ++fit)
+                    // Fill the FragmentNumberSet_t bitmap, which cannot hold more than 256 fragments.
+                    uint32_t last_frag_num = std::min(cit->getFragmentCount(), frag_num + 255);
+                    for(; frag_num <= last_frag_num; ++frag_num)
                     {
-                        if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
+                        if(!cit->is_fragment_received(frag_num - 1))
                             frag_sns.add(frag_num);
-
-                        ++frag_num;
                     }
 
                     ++mp_WP->mp_SFR->m_nackfragCount;
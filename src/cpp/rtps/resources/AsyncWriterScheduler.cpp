@@ -0,0 +1,178 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file AsyncWriterScheduler.cpp
+ *
+ */
+
+#include "AsyncWriterScheduler.h"
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+
+#include <algorithm>
+
+using namespace eprosima::fastrtps::rtps;
+
+AsyncWriterScheduler::AsyncWriterScheduler(uint32_t thread_count)
+{
+    if(thread_count == 0)
+    {
+        thread_count = 1;
+    }
+
+    for(uint32_t i = 0; i < thread_count; ++i)
+    {
+        workers_.emplace_back(new Worker());
+    }
+}
+
+AsyncWriterScheduler::~AsyncWriterScheduler()
+{
+    for(auto& worker : workers_)
+    {
+        std::unique_lock<std::mutex> guard(worker->mutex);
+        worker->running = false;
+        worker->cv.notify_all();
+    }
+
+    for(auto& worker : workers_)
+    {
+        if(worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+bool AsyncWriterScheduler::add_writer(RTPSWriter& writer)
+{
+    std::unique_lock<std::mutex> guard(writers_mutex_);
+
+    if(writers_.find(&writer) != writers_.end())
+    {
+        return false;
+    }
+
+    // Assign the writer to the worker serving fewer writers.
+    Worker* worker = std::min_element(workers_.begin(), workers_.end(),
+            [](const std::unique_ptr<Worker>& a, const std::unique_ptr<Worker>& b)
+            {
+                return a->writer_count < b->writer_count;
+            })->get();
+    ++worker->writer_count;
+
+    WriterEntry& entry = writers_[&writer];
+    entry.writer = &writer;
+    entry.worker = worker;
+    entry.queued = false;
+
+    // If the worker thread is not running, start it.
+    std::unique_lock<std::mutex> worker_guard(worker->mutex);
+    if(!worker->running)
+    {
+        worker->running = true;
+        worker->thread = std::thread(&AsyncWriterScheduler::run, worker);
+    }
+
+    return true;
+}
+
+bool AsyncWriterScheduler::remove_writer(RTPSWriter& writer)
+{
+    std::unique_lock<std::mutex> guard(writers_mutex_);
+
+    auto it = writers_.find(&writer);
+    if(it == writers_.end())
+    {
+        return false;
+    }
+
+    Worker* worker = it->second.worker;
+    std::unique_lock<std::mutex> worker_guard(worker->mutex);
+    if(it->second.queued)
+    {
+        worker->ready.erase(std::find(worker->ready.begin(), worker->ready.end(), &it->second));
+    }
+    --worker->writer_count;
+    writers_.erase(it);
+
+    // The writer cannot be queued anymore. Wait until the worker finishes serving it, without blocking other
+    // writers from being woken up meanwhile.
+    guard.unlock();
+    worker->cv.wait(worker_guard, [worker, &writer]()
+            {
+                return worker->current != &writer;
+            });
+
+    return true;
+}
+
+void AsyncWriterScheduler::wake_up(const RTPSWriter* writer)
+{
+    std::unique_lock<std::mutex> guard(writers_mutex_);
+
+    auto it = writers_.find(writer);
+    if(it != writers_.end())
+    {
+        enqueue(it->second);
+    }
+}
+
+void AsyncWriterScheduler::wake_up_all()
+{
+    std::unique_lock<std::mutex> guard(writers_mutex_);
+
+    for(auto& writer : writers_)
+    {
+        enqueue(writer.second);
+    }
+}
+
+void AsyncWriterScheduler::enqueue(WriterEntry& entry)
+{
+    Worker* worker = entry.worker;
+    std::unique_lock<std::mutex> guard(worker->mutex);
+    if(!entry.queued)
+    {
+        entry.queued = true;
+        worker->ready.push_back(&entry);
+        worker->cv.notify_all();
+    }
+}
+
+void AsyncWriterScheduler::run(Worker* worker)
+{
+    std::unique_lock<std::mutex> guard(worker->mutex);
+    while(worker->running)
+    {
+        if(worker->ready.empty())
+        {
+            worker->cv.wait(guard);
+            continue;
+        }
+
+        WriterEntry* entry = worker->ready.front();
+        worker->ready.pop_front();
+        entry->queued = false;
+        worker->current = entry->writer;
+
+        // The entry may be removed once the mutex is unlocked, but the writer is kept alive until current is reset.
+        guard.unlock();
+        worker->current->send_any_unsent_changes();
+        guard.lock();
+
+        worker->current = nullptr;
+        worker->cv.notify_all();
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file AsyncWriterScheduler.h
+ *
+ */
+
+#ifndef _RTPS_RESOURCES_ASYNCWRITERSCHEDULER_H_
+#define _RTPS_RESOURCES_ASYNCWRITERSCHEDULER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class RTPSWriter;
+
+/**
+ * Schedules the asynchronous writes of the writers of a participant on a set of worker threads.
+ * Each writer is assigned to the worker serving fewer writers when it is added, and it is always served by that
+ * worker. Every worker serves its writers in the order they were woken up, and a writer is queued at most once,
+ * so a writer with a continuous flow of data cannot starve the rest.
+ * @ingroup COMMON_MODULE
+ */
+class AsyncWriterScheduler
+{
+public:
+
+    /**
+     * Constructor.
+     * Worker threads are not started until there are writers to serve.
+     * @param thread_count Number of worker threads. At least one is used.
+     */
+    explicit AsyncWriterScheduler(uint32_t thread_count);
+
+    //! Stops and joins all the worker threads.
+    ~AsyncWriterScheduler();
+
+    /**
+     * Adds a writer to be served by one of the worker threads.
+     * @param writer Writer to be added.
+     * @return True if the writer was added. False if it was already added.
+     */
+    bool add_writer(RTPSWriter& writer);
+
+    /**
+     * Removes a writer.
+     * When this method returns, the writer is not being served by its worker thread and it will not be served again.
+     * @param writer Writer to be removed.
+     * @return True if the writer was removed. False if it was not added.
+     */
+    bool remove_writer(RTPSWriter& writer);
+
+    /**
+     * Queues a writer on its worker thread, so it sends any unsent changes.
+     * Nothing is done if the writer was not added.
+     * @param writer Writer to be woken up.
+     */
+    void wake_up(const RTPSWriter* writer);
+
+    //! Queues all the writers on their worker threads.
+    void wake_up_all();
+
+private:
+
+    struct Worker;
+
+    struct WriterEntry
+    {
+        RTPSWriter* writer;
+        Worker* worker;
+        //! Whether the writer is in the ready queue of its worker. Protected by the mutex of the worker.
+        bool queued;
+    };
+
+    struct Worker
+    {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        //! Writers waiting to be served, in the order they were woken up.
+        std::deque<WriterEntry*> ready;
+        //! Writer being served, or nullptr.
+        RTPSWriter* current = nullptr;
+        //! Number of writers assigned to the worker. Protected by writers_mutex_.
+        uint32_t writer_count = 0;
+        bool running = false;
+    };
+
+    AsyncWriterScheduler(const AsyncWriterScheduler&) = delete;
+    AsyncWriterScheduler& operator=(const AsyncWriterScheduler&) = delete;
+
+    //! Queues a writer in its worker. writers_mutex_ should be locked.
+    static void enqueue(WriterEntry& entry);
+
+    //! Main loop of a worker thread.
+    static void run(Worker* worker);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex writers_mutex_;
+    std::unordered_map<const RTPSWriter*, WriterEntry> writers_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_RESOURCES_ASYNCWRITERSCHEDULER_H_
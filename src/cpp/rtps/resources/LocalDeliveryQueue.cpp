@@ -0,0 +1,108 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LocalDeliveryQueue.cpp
+ *
+ */
+
+#include "LocalDeliveryQueue.h"
+
+#include <algorithm>
+
+using namespace eprosima::fastrtps::rtps;
+
+LocalDeliveryQueue::LocalDeliveryQueue()
+    : current_{nullptr, nullptr, nullptr}
+    , running_(false)
+{
+}
+
+LocalDeliveryQueue::~LocalDeliveryQueue()
+{
+    {
+        std::unique_lock<std::mutex> guard(mutex_);
+        running_ = false;
+        pending_.clear();
+        cv_.notify_all();
+    }
+
+    if(thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+void LocalDeliveryQueue::push(
+        const Endpoint* writer,
+        const Endpoint* reader,
+        std::function<void()>&& delivery)
+{
+    std::unique_lock<std::mutex> guard(mutex_);
+
+    pending_.push_back(Delivery{writer, reader, std::move(delivery)});
+
+    // If the delivery thread is not running, start it.
+    if(!running_ && !thread_.joinable())
+    {
+        running_ = true;
+        thread_ = std::thread(&LocalDeliveryQueue::run, this);
+    }
+
+    cv_.notify_all();
+}
+
+void LocalDeliveryQueue::remove_endpoint(const Endpoint* endpoint)
+{
+    std::unique_lock<std::mutex> guard(mutex_);
+
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(), [endpoint](const Delivery& delivery)
+            {
+                return delivery.involves(endpoint);
+            }), pending_.end());
+
+    if(std::this_thread::get_id() == thread_.get_id())
+    {
+        return;
+    }
+
+    cv_.wait(guard, [this, endpoint]()
+            {
+                return !current_.involves(endpoint);
+            });
+}
+
+void LocalDeliveryQueue::run()
+{
+    std::unique_lock<std::mutex> guard(mutex_);
+    while(running_)
+    {
+        if(pending_.empty())
+        {
+            cv_.wait(guard);
+            continue;
+        }
+
+        current_ = std::move(pending_.front());
+        pending_.pop_front();
+
+        // The endpoints of the delivery are kept alive until current_ is reset.
+        guard.unlock();
+        current_.delivery();
+        guard.lock();
+
+        current_ = Delivery{nullptr, nullptr, nullptr};
+        cv_.notify_all();
+    }
+}
@@ -0,0 +1,111 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LocalDeliveryQueue.h
+ *
+ */
+
+#ifndef _RTPS_RESOURCES_LOCALDELIVERYQUEUE_H_
+#define _RTPS_RESOURCES_LOCALDELIVERYQUEUE_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class Endpoint;
+
+/**
+ * Runs the deliveries of the writers of a participant to the readers of the same participant.
+ * Writers queue their deliveries while holding their own mutex, and a single thread runs them afterwards, in the
+ * order they were queued, with no writer mutex taken. This thread plays the role of a receive thread for local
+ * traffic: readers and their listeners may use any writer, and a listener writing to a writer whose readers write
+ * back does not recurse.
+ * @ingroup COMMON_MODULE
+ */
+class LocalDeliveryQueue
+{
+public:
+
+    /**
+     * Constructor.
+     * The delivery thread is not started until the first delivery is queued.
+     */
+    LocalDeliveryQueue();
+
+    //! Stops and joins the delivery thread. Pending deliveries are discarded.
+    ~LocalDeliveryQueue();
+
+    /**
+     * Queues a delivery.
+     * @param writer Writer the delivery comes from.
+     * @param reader Reader the delivery is addressed to.
+     * @param delivery Function doing the delivery. It is called without any lock taken.
+     */
+    void push(
+            const Endpoint* writer,
+            const Endpoint* reader,
+            std::function<void()>&& delivery);
+
+    /**
+     * Discards the pending deliveries from or to an endpoint.
+     * When this method returns, no delivery of the endpoint is being run, so it can be destroyed. This is not
+     * guaranteed when called from the delivery thread itself, as it would wait for itself.
+     * @param endpoint Endpoint being removed.
+     */
+    void remove_endpoint(const Endpoint* endpoint);
+
+private:
+
+    struct Delivery
+    {
+        const Endpoint* writer;
+        const Endpoint* reader;
+        std::function<void()> delivery;
+
+        bool involves(const Endpoint* endpoint) const
+        {
+            return writer == endpoint || reader == endpoint;
+        }
+    };
+
+    LocalDeliveryQueue(const LocalDeliveryQueue&) = delete;
+    LocalDeliveryQueue& operator=(const LocalDeliveryQueue&) = delete;
+
+    //! Main loop of the delivery thread.
+    void run();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    //! Deliveries waiting to be run, in the order they were queued.
+    std::deque<Delivery> pending_;
+    //! Delivery being run. Its endpoints are nullptr when there is none.
+    Delivery current_;
+    bool running_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_RESOURCES_LOCALDELIVERYQUEUE_H_
@@ -24,6 +24,7 @@
 #include <functional>
 #include <rtps/participant/RTPSParticipantImpl.h>
 #include <fastrtps/log/Log.h>
+#include "TimerWheel.h"
 
 namespace eprosima {
 namespace fastrtps{
@@ -38,6 +39,7 @@ ResourceEvent::ResourceEvent():
     {
         mp_io_service = new asio::io_service();
         mp_work = (void*)new asio::io_service::work(*mp_io_service);
+        mp_timer_wheel = TimerWheel::get(*mp_io_service);
     }
 
 ResourceEvent::~ResourceEvent() {
@@ -45,6 +47,7 @@ ResourceEvent::~ResourceEvent() {
     mp_io_service->stop();
     mp_b_thread->join();
     delete(mp_b_thread);
+    mp_timer_wheel.reset();
     delete((asio::io_service::work*)mp_work);
     delete(mp_io_service);
 
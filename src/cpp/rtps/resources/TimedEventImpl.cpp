@@ -67,18 +67,22 @@ TimedEventImpl::TimedEventImpl(
         const std::thread& event_thread,
         std::chrono::microseconds interval,
         TimedEvent::AUTODESTRUCTION_MODE autodestruction)
-    : timer_(service, interval)
+    : wheel_(TimerWheel::get(service))
     , m_interval_microsec(interval)
     , mp_event(event)
     , autodestruction_(autodestruction)
     , state_(std::make_shared<TimerState>(autodestruction))
     , event_thread_id_(event_thread.get_id())
+    , service_(service)
 {
+    wheel_node_.event = this;
 	//TIME_INFINITE(m_timeInfinite);
 }
 
 TimedEventImpl::~TimedEventImpl()
 {
+    // The wheel cannot keep a link to a destroyed event.
+    wheel_->cancel(wheel_node_);
 }
 
 void TimedEventImpl::destroy()
@@ -92,7 +96,7 @@ void TimedEventImpl::destroy()
 
     // If the event is waiting, cancel it.
     if(code == TimerState::WAITING)
-        timer_.cancel();
+        wheel_->cancel(wheel_node_);
 
     // If the event is waiting or running, wait it finishes.
     // Don't wait if it is the event thread.
@@ -117,12 +121,17 @@ void TimedEventImpl::cancel_timer()
 
     if(ret)
     {
+        std::shared_ptr<TimerState> cancelled_state = state_;
         // Unattach the event state from future event execution.
         state_.reset(new TimerState(autodestruction_));
-        // Cancel the event.
-        timer_.cancel();
+        // Cancel the event. If the wheel has already collected it, the cancelled state will discard it.
+        bool unlinked = wheel_->cancel(wheel_node_);
         // Alert to user.
         mp_event->event(TimedEvent::EVENT_ABORT, nullptr);
+
+        // Autodestruction on cancellation is done by the event thread, as it was when the wheel had collected it.
+        if(unlinked && autodestruction_ == TimedEvent::ALLWAYS)
+            service_.post(std::bind(&TimedEventImpl::event, this, cancelled_state));
     }
 }
 
@@ -138,23 +147,14 @@ void TimedEventImpl::restart_timer()
     // if the code indicate an event is already waiting, don't start other event.
     if(code != TimerState::DESTROYED && code != TimerState::WAITING)
     {
-        bool restartTimer = true;
-
-        // If there is an event running, desattach state and set to not notify.
+        // If there is an event running, it will be scheduled again when it finishes.
         if(code == TimerState::RUNNING)
-        {
-            if(state_.get()->forwardRestart_)
-                restartTimer = false;
-            else
-                state_.get()->forwardRestart_ = true;
-        }
+            state_.get()->forwardRestart_ = true;
         else
-            state_.get()->code_.store(TimerState::WAITING, std::memory_order_relaxed);
-
-        if(restartTimer)
         {
-            timer_.expires_from_now(m_interval_microsec);
-            timer_.async_wait(std::bind(&TimedEventImpl::event,this,std::placeholders::_1, state_));
+            state_.get()->code_.store(TimerState::WAITING, std::memory_order_relaxed);
+            wheel_node_.state = state_;
+            wheel_->schedule(wheel_node_, m_interval_microsec);
         }
     }
 }
@@ -173,7 +173,7 @@ bool TimedEventImpl::update_interval_millisec(double time_millisec)
 	return true;
 }
 
-void TimedEventImpl::event(const std::error_code& ec, const std::shared_ptr<TimerState>& state)
+void TimedEventImpl::event(const std::shared_ptr<TimerState>& state)
 {
     TimerState::StateCode scode = TimerState::WAITING;
 
@@ -183,7 +183,7 @@ void TimedEventImpl::event(const std::error_code& ec, const std::shared_ptr<Time
     // Check bad preconditions
     assert(!(ret && scode == TimerState::DESTROYED));
 
-    if(scode != TimerState::WAITING || !ret || ec == asio::error::operation_aborted)
+    if(scode != TimerState::WAITING || !ret)
     {
         // If autodestruction is TimedEvent::ALLWAYS, delete the event.
         if(scode != TimerState::DESTROYED && state.get()->autodestruction_ == TimedEvent::ALLWAYS)
@@ -194,15 +194,9 @@ void TimedEventImpl::event(const std::error_code& ec, const std::shared_ptr<Time
         return;
     }
 
-    TimedEvent::EventCode code = TimedEvent::EVENT_MSG;
-    std::string message;
-
-    if(!ec)
-        code = TimedEvent::EVENT_SUCCESS;
-    else
-        message = ec.message();
+    TimedEvent::EventCode code = TimedEvent::EVENT_SUCCESS;
 
-    this->mp_event->event(code, message.c_str());
+    this->mp_event->event(code, "");
 
     // If the destructor is waiting, signal it.
     std::unique_lock<std::mutex> lock(mutex_);
@@ -216,6 +210,13 @@ void TimedEventImpl::event(const std::error_code& ec, const std::shared_ptr<Time
     {
         state.get()->forwardRestart_ = false;
         ret =  state.get()->code_.compare_exchange_strong(scode, TimerState::WAITING, std::memory_order_relaxed);
+
+        // The restart was requested while running.
+        if(ret)
+        {
+            wheel_node_.state = state;
+            wheel_->schedule(wheel_node_, m_interval_microsec);
+        }
     }
 
     if(scode == TimerState::DESTROYED)
@@ -35,6 +35,8 @@
 
 #include <fastrtps/utils/Semaphore.h>
 
+#include "TimerWheel.h"
+
 #include <thread>
 #include <functional>
 #include <mutex>
@@ -69,17 +71,18 @@ namespace eprosima
                     TimedEventImpl(TimedEvent* ev, asio::io_service &service, const std::thread& event_thread, std::chrono::microseconds interval, TimedEvent::AUTODESTRUCTION_MODE autodestruction);
 
                     /**
-                     * Method invoked when the event occurs. Abstract method.
+                     * Method invoked by the timer wheel when the event occurs.
                      *
-                     * @param code Code representing the status of the event
-                     * @param msg Message associated to the event
+                     * @param state State of the event when it was scheduled
                      */
-                    void event(const std::error_code& ec, const std::shared_ptr<TimerState>& state);
+                    void event(const std::shared_ptr<TimerState>& state);
 
 
                 protected:
-                    //!Pointer to the timer.
-                    asio::steady_timer timer_;
+                    //!Timer wheel of the IO service.
+                    std::shared_ptr<TimerWheel> wheel_;
+                    //!Link of the event into the timer wheel.
+                    TimerWheel::Node wheel_node_;
                     //!Interval to be used in the timed Event.
                     std::chrono::microseconds m_interval_microsec;
                     //!TimedEvent pointer
@@ -128,7 +131,7 @@ namespace eprosima
                     double getRemainingTimeMilliSec()
                     {
                         std::unique_lock<std::mutex> lock(mutex_);
-                        return static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(timer_.expires_from_now()).count());
+                        return static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(wheel_->remaining(wheel_node_)).count());
                     }
 
                 private:
@@ -141,6 +144,8 @@ namespace eprosima
                     std::shared_ptr<TimerState> state_;
 
                     std::thread::id event_thread_id_;
+
+                    asio::io_service& service_;
             };
 
 
@@ -0,0 +1,390 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TimerWheel.cpp
+ *
+ */
+
+#include "TimerWheel.h"
+#include "TimedEventImpl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <map>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+constexpr uint32_t TimerWheel::c_unlinked;
+constexpr uint32_t TimerWheel::c_slot_bits;
+constexpr uint32_t TimerWheel::c_slots_per_level;
+constexpr uint32_t TimerWheel::c_levels;
+constexpr uint32_t TimerWheel::c_overflow_slot;
+constexpr uint64_t TimerWheel::c_no_tick;
+
+namespace {
+
+typedef std::map<asio::io_service*, std::weak_ptr<TimerWheel>> WheelRegistry;
+
+std::mutex& registry_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+WheelRegistry& registry()
+{
+    static WheelRegistry wheels;
+    return wheels;
+}
+
+inline uint32_t first_bit(uint64_t word)
+{
+#if defined(_MSC_VER)
+    unsigned long bit;
+    _BitScanForward64(&bit, word);
+    return static_cast<uint32_t>(bit);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+}
+
+} // namespace
+
+std::shared_ptr<TimerWheel> TimerWheel::get(asio::io_service& service)
+{
+    std::lock_guard<std::mutex> guard(registry_mutex());
+
+    std::weak_ptr<TimerWheel>& entry = registry()[&service];
+    std::shared_ptr<TimerWheel> wheel = entry.lock();
+    if (!wheel)
+    {
+        wheel = std::make_shared<TimerWheel>(service);
+        entry = wheel;
+    }
+
+    return wheel;
+}
+
+TimerWheel::TimerWheel(asio::io_service& service)
+    : service_(service)
+    , timer_(service)
+    , epoch_(std::chrono::steady_clock::now())
+    , current_tick_(0)
+    , armed_tick_(c_no_tick)
+{
+    slots_.fill(nullptr);
+    occupied_.fill(0);
+}
+
+TimerWheel::~TimerWheel()
+{
+    std::lock_guard<std::mutex> guard(registry_mutex());
+
+    // Another wheel may have been registered for the same service after this one expired.
+    WheelRegistry::iterator it = registry().find(&service_);
+    if (it != registry().end() && it->second.expired())
+    {
+        registry().erase(it);
+    }
+}
+
+void TimerWheel::schedule(
+        Node& node,
+        std::chrono::microseconds interval)
+{
+    std::chrono::steady_clock::time_point expiration = std::chrono::steady_clock::now() + interval;
+
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if (node.slot != c_unlinked)
+    {
+        unlink_nts(node);
+    }
+
+    node.expiration = (std::max)(tick_of(expiration), current_tick_ + 1);
+    link_nts(node);
+    arm_nts();
+}
+
+bool TimerWheel::cancel(Node& node)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if (node.slot == c_unlinked)
+    {
+        return false;
+    }
+
+    unlink_nts(node);
+    node.state.reset();
+    // The asio timer is left armed. If nothing expires on that tick, it will only re-arm.
+    return true;
+}
+
+std::chrono::microseconds TimerWheel::remaining(const Node& node)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if (node.slot == c_unlinked)
+    {
+        return std::chrono::microseconds(0);
+    }
+
+    std::chrono::steady_clock::time_point expiration = epoch_ + std::chrono::milliseconds(node.expiration);
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (expiration <= now)
+    {
+        return std::chrono::microseconds(0);
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(expiration - now);
+}
+
+uint64_t TimerWheel::tick_of(std::chrono::steady_clock::time_point time) const
+{
+    if (time <= epoch_)
+    {
+        return 0;
+    }
+
+    std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - epoch_);
+    return static_cast<uint64_t>((elapsed.count() + 999) / 1000);
+}
+
+void TimerWheel::link_nts(Node& node)
+{
+    assert(node.expiration >= current_tick_);
+
+    // The node goes to the lowest level whose slots cover its expiration from the current tick.
+    uint64_t diff = node.expiration ^ current_tick_;
+    uint32_t level = 0;
+    while (level < c_levels && (diff >> (c_slot_bits * (level + 1))) != 0)
+    {
+        ++level;
+    }
+
+    uint32_t slot = c_overflow_slot;
+    if (level < c_levels)
+    {
+        slot = level * c_slots_per_level +
+                static_cast<uint32_t>((node.expiration >> (c_slot_bits * level)) & (c_slots_per_level - 1));
+        occupied_[slot / 64] |= (1ull << (slot % 64));
+    }
+
+    Node*& head = slots_[slot];
+    if (head == nullptr)
+    {
+        node.prev = &node;
+        node.next = &node;
+        head = &node;
+    }
+    else
+    {
+        node.prev = head->prev;
+        node.next = head;
+        head->prev->next = &node;
+        head->prev = &node;
+    }
+
+    node.slot = slot;
+}
+
+void TimerWheel::unlink_nts(Node& node)
+{
+    assert(node.slot != c_unlinked);
+
+    Node*& head = slots_[node.slot];
+    if (node.next == &node)
+    {
+        head = nullptr;
+        if (node.slot != c_overflow_slot)
+        {
+            occupied_[node.slot / 64] &= ~(1ull << (node.slot % 64));
+        }
+    }
+    else
+    {
+        node.prev->next = node.next;
+        node.next->prev = node.prev;
+        if (head == &node)
+        {
+            head = node.next;
+        }
+    }
+
+    node.prev = nullptr;
+    node.next = nullptr;
+    node.slot = c_unlinked;
+}
+
+uint32_t TimerWheel::find_occupied(
+        uint32_t level,
+        uint32_t from) const
+{
+    const uint32_t words_per_level = c_slots_per_level / 64;
+
+    while (from < c_slots_per_level)
+    {
+        uint64_t word = occupied_[level * words_per_level + from / 64] >> (from % 64);
+        if (word != 0)
+        {
+            return from + first_bit(word);
+        }
+
+        from = (from / 64 + 1) * 64;
+    }
+
+    return c_slots_per_level;
+}
+
+uint64_t TimerWheel::next_tick_nts() const
+{
+    // Slots of a level are always reached before the ones of the levels above.
+    for (uint32_t level = 0; level < c_levels; ++level)
+    {
+        uint32_t shift = c_slot_bits * level;
+        uint32_t current_index = static_cast<uint32_t>((current_tick_ >> shift) & (c_slots_per_level - 1));
+        uint32_t index = find_occupied(level, current_index + 1);
+        if (index < c_slots_per_level)
+        {
+            uint64_t block = (current_tick_ >> (shift + c_slot_bits)) << (shift + c_slot_bits);
+            return block | (static_cast<uint64_t>(index) << shift);
+        }
+    }
+
+    if (slots_[c_overflow_slot] != nullptr)
+    {
+        uint32_t shift = c_slot_bits * c_levels;
+        return ((current_tick_ >> shift) + 1) << shift;
+    }
+
+    return c_no_tick;
+}
+
+void TimerWheel::cascade_nts(uint32_t slot)
+{
+    Node* node = slots_[slot];
+    while (node != nullptr)
+    {
+        unlink_nts(*node);
+        link_nts(*node);
+        node = slots_[slot];
+    }
+}
+
+void TimerWheel::advance_nts(
+        uint64_t until,
+        Batch& expired)
+{
+    for (uint64_t tick = next_tick_nts(); tick <= until; tick = next_tick_nts())
+    {
+        current_tick_ = tick;
+
+        // Move down the nodes of the slots starting on this tick, from the highest level.
+        if ((tick & ((1ull << (c_slot_bits * c_levels)) - 1)) == 0)
+        {
+            cascade_nts(c_overflow_slot);
+        }
+
+        for (uint32_t level = c_levels - 1; level > 0; --level)
+        {
+            uint32_t shift = c_slot_bits * level;
+            if ((tick & ((1ull << shift) - 1)) == 0)
+            {
+                cascade_nts(level * c_slots_per_level +
+                        static_cast<uint32_t>((tick >> shift) & (c_slots_per_level - 1)));
+            }
+        }
+
+        // All the nodes of the first level slot expire on this tick.
+        uint32_t slot = static_cast<uint32_t>(tick & (c_slots_per_level - 1));
+        while (slots_[slot] != nullptr)
+        {
+            Node* node = slots_[slot];
+            assert(node->expiration == tick);
+            unlink_nts(*node);
+            expired.emplace_back(node->event, std::move(node->state));
+        }
+    }
+
+    // Nothing is pending up to the given tick, so the placement of the remaining nodes is still valid.
+    if (until > current_tick_)
+    {
+        current_tick_ = until;
+    }
+}
+
+void TimerWheel::arm_nts()
+{
+    uint64_t tick = next_tick_nts();
+    if (tick == c_no_tick || tick >= armed_tick_)
+    {
+        return;
+    }
+
+    armed_tick_ = tick;
+    timer_.expires_at(epoch_ + std::chrono::milliseconds(tick));
+    timer_.async_wait(std::bind(&TimerWheel::on_timer, std::weak_ptr<TimerWheel>(shared_from_this()),
+            std::placeholders::_1));
+}
+
+void TimerWheel::on_timer(
+        const std::weak_ptr<TimerWheel>& weak_wheel,
+        const asio::error_code& ec)
+{
+    if (ec == asio::error::operation_aborted)
+    {
+        return;
+    }
+
+    std::shared_ptr<TimerWheel> wheel = weak_wheel.lock();
+    if (!wheel)
+    {
+        return;
+    }
+
+    Batch expired;
+
+    {
+        std::lock_guard<std::mutex> guard(wheel->mutex_);
+
+        std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - wheel->epoch_);
+        wheel->armed_tick_ = c_no_tick;
+        wheel->advance_nts(static_cast<uint64_t>(elapsed.count() / 1000), expired);
+        wheel->arm_nts();
+    }
+
+    execute(expired);
+}
+
+void TimerWheel::execute(Batch& expired)
+{
+    for (auto& entry : expired)
+    {
+        entry.first->event(entry.second);
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,179 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TimerWheel.h
+ *
+ */
+
+#ifndef _RTPS_RESOURCES_TIMERWHEEL_H_
+#define _RTPS_RESOURCES_TIMERWHEEL_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <asio/io_service.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class TimedEventImpl;
+class TimerState;
+
+/**
+ * Hierarchical timer wheel serving all the timed events of an IO service with a single asio timer.
+ * Time is divided in ticks of one millisecond. The wheel has four levels of 256 slots: the first one holds the timers
+ * expiring in the next 256 ticks, and each of the others holds the timers expiring in the next 256 slots of the level
+ * below, which are moved down when their slot is reached. Timers beyond the last level wait in an overflow list.
+ * Scheduling and cancelling a timer are O(1), and all the timers expiring on the same tick are collected together.
+ * The expired timers are executed on the thread running the IO service. Events assume they are all run by that single
+ * thread, so running the IO service on several threads is not supported.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class TimerWheel : public std::enable_shared_from_this<TimerWheel>
+{
+public:
+
+    //! Link of a timed event into the slot of the wheel where it waits.
+    struct Node
+    {
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        //! Tick on which the timer expires.
+        uint64_t expiration = 0;
+        //! Slot holding the node, or c_unlinked.
+        uint32_t slot = c_unlinked;
+        TimedEventImpl* event = nullptr;
+        //! State of the event when it was scheduled.
+        std::shared_ptr<TimerState> state;
+    };
+
+    /**
+     * Get the wheel of an IO service, creating it if needed.
+     * The wheel lives while there are references to it.
+     * @param service IO service whose threads run the expired timers.
+     * @return Shared pointer to the wheel.
+     */
+    static std::shared_ptr<TimerWheel> get(asio::io_service& service);
+
+    /**
+     * Constructor. Use get() to obtain the wheel shared by the events of an IO service.
+     * @param service IO service whose threads run the expired timers.
+     */
+    TimerWheel(asio::io_service& service);
+
+    ~TimerWheel();
+
+    /**
+     * Schedule a timer.
+     * @param node Node of the timed event. It should not be scheduled.
+     * @param interval Time from now until the timer expires.
+     */
+    void schedule(
+            Node& node,
+            std::chrono::microseconds interval);
+
+    /**
+     * Cancel a timer.
+     * @param node Node of the timed event.
+     * @return True if the timer was scheduled. False if it was not scheduled or it is already being executed.
+     */
+    bool cancel(Node& node);
+
+    /**
+     * Get the time remaining for a timer to expire.
+     * @param node Node of the timed event.
+     * @return Remaining time, or zero if the timer is not scheduled.
+     */
+    std::chrono::microseconds remaining(const Node& node);
+
+private:
+
+    static constexpr uint32_t c_unlinked = 0xFFFFFFFFu;
+    static constexpr uint32_t c_slot_bits = 8u;
+    static constexpr uint32_t c_slots_per_level = 1u << c_slot_bits;
+    static constexpr uint32_t c_levels = 4u;
+    static constexpr uint32_t c_overflow_slot = c_levels * c_slots_per_level;
+    static constexpr uint64_t c_no_tick = ~0ull;
+
+    typedef std::vector<std::pair<TimedEventImpl*, std::shared_ptr<TimerState>>> Batch;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    //! Tick corresponding to a point in time, rounded up.
+    uint64_t tick_of(std::chrono::steady_clock::time_point time) const;
+
+    //! Links a node in the slot corresponding to its expiration.
+    void link_nts(Node& node);
+
+    //! Unlinks a node from its slot.
+    void unlink_nts(Node& node);
+
+    //! Next tick on which a slot should be expired or moved down, or c_no_tick.
+    uint64_t next_tick_nts() const;
+
+    //! Processes the ticks up to the given one, collecting the expired timers.
+    void advance_nts(
+            uint64_t until,
+            Batch& expired);
+
+    //! Moves the nodes of a slot to the levels below.
+    void cascade_nts(uint32_t slot);
+
+    //! Arms the asio timer for the next tick to be processed, if it is earlier than the armed one.
+    void arm_nts();
+
+    //! Handler of the asio timer.
+    static void on_timer(
+            const std::weak_ptr<TimerWheel>& wheel,
+            const asio::error_code& ec);
+
+    //! Executes the expired timers, in the order they were collected.
+    static void execute(Batch& expired);
+
+    //! Position of the first occupied slot of a level at or after the given index, or c_slots_per_level.
+    uint32_t find_occupied(
+            uint32_t level,
+            uint32_t from) const;
+
+    asio::io_service& service_;
+    asio::steady_timer timer_;
+    std::chrono::steady_clock::time_point epoch_;
+
+    std::mutex mutex_;
+    //! Last processed tick.
+    uint64_t current_tick_;
+    //! Tick the asio timer is waiting for, or c_no_tick.
+    uint64_t armed_tick_;
+    //! Heads of the circular lists of each slot, followed by the overflow list.
+    std::array<Node*, c_overflow_slot + 1> slots_;
+    //! Occupied slots of each level.
+    std::array<uint64_t, c_levels * c_slots_per_level / 64u> occupied_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif // _RTPS_RESOURCES_TIMERWHEEL_H_
@@ -67,6 +67,11 @@ void PersistentWriter::remove_persistent_change(CacheChange_t* change)
     persistence_->remove_writer_change_from_storage(persistence_guid_, *change);
 }
 
+bool PersistentWriter::flush_persistent_changes()
+{
+    return persistence_->flush();
+}
+
 } /* namespace rtps */
 } /* namespace eprosima */
 }
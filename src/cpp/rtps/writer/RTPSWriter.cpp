@@ -18,6 +18,7 @@
  */
 
 #include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/history/WriterHistory.h>
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
 #include <fastrtps/log/Log.h>
@@ -51,6 +52,7 @@ RTPSWriter::RTPSWriter(
     , mp_listener(listen)
     , is_async_(att.mode == SYNCHRONOUS_WRITER ? false : true)
     , m_separateSendingEnabled(false)
+    , m_flowControllerPriority(att.throughputController.priority)
     , all_remote_readers_(att.matched_readers_allocation)
 #if HAVE_SECURITY
     , encrypt_payload_(mp_history->getTypeMaxSerialized())
@@ -184,6 +186,54 @@ void RTPSWriter::update_cached_info_nts(std::vector<LocatorList_t>& allLocatorLi
     mAllShrinkedLocatorList.push_back(mp_RTPSParticipant->network_factory().ShrinkLocatorLists(allLocatorLists));
 }
 
+RTPSReader* RTPSWriter::find_local_reader(const GUID_t& reader_guid)
+{
+    if (reader_guid.guidPrefix != m_guid.guidPrefix)
+    {
+        return nullptr;
+    }
+
+#if HAVE_SECURITY
+    if (getAttributes().security_attributes().is_submessage_protected ||
+        getAttributes().security_attributes().is_payload_protected)
+    {
+        return nullptr;
+    }
+#endif
+
+    RTPSReader* reader = mp_RTPSParticipant->find_local_reader(reader_guid);
+
+#if HAVE_SECURITY
+    if (reader != nullptr &&
+        (reader->getAttributes().security_attributes().is_submessage_protected ||
+         reader->getAttributes().security_attributes().is_payload_protected))
+    {
+        return nullptr;
+    }
+#endif
+
+    return reader;
+}
+
+void RTPSWriter::push_local_delivery(
+        RTPSReader* reader,
+        std::function<void()>&& delivery)
+{
+    mp_RTPSParticipant->local_delivery_queue().push(this, reader, std::move(delivery));
+}
+
+std::shared_ptr<CacheChange_t> RTPSWriter::copy_for_local_delivery(const CacheChange_t* change)
+{
+    std::shared_ptr<CacheChange_t> copy = std::make_shared<CacheChange_t>(change->serializedPayload.length);
+    if (!copy->copy(change))
+    {
+        logError(RTPS_WRITER, "Error copying change " << change->sequenceNumber << " for local readers");
+        return nullptr;
+    }
+
+    return copy;
+}
+
 #if HAVE_SECURITY
 bool RTPSWriter::encrypt_cachechange(CacheChange_t* change)
 {
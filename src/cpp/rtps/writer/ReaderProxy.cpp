@@ -41,12 +41,15 @@ ReaderProxy::ReaderProxy(
     : is_active_(false)
     , reader_attributes_()
     , writer_(writer)
+    , local_reader_(nullptr)
     , guid_as_vector_(ResourceLimitedContainerConfig::fixed_size_configuration(1u))
     , changes_for_reader_(resource_limits_from_history(writer->mp_history->m_att, 0))
     , nack_supression_event_(nullptr)
     , timers_enabled_(false)
     , last_acknack_count_(0)
     , last_nackfrag_count_(0)
+    , low_mark_heap_index_(0)
+    , counted_with_changes_(false)
 {
     nack_supression_event_ = std::make_shared <NackSupressionDuration>(writer_,
         TimeConv::Time_t2MilliSecondsDouble(times.nackSupressionDuration));
@@ -58,10 +61,13 @@ ReaderProxy::~ReaderProxy()
 {
 }
 
-void ReaderProxy::start(const RemoteReaderAttributes& reader_attributes)
+void ReaderProxy::start(
+        const RemoteReaderAttributes& reader_attributes,
+        RTPSReader* local_reader)
 {
     is_active_ = true;
     reader_attributes_ = reader_attributes;
+    local_reader_ = local_reader;
     guid_as_vector_.push_back(reader_attributes_.guid);
 
     reader_attributes_.endpoint.remoteLocatorList.assign(reader_attributes_.endpoint.unicastLocatorList);
@@ -77,6 +83,7 @@ void ReaderProxy::stop()
 {
     is_active_ = false;
     reader_attributes_.guid = c_Guid_Unknown;
+    local_reader_ = nullptr;
     disable_timers();
 
     changes_for_reader_.clear();
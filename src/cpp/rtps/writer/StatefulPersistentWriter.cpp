@@ -57,6 +57,11 @@ bool StatefulPersistentWriter::change_removed_by_history(CacheChange_t* change)
     return StatefulWriter::change_removed_by_history(change);
 }
 
+bool StatefulPersistentWriter::flush_persistence()
+{
+    return flush_persistent_changes();
+}
+
 } /* namespace rtps */
 } /* namespace eprosima */
 }
@@ -20,6 +20,8 @@
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 #include <fastrtps/rtps/writer/WriterListener.h>
 #include <fastrtps/rtps/writer/ReaderProxy.h>
+#include <fastrtps/rtps/reader/StatefulReader.h>
+#include <fastrtps/rtps/reader/WriterProxy.h>
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
 
 #include "../participant/RTPSParticipantImpl.h"
@@ -63,6 +65,9 @@ StatefulWriter::StatefulWriter(
     , m_times(att.times)
     , matched_readers_(att.matched_readers_allocation)
     , matched_readers_pool_(att.matched_readers_allocation)
+    , matched_readers_index_()
+    , low_mark_heap_(att.matched_readers_allocation)
+    , readers_with_changes_(0)
     , next_all_acked_notify_sequence_(0, 1)
     , all_acked_(false)
     , may_remove_change_cond_()
@@ -91,6 +96,7 @@ StatefulWriter::StatefulWriter(
                     pimpl->getUserRTPSParticipant()->get_resource_event().getThread());
     }
 
+    matched_readers_index_.reserve(att.matched_readers_allocation.initial);
     for (size_t n = 0; n < att.matched_readers_allocation.initial; ++n)
     {
         matched_readers_pool_.push_back(new ReaderProxy(m_times, this));
@@ -110,6 +116,9 @@ StatefulWriter::~StatefulWriter()
     }
 
     // Stop all active proxies and pass them to the pool
+    matched_readers_index_.clear();
+    low_mark_heap_.clear();
+    readers_with_changes_ = 0;
     while (!matched_readers_.empty())
     {
         ReaderProxy* remote_reader = matched_readers_.back();
@@ -187,13 +196,29 @@ void StatefulWriter::unsent_change_added_to_history(
 
                 changeForReader.setRelevance(it->rtps_is_relevant(change));
                 it->add_change(changeForReader, true);
+                update_acked_status_nts(it);
                 expectsInlineQos |= it->expects_inline_qos();
             }
 
+            // Readers of this participant get the change directly, once the mutex of this writer is released.
+            std::shared_ptr<CacheChange_t> local_change;
+            for (ReaderProxy* it : matched_readers_)
+            {
+                if (it->is_local_reader())
+                {
+                    if (!local_change)
+                    {
+                        local_change = copy_for_local_delivery(change);
+                    }
+                    deliver_to_local_reader_nts(it, local_change);
+                }
+            }
+
             try
             {
                 //At this point we are sure all information was stores. We now can send data.
-                if (!m_separateSendingEnabled)
+                //Nothing goes through the transports when all the readers are local.
+                if (!m_separateSendingEnabled && !all_remote_readers_.empty())
                 {
                     RTPSMessageGroup group(
                                 mp_RTPSParticipant,
@@ -211,10 +236,15 @@ void StatefulWriter::unsent_change_added_to_history(
                     uint32_t last_processed = 0;
                     send_heartbeat_piggyback_nts_(group, last_processed);
                 }
-                else
+                else if (m_separateSendingEnabled)
                 {
                     for (ReaderProxy* it : matched_readers_)
                     {
+                        if (it->is_local_reader())
+                        {
+                            continue;
+                        }
+
                         const std::vector<GUID_t>& guids = it->guid_as_vector();
                         const LocatorList_t& locators = it->remote_locators_shrinked();
                         RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
@@ -261,6 +291,7 @@ void StatefulWriter::unsent_change_added_to_history(
 
                 changeForReader.setRelevance(it->rtps_is_relevant(change));
                 it->add_change(changeForReader, false);
+                update_acked_status_nts(it);
             }
 
             if (m_pushMode)
@@ -302,6 +333,7 @@ bool StatefulWriter::change_removed_by_history(CacheChange_t* a_change)
     for(ReaderProxy* it : matched_readers_)
     {
         it->change_has_been_removed(sequence_number);
+        update_acked_status_nts(it);
     }
 
     may_remove_change_ = 2;
@@ -317,6 +349,15 @@ void StatefulWriter::send_any_unsent_changes()
     bool activateHeartbeatPeriod = false;
     SequenceNumber_t max_sequence = mp_history->next_sequence_number();
 
+    // Readers of this participant get their changes directly, without going through the flow controllers.
+    for (ReaderProxy* remoteReader : matched_readers_)
+    {
+        if (remoteReader->is_local_reader())
+        {
+            activateHeartbeatPeriod |= send_unsent_changes_to_local_reader_nts(remoteReader, max_sequence);
+        }
+    }
+
     // Separate sending for asynchronous writers
     if (m_pushMode && m_separateSendingEnabled)
     {
@@ -324,6 +365,11 @@ void StatefulWriter::send_any_unsent_changes()
         {
             for (ReaderProxy* remoteReader : matched_readers_)
             {
+                if (remoteReader->is_local_reader())
+                {
+                    continue;
+                }
+
                 try
                 {
                     // For possible GAP
@@ -400,6 +446,11 @@ void StatefulWriter::send_any_unsent_changes()
 
         for (ReaderProxy* remoteReader : matched_readers_)
         {
+            if (remoteReader->is_local_reader())
+            {
+                continue;
+            }
+
             auto unsent_change_process = [&](const SequenceNumber_t& seq_num, const ChangeForReader_t* unsentChange)
             {
                 if (unsentChange != nullptr && unsentChange->isRelevant() && unsentChange->isValid())
@@ -434,7 +485,7 @@ void StatefulWriter::send_any_unsent_changes()
             // Clear all relevant changes through the parent controllers
             for (std::unique_ptr<FlowController>& controller : mp_RTPSParticipant->getFlowControllers())
             {
-                (*controller)(relevantChanges);
+                (*controller)(relevantChanges, this);
             }
 
             try
@@ -553,6 +604,14 @@ void StatefulWriter::send_any_unsent_changes()
         }
         else
         {
+            for (ReaderProxy* remoteReader : matched_readers_)
+            {
+                if (remoteReader->is_local_reader())
+                {
+                    send_heartbeat_to_local_reader_nts(remoteReader);
+                }
+            }
+
             try
             {
                 RTPSMessageGroup group(
@@ -577,6 +636,12 @@ void StatefulWriter::send_any_unsent_changes()
         this->mp_periodicHB->restart_timer();
     }
 
+    // Sending may have acknowledged changes (best effort readers) and moved the low marks.
+    for (ReaderProxy* remoteReader : matched_readers_)
+    {
+        update_acked_status_nts(remoteReader);
+    }
+
     // On VOLATILE writers, remove auto-acked (best effort readers) changes
     check_acked_status();
 
@@ -595,20 +660,25 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         return false;
     }
 
-    std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
+    // Looked for before taking the writer mutex, as it takes the participant one.
+    RTPSReader* local_reader = find_local_reader(rdata.guid);
 
-    std::vector<LocatorList_t> allLocatorLists;
+    std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
 
     // Check if it is already matched.
+    if (find_matched_reader_nts(rdata.guid) != nullptr)
+    {
+        logInfo(RTPS_WRITER, "Attempting to add existing reader" << endl);
+        return false;
+    }
+
+    std::vector<LocatorList_t> allLocatorLists;
     for(ReaderProxy* it : matched_readers_)
     {
-        if(it->guid() == rdata.guid)
+        if (!it->is_local_reader())
         {
-            logInfo(RTPS_WRITER, "Attempting to add existing reader" << endl);
-            return false;
+            allLocatorLists.push_back(it->remote_locators());
         }
-
-        allLocatorLists.push_back(it->remote_locators());
     }
 
     // Get a reader proxy from the inactive pool (or create a new one if necessary and allowed)
@@ -633,20 +703,23 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
         matched_readers_pool_.pop_back();
     }
 
-    // Add info of new datareader.
-    all_remote_readers_.push_back(rdata.guid);
-    LocatorList_t locators(rdata.endpoint.unicastLocatorList);
-    locators.push_back(rdata.endpoint.multicastLocatorList);
-    allLocatorLists.push_back(locators);
+    // Add info of new datareader. Local readers are not reached through the transports.
+    if (local_reader == nullptr)
+    {
+        all_remote_readers_.push_back(rdata.guid);
+        LocatorList_t locators(rdata.endpoint.unicastLocatorList);
+        locators.push_back(rdata.endpoint.multicastLocatorList);
+        allLocatorLists.push_back(locators);
 
-    update_cached_info_nts(allLocatorLists);
+        update_cached_info_nts(allLocatorLists);
 
-    getRTPSParticipant()->createSenderResources(mAllShrinkedLocatorList, false);
+        getRTPSParticipant()->createSenderResources(mAllShrinkedLocatorList, false);
 
-    rdata.endpoint.unicastLocatorList =
-        mp_RTPSParticipant->network_factory().ShrinkLocatorLists({rdata.endpoint.unicastLocatorList});
+        rdata.endpoint.unicastLocatorList =
+            mp_RTPSParticipant->network_factory().ShrinkLocatorLists({rdata.endpoint.unicastLocatorList});
+    }
 
-    rp->start(rdata);
+    rp->start(rdata, local_reader);
     std::set<SequenceNumber_t> not_relevant_changes;
 
     SequenceNumber_t current_seq = get_seq_num_min();
@@ -697,35 +770,43 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
             ++current_seq;
         }
 
-        try
+        if (rp->is_local_reader())
         {
-            const std::vector<GUID_t>& guids = rp->guid_as_vector();
-            const LocatorList_t& locatorsList = rp->remote_locators_shrinked();
-            RTPSMessageGroup group(
-                        mp_RTPSParticipant,
-                        this,
-                        RTPSMessageGroup::WRITER,
-                        m_cdrmessages,
-                        locatorsList,
-                        guids);
-
-            // Send initial heartbeat
-            send_heartbeat_nts_(
-                        guids,
-                        locatorsList,
-                        group,
-                        disable_positive_acks_);
+            send_gap_to_local_reader_nts(rp, not_relevant_changes);
+            send_heartbeat_to_local_reader_nts(rp);
+        }
+        else
+        {
+            try
+            {
+                const std::vector<GUID_t>& guids = rp->guid_as_vector();
+                const LocatorList_t& locatorsList = rp->remote_locators_shrinked();
+                RTPSMessageGroup group(
+                            mp_RTPSParticipant,
+                            this,
+                            RTPSMessageGroup::WRITER,
+                            m_cdrmessages,
+                            locatorsList,
+                            guids);
 
-            // Send Gap
-            if(!not_relevant_changes.empty())
+                // Send initial heartbeat
+                send_heartbeat_nts_(
+                            guids,
+                            locatorsList,
+                            group,
+                            disable_positive_acks_);
+
+                // Send Gap
+                if(!not_relevant_changes.empty())
+                {
+                    group.add_gap(not_relevant_changes, guids, locatorsList);
+                }
+            }
+            catch(const RTPSMessageGroup::timeout&)
             {
-                group.add_gap(not_relevant_changes, guids, locatorsList);
+                logError(RTPS_WRITER, "Max blocking time reached");
             }
         }
-        catch(const RTPSMessageGroup::timeout&)
-        {
-            logError(RTPS_WRITER, "Max blocking time reached");
-        }
 
         // Always activate heartbeat period. We need a confirmation of the reader.
         // The state has to be updated.
@@ -737,6 +818,8 @@ bool StatefulWriter::matched_reader_add(RemoteReaderAttributes& rdata)
     }
 
     matched_readers_.push_back(rp);
+    matched_readers_index_[rp->guid()] = rp;
+    low_mark_heap_add_nts(rp);
 
     logInfo(RTPS_WRITER, "Reader Proxy "<< rp->guid()<< " added to " << this->m_guid.entityId << " with "
             <<rp->reader_attributes().endpoint.unicastLocatorList.size()<<"(u)-"
@@ -760,11 +843,16 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
             logInfo(RTPS_WRITER, "Reader Proxy removed: " << (*it)->guid());
             rproxy = std::move(*it);
             it = matched_readers_.erase(it);
+            matched_readers_index_.erase(rdata.guid);
+            low_mark_heap_remove_nts(rproxy);
 
             continue;
         }
 
-        allLocatorLists.push_back((*it)->remote_locators());
+        if (!(*it)->is_local_reader())
+        {
+            allLocatorLists.push_back((*it)->remote_locators());
+        }
         ++it;
     }
 
@@ -793,28 +881,154 @@ bool StatefulWriter::matched_reader_remove(const RemoteReaderAttributes& rdata)
 bool StatefulWriter::matched_reader_is_matched(const RemoteReaderAttributes& rdata)
 {
     std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
-    for(ReaderProxy* it : matched_readers_)
+    return find_matched_reader_nts(rdata.guid) != nullptr;
+}
+
+bool StatefulWriter::matched_reader_lookup(GUID_t& readerGuid,ReaderProxy** RP)
+{
+    std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
+    ReaderProxy* reader = find_matched_reader_nts(readerGuid);
+    if(reader != nullptr)
+    {
+        *RP = reader;
+        return true;
+    }
+    return false;
+}
+
+ReaderProxy* StatefulWriter::find_matched_reader_nts(const GUID_t& reader_guid) const
+{
+    auto it = matched_readers_index_.find(reader_guid);
+    return it != matched_readers_index_.end() ? it->second : nullptr;
+}
+
+SequenceNumber_t StatefulWriter::min_low_mark_nts() const
+{
+    return low_mark_heap_.empty() ? SequenceNumber_t() : low_mark_heap_.front()->changes_low_mark();
+}
+
+void StatefulWriter::low_mark_heap_add_nts(ReaderProxy* reader)
+{
+    reader->low_mark_heap_index_ = low_mark_heap_.size();
+    reader->counted_with_changes_ = false;
+    low_mark_heap_.push_back(reader);
+    update_acked_status_nts(reader);
+}
+
+void StatefulWriter::low_mark_heap_remove_nts(ReaderProxy* reader)
+{
+    size_t index = reader->low_mark_heap_index_;
+    assert(index < low_mark_heap_.size() && low_mark_heap_[index] == reader);
+
+    size_t last = low_mark_heap_.size() - 1;
+    if (index != last)
+    {
+        low_mark_heap_swap_nts(index, last);
+    }
+    low_mark_heap_.pop_back();
+    if (index < low_mark_heap_.size())
+    {
+        low_mark_heap_sift_nts(index);
+    }
+
+    if (reader->counted_with_changes_)
+    {
+        reader->counted_with_changes_ = false;
+        --readers_with_changes_;
+    }
+}
+
+void StatefulWriter::update_acked_status_nts(ReaderProxy* reader)
+{
+    size_t index = reader->low_mark_heap_index_;
+    if (index >= low_mark_heap_.size() || low_mark_heap_[index] != reader)
     {
-        if(it->guid() == rdata.guid)
+        // Proxy not active yet (it is being matched)
+        return;
+    }
+
+    bool has_changes = reader->has_changes();
+    if (has_changes != reader->counted_with_changes_)
+    {
+        reader->counted_with_changes_ = has_changes;
+        if (has_changes)
         {
-            return true;
+            ++readers_with_changes_;
+        }
+        else
+        {
+            --readers_with_changes_;
         }
     }
-    return false;
+
+    low_mark_heap_sift_nts(index);
 }
 
-bool StatefulWriter::matched_reader_lookup(GUID_t& readerGuid,ReaderProxy** RP)
+void StatefulWriter::low_mark_heap_sift_nts(size_t index)
 {
-    std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
-    for(ReaderProxy* it : matched_readers_)
+    // Only the low mark of the proxy at index may have changed, so it is moved either up or down.
+    while (index > 0)
     {
-        if(it->guid() == readerGuid)
+        size_t parent = (index - 1) / 2;
+        if (!(low_mark_heap_[index]->changes_low_mark() < low_mark_heap_[parent]->changes_low_mark()))
         {
-            *RP = it;
-            return true;
+            break;
         }
+        low_mark_heap_swap_nts(index, parent);
+        index = parent;
+    }
+
+    size_t size = low_mark_heap_.size();
+    while (true)
+    {
+        size_t lowest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < size && low_mark_heap_[left]->changes_low_mark() < low_mark_heap_[lowest]->changes_low_mark())
+        {
+            lowest = left;
+        }
+        if (right < size && low_mark_heap_[right]->changes_low_mark() < low_mark_heap_[lowest]->changes_low_mark())
+        {
+            lowest = right;
+        }
+        if (lowest == index)
+        {
+            break;
+        }
+        low_mark_heap_swap_nts(index, lowest);
+        index = lowest;
     }
-    return false;
+}
+
+void StatefulWriter::low_mark_heap_swap_nts(
+        size_t first,
+        size_t second)
+{
+    std::swap(low_mark_heap_[first], low_mark_heap_[second]);
+    low_mark_heap_[first]->low_mark_heap_index_ = first;
+    low_mark_heap_[second]->low_mark_heap_index_ = second;
+}
+
+bool StatefulWriter::change_is_acked_by_subtree_nts(
+        const SequenceNumber_t& seq_num,
+        size_t index) const
+{
+    if (index >= low_mark_heap_.size())
+    {
+        return true;
+    }
+
+    // Readers below this one in the heap have a higher low mark, so they acknowledged the change too.
+    const ReaderProxy* reader = low_mark_heap_[index];
+    if (seq_num <= reader->changes_low_mark())
+    {
+        return true;
+    }
+
+    return reader->change_is_acked(seq_num) &&
+           change_is_acked_by_subtree_nts(seq_num, 2 * index + 1) &&
+           change_is_acked_by_subtree_nts(seq_num, 2 * index + 2);
 }
 
 bool StatefulWriter::is_acked_by_all(const CacheChange_t* change) const
@@ -828,11 +1042,7 @@ bool StatefulWriter::is_acked_by_all(const CacheChange_t* change) const
     }
 
     assert(mp_history->next_sequence_number() > change->sequenceNumber);
-    return std::all_of(matched_readers_.begin(), matched_readers_.end(),
-        [change](const ReaderProxy* reader)
-        {
-            return reader->change_is_acked(change->sequenceNumber);
-        });
+    return change_is_acked_by_subtree_nts(change->sequenceNumber, 0);
 }
 
 bool StatefulWriter::wait_for_all_acked(const Duration_t& max_wait)
@@ -840,11 +1050,7 @@ bool StatefulWriter::wait_for_all_acked(const Duration_t& max_wait)
     std::unique_lock<std::recursive_timed_mutex> lock(mp_mutex);
     std::unique_lock<std::mutex> all_acked_lock(all_acked_mutex_);
 
-    all_acked_ = std::none_of(matched_readers_.begin(), matched_readers_.end(),
-        [](const ReaderProxy* reader)
-        {
-            return reader->has_changes();
-        });
+    all_acked_ = readers_with_changes_ == 0;
     lock.unlock();
 
     if(!all_acked_)
@@ -860,22 +1066,8 @@ void StatefulWriter::check_acked_status()
 {
     std::unique_lock<std::recursive_timed_mutex> lock(mp_mutex);
 
-    bool all_acked = true;
-    SequenceNumber_t min_low_mark;
-
-    for(const ReaderProxy* it : matched_readers_)
-    {
-        SequenceNumber_t reader_low_mark = it->changes_low_mark();
-        if(min_low_mark == SequenceNumber_t() || reader_low_mark < min_low_mark)
-        {
-            min_low_mark = reader_low_mark;
-        }
-
-        if(it->has_changes())
-        {
-            all_acked = false;
-        }
-    }
+    bool all_acked = readers_with_changes_ == 0;
+    SequenceNumber_t min_low_mark = min_low_mark_nts();
 
     if(get_seq_num_min() != SequenceNumber_t::unknown())
     {
@@ -922,16 +1114,7 @@ bool StatefulWriter::try_remove_change(
 {
     logInfo(RTPS_WRITER, "Starting process try remove change for writer " << getGuid());
 
-    SequenceNumber_t min_low_mark;
-
-    for(ReaderProxy* it : matched_readers_)
-    {
-        SequenceNumber_t reader_low_mark = it->changes_low_mark();
-        if (min_low_mark == SequenceNumber_t() || reader_low_mark < min_low_mark)
-        {
-            min_low_mark = reader_low_mark;
-        }
-    }
+    SequenceNumber_t min_low_mark = min_low_mark_nts();
 
     SequenceNumber_t calc = min_low_mark < get_seq_num_min() ? SequenceNumber_t() :
         (min_low_mark - get_seq_num_min()) + 1;
@@ -1045,19 +1228,30 @@ bool StatefulWriter::send_periodic_heartbeat()
 
             if (unacked_changes)
             {
-                try
+                for (ReaderProxy* it : matched_readers_)
                 {
-                    RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
-                        mAllShrinkedLocatorList, all_remote_readers_);
-                    send_heartbeat_nts_(
-                                all_remote_readers_,
-                                mAllShrinkedLocatorList,
-                                group,
-                                disable_positive_acks_);
+                    if (it->is_local_reader() && it->has_unacknowledged())
+                    {
+                        send_heartbeat_to_local_reader_nts(it);
+                    }
                 }
-                catch(const RTPSMessageGroup::timeout&)
+
+                if (!all_remote_readers_.empty())
                 {
-                    logError(RTPS_WRITER, "Max blocking time reached");
+                    try
+                    {
+                        RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
+                            mAllShrinkedLocatorList, all_remote_readers_);
+                        send_heartbeat_nts_(
+                                    all_remote_readers_,
+                                    mAllShrinkedLocatorList,
+                                    group,
+                                    disable_positive_acks_);
+                    }
+                    catch(const RTPSMessageGroup::timeout&)
+                    {
+                        logError(RTPS_WRITER, "Max blocking time reached");
+                    }
                 }
             }
         }
@@ -1068,6 +1262,12 @@ bool StatefulWriter::send_periodic_heartbeat()
 
 void StatefulWriter::send_heartbeat_to_nts(ReaderProxy& remoteReaderProxy)
 {
+    if (remoteReaderProxy.is_local_reader())
+    {
+        send_heartbeat_to_local_reader_nts(&remoteReaderProxy);
+        return;
+    }
+
     try
     {
         const std::vector<GUID_t>& guids = remoteReaderProxy.guid_as_vector();
@@ -1087,6 +1287,196 @@ void StatefulWriter::send_heartbeat_to_nts(ReaderProxy& remoteReaderProxy)
     }
 }
 
+void StatefulWriter::deliver_to_local_reader_nts(
+        ReaderProxy* reader,
+        const std::shared_ptr<CacheChange_t>& change)
+{
+    push_local_data_nts(reader, change);
+
+    if (reader->is_reliable())
+    {
+        push_local_acknowledgement_nts(reader);
+    }
+}
+
+bool StatefulWriter::send_unsent_changes_to_local_reader_nts(
+        ReaderProxy* reader,
+        const SequenceNumber_t& max_sequence)
+{
+    bool is_reliable = reader->is_reliable();
+    bool delivered = false;
+    std::set<SequenceNumber_t> irrelevant;
+
+    // Statuses are changed once the collection has been walked, as best-effort changes are removed when sent.
+    std::vector<std::pair<SequenceNumber_t, CacheChange_t*>> unsent_changes;
+    std::vector<SequenceNumber_t> pull_changes;
+    auto unsent_change_process = [&](const SequenceNumber_t& seq_num, const ChangeForReader_t* unsentChange)
+    {
+        if (unsentChange != nullptr && unsentChange->isRelevant() && unsentChange->isValid())
+        {
+            if (m_pushMode)
+            {
+                unsent_changes.emplace_back(seq_num, unsentChange->getChange());
+            }
+            else // Change status to UNACKNOWLEDGED
+            {
+                pull_changes.push_back(seq_num);
+            }
+        }
+        else
+        {
+            unsent_changes.emplace_back(seq_num, nullptr);
+        }
+    };
+    reader->for_each_unsent_change(max_sequence, unsent_change_process);
+
+    for (const SequenceNumber_t& seq_num : pull_changes)
+    {
+        reader->set_change_to_status(seq_num, UNACKNOWLEDGED, false);
+    }
+
+    for (const std::pair<SequenceNumber_t, CacheChange_t*>& unsent_change : unsent_changes)
+    {
+        reader->set_change_to_status(unsent_change.first, UNDERWAY, true);
+        if (unsent_change.second != nullptr)
+        {
+            push_local_data_nts(reader, copy_for_local_delivery(unsent_change.second));
+            delivered = true;
+        }
+        else if (is_reliable)
+        {
+            irrelevant.emplace(unsent_change.first);
+        }
+    }
+
+    send_gap_to_local_reader_nts(reader, irrelevant);
+
+    if (is_reliable && (delivered || !irrelevant.empty()))
+    {
+        push_local_acknowledgement_nts(reader);
+    }
+
+    return is_reliable && delivered;
+}
+
+void StatefulWriter::send_gap_to_local_reader_nts(
+        ReaderProxy* reader,
+        const std::set<SequenceNumber_t>& irrelevant)
+{
+    RTPSReader* local_reader = reader->local_reader();
+    GUID_t writer_guid = m_guid;
+    auto it = irrelevant.begin();
+    while (it != irrelevant.end())
+    {
+        // One GAP for each run of consecutive sequence numbers
+        SequenceNumber_t gap_start = *it;
+        SequenceNumber_t gap_end = *it;
+        while (++it != irrelevant.end() && *it == gap_end + 1)
+        {
+            gap_end = *it;
+        }
+
+        SequenceNumberSet_t gap_list(gap_end + 1);
+        push_local_delivery(local_reader, [local_reader, writer_guid, gap_start, gap_list]() mutable
+                {
+                    local_reader->processGapMsg(writer_guid, gap_start, gap_list);
+                });
+    }
+}
+
+void StatefulWriter::send_heartbeat_to_local_reader_nts(ReaderProxy* reader)
+{
+    if (!reader->has_changes())
+    {
+        return;
+    }
+
+    SequenceNumber_t first_seq = get_seq_num_min();
+    SequenceNumber_t last_seq = get_seq_num_max();
+    if (first_seq == c_SequenceNumber_Unknown || last_seq == c_SequenceNumber_Unknown)
+    {
+        first_seq = next_sequence_number();
+        last_seq = first_seq - 1;
+    }
+
+    incrementHBCount();
+
+    // The reader answers through the transports, so changes it misses are requested as with any other reader.
+    RTPSReader* local_reader = reader->local_reader();
+    GUID_t writer_guid = m_guid;
+    Count_t count = m_heartbeatCount;
+    bool final_flag = disable_positive_acks_;
+    push_local_delivery(local_reader, [this, local_reader, writer_guid, count, first_seq, last_seq, final_flag]() mutable
+            {
+                // Changes the reader already has are acknowledged before it decides what to request.
+                acknowledge_local_reader(local_reader);
+                local_reader->processHeartbeatMsg(writer_guid, count, first_seq, last_seq, final_flag, false);
+            });
+}
+
+void StatefulWriter::push_local_data_nts(
+        ReaderProxy* reader,
+        const std::shared_ptr<CacheChange_t>& change)
+{
+    if (!change)
+    {
+        return;
+    }
+
+    RTPSReader* local_reader = reader->local_reader();
+    push_local_delivery(local_reader, [local_reader, change]()
+            {
+                if (!local_reader->processDataMsg(change.get()))
+                {
+                    logWarning(RTPS_WRITER, "Local reader " << local_reader->getGuid() << " could not take change " <<
+                            change->sequenceNumber);
+                }
+            });
+}
+
+void StatefulWriter::push_local_acknowledgement_nts(ReaderProxy* reader)
+{
+    RTPSReader* local_reader = reader->local_reader();
+    push_local_delivery(local_reader, [this, local_reader]()
+            {
+                acknowledge_local_reader(local_reader);
+            });
+}
+
+void StatefulWriter::acknowledge_local_reader(RTPSReader* local_reader)
+{
+    StatefulReader* stateful_reader = dynamic_cast<StatefulReader*>(local_reader);
+    if (stateful_reader == nullptr)
+    {
+        return;
+    }
+
+    // The mutex of the reader is released before taking the one of this writer, as a remote ACKNACK would be.
+    SequenceNumber_t received;
+    {
+        std::lock_guard<std::recursive_timed_mutex> guard(stateful_reader->getMutex());
+        WriterProxy* writer_proxy = nullptr;
+        if (!stateful_reader->matched_writer_lookup(m_guid, &writer_proxy))
+        {
+            // Not matched with this writer yet. The reader will acknowledge the changes through the transports.
+            return;
+        }
+        received = writer_proxy->available_changes_max();
+    }
+
+    std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
+    ReaderProxy* reader = find_matched_reader_nts(local_reader->getGuid());
+    if (reader != nullptr && received > reader->changes_low_mark())
+    {
+        reader->acked_changes_set(received + 1);
+        update_acked_status_nts(reader);
+
+        // Check if all CacheChange are acknowledge, because a user could be waiting
+        // for this, of if VOLATILE should be removed CacheChanges
+        check_acked_status();
+    }
+}
+
 void StatefulWriter::send_heartbeat_nts_(
     const std::vector<GUID_t>& remote_readers,
     const LocatorList_t& locators,
@@ -1196,14 +1586,11 @@ void StatefulWriter::perform_nack_supression(const GUID_t& reader_guid)
 {
     std::unique_lock<std::recursive_timed_mutex> lock(mp_mutex);
 
-    for (ReaderProxy* remote_reader : matched_readers_)
+    ReaderProxy* remote_reader = find_matched_reader_nts(reader_guid);
+    if (remote_reader != nullptr)
     {
-        if (remote_reader->guid() == reader_guid)
-        {
-            remote_reader->perform_nack_supression();
-            mp_periodicHB->restart_timer();
-            return;
-        }
+        remote_reader->perform_nack_supression();
+        mp_periodicHB->restart_timer();
     }
 }
 
@@ -1219,37 +1606,32 @@ bool StatefulWriter::process_acknack(
     result = (m_guid == writer_guid);
     if (result)
     {
-        for (ReaderProxy* remote_reader : matched_readers_)
+        ReaderProxy* remote_reader = find_matched_reader_nts(reader_guid);
+        if (remote_reader != nullptr && remote_reader->check_and_set_acknack_count(ack_count))
         {
-            if (remote_reader->guid() == reader_guid)
+            // Sequence numbers before Base are set as Acknowledged.
+            remote_reader->acked_changes_set(sn_set.base());
+            update_acked_status_nts(remote_reader);
+            if (sn_set.base() > SequenceNumber_t(0, 0))
             {
-                if (remote_reader->check_and_set_acknack_count(ack_count))
+                if (remote_reader->requested_changes_set(sn_set))
                 {
-                    // Sequence numbers before Base are set as Acknowledged.
-                    remote_reader->acked_changes_set(sn_set.base());
-                    if (sn_set.base() > SequenceNumber_t(0, 0))
-                    {
-                        if (remote_reader->requested_changes_set(sn_set))
-                        {
-                            nack_response_event_->restart_timer();
-                        }
-                        else if (!final_flag)
-                        {
-                            mp_periodicHB->restart_timer();
-                        }
-                    }
-                    else if (sn_set.empty() && !final_flag)
-                    {
-                        // This is the preemptive acknack. Always send heartbeat
-                        send_heartbeat_to_nts(*remote_reader);
-                    }
-
-                    // Check if all CacheChange are acknowledge, because a user could be waiting
-                    // for this, of if VOLATILE should be removed CacheChanges
-                    check_acked_status();
+                    nack_response_event_->restart_timer();
+                }
+                else if (!final_flag)
+                {
+                    mp_periodicHB->restart_timer();
                 }
-                break;
             }
+            else if (sn_set.empty() && !final_flag)
+            {
+                // This is the preemptive acknack. Always send heartbeat
+                send_heartbeat_to_nts(*remote_reader);
+            }
+
+            // Check if all CacheChange are acknowledge, because a user could be waiting
+            // for this, of if VOLATILE should be removed CacheChanges
+            check_acked_status();
         }
     }
 
@@ -1269,16 +1651,11 @@ bool StatefulWriter::process_nack_frag(
     if (m_guid == writer_guid)
     {
         result = true;
-        for (ReaderProxy* remote_reader : matched_readers_)
+        ReaderProxy* remote_reader = find_matched_reader_nts(reader_guid);
+        if (remote_reader != nullptr &&
+                remote_reader->process_nack_frag(reader_guid, ack_count, seq_num, fragments_state))
         {
-            if (remote_reader->guid() == reader_guid)
-            {
-                if (remote_reader->process_nack_frag(reader_guid, ack_count, seq_num, fragments_state))
-                {
-                    nack_response_event_->restart_timer();
-                }
-                break;
-            }
+            nack_response_event_->restart_timer();
         }
     }
 
@@ -1306,6 +1683,7 @@ void StatefulWriter::ack_timer_expired()
             if (remote_reader->reader_attributes().disable_positive_acks)
             {
                 remote_reader->acked_changes_set(last_sequence_number_ + 1);
+                update_acked_status_nts(remote_reader);
             }
         }
         last_sequence_number_++;
@@ -57,6 +57,11 @@ bool StatelessPersistentWriter::change_removed_by_history(CacheChange_t* change)
     return StatelessWriter::change_removed_by_history(change);
 }
 
+bool StatelessPersistentWriter::flush_persistence()
+{
+    return flush_persistent_changes();
+}
+
 } /* namespace rtps */
 } /* namespace eprosima */
 }
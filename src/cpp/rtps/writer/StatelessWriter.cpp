@@ -21,6 +21,7 @@
 #include <fastrtps/rtps/writer/WriterListener.h>
 #include <fastrtps/rtps/history/WriterHistory.h>
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
 #include "../participant/RTPSParticipantImpl.h"
 #include "../flowcontrol/FlowController.h"
 #include "../history/HistoryAttributesExtension.hpp"
@@ -50,6 +51,7 @@ StatelessWriter::StatelessWriter(
           history,
           listener)
     , matched_readers_(attributes.matched_readers_allocation)
+    , local_readers_(attributes.matched_readers_allocation)
     , unsent_changes_(resource_limits_from_history(history->m_att))
 {
     get_builtin_guid(all_remote_readers_);
@@ -102,6 +104,16 @@ void StatelessWriter::unsent_change_added_to_history(
 {
     std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
 
+    // Readers of this participant get the change directly, whether the writer is asynchronous or not.
+    if (!local_readers_.empty())
+    {
+        std::shared_ptr<CacheChange_t> local_change = copy_for_local_delivery(change);
+        for (RTPSReader* reader : local_readers_)
+        {
+            deliver_to_local_reader_nts(reader, local_change);
+        }
+    }
+
     if (!mAllShrinkedLocatorList.empty())
     {
 #if HAVE_SECURITY
@@ -119,6 +131,11 @@ void StatelessWriter::unsent_change_added_to_history(
                     std::vector<GUID_t> guids(1);
                     for (const RemoteReaderAttributes& it : matched_readers_)
                     {
+                        if (is_local_reader_nts(it.guid))
+                        {
+                            continue;
+                        }
+
                         guids.at(0) = it.guid;
                         RTPSMessageGroup group(mp_RTPSParticipant, this, RTPSMessageGroup::WRITER, m_cdrmessages,
                                 it.endpoint.unicastLocatorList, guids, max_blocking_time);
@@ -256,7 +273,7 @@ void StatelessWriter::send_any_unsent_changes()
     // Clear through parent controllers
     for (auto& controller : mp_RTPSParticipant->getFlowControllers())
     {
-        (*controller)(changesToSend);
+        (*controller)(changesToSend, this);
     }
 
     try
@@ -315,6 +332,9 @@ void StatelessWriter::send_any_unsent_changes()
 
 bool StatelessWriter::matched_reader_add(RemoteReaderAttributes& reader_attributes)
 {
+    // Looked for before taking the writer mutex, as it takes the participant one.
+    RTPSReader* local_reader = find_local_reader(reader_attributes.guid);
+
     std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
 
     std::vector<LocatorList_t> allLocatorLists;
@@ -328,9 +348,35 @@ bool StatelessWriter::matched_reader_add(RemoteReaderAttributes& reader_attribut
             return false;
         }
 
-        LocatorList_t locators(reader.endpoint.unicastLocatorList);
-        locators.push_back(reader.endpoint.multicastLocatorList);
-        allLocatorLists.push_back(locators);
+        if (!is_local_reader_nts(reader.guid))
+        {
+            LocatorList_t locators(reader.endpoint.unicastLocatorList);
+            locators.push_back(reader.endpoint.multicastLocatorList);
+            allLocatorLists.push_back(locators);
+        }
+    }
+
+    if (local_reader != nullptr)
+    {
+        if (local_readers_.push_back(local_reader) == nullptr)
+        {
+            logWarning(RTPS_WRITER, "Maximum number of matched readers reached for writer " << m_guid);
+            return false;
+        }
+
+        matched_readers_.push_back(reader_attributes);
+
+        // Local readers are not reached through the transports, so they get the history directly.
+        if (reader_attributes.endpoint.durabilityKind >= TRANSIENT_LOCAL)
+        {
+            for (auto cit = mp_history->changesBegin(); cit != mp_history->changesEnd(); ++cit)
+            {
+                deliver_to_local_reader_nts(local_reader, copy_for_local_delivery(*cit));
+            }
+        }
+
+        logInfo(RTPS_READER,"Local reader " << reader_attributes.guid << " added to "<<m_guid.entityId);
+        return true;
     }
 
     // Add info of new datareader.
@@ -404,8 +450,18 @@ bool StatelessWriter::matched_reader_remove(const RemoteReaderAttributes& reader
         bool addGuid = !has_builtin_guid();
         is_inline_qos_expected_ = false;
 
+        local_readers_.remove_if([&reader_attributes](const RTPSReader* reader)
+        {
+            return reader->getGuid() == reader_attributes.guid;
+        });
+
         for (const RemoteReaderAttributes& rit : matched_readers_)
         {
+            if (is_local_reader_nts(rit.guid))
+            {
+                continue;
+            }
+
             LocatorList_t locators(rit.endpoint.unicastLocatorList);
             locators.push_back(rit.endpoint.multicastLocatorList);
             allLocatorLists.push_back(locators);
@@ -430,6 +486,33 @@ bool StatelessWriter::matched_reader_is_matched(const RemoteReaderAttributes& re
     return std::any_of(matched_readers_.begin(), matched_readers_.end(), reader_attributes.compare_guid_function());
 }
 
+void StatelessWriter::deliver_to_local_reader_nts(
+        RTPSReader* reader,
+        const std::shared_ptr<CacheChange_t>& change)
+{
+    if (!change)
+    {
+        return;
+    }
+
+    push_local_delivery(reader, [reader, change]()
+            {
+                if (!reader->processDataMsg(change.get()))
+                {
+                    logWarning(RTPS_WRITER, "Local reader " << reader->getGuid() << " could not take change " <<
+                            change->sequenceNumber);
+                }
+            });
+}
+
+bool StatelessWriter::is_local_reader_nts(const GUID_t& reader_guid) const
+{
+    return std::any_of(local_readers_.begin(), local_readers_.end(), [&reader_guid](const RTPSReader* reader)
+    {
+        return reader->getGuid() == reader_guid;
+    });
+}
+
 void StatelessWriter::unsent_changes_reset()
 {
     std::lock_guard<std::recursive_timed_mutex> guard(mp_mutex);
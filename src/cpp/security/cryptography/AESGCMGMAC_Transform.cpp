@@ -23,15 +23,9 @@
 
 #include <openssl/aes.h>
 #include <openssl/evp.h>
-#include <openssl/rand.h>
+#include <openssl/hmac.h>
 #include <cstring>
 
-#if OPENSSL_VERSION_NUMBER >= 0x10100000L
-#define IS_OPENSSL_1_1 1
-#else
-#define IS_OPENSSL_1_1 0
-#endif
-
  // Solve error with Win32 macro
 #ifdef WIN32
 #undef max
@@ -42,6 +36,33 @@ using namespace eprosima::fastrtps::rtps::security;
 
 CONSTEXPR int initialization_vector_suffix_length = 8;
 
+/*
+ * The suffix of the initialization vector is the number of the block in the current session. The session key changes
+ * when the counter is reset, so a pair of key and initialization vector is never repeated.
+ */
+static void build_initialization_vector(uint32_t session_id, uint64_t session_block_counter,
+        std::array<uint8_t, initialization_vector_suffix_length>& initialization_vector_suffix,
+        std::array<uint8_t, 12>& initialization_vector)
+{
+    memcpy(initialization_vector_suffix.data(), &session_block_counter, initialization_vector_suffix_length);
+    memcpy(initialization_vector.data(), &session_id, 4);
+    memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), initialization_vector_suffix_length);
+}
+
+static const EVP_CIPHER* get_cipher(const CryptoTransformKind& transformation_kind)
+{
+    if(transformation_kind == c_transfrom_kind_aes128_gcm || transformation_kind == c_transfrom_kind_aes128_gmac)
+    {
+        return EVP_aes_128_gcm();
+    }
+    else if(transformation_kind == c_transfrom_kind_aes256_gcm || transformation_kind == c_transfrom_kind_aes256_gmac)
+    {
+        return EVP_aes_256_gcm();
+    }
+
+    return nullptr;
+}
+
 static KeyMaterial_AES_GCM_GMAC* find_key(KeyMaterial_AES_GCM_GMAC_Seq& keys, const CryptoTransformIdentifier& id)
 {
     for (auto& it : keys)
@@ -112,10 +133,9 @@ bool AESGCMGMAC_Transform::encode_serialized_payload(
 
     //Build NONCE elements (Build once, use once)
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
-    RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t, 12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(session->session_id),4);
-    memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
+    build_initialization_vector(session->session_id, session->session_block_counter, initialization_vector_suffix,
+            initialization_vector);
     std::array<uint8_t, 4> session_id;
     memcpy(session_id.data(), &(session->session_id), 4);
 
@@ -137,7 +157,7 @@ bool AESGCMGMAC_Transform::encode_serialized_payload(
     try
     {
         if(!serialize_SecureDataBody(serializer, keyMat.transformation_kind, session->SessionKey,
-                    initialization_vector, output_buffer, payload.data, payload.length, tag, false))
+                    session->cipher, initialization_vector, output_buffer, payload.data, payload.length, tag, false))
         {
             return false;
         }
@@ -215,10 +235,9 @@ bool AESGCMGMAC_Transform::encode_datawriter_submessage(
 
     //Build remaining NONCE elements
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
-    RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t,12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(session->session_id),4);
-    memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
+    build_initialization_vector(session->session_id, session->session_block_counter, initialization_vector_suffix,
+            initialization_vector);
     std::array<uint8_t, 4> session_id;
     memcpy(session_id.data(), &(session->session_id), 4);
 
@@ -262,7 +281,7 @@ bool AESGCMGMAC_Transform::encode_datawriter_submessage(
     try
     {
         if(!serialize_SecureDataBody(serializer, keyMat.transformation_kind, session->SessionKey,
-                    initialization_vector, output_buffer, &plain_rtps_submessage.buffer[plain_rtps_submessage.pos],
+                    session->cipher, initialization_vector, output_buffer, &plain_rtps_submessage.buffer[plain_rtps_submessage.pos],
                     plain_rtps_submessage.length - plain_rtps_submessage.pos, tag, true))
         {
             return false;
@@ -352,10 +371,9 @@ bool AESGCMGMAC_Transform::encode_datareader_submessage(
 
     //Build remaining NONCE elements
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
-    RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t,12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(session->session_id),4);
-    memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
+    build_initialization_vector(session->session_id, session->session_block_counter, initialization_vector_suffix,
+            initialization_vector);
     std::array<uint8_t, 4> session_id;
     memcpy(session_id.data(), &(session->session_id), 4);
 
@@ -399,7 +417,7 @@ bool AESGCMGMAC_Transform::encode_datareader_submessage(
     try
     {
         if(!serialize_SecureDataBody(serializer, local_reader->EntityKeyMaterial.at(0).transformation_kind, session->SessionKey,
-                    initialization_vector, output_buffer, &plain_rtps_submessage.buffer[plain_rtps_submessage.pos],
+                    session->cipher, initialization_vector, output_buffer, &plain_rtps_submessage.buffer[plain_rtps_submessage.pos],
                     plain_rtps_submessage.length - plain_rtps_submessage.pos, tag, true))
         {
             return false;
@@ -491,10 +509,9 @@ bool AESGCMGMAC_Transform::encode_rtps_message(
 
     //Build remaining NONCE elements
     std::array<uint8_t, initialization_vector_suffix_length> initialization_vector_suffix;  //iv suffix changes with every operation
-    RAND_bytes(initialization_vector_suffix.data(), initialization_vector_suffix_length);
     std::array<uint8_t,12> initialization_vector; //96 bytes, session_id + suffix
-    memcpy(initialization_vector.data(),&(local_participant->session_id),4);
-    memcpy(initialization_vector.data() + 4, initialization_vector_suffix.data(), 8);
+    build_initialization_vector(local_participant->session_id, local_participant->session_block_counter,
+            initialization_vector_suffix, initialization_vector);
     std::array<uint8_t, 4> session_id;
     memcpy(session_id.data(), &(local_participant->session_id), 4);
 
@@ -538,7 +555,7 @@ bool AESGCMGMAC_Transform::encode_rtps_message(
     try
     {
         if(!serialize_SecureDataBody(serializer, local_participant->ParticipantKeyMaterial.transformation_kind, local_participant->SessionKey,
-                    initialization_vector, output_buffer, &plain_rtps_message.buffer[plain_rtps_message.pos],
+                    local_participant->SessionCipher, initialization_vector, output_buffer, &plain_rtps_message.buffer[plain_rtps_message.pos],
                     plain_rtps_message.length - plain_rtps_message.pos, tag, true))
         {
             return false;
@@ -667,11 +684,8 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
     uint32_t session_id;
     memcpy(&session_id, header.session_id.data(), 4);
 
-    //Sessionkey
-    std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key,
-            sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0),
-            session_id);
+    //Sessionkey, cached with its cipher context in the sending participant
+    std::unique_lock<std::mutex> lock(sending_participant->ReceivedSessions.mutex_);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -757,7 +771,7 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).receiver_specific_key_id,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).master_receiver_specific_key,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).master_salt,
-                initialization_vector, session_id, exception))
+                initialization_vector, session_id, sending_participant->ReceivedSessions, exception))
         {
             return false;
         }
@@ -777,8 +791,10 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
     uint32_t length = plain_buffer.max_size - plain_buffer.pos;
     if(!deserialize_SecureDataBody(decoder, is_encrypted ? body_state : protected_body_state, tag, 
         is_encrypted ? body_length : body_length + 4,
-        sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).transformation_kind, 
-        session_key, initialization_vector,
+        sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).transformation_kind,
+        get_received_session_key(sending_participant->ReceivedSessions,
+            sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0), session_id),
+        initialization_vector,
         &plain_buffer.buffer[plain_buffer.pos], length))
     {
         logWarning(SECURITY_CRYPTO, "Error decoding content");
@@ -1039,9 +1055,8 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
 
     uint32_t session_id;
     memcpy(&session_id,header.session_id.data(),4);
-    //Sessionkey
-    std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key, *keyMat, session_id);
+    //Sessionkey, cached with its cipher context in the sending entity
+    std::unique_lock<std::mutex> lock(sending_writer->ReceivedSessions.mutex_);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1099,7 +1114,7 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
                 keyMat->receiver_specific_key_id,
                 keyMat->master_receiver_specific_key,
                 keyMat->master_salt,
-                initialization_vector, session_id, exception))
+                initialization_vector, session_id, sending_writer->ReceivedSessions, exception))
         {
             return false;
         }
@@ -1119,7 +1134,8 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
     uint32_t length = plain_rtps_submessage.max_size - plain_rtps_submessage.pos;
     if(!deserialize_SecureDataBody(decoder, is_encrypted ? body_state : protected_body_state, tag,
         is_encrypted ? body_length : body_length + 4,
-        keyMat->transformation_kind, session_key, initialization_vector,
+        keyMat->transformation_kind,
+        get_received_session_key(sending_writer->ReceivedSessions, *keyMat, session_id), initialization_vector,
         &plain_rtps_submessage.buffer[plain_rtps_submessage.pos], length))
     {
         logWarning(SECURITY_CRYPTO, "Error decoding content");
@@ -1217,9 +1233,8 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
 
     uint32_t session_id;
     memcpy(&session_id,header.session_id.data(),4);
-    //Sessionkey
-    std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key, *keyMat, session_id);
+    //Sessionkey, cached with its cipher context in the sending entity
+    std::unique_lock<std::mutex> lock(sending_reader->ReceivedSessions.mutex_);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1277,7 +1292,7 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
                 keyMat->receiver_specific_key_id,
                 keyMat->master_receiver_specific_key,
                 keyMat->master_salt,
-                initialization_vector, session_id, exception))
+                initialization_vector, session_id, sending_reader->ReceivedSessions, exception))
         {
             return false;
         }
@@ -1297,7 +1312,8 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
     uint32_t length = plain_rtps_submessage.max_size - plain_rtps_submessage.pos;
     if(!deserialize_SecureDataBody(decoder, is_encrypted ? body_state : protected_body_state, tag,
         is_encrypted ? body_length : body_length + 4,
-        keyMat->transformation_kind, session_key, initialization_vector,
+        keyMat->transformation_kind,
+        get_received_session_key(sending_reader->ReceivedSessions, *keyMat, session_id), initialization_vector,
         &plain_rtps_submessage.buffer[plain_rtps_submessage.pos], length))
     {
         logWarning(SECURITY_CRYPTO, "Error decoding content");
@@ -1371,9 +1387,8 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
     uint32_t session_id;
     memcpy(&session_id, header.session_id.data(), 4);
 
-    //Sessionkey
-    std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key, *keyMat, session_id);
+    //Sessionkey, cached with its cipher context in the sending entity
+    std::unique_lock<std::mutex> lock(sending_writer->ReceivedSessions.mutex_);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1412,7 +1427,7 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
     // Tag
     try
     {
-        deserialize_SecureDataTag(decoder, tag, {}, {}, {}, {}, {}, 0, exception);
+        deserialize_SecureDataTag(decoder, tag, {}, {}, {}, {}, {}, 0, sending_writer->ReceivedSessions, exception);
     }
     catch(eprosima::fastcdr::exception::NotEnoughMemoryException&)
     {
@@ -1422,7 +1437,8 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
 
     uint32_t length = plain_payload.max_size;
     if(!deserialize_SecureDataBody(decoder, protected_body_state, tag, body_length,
-        keyMat->transformation_kind, session_key, initialization_vector,
+        keyMat->transformation_kind,
+        get_received_session_key(sending_writer->ReceivedSessions, *keyMat, session_id), initialization_vector,
         plain_payload.data, length))
     {
         logWarning(SECURITY_CRYPTO, "Error decoding content");
@@ -1468,28 +1484,41 @@ void AESGCMGMAC_Transform::compute_sessionkey(std::array<uint8_t, 32>& session_k
     memcpy(source + sourceLen, &session_id, 4);
     sourceLen += 4;
 
-    EVP_PKEY *key = EVP_PKEY_new_mac_key(EVP_PKEY_HMAC, NULL, master_key.data(), key_len);
-    EVP_MD_CTX* ctx =
-#if IS_OPENSSL_1_1
-        EVP_MD_CTX_new();
-#else
-        (EVP_MD_CTX*)malloc(sizeof(EVP_MD_CTX));
-#endif
-    EVP_MD_CTX_init(ctx);
-    EVP_DigestSignInit(ctx, NULL, EVP_sha256(), NULL, key);
-    EVP_DigestSignUpdate(ctx, source, sourceLen);
+    // One-shot HMAC, without creating a key and a digest context for every derivation.
+    unsigned int finalLen = static_cast<unsigned int>(session_key.size());
+    HMAC(EVP_sha256(), master_key.data(), key_len, source, static_cast<size_t>(sourceLen), session_key.data(),
+            &finalLen);
+}
+
+ReceivedSessionKey& AESGCMGMAC_Transform::get_received_session_key(ReceivedSessionKeys& sessions,
+        bool receiver_specific, const std::array<uint8_t, 32>& master_key, const std::array<uint8_t, 32>& master_salt,
+        const uint32_t session_id, int key_len)
+{
+    ReceivedSessionKey* key = sessions.find(receiver_specific, master_key, master_salt, session_id, key_len);
+    if(key == nullptr)
+    {
+        key = &sessions.replace();
+        compute_sessionkey(key->SessionKey, receiver_specific, master_key, master_salt, session_id, key_len);
+        key->receiver_specific = receiver_specific;
+        key->key_len = key_len;
+        key->session_id = session_id;
+        key->master_key = master_key;
+        key->master_salt = master_salt;
+        key->valid = true;
+    }
 
-    size_t finalLen;
-    EVP_DigestSignFinal(ctx, NULL, &finalLen);
-    EVP_DigestSignFinal(ctx, session_key.data(), &finalLen);
+    return *key;
+}
 
-    EVP_PKEY_free(key);
-#if IS_OPENSSL_1_1
-    EVP_MD_CTX_free(ctx);
-#else
-    EVP_MD_CTX_cleanup(ctx);
-    free(ctx);
-#endif
+ReceivedSessionKey& AESGCMGMAC_Transform::get_received_session_key(ReceivedSessionKeys& sessions,
+        const KeyMaterial_AES_GCM_GMAC& key_mat, const uint32_t session_id)
+{
+    bool use_256_bits = (key_mat.transformation_kind == c_transfrom_kind_aes256_gcm ||
+        key_mat.transformation_kind == c_transfrom_kind_aes256_gmac);
+    int key_len = use_256_bits ? 32 : 16;
+
+    return get_received_session_key(sessions, false, key_mat.master_sender_key, key_mat.master_salt, session_id,
+            key_len);
 }
 
 void AESGCMGMAC_Transform::serialize_SecureDataHeader(eprosima::fastcdr::Cdr& serializer,
@@ -1501,7 +1530,7 @@ void AESGCMGMAC_Transform::serialize_SecureDataHeader(eprosima::fastcdr::Cdr& se
 
 bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& serializer,
         const std::array<uint8_t, 4>& transformation_kind, const std::array<uint8_t,32>& session_key,
-        const std::array<uint8_t, 12>& initialization_vector,
+        CipherContext& cipher, const std::array<uint8_t, 12>& initialization_vector,
         eprosima::fastcdr::FastBuffer& output_buffer, octet* plain_buffer, uint32_t plain_buffer_len,
         SecureDataTag& tag, bool submessage)
 {
@@ -1512,31 +1541,15 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
 
     // AES_BLOCK_SIZE = 16
     int cipher_block_size = 0, actual_size = 0, final_size = 0;
-    EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-    if (!use_256_bits)
+    const EVP_CIPHER* e_cipher = use_256_bits ? EVP_aes_256_gcm() : EVP_aes_128_gcm();
+    EVP_CIPHER_CTX* e_ctx = cipher.init(e_cipher, session_key, initialization_vector, true);
+    if (e_ctx == nullptr)
     {
-        if (!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(session_key.data()),
-            initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_128_gcm());
+        logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
+        return false;
     }
-    else
-    {
-        if (!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(session_key.data()),
-            initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
-            return false;
-        }
 
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
-    }
+    cipher_block_size = EVP_CIPHER_block_size(e_cipher);
 
     if (!do_encryption)
     {
@@ -1545,7 +1558,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
             plain_buffer_len)
         {
             logError(SECURITY_CRYPTO, "Not enough memory to copy payload");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
         memcpy(serializer.getCurrentPosition(), plain_buffer, plain_buffer_len);
@@ -1554,14 +1566,12 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
         if (!EVP_EncryptUpdate(e_ctx, nullptr, &actual_size, plain_buffer, static_cast<int>(plain_buffer_len)))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
-        if (!EVP_EncryptFinal(e_ctx, nullptr, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, nullptr, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
     }
@@ -1602,7 +1612,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
             (plain_buffer_len + (2 * cipher_block_size) - 1))
         {
             logError(SECURITY_CRYPTO, "Not enough memory to cipher payload");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
@@ -1610,14 +1619,12 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
             static_cast<int>(plain_buffer_len)))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
-        if (!EVP_EncryptFinal(e_ctx, output_buffer_raw, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, output_buffer_raw, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
@@ -1642,7 +1649,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
 
     // Get commmon_mac
     EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
-    EVP_CIPHER_CTX_free(e_ctx);
 
     if (submessage)
     {
@@ -1719,45 +1725,28 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
 
         //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
         int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-        if(transformation_kind == c_transfrom_kind_aes128_gcm ||
-                transformation_kind == c_transfrom_kind_aes128_gmac)
-        {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
-                        initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
-        }
-        else if(transformation_kind == c_transfrom_kind_aes256_gcm ||
-                transformation_kind == c_transfrom_kind_aes256_gmac)
+        const EVP_CIPHER* e_cipher = get_cipher(transformation_kind);
+        EVP_CIPHER_CTX* e_ctx = e_cipher == nullptr ? nullptr :
+            remote_entity->Sessions[sessionIndex].cipher.init(e_cipher, remote_entity->Sessions[sessionIndex].SessionKey,
+                    initialization_vector, true);
+        if(e_ctx == nullptr)
         {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
-                        initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
+            continue;
         }
         if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
-        if(!EVP_EncryptFinal(e_ctx, NULL, &final_size))
+        if(!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
         serializer << remote_entity->Remote2EntityKeyMaterial.at(0).receiver_specific_key_id;
         EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, serializer.getCurrentPosition());
         serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
 
         ++length;
     }
@@ -1823,46 +1812,27 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
 
         //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
         int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
-        auto& trans_kind = remote_participant->Participant2ParticipantKeyMaterial.at(0).transformation_kind;
-        if(trans_kind == c_transfrom_kind_aes128_gcm ||
-            trans_kind == c_transfrom_kind_aes128_gmac)
-        {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
-                        initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
-        }
-        else if(trans_kind == c_transfrom_kind_aes256_gcm ||
-            trans_kind == c_transfrom_kind_aes256_gmac)
+        const EVP_CIPHER* e_cipher = get_cipher(remote_participant->Participant2ParticipantKeyMaterial.at(0).transformation_kind);
+        EVP_CIPHER_CTX* e_ctx = e_cipher == nullptr ? nullptr :
+            remote_participant->SessionCipher.init(e_cipher, remote_participant->SessionKey, initialization_vector, true);
+        if(e_ctx == nullptr)
         {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
-                        initialization_vector.data()))
-            {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
-                continue;
-            }
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
+            continue;
         }
         if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
-        if(!EVP_EncryptFinal(e_ctx, NULL, &final_size))
+        if(!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
         serializer << remote_participant->Participant2ParticipantKeyMaterial.at(0).receiver_specific_key_id;
         EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, serializer.getCurrentPosition());
         serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
 
         ++length;
     }
@@ -1887,7 +1857,7 @@ SecureDataHeader AESGCMGMAC_Transform::deserialize_SecureDataHeader(eprosima::fa
 bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& decoder,
         eprosima::fastcdr::Cdr::state& body_state, SecureDataTag& tag, const uint32_t body_length,
         const std::array<uint8_t, 4> transformation_kind,
-        const std::array<uint8_t,32>& session_key, const std::array<uint8_t, 12>& initialization_vector,
+        ReceivedSessionKey& session_key, const std::array<uint8_t, 12>& initialization_vector,
         octet* plain_buffer, uint32_t& plain_buffer_len)
 {
     eprosima::fastcdr::Cdr::state current_state = decoder.getState();
@@ -1898,30 +1868,14 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
     bool use_256_bits = (transformation_kind == c_transfrom_kind_aes256_gcm ||
         transformation_kind == c_transfrom_kind_aes256_gmac);
 
-    EVP_CIPHER_CTX *d_ctx = EVP_CIPHER_CTX_new();
-    int cipher_block_size = 0, actual_size = 0, final_size = 0;
-
-    if(!use_256_bits)
-    {
-        if(!EVP_DecryptInit(d_ctx, EVP_aes_128_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
-            return false;
-        }
+    const EVP_CIPHER* d_cipher = use_256_bits ? EVP_aes_256_gcm() : EVP_aes_128_gcm();
+    int cipher_block_size = EVP_CIPHER_block_size(d_cipher), actual_size = 0, final_size = 0;
 
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_128_gcm());
-    }
-    else
+    EVP_CIPHER_CTX* d_ctx = session_key.cipher.init(d_cipher, session_key.SessionKey, initialization_vector, false);
+    if(d_ctx == nullptr)
     {
-        if(!EVP_DecryptInit(d_ctx, EVP_aes_256_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data()))
-        {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
-            return false;
-        }
-
-        cipher_block_size = EVP_CIPHER_block_size(EVP_aes_256_gcm());
+        logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_CipherInit_ex function returns an error");
+        return false;
     }
 
     uint32_t protected_len = body_length;
@@ -1934,7 +1888,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
         if (plain_buffer_len < (protected_len + cipher_block_size))
         {
             logWarning(SECURITY_CRYPTO, "Not enough memory to decode payload");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
     }
@@ -1944,19 +1897,16 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
     if(!EVP_DecryptUpdate(d_ctx, output_buffer, &actual_size, input_buffer, protected_len))
     {
         logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptUpdate function returns an error");
-        EVP_CIPHER_CTX_free(d_ctx);
         return false;
     }
 
     EVP_CIPHER_CTX_ctrl(d_ctx, EVP_CTRL_GCM_SET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
 
-    if(!EVP_DecryptFinal(d_ctx, output_buffer, &final_size))
+    if(!EVP_DecryptFinal_ex(d_ctx, output_buffer, &final_size))
     {
-        logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptFinal function returns an error");
-        EVP_CIPHER_CTX_free(d_ctx);
+        logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptFinal_ex function returns an error");
         return false;
     }
-    EVP_CIPHER_CTX_free(d_ctx);
 
     uint32_t cnt_len = do_encryption ? static_cast<uint32_t>(actual_size + final_size) : body_length;
     if (plain_buffer_len < cnt_len)
@@ -2017,7 +1967,7 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         const CryptoTransformKind& transformation_kind,
         const CryptoTransformKeyId& receiver_specific_key_id, const std::array<uint8_t, 32>& receiver_specific_key,
         const std::array<uint8_t,32>& master_salt, const std::array<uint8_t,12>& initialization_vector,
-        const uint32_t session_id, SecurityException& exception)
+        const uint32_t session_id, ReceivedSessionKeys& sessions, SecurityException& exception)
 {
     decoder >> tag.common_mac;
 
@@ -2050,15 +2000,10 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         }
 
         //Auth message - The point is that we cannot verify the authorship of the message with our receiver_specific_key the message could be crafted
-        EVP_CIPHER_CTX* d_ctx = EVP_CIPHER_CTX_new();
         const EVP_CIPHER* d_cipher = nullptr;
 
         int actual_size = 0, final_size = 0;
 
-        //Get ReceiverSpecificSessionKey
-        std::array<uint8_t, 32> specific_session_key;
-        compute_sessionkey(specific_session_key, true, receiver_specific_key, master_salt, session_id);
-
         //Verify specific MAC
         if(transformation_kind == c_transfrom_kind_aes128_gcm ||
                 transformation_kind == c_transfrom_kind_aes128_gmac)
@@ -2073,40 +2018,38 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         else
         {
             logError(SECURITY_CRYPTO, "Invalid transformation kind)");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
-        if(!EVP_DecryptInit(d_ctx, d_cipher, (const unsigned char *)specific_session_key.data(),
-                    initialization_vector.data()))
+        //Get ReceiverSpecificSessionKey
+        ReceivedSessionKey& specific_session_key = get_received_session_key(sessions, true, receiver_specific_key,
+                master_salt, session_id);
+
+        EVP_CIPHER_CTX* d_ctx = specific_session_key.cipher.init(d_cipher, specific_session_key.SessionKey,
+                initialization_vector, false);
+        if(d_ctx == nullptr)
         {
-            logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
+            logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_CipherInit_ex function returns an error");
             return false;
         }
 
         if(!EVP_DecryptUpdate(d_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
         if (!EVP_CIPHER_CTX_ctrl(d_ctx, EVP_CTRL_GCM_SET_TAG, 16, tag.receiver_mac.data()))
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_CIPHER_CTX_ctrl function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
         if(!EVP_DecryptFinal_ex(d_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptFinal_ex function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
-
-        EVP_CIPHER_CTX_free(d_ctx);
     }
 
     return true;
@@ -118,6 +118,21 @@ class AESGCMGMAC_Transform : public CryptoTransform
         const KeyMaterial_AES_GCM_GMAC& key, 
         const uint32_t session_id);
 
+    //Returns the session key of a received message, deriving it only for the first message of each session.
+    //The mutex of sessions should be locked while the returned key is in use.
+    ReceivedSessionKey& get_received_session_key(
+        ReceivedSessionKeys& sessions,
+        bool receiver_specific,
+        const std::array<uint8_t, 32>& master_key,
+        const std::array<uint8_t, 32>& master_salt,
+        const uint32_t session_id,
+        int key_len = 32);
+
+    ReceivedSessionKey& get_received_session_key(
+        ReceivedSessionKeys& sessions,
+        const KeyMaterial_AES_GCM_GMAC& key,
+        const uint32_t session_id);
+
     //Serialization and deserialization of message components
     void serialize_SecureDataHeader(eprosima::fastcdr::Cdr& serializer,
             const CryptoTransformKind& transformation_kind, const CryptoTransformKeyId& transformation_key_id,
@@ -125,7 +140,7 @@ class AESGCMGMAC_Transform : public CryptoTransform
 
     bool serialize_SecureDataBody(eprosima::fastcdr::Cdr& serializer,
             const std::array<uint8_t, 4>& transformation_kind, const std::array<uint8_t,32>& session_key,
-            const std::array<uint8_t, 12>& initialization_vector,
+            CipherContext& cipher, const std::array<uint8_t, 12>& initialization_vector,
             eprosima::fastcdr::FastBuffer& output_buffer, octet* plain_buffer, uint32_t plain_buffer_len,
             SecureDataTag& tag, bool submessage);
 
@@ -155,14 +170,14 @@ class AESGCMGMAC_Transform : public CryptoTransform
     bool deserialize_SecureDataBody(eprosima::fastcdr::Cdr& decoder,
             eprosima::fastcdr::Cdr::state& body_state, SecureDataTag& tag, uint32_t body_length,
             const std::array<uint8_t, 4> transformation_kind,
-            const std::array<uint8_t,32>& session_key, const std::array<uint8_t, 12>& initialization_vector,
+            ReceivedSessionKey& session_key, const std::array<uint8_t, 12>& initialization_vector,
             octet* plain_buffer, uint32_t& plain_buffer_len);
 
     bool deserialize_SecureDataTag(eprosima::fastcdr::Cdr& decoder, SecureDataTag& tag,
             const CryptoTransformKind& transformation_kind,
             const CryptoTransformKeyId& receiver_specific_key_id, const std::array<uint8_t, 32>& receiver_specific_key,
             const std::array<uint8_t,32>& master_salt, const std::array<uint8_t,12>& initialization_vector,
-            uint32_t session_id, SecurityException& exception);
+            uint32_t session_id, ReceivedSessionKeys& sessions, SecurityException& exception);
 
     uint32_t calculate_extra_size_for_rtps_message(uint32_t number_discovered_participants) const override;
 
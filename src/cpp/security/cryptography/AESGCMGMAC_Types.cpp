@@ -24,3 +24,68 @@ using namespace eprosima::fastrtps::rtps::security;
 
 const char* const ParticipantKeyHandle::class_id_ = "ParticipantCryptohandle";
 const char * const EntityKeyHandle::class_id_ = "EntityCryptohandle";
+
+CipherContext::~CipherContext()
+{
+    if(ctx_ != nullptr)
+    {
+        EVP_CIPHER_CTX_free(ctx_);
+    }
+}
+
+EVP_CIPHER_CTX* CipherContext::init(const EVP_CIPHER* cipher, const std::array<uint8_t, 32>& key,
+        const std::array<uint8_t, 12>& initialization_vector, bool encrypt)
+{
+    if(ctx_ == nullptr)
+    {
+        ctx_ = EVP_CIPHER_CTX_new();
+        if(ctx_ == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    if(cipher != cipher_ || encrypt != encrypt_ || key != key_)
+    {
+        // Forget the key until the context is initialized with the new one.
+        cipher_ = nullptr;
+        if(!EVP_CipherInit_ex(ctx_, cipher, nullptr, key.data(), nullptr, encrypt ? 1 : 0))
+        {
+            return nullptr;
+        }
+        cipher_ = cipher;
+        encrypt_ = encrypt;
+        key_ = key;
+    }
+
+    // Only the initialization vector changes, the key schedule is kept.
+    if(!EVP_CipherInit_ex(ctx_, nullptr, nullptr, nullptr, initialization_vector.data(), encrypt ? 1 : 0))
+    {
+        return nullptr;
+    }
+
+    return ctx_;
+}
+
+ReceivedSessionKey* ReceivedSessionKeys::find(bool receiver_specific, const std::array<uint8_t, 32>& master_key,
+        const std::array<uint8_t, 32>& master_salt, uint32_t session_id, int key_len)
+{
+    for(ReceivedSessionKey& key : keys_)
+    {
+        if(key.valid && key.session_id == session_id && key.receiver_specific == receiver_specific &&
+                key.key_len == key_len && key.master_key == master_key && key.master_salt == master_salt)
+        {
+            return &key;
+        }
+    }
+
+    return nullptr;
+}
+
+ReceivedSessionKey& ReceivedSessionKeys::replace()
+{
+    ReceivedSessionKey& key = keys_[next_];
+    next_ = (next_ + 1) % max_sessions;
+    key.valid = false;
+    return key;
+}
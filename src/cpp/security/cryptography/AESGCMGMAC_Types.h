@@ -26,6 +26,9 @@
 #include <fastrtps/rtps/security/accesscontrol/ParticipantSecurityAttributes.h>
 #include <fastrtps/rtps/security/accesscontrol/EndpointSecurityAttributes.h>
 
+#include <openssl/evp.h>
+
+#include <array>
 #include <mutex>
 #include <limits>
 
@@ -126,15 +129,95 @@ struct SecureDataTag{
  * Note: the common key of the remote cryptohandle is stored along with the specific keys. KeyMaterial->master_sender_key
  */
 
+/* Cipher contexts
+ * ---------------
+ * Initializing an AES-GCM context expands the key and precomputes the GHASH tables. A CipherContext keeps the context
+ * initialized with the last key it was given, so the messages protected with the same session key only set their
+ * initialization vector.
+ * A CipherContext is not thread safe, it is protected by the mutex of the structure holding it.
+ */
+class CipherContext
+{
+    public:
+
+        CipherContext() : ctx_(nullptr), cipher_(nullptr), encrypt_(true), key_{} {}
+
+        ~CipherContext();
+
+        /*!
+         * Prepares the context to process a new message.
+         * @param cipher AES-GCM cipher to use.
+         * @param key Session key. The key schedule is only computed when it changes.
+         * @param initialization_vector Initialization vector of the message.
+         * @param encrypt Whether the context encrypts or decrypts.
+         * @return Pointer to the context, or nullptr on error.
+         */
+        EVP_CIPHER_CTX* init(const EVP_CIPHER* cipher, const std::array<uint8_t, 32>& key,
+                const std::array<uint8_t, 12>& initialization_vector, bool encrypt);
+
+    private:
+
+        CipherContext(const CipherContext&) = delete;
+        CipherContext& operator=(const CipherContext&) = delete;
+
+        EVP_CIPHER_CTX* ctx_;
+        const EVP_CIPHER* cipher_;
+        bool encrypt_;
+        std::array<uint8_t, 32> key_;
+};
+
 struct KeySessionData
 {
     uint32_t session_id;
     std::array<uint8_t, 32> SessionKey;
     uint64_t session_block_counter;
+    //Context initialized with SessionKey
+    CipherContext cipher;
 
     KeySessionData() : session_id(std::numeric_limits<uint32_t>::max()), session_block_counter(0) {}
 };
 
+/* Session keys derived to decode the messages received from a remote element.
+ * The keys of the last sessions are kept along with a context initialized with each of them, as the messages of a
+ * session may still arrive after the first message of the next one.
+ */
+struct ReceivedSessionKey
+{
+    bool valid;
+    bool receiver_specific;
+    int key_len;
+    uint32_t session_id;
+    std::array<uint8_t, 32> master_key;
+    std::array<uint8_t, 32> master_salt;
+    std::array<uint8_t, 32> SessionKey;
+    CipherContext cipher;
+
+    ReceivedSessionKey() : valid(false), receiver_specific(false), key_len(0), session_id(0) {}
+};
+
+class ReceivedSessionKeys
+{
+    public:
+
+        static const size_t max_sessions = 4;
+
+        ReceivedSessionKeys() : next_(0) {}
+
+        //! Returns the cached key derived with these parameters, or nullptr. mutex_ should be locked.
+        ReceivedSessionKey* find(bool receiver_specific, const std::array<uint8_t, 32>& master_key,
+                const std::array<uint8_t, 32>& master_salt, uint32_t session_id, int key_len);
+
+        //! Returns the entry where a new key has to be stored, replacing the oldest one. mutex_ should be locked.
+        ReceivedSessionKey& replace();
+
+        std::mutex mutex_;
+
+    private:
+
+        std::array<ReceivedSessionKey, max_sessions> keys_;
+        size_t next_;
+};
+
 class  EntityKeyHandle
 {
     public:
@@ -166,6 +249,9 @@ class  EntityKeyHandle
         KeySessionData Sessions[2];
         uint64_t max_blocks_per_session;
         std::mutex mutex_;
+
+        //Session keys of the messages received from the remote entity, not used in LocalCryptoHandles
+        ReceivedSessionKeys ReceivedSessions;
 };
 typedef HandleImpl<EntityKeyHandle> AESGCMGMAC_WriterCryptoHandle;
 typedef HandleImpl<EntityKeyHandle> AESGCMGMAC_ReaderCryptoHandle;
@@ -204,6 +290,12 @@ class  ParticipantKeyHandle
         uint64_t session_block_counter;
         uint64_t max_blocks_per_session;
         std::mutex mutex_;
+        //Context initialized with SessionKey
+        CipherContext SessionCipher;
+
+        //Session keys of the messages received from the remote participant, not used in LocalCryptoHandles.
+        //Mutable because messages are decoded through const handles.
+        mutable ReceivedSessionKeys ReceivedSessions;
 };
 
 typedef HandleImpl<ParticipantKeyHandle> AESGCMGMAC_ParticipantCryptoHandle;
@@ -0,0 +1,73 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoanedSamples.cpp
+ *
+ */
+
+#include <fastrtps/subscriber/LoanedSamples.h>
+#include <fastrtps/subscriber/SubscriberHistory.h>
+
+using namespace eprosima::fastrtps;
+
+LoanedSamples::~LoanedSamples()
+{
+    if (history_ != nullptr)
+    {
+        history_->return_loan(*this);
+    }
+}
+
+LoanedSamples::LoanedSamples(LoanedSamples&& other)
+    : history_(other.history_)
+    , changes_(std::move(other.changes_))
+    , samples_(std::move(other.samples_))
+    , infos_(std::move(other.infos_))
+{
+    if (history_ != nullptr)
+    {
+        history_->move_loan(&other, this);
+        other.history_ = nullptr;
+    }
+    other.changes_.clear();
+    other.samples_.clear();
+    other.infos_.clear();
+}
+
+LoanedSamples& LoanedSamples::operator=(LoanedSamples&& other)
+{
+    if (this != &other)
+    {
+        if (history_ != nullptr)
+        {
+            history_->return_loan(*this);
+        }
+
+        history_ = other.history_;
+        changes_ = std::move(other.changes_);
+        samples_ = std::move(other.samples_);
+        infos_ = std::move(other.infos_);
+        if (history_ != nullptr)
+        {
+            history_->move_loan(&other, this);
+            other.history_ = nullptr;
+        }
+        other.changes_.clear();
+        other.samples_.clear();
+        other.infos_.clear();
+    }
+
+    return *this;
+}
@@ -59,6 +59,25 @@ bool Subscriber::isInCleanState() const
     return mp_impl->isInCleanState();
 }
 
+bool Subscriber::read_loaned(
+        LoanedSamples& samples,
+        size_t max_samples)
+{
+    return mp_impl->read_loaned(samples, max_samples);
+}
+
+bool Subscriber::take_loaned(
+        LoanedSamples& samples,
+        size_t max_samples)
+{
+    return mp_impl->take_loaned(samples, max_samples);
+}
+
+bool Subscriber::return_loan(LoanedSamples& samples)
+{
+    return mp_impl->return_loan(samples);
+}
+
 uint64_t Subscriber::getUnreadCount() const
 {
 	return mp_impl->getUnreadCount();
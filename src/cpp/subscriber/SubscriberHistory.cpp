@@ -67,6 +67,19 @@ SubscriberHistory::SubscriberHistory(
 
 SubscriberHistory::~SubscriberHistory()
 {
+    // The payloads of the outstanding loans are released with the history
+    if (!loaned_sequences_.empty())
+    {
+        logWarning(SUBSCRIBER, "Removing a subscriber with " << loaned_sequences_.size() << " loans not returned");
+    }
+    for (LoanedSamples* samples : loaned_sequences_)
+    {
+        samples->changes_.clear();
+        samples->samples_.clear();
+        samples->infos_.clear();
+        samples->history_ = nullptr;
+    }
+
     if (mp_subImpl->getType()->m_isGetKeyDefined)
     {
         mp_subImpl->getType()->deleteData(mp_getKeyObject);
@@ -93,14 +106,14 @@ bool SubscriberHistory::received_change(
         if (m_historyQos.kind == KEEP_ALL_HISTORY_QOS)
         {
             // TODO(Ricardo) Check
-            if (m_changes.size() + unknown_missing_changes_up_to < (size_t)m_resourceLimitsQos.max_samples)
+            if (getHistorySize() + unknown_missing_changes_up_to < (size_t)m_resourceLimitsQos.max_samples)
             {
                 add = true;
             }
         }
         else if (m_historyQos.kind == KEEP_LAST_HISTORY_QOS)
         {
-            if (m_changes.size() < (size_t)m_historyQos.depth)
+            if (getHistorySize() < (size_t)m_historyQos.depth)
             {
                 add = true;
             }
@@ -111,7 +124,7 @@ bool SubscriberHistory::received_change(
                 // Try to substitute a older samples.
                 CacheChange_t* older = nullptr;
 
-                for (auto it = m_changes.begin(); it != m_changes.end(); ++it)
+                for (auto it = changesBegin(); it != changesEnd(); ++it)
                 {
                     if ((*it)->writerGUID == a_change->writerGUID &&
                         (*it)->sequenceNumber < a_change->sequenceNumber)
@@ -149,7 +162,7 @@ bool SubscriberHistory::received_change(
             if (this->add_change(a_change))
             {
                 increaseUnreadCount();
-                if ((int32_t)m_changes.size() == m_resourceLimitsQos.max_samples)
+                if ((int32_t)getHistorySize() == m_resourceLimitsQos.max_samples)
                     m_isHistoryFull = true;
                 logInfo(SUBSCRIBER, this->mp_subImpl->getGuid().entityId
                     << ": Change " << a_change->sequenceNumber << " added from: "
@@ -247,7 +260,7 @@ bool SubscriberHistory::received_change(
                 if (this->add_change(a_change))
                 {
                     increaseUnreadCount();
-                    if ((int32_t)m_changes.size() == m_resourceLimitsQos.max_samples)
+                    if ((int32_t)getHistorySize() == m_resourceLimitsQos.max_samples)
                         m_isHistoryFull = true;
                     //ADD TO KEY VECTOR
                     if (vit->second.cache_changes.size() == 0)
@@ -474,6 +487,143 @@ bool SubscriberHistory::takeNextData(void* data, SampleInfo_t* info)
     return false;
 }
 
+bool SubscriberHistory::read_loaned(LoanedSamples& samples, size_t max_samples)
+{
+    return loan_samples(samples, max_samples, false);
+}
+
+bool SubscriberHistory::take_loaned(LoanedSamples& samples, size_t max_samples)
+{
+    return loan_samples(samples, max_samples, true);
+}
+
+bool SubscriberHistory::loan_samples(
+        LoanedSamples& samples,
+        size_t max_samples,
+        bool take)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    if (samples.history_ != nullptr)
+    {
+        logError(SUBSCRIBER, "The sequence holds a loan that has not been returned");
+        return false;
+    }
+
+    const uint16_t native_encapsulation = DEFAULT_ENDIAN == BIGEND ? CDR_BE : CDR_LE;
+    bool is_plain = mp_subImpl->getType()->is_plain();
+
+    std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
+    CacheChange_t* change;
+    WriterProxy * wp;
+    while ((max_samples == 0 || samples.changes_.size() < max_samples) &&
+            (take ? mp_reader->nextUntakenCache(&change, &wp) : mp_reader->nextUnreadCache(&change, &wp)))
+    {
+        if (!change->isRead)
+        {
+            this->decreaseUnreadCount();
+        }
+        change->isRead = true;
+        logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": loaning seqNum" << change->sequenceNumber <<
+            " from writer: " << change->writerGUID);
+
+        SampleInfo_t info;
+        info.sampleKind = change->kind;
+        info.sample_identity.writer_guid(change->writerGUID);
+        info.sample_identity.sequence_number(change->sequenceNumber);
+        info.sourceTimestamp = change->sourceTimestamp;
+        if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
+        {
+            info.ownershipStrength = wp->m_att.ownershipStrength;
+        }
+        info.iHandle = change->instanceHandle;
+        info.related_sample_identity = change->write_params.sample_identity();
+
+        // Plain samples in the native endianness are their own in-memory representation.
+        const void* sample = nullptr;
+        if (is_plain && change->kind == ALIVE && change->serializedPayload.encapsulation == native_encapsulation)
+        {
+            sample = change->serializedPayload.data + 4;
+        }
+
+        samples.changes_.push_back(change);
+        samples.samples_.push_back(sample);
+        samples.infos_.push_back(info);
+        ++loaned_changes_[change].count;
+
+        // The change stays in the pool until the loan is returned.
+        if (take)
+        {
+            this->remove_change_sub(change);
+        }
+    }
+
+    if (samples.changes_.empty())
+    {
+        return false;
+    }
+
+    samples.history_ = this;
+    loaned_sequences_.insert(&samples);
+    return true;
+}
+
+bool SubscriberHistory::return_loan(LoanedSamples& samples)
+{
+    if (samples.history_ != this)
+    {
+        logError(SUBSCRIBER, "The samples were not loaned by this subscriber");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
+    for (CacheChange_t* change : samples.changes_)
+    {
+        auto loan = loaned_changes_.find(change);
+        if (loan != loaned_changes_.end() && --loan->second.count == 0)
+        {
+            if (loan->second.removed)
+            {
+                ReaderHistory::release_removed_change(change);
+            }
+            loaned_changes_.erase(loan);
+        }
+    }
+
+    samples.changes_.clear();
+    samples.samples_.clear();
+    samples.infos_.clear();
+    samples.history_ = nullptr;
+    loaned_sequences_.erase(&samples);
+    return true;
+}
+
+void SubscriberHistory::move_loan(
+        LoanedSamples* from,
+        LoanedSamples* to)
+{
+    std::lock_guard<std::recursive_timed_mutex> guard(*mp_mutex);
+    loaned_sequences_.erase(from);
+    loaned_sequences_.insert(to);
+}
+
+void SubscriberHistory::release_removed_change(CacheChange_t* a_change)
+{
+    auto loan = loaned_changes_.find(a_change);
+    if (loan != loaned_changes_.end())
+    {
+        loan->second.removed = true;
+    }
+    else
+    {
+        ReaderHistory::release_removed_change(a_change);
+    }
+}
+
 bool SubscriberHistory::find_key(
         CacheChange_t* a_change,
         t_m_Inst_Caches::iterator* vit_out)
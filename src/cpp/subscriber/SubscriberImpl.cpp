@@ -99,6 +99,21 @@ bool SubscriberImpl::takeNextData(void* data,SampleInfo_t* info)
     return this->m_history.takeNextData(data,info);
 }
 
+bool SubscriberImpl::read_loaned(LoanedSamples& samples, size_t max_samples)
+{
+    return this->m_history.read_loaned(samples, max_samples);
+}
+
+bool SubscriberImpl::take_loaned(LoanedSamples& samples, size_t max_samples)
+{
+    return this->m_history.take_loaned(samples, max_samples);
+}
+
+bool SubscriberImpl::return_loan(LoanedSamples& samples)
+{
+    return this->m_history.return_loan(samples);
+}
+
 const GUID_t& SubscriberImpl::getGuid()
 {
     return mp_reader->getGuid();
@@ -80,6 +80,10 @@ public:
 	bool readNextData(void* data,SampleInfo_t* info);
 	bool takeNextData(void* data,SampleInfo_t* info);
 
+	bool read_loaned(LoanedSamples& samples, size_t max_samples);
+	bool take_loaned(LoanedSamples& samples, size_t max_samples);
+	bool return_loan(LoanedSamples& samples);
+
 	///@}
 
 	/**
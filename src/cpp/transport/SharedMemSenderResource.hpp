@@ -0,0 +1,81 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHAREDMEMSENDERRESOURCE_HPP__
+#define __TRANSPORT_SHAREDMEMSENDERRESOURCE_HPP__
+
+#include <fastrtps/rtps/network/SenderResource.h>
+#include <fastrtps/transport/SharedMemTransport.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class SharedMemSenderResource : public SenderResource
+{
+    public:
+
+        SharedMemSenderResource(
+                SharedMemTransport& transport)
+            : SenderResource(transport.kind())
+        {
+            // Implementation functions are bound to the right transport parameters
+            clean_up = []()
+                {
+                    // The segments of the destinations are owned by the transport.
+                };
+
+            send_lambda_ = [&transport] (
+                    const octet* data,
+                    uint32_t dataSize,
+                    const Locator_t& destination)-> bool
+                {
+                    return transport.send(data, dataSize, destination);
+                };
+        }
+
+        virtual ~SharedMemSenderResource()
+        {
+            if (clean_up)
+            {
+                clean_up();
+            }
+        }
+
+        static SharedMemSenderResource* cast(TransportInterface& transport, SenderResource* sender_resource)
+        {
+            SharedMemSenderResource* returned_resource = nullptr;
+
+            if (sender_resource->kind() == transport.kind())
+            {
+                returned_resource = dynamic_cast<SharedMemSenderResource*>(sender_resource);
+            }
+
+            return returned_resource;
+        }
+
+    private:
+
+        SharedMemSenderResource() = delete;
+
+        SharedMemSenderResource(const SenderResource&) = delete;
+
+        SharedMemSenderResource& operator=(const SenderResource&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHAREDMEMSENDERRESOURCE_HPP__
@@ -0,0 +1,463 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include "SharedMemSenderResource.hpp"
+#include "shared_mem/SharedMemChannelResource.hpp"
+#include "shared_mem/SharedMemSegment.hpp"
+#include <fastrtps/log/Log.h>
+
+#include <cassert>
+#include <thread>
+
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+static const uint32_t s_default_segment_size = 1024 * 1024;
+static const uint32_t s_maximum_port = 65535;
+//! Maximum time the listening threads sleep before checking whether they have been disabled.
+static const uint32_t s_listen_wait_ms = 1000;
+
+static bool has_host_address(const Locator_t& locator)
+{
+    return locator.address[12] != 0 || locator.address[13] != 0 ||
+        locator.address[14] != 0 || locator.address[15] != 0;
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor()
+    : TransportDescriptorInterface(s_maximumMessageSize, s_maximumInitialPeersRange)
+    , segment_size(s_default_segment_size)
+    , non_blocking_send(true)
+{
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t)
+    : TransportDescriptorInterface(t)
+    , segment_size(t.segment_size)
+    , non_blocking_send(t.non_blocking_send)
+{
+}
+
+TransportInterface* SharedMemTransportDescriptor::create_transport() const
+{
+    return new SharedMemTransport(*this);
+}
+
+SharedMemTransport::SharedMemTransport(const SharedMemTransportDescriptor& descriptor)
+    : TransportInterface(LOCATOR_KIND_SHM)
+    , configuration_(descriptor)
+    , host_id_(0)
+{
+}
+
+SharedMemTransport::~SharedMemTransport()
+{
+    std::map<uint32_t, SharedMemChannelResource*> channels;
+    {
+        std::unique_lock<std::mutex> scopedLock(input_mutex_);
+        channels.swap(input_channels_);
+    }
+
+    for (auto& channel : channels)
+    {
+        channel.second->segment().close();
+        delete channel.second;
+    }
+}
+
+bool SharedMemTransport::init()
+{
+    if (!SharedMemSegment::is_supported())
+    {
+        logError(RTPS_MSG_OUT, "Shared memory segments cannot be created on this host");
+        return false;
+    }
+
+    // Each record of the ring buffer stores the size of the message and keeps the next one aligned.
+    if (configuration_.maxMessageSize + 32 > configuration_.segment_size)
+    {
+        logError(RTPS_MSG_OUT, "maxMessageSize must be lower than segment_size");
+        return false;
+    }
+
+    // A zero address means any host, so the token is never zero.
+    if (!SharedMemSegment::host_token(host_id_))
+    {
+        logError(RTPS_MSG_OUT, "Cannot get the shared-memory token of this host");
+        return false;
+    }
+
+    return true;
+}
+
+bool SharedMemTransport::IsInputChannelOpen(const Locator_t& locator) const
+{
+    std::unique_lock<std::mutex> scopedLock(input_mutex_);
+    return IsLocatorSupported(locator) && (input_channels_.find(locator.port) != input_channels_.end());
+}
+
+bool SharedMemTransport::IsLocatorSupported(const Locator_t& locator) const
+{
+    return locator.kind == transport_kind_;
+}
+
+bool SharedMemTransport::is_locator_allowed(const Locator_t& locator) const
+{
+    return IsLocatorSupported(locator) && locator.port <= s_maximum_port &&
+        (!has_host_address(locator) || is_local_locator(locator));
+}
+
+bool SharedMemTransport::is_local_locator(const Locator_t& locator) const
+{
+    return IsLocatorSupported(locator) &&
+        locator.address[12] == static_cast<octet>(host_id_ >> 24) &&
+        locator.address[13] == static_cast<octet>(host_id_ >> 16) &&
+        locator.address[14] == static_cast<octet>(host_id_ >> 8) &&
+        locator.address[15] == static_cast<octet>(host_id_);
+}
+
+void SharedMemTransport::fill_host_address(Locator_t& locator) const
+{
+    locator.set_Invalid_Address();
+    locator.address[12] = static_cast<octet>(host_id_ >> 24);
+    locator.address[13] = static_cast<octet>(host_id_ >> 16);
+    locator.address[14] = static_cast<octet>(host_id_ >> 8);
+    locator.address[15] = static_cast<octet>(host_id_);
+}
+
+Locator_t SharedMemTransport::RemoteToMainLocal(const Locator_t& remote) const
+{
+    Locator_t mainLocal(remote);
+    if (IsLocatorSupported(remote))
+    {
+        fill_host_address(mainLocal);
+    }
+    return mainLocal;
+}
+
+bool SharedMemTransport::OpenOutputChannel(
+        SendResourceList& sender_resource_list,
+        const Locator_t& locator)
+{
+    if (!IsLocatorSupported(locator))
+    {
+        return false;
+    }
+
+    // The same SenderResource reaches every port of this host.
+    for (auto& sender_resource : sender_resource_list)
+    {
+        if (SharedMemSenderResource::cast(*this, sender_resource.get()) != nullptr)
+        {
+            return true;
+        }
+    }
+
+    sender_resource_list.emplace_back(static_cast<SenderResource*>(new SharedMemSenderResource(*this)));
+    return true;
+}
+
+bool SharedMemTransport::OpenInputChannel(
+        const Locator_t& locator,
+        TransportReceiverInterface* receiver,
+        uint32_t maxMsgSize)
+{
+    (void)maxMsgSize;
+
+    std::unique_lock<std::mutex> scopedLock(input_mutex_);
+    if (!is_locator_allowed(locator) || input_channels_.find(locator.port) != input_channels_.end())
+    {
+        return false;
+    }
+
+    std::shared_ptr<SharedMemSegment> segment =
+        SharedMemSegment::create(static_cast<uint16_t>(locator.port), configuration_.segment_size);
+    if (!segment)
+    {
+        logInfo(RTPS_MSG_IN, "SharedMemTransport cannot listen on port " << locator.port <<
+            ": it is already in use or the segment could not be created");
+        return false;
+    }
+
+    SharedMemChannelResource* p_channel_resource = new SharedMemChannelResource(segment, receiver);
+    p_channel_resource->thread(std::thread(&SharedMemTransport::perform_listen_operation, this,
+        p_channel_resource, locator));
+    input_channels_[locator.port] = p_channel_resource;
+    return true;
+}
+
+bool SharedMemTransport::CloseInputChannel(const Locator_t& locator)
+{
+    SharedMemChannelResource* p_channel_resource = nullptr;
+    {
+        std::unique_lock<std::mutex> scopedLock(input_mutex_);
+        auto it = input_channels_.find(locator.port);
+        if (!IsLocatorSupported(locator) || it == input_channels_.end())
+        {
+            return false;
+        }
+
+        p_channel_resource = it->second;
+        input_channels_.erase(it);
+    }
+
+    // Producers stop using the segment, and the listening thread is joined.
+    p_channel_resource->segment().close();
+    delete p_channel_resource;
+    return true;
+}
+
+bool SharedMemTransport::DoInputLocatorsMatch(const Locator_t& left, const Locator_t& right) const
+{
+    return left.kind == right.kind && left.port == right.port;
+}
+
+LocatorList_t SharedMemTransport::NormalizeLocator(const Locator_t& locator)
+{
+    LocatorList_t list;
+    Locator_t newloc(locator);
+    if (!has_host_address(newloc))
+    {
+        fill_host_address(newloc);
+    }
+    list.push_back(newloc);
+    return list;
+}
+
+LocatorList_t SharedMemTransport::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
+{
+    LocatorList_t result;
+
+    for (auto& locatorList : locatorLists)
+    {
+        for (auto it = locatorList.begin(); it != locatorList.end(); ++it)
+        {
+            assert((*it).kind == transport_kind_);
+
+            if (!result.contains(*it))
+            {
+                result.push_back(*it);
+            }
+        }
+    }
+
+    return result;
+}
+
+void SharedMemTransport::AddDefaultOutputLocator(LocatorList_t&)
+{
+}
+
+bool SharedMemTransport::getDefaultMetatrafficMulticastLocators(
+        LocatorList_t&,
+        uint32_t) const
+{
+    return false;
+}
+
+bool SharedMemTransport::getDefaultMetatrafficUnicastLocators(
+        LocatorList_t &locators,
+        uint32_t metatraffic_unicast_port) const
+{
+    Locator_t locator;
+    locator.kind = LOCATOR_KIND_SHM;
+    locator.port = metatraffic_unicast_port;
+    fill_host_address(locator);
+    locators.push_back(locator);
+
+    return true;
+}
+
+bool SharedMemTransport::getDefaultUnicastLocators(
+        LocatorList_t &locators,
+        uint32_t unicast_port) const
+{
+    Locator_t locator;
+    locator.kind = LOCATOR_KIND_SHM;
+    locator.port = unicast_port;
+    fill_host_address(locator);
+    locators.push_back(locator);
+
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficMulticastLocator(
+        Locator_t &locator,
+        uint32_t metatraffic_multicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_multicast_port;
+    }
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficUnicastLocator(
+        Locator_t &locator,
+        uint32_t metatraffic_unicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_unicast_port;
+    }
+    return true;
+}
+
+bool SharedMemTransport::configureInitialPeerLocator(
+        Locator_t &locator,
+        const PortParameters &port_params,
+        uint32_t domainId,
+        LocatorList_t& list) const
+{
+    if (!has_host_address(locator))
+    {
+        fill_host_address(locator);
+    }
+
+    if (locator.port == 0)
+    {
+        for (uint32_t i = 0; i < configuration_.maxInitialPeersRange; ++i)
+        {
+            Locator_t auxloc(locator);
+            auxloc.port = port_params.getUnicastPort(domainId, i);
+
+            list.push_back(auxloc);
+        }
+    }
+    else
+    {
+        list.push_back(locator);
+    }
+
+    return true;
+}
+
+bool SharedMemTransport::fillUnicastLocator(
+        Locator_t &locator,
+        uint32_t well_known_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = well_known_port;
+    }
+    return true;
+}
+
+void SharedMemTransport::shutdown()
+{
+    std::lock_guard<std::mutex> guard(output_mutex_);
+    output_segments_.clear();
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemTransport::output_segment(uint32_t port)
+{
+    std::lock_guard<std::mutex> guard(output_mutex_);
+
+    auto it = output_segments_.find(port);
+    if (it != output_segments_.end())
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<SharedMemSegment> segment = SharedMemSegment::open(static_cast<uint16_t>(port));
+    if (segment)
+    {
+        output_segments_[port] = segment;
+    }
+    return segment;
+}
+
+void SharedMemTransport::release_output_segment(
+        uint32_t port,
+        const std::shared_ptr<SharedMemSegment>& segment)
+{
+    std::lock_guard<std::mutex> guard(output_mutex_);
+
+    auto it = output_segments_.find(port);
+    if (it != output_segments_.end() && it->second == segment)
+    {
+        output_segments_.erase(it);
+    }
+}
+
+bool SharedMemTransport::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        const Locator_t& remote_locator)
+{
+    if (!is_local_locator(remote_locator) || remote_locator.port > s_maximum_port ||
+            send_buffer_size > configuration_.maxMessageSize)
+    {
+        return false;
+    }
+
+    bool blocking = !configuration_.non_blocking_send;
+    std::shared_ptr<SharedMemSegment> segment = output_segment(remote_locator.port);
+    if (!segment)
+    {
+        return false;
+    }
+
+    if (segment->push(send_buffer, send_buffer_size, blocking))
+    {
+        return true;
+    }
+
+    if (segment->is_open())
+    {
+        // The ring buffer is full.
+        return false;
+    }
+
+    // The listener has gone away. Another one may have created a new segment for the port.
+    release_output_segment(remote_locator.port, segment);
+    segment = output_segment(remote_locator.port);
+    return segment && segment->push(send_buffer, send_buffer_size, blocking);
+}
+
+void SharedMemTransport::perform_listen_operation(
+        SharedMemChannelResource* p_channel_resource,
+        Locator_t input_locator)
+{
+    Locator_t remote_locator;
+    remote_locator.kind = LOCATOR_KIND_SHM;
+    fill_host_address(remote_locator);
+
+    SharedMemSegment& segment = p_channel_resource->segment();
+
+    while (p_channel_resource->alive())
+    {
+        uint32_t size = 0;
+        const octet* data = segment.front(size);
+        if (data == nullptr)
+        {
+            segment.wait(s_listen_wait_ms);
+            continue;
+        }
+
+        // The message is processed in place, and its space is released afterwards.
+        TransportReceiverInterface* receiver = p_channel_resource->message_receiver();
+        if (receiver != nullptr)
+        {
+            receiver->OnDataReceived(data, size, input_locator, remote_locator);
+        }
+        segment.pop();
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -18,6 +18,7 @@
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/utils/eClock.h>
 
+#include <algorithm>
 #include <future>
 
 using namespace asio;
@@ -26,6 +27,8 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+constexpr size_t TCPChannelResourceBasic::max_coalesced_writes_;
+
 TCPChannelResourceBasic::TCPChannelResourceBasic(
         TCPTransportInterface* parent,
         asio::io_service& service,
@@ -33,7 +36,10 @@ TCPChannelResourceBasic::TCPChannelResourceBasic(
         uint32_t maxMsgSize)
     : TCPChannelResource(parent, locator, maxMsgSize)
     , service_(service)
+    , strand_(service)
+    , writing_(false)
 {
+    write_buffers_.reserve(2 * max_coalesced_writes_);
 }
 
 TCPChannelResourceBasic::TCPChannelResourceBasic(
@@ -43,8 +49,11 @@ TCPChannelResourceBasic::TCPChannelResourceBasic(
         uint32_t maxMsgSize)
     : TCPChannelResource(parent, maxMsgSize)
     , service_(service)
+    , strand_(service)
     , socket_(socket)
+    , writing_(false)
 {
+    write_buffers_.reserve(2 * max_coalesced_writes_);
 }
 
 TCPChannelResourceBasic::~TCPChannelResourceBasic()
@@ -73,7 +82,7 @@ void TCPChannelResourceBasic::connect(
             asio::async_connect(
                 *socket_,
                 endpoints,
-                [this, channel_weak_ptr](std::error_code ec
+                strand_.wrap([this, channel_weak_ptr](std::error_code ec
 #if ASIO_VERSION >= 101200
                         , ip::tcp::endpoint
 #else
@@ -82,7 +91,7 @@ void TCPChannelResourceBasic::connect(
                         )
                 {
                     parent_->SocketConnected(channel_weak_ptr, ec);
-                }
+                })
             );
         }
         catch(const std::system_error &error)
@@ -98,7 +107,7 @@ void TCPChannelResourceBasic::disconnect()
     {
         auto socket = socket_;
 
-        service_.post([&, socket]()
+        strand_.post([&, socket]()
                 {
                     try
                     {
@@ -146,21 +155,66 @@ size_t TCPChannelResourceBasic::send(
 
     if (eConnecting < connection_status_)
     {
+        PendingWrite write{header, header_size, data, size, asio::error_code(), 0, false};
+
         std::unique_lock<std::mutex> write_lock(write_mutex_);
+        pending_writes_.push_back(&write);
 
+        // While other thread is writing on the socket, it will write this message along with the next ones.
+        write_cond_.wait(write_lock, [&]() { return write.done || !writing_; });
 
-        if (header_size > 0)
+        if (!write.done)
         {
-            bytes_sent = socket_->send(asio::buffer(header, header_size), 0, ec);
+            writing_ = true;
+            while (!write.done)
+            {
+                write_pending(write_lock);
+            }
+            writing_ = false;
+            write_cond_.notify_all();
         }
 
-        if (!ec)
+        ec = write.ec;
+        bytes_sent = write.bytes_sent;
+    }
+
+    return  bytes_sent;
+}
+
+void TCPChannelResourceBasic::write_pending(std::unique_lock<std::mutex>& write_lock)
+{
+    size_t count = (std::min)(pending_writes_.size(), max_coalesced_writes_);
+    PendingWrite* batch[max_coalesced_writes_];
+    std::copy(pending_writes_.begin(), pending_writes_.begin() + count, batch);
+    pending_writes_.erase(pending_writes_.begin(), pending_writes_.begin() + count);
+
+    write_lock.unlock();
+
+    write_buffers_.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (batch[i]->header_size > 0)
         {
-            bytes_sent += socket_->send(asio::buffer(data, size), 0, ec);
+            write_buffers_.push_back(asio::buffer(batch[i]->header, batch[i]->header_size));
         }
+        write_buffers_.push_back(asio::buffer(batch[i]->data, batch[i]->size));
     }
 
-    return  bytes_sent;
+    asio::error_code ec;
+    size_t bytes_written = asio::write(*socket_, write_buffers_, ec);
+
+    write_lock.lock();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t message_size = batch[i]->header_size + batch[i]->size;
+        batch[i]->bytes_sent = (std::min)(bytes_written, message_size);
+        bytes_written -= batch[i]->bytes_sent;
+        batch[i]->ec = ec;
+        batch[i]->done = true;
+    }
+
+    write_cond_.notify_all();
 }
 
 asio::ip::tcp::endpoint TCPChannelResourceBasic::remote_endpoint() const
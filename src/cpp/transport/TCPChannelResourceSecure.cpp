@@ -84,7 +84,7 @@ void TCPChannelResourceSecure::connect(
             const auto secure_socket = secure_socket_;
 
             asio::async_connect(secure_socket_->lowest_layer(), endpoints,
-                [secure_socket, channel_weak_ptr, parent](const std::error_code& error
+                strand_read_.wrap([secure_socket, channel_weak_ptr, parent](const std::error_code& error
 #if ASIO_VERSION >= 101200
                     , ip::tcp::endpoint
 #else
@@ -120,7 +120,7 @@ void TCPChannelResourceSecure::connect(
                     //logError(RTCP_TLS, "Connect failed: " << error.message());
                     parent->SocketConnected(channel_weak_ptr, error); // Manages errors and retries
                 }
-            });
+            }));
         }
         catch(const std::system_error &error)
         {
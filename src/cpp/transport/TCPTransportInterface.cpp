@@ -56,6 +56,7 @@ TCPTransportDescriptor::TCPTransportDescriptor()
     , calculate_crc(true)
     , check_crc(true)
     , apply_security(false)
+    , io_service_threads(1)
 {
 }
 
@@ -73,6 +74,7 @@ TCPTransportDescriptor::TCPTransportDescriptor(const TCPTransportDescriptor& t)
     , calculate_crc(t.calculate_crc)
     , check_crc(t.check_crc)
     , apply_security(t.apply_security)
+    , io_service_threads(t.io_service_threads)
     , tls_config(t.tls_config)
 {
 }
@@ -97,6 +99,7 @@ TCPTransportDescriptor& TCPTransportDescriptor::operator=(const TCPTransportDesc
     calculate_crc = t.calculate_crc;
     check_crc = t.check_crc;
     apply_security = t.apply_security;
+    io_service_threads = t.io_service_threads;
     tls_config = t.tls_config;
     return *this;
 }
@@ -107,6 +110,8 @@ TCPTransportInterface::TCPTransportInterface(int32_t transport_kind)
 #if TLS_FOUND
     , ssl_context_(asio::ssl::context::sslv23)
 #endif
+    , receiver_resources_(std::make_shared<ReceiverMap>())
+    , receiver_resources_version_(0)
     , keep_alive_event_(nullptr)
 {
 }
@@ -117,7 +122,7 @@ TCPTransportInterface::~TCPTransportInterface()
 
 void TCPTransportInterface::clean()
 {
-    assert(receiver_resources_.size() == 0);
+    assert(receiver_resources_->empty());
     alive_.store(false);
 
     if(keep_alive_event_ != nullptr)
@@ -175,11 +180,14 @@ void TCPTransportInterface::clean()
         }
     }
 
-    if (io_service_thread_)
+    if (!io_service_threads_.empty())
     {
         io_service_.stop();
-        io_service_thread_->join();
-        io_service_thread_ = nullptr;
+        for (std::thread& io_service_thread : io_service_threads_)
+        {
+            io_service_thread.join();
+        }
+        io_service_threads_.clear();
     }
 
     channel_resources_.clear();
@@ -203,12 +211,7 @@ bool TCPTransportInterface::check_crc(
         const octet *data,
         uint32_t size) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    return crc == header.crc;
+    return RTCPMessageManager::addToCRC(0, data, size) == header.crc;
 }
 
 void TCPTransportInterface::calculate_crc(
@@ -216,12 +219,7 @@ void TCPTransportInterface::calculate_crc(
         const octet *data,
         uint32_t size) const
 {
-    uint32_t crc(0);
-    for (uint32_t i = 0; i < size; ++i)
-    {
-        crc = RTCPMessageManager::addToCRC(crc, data[i]);
-    }
-    header.crc = crc;
+    header.crc = RTCPMessageManager::addToCRC(0, data, size);
 }
 
 
@@ -387,7 +385,12 @@ bool TCPTransportInterface::init()
 #endif
         io_service_.run();
     };
-    io_service_thread_ = std::make_shared<std::thread>(ioServiceFunction);
+    // The handlers of each connection are serialized by its strand, so several threads can run them.
+    uint32_t io_service_threads = (std::max)(configuration()->io_service_threads, 1u);
+    for (uint32_t i = 0; i < io_service_threads; ++i)
+    {
+        io_service_threads_.emplace_back(ioServiceFunction);
+    }
 
     if (0 < configuration()->keep_alive_frequency_ms)
     {
@@ -412,7 +415,7 @@ bool TCPTransportInterface::init()
 bool TCPTransportInterface::is_input_port_open(uint16_t port) const
 {
     std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
-    return receiver_resources_.find(port) != receiver_resources_.end();
+    return receiver_resources_->find(port) != receiver_resources_->end();
 }
 
 bool TCPTransportInterface::IsInputChannelOpen(const Locator_t& locator) const
@@ -469,17 +472,20 @@ void TCPTransportInterface::CloseOutputChannel(std::shared_ptr<TCPChannelResourc
 
 bool TCPTransportInterface::CloseInputChannel(const Locator_t& locator)
 {
-    bool bClosed = false;
+    std::shared_ptr<ReceiverInUseCV> receiver_in_use;
     {
         std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
 
         uint16_t logicalPort = IPLocator::getLogicalPort(locator);
-        auto receiverIt = receiver_resources_.find(logicalPort);
-        if (receiverIt != receiver_resources_.end())
+        auto receiverIt = receiver_resources_->find(logicalPort);
+        if (receiverIt != receiver_resources_->end())
         {
-            bClosed = true;
-            ReceiverInUseCV* receiver_in_use = receiverIt->second.second;
-            receiver_resources_.erase(receiverIt);
+            receiver_in_use = receiverIt->second;
+
+            auto receivers = std::make_shared<ReceiverMap>(*receiver_resources_);
+            receivers->erase(logicalPort);
+            std::atomic_store(&receiver_resources_, std::shared_ptr<const ReceiverMap>(receivers));
+            receiver_resources_version_.fetch_add(1);
 
             // Inform all channel resources that logical port has been closed
             for (auto channelIt : channel_resources_)
@@ -489,13 +495,17 @@ bool TCPTransportInterface::CloseInputChannel(const Locator_t& locator)
                     rtcp_message_manager_->sendLogicalPortIsClosedRequest(channelIt.second, logicalPort);
                 }
             }
-
-            receiver_in_use->cv.wait(scopedLock, [&]() { return receiver_in_use->in_use == false; });
-            delete receiver_in_use;
         }
     }
 
-    return bClosed;
+    if (!receiver_in_use)
+    {
+        return false;
+    }
+
+    // Listening threads may still hold the previous table, so wait until they stop using the receiver.
+    receiver_in_use->close_and_wait();
+    return true;
 }
 
 void TCPTransportInterface::close_tcp_socket(
@@ -616,8 +626,10 @@ bool TCPTransportInterface::OpenInputChannel(
             success = true;
             {
                 std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
-                receiver_resources_[logicalPort] = std::pair<TransportReceiverInterface*, ReceiverInUseCV*>
-                    (receiver, new ReceiverInUseCV());
+                auto receivers = std::make_shared<ReceiverMap>(*receiver_resources_);
+                (*receivers)[logicalPort] = std::make_shared<ReceiverInUseCV>(receiver);
+                std::atomic_store(&receiver_resources_, std::shared_ptr<const ReceiverMap>(receivers));
+                receiver_resources_version_.fetch_add(1);
             }
 
             logInfo(RTCP, " OpenInputChannel (physical: " << IPLocator::getPhysicalPort(locator) << "; logical: " << \
@@ -724,6 +736,10 @@ void TCPTransportInterface::perform_listen_operation(
         return;
     }
 
+    // Receivers table of the last message, reloaded only when a logical port is opened or closed.
+    std::shared_ptr<const ReceiverMap> receivers;
+    uint32_t receivers_version = 0;
+
     while (channel && TCPChannelResource::eConnectionStatus::eConnecting < channel->connection_status())
     {
         // Blocking receive.
@@ -738,19 +754,18 @@ void TCPTransportInterface::perform_listen_operation(
         {
             // Processes the data through the CDR Message interface.
             logicalPort = IPLocator::getLogicalPort(remote_locator);
-            std::unique_lock<std::mutex> scopedLock(sockets_map_mutex_);
-            auto it = receiver_resources_.find(logicalPort);
-            //TransportReceiverInterface* receiver = channel->GetMessageReceiver(logicalPort);
-            if (it != receiver_resources_.end())
+            uint32_t version = receiver_resources_version_.load();
+            if (!receivers || version != receivers_version)
+            {
+                receivers = std::atomic_load(&receiver_resources_);
+                receivers_version = version;
+            }
+
+            auto it = receivers->find(logicalPort);
+            if (it != receivers->end() && it->second->acquire())
             {
-                TransportReceiverInterface* receiver = it->second.first;
-                ReceiverInUseCV* receiver_in_use = it->second.second;
-                receiver_in_use->in_use = true;
-                scopedLock.unlock();
-                receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
-                scopedLock.lock();
-                receiver_in_use->in_use = false;
-                receiver_in_use->cv.notify_one();
+                it->second->receiver->OnDataReceived(msg.buffer, msg.length, channel->locator(), remote_locator);
+                it->second->release();
             }
             else
             {
@@ -24,6 +24,7 @@ UDPChannelResource::UDPChannelResource(eProsimaUDPSocket& socket)
     : message_receiver_(nullptr)
     , socket_(moveSocket(socket))
     , only_multicast_purpose_(false)
+    , dropped_datagrams_(0)
 {
 }
 
@@ -32,6 +33,7 @@ UDPChannelResource::UDPChannelResource(eProsimaUDPSocket& socket, uint32_t maxMs
     , message_receiver_(nullptr)
     , socket_(moveSocket(socket))
     , only_multicast_purpose_(false)
+    , dropped_datagrams_(0)
 {
 }
 
@@ -39,6 +41,7 @@ UDPChannelResource::UDPChannelResource(UDPChannelResource&& channelResource)
     : message_receiver_(channelResource.message_receiver_)
     , socket_(moveSocket(channelResource.socket_))
     , only_multicast_purpose_(channelResource.only_multicast_purpose_)
+    , dropped_datagrams_(channelResource.dropped_datagrams())
 {
     channelResource.message_receiver_ = nullptr;
 }
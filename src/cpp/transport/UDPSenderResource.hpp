@@ -47,6 +47,14 @@ class UDPSenderResource : public SenderResource
                 {
                     return transport.send(data, dataSize, socket_, destination, only_multicast_purpose_);
                 };
+
+            send_list_lambda_ = [this, &transport] (
+                    const octet* data,
+                    uint32_t dataSize,
+                    const LocatorList_t& destinations)-> bool
+                {
+                    return transport.send(data, dataSize, socket_, destinations, only_multicast_purpose_);
+                };
         }
 
         virtual ~UDPSenderResource()
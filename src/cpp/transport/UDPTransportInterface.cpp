@@ -23,6 +23,11 @@
 #include <fastrtps/utils/Semaphore.h>
 #include <fastrtps/utils/IPLocator.h>
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+
 using namespace std;
 using namespace asio;
 
@@ -51,6 +56,7 @@ UDPTransportDescriptor::UDPTransportDescriptor()
 UDPTransportDescriptor::UDPTransportDescriptor(const UDPTransportDescriptor& t)
     : SocketTransportDescriptor(t)
     , m_output_udp_socket(t.m_output_udp_socket)
+    , receive_batch_size(t.receive_batch_size)
 {
 }
 
@@ -374,6 +380,14 @@ bool UDPTransportInterface::OpenOutputChannel(
 
 void UDPTransportInterface::perform_listen_operation(UDPChannelResource* p_channel_resource, Locator_t input_locator)
 {
+#if defined(__linux__)
+    if (configuration()->receive_batch_size > 1)
+    {
+        perform_batched_listen_operation(p_channel_resource, input_locator);
+        return;
+    }
+#endif
+
     Locator_t remote_locator;
 
     while (p_channel_resource->alive())
@@ -398,6 +412,139 @@ void UDPTransportInterface::perform_listen_operation(UDPChannelResource* p_chann
     }
 }
 
+#if defined(__linux__)
+void UDPTransportInterface::perform_batched_listen_operation(UDPChannelResource* p_channel_resource,
+        Locator_t input_locator)
+{
+    const uint32_t batch_size = configuration()->receive_batch_size;
+    const uint32_t buffer_size = p_channel_resource->message_buffer().max_size;
+    int fd = p_channel_resource->socket()->native_handle();
+
+#if defined(SO_RXQ_OVFL)
+    // Ask the kernel to report the number of datagrams dropped on the socket with every datagram received.
+    int enable = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) != 0)
+    {
+        logWarning(RTPS_MSG_IN, "Cannot enable the drop counter of the socket: " << std::strerror(errno));
+    }
+    const size_t control_size = CMSG_SPACE(sizeof(uint32_t));
+#else
+    const size_t control_size = 0;
+#endif
+
+    // The buffers are only used by this thread, so they are kept here.
+    std::vector<octet> buffers(static_cast<size_t>(batch_size) * buffer_size);
+    std::vector<struct iovec> iovecs(batch_size);
+    std::vector<struct sockaddr_storage> addresses(batch_size);
+    std::vector<char> controls(batch_size * control_size + 1);
+    std::vector<struct mmsghdr> messages(batch_size);
+
+    Locator_t remote_locator;
+
+    while (p_channel_resource->alive())
+    {
+        for (uint32_t i = 0; i < batch_size; ++i)
+        {
+            iovecs[i].iov_base = &buffers[static_cast<size_t>(i) * buffer_size];
+            iovecs[i].iov_len = buffer_size;
+
+            struct msghdr& header = messages[i].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = &addresses[i];
+            header.msg_namelen = sizeof(addresses[i]);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+            if (control_size > 0)
+            {
+                header.msg_control = &controls[i * control_size];
+                header.msg_controllen = control_size;
+            }
+        }
+
+        // Blocking receive of the first datagram. Any other datagram already queued is received too.
+        int received = ::recvmmsg(fd, messages.data(), batch_size, MSG_WAITFORONE, nullptr);
+        if (received < 0)
+        {
+            if (errno != EINTR)
+            {
+                logWarning(RTPS_MSG_IN, "Error receiving data: " << std::strerror(errno));
+            }
+            continue;
+        }
+
+        auto receiver = p_channel_resource->message_receiver();
+
+        for (int i = 0; i < received && p_channel_resource->alive(); ++i)
+        {
+            struct msghdr& header = messages[i].msg_hdr;
+            octet* data = static_cast<octet*>(iovecs[i].iov_base);
+            uint32_t length = static_cast<uint32_t>(messages[i].msg_len);
+
+#if defined(SO_RXQ_OVFL)
+            for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr;
+                    cmsg = CMSG_NXTHDR(&header, cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+                {
+                    uint32_t dropped = 0;
+                    memcpy(&dropped, CMSG_DATA(cmsg), sizeof(dropped));
+                    uint32_t previous = p_channel_resource->dropped_datagrams(dropped);
+                    if (dropped != previous)
+                    {
+                        logWarning(RTPS_MSG_IN, "UDPTransport: " << (dropped - previous) <<
+                            " datagrams dropped by the kernel on port " << IPLocator::getPhysicalPort(input_locator));
+                    }
+                }
+            }
+#endif
+
+            if (length == 0 || (length == 13 && memcmp(data, "EPRORTPSCLOSE", 13) == 0))
+            {
+                continue;
+            }
+
+            if (header.msg_flags & MSG_TRUNC)
+            {
+                logWarning(RTPS_MSG_IN, "UDPTransport: Received datagram bigger than " << buffer_size <<
+                    " bytes. It is discarded.");
+                continue;
+            }
+
+            asio::ip::udp::endpoint senderEndpoint;
+            memcpy(senderEndpoint.data(), &addresses[i], header.msg_namelen);
+            senderEndpoint.resize(header.msg_namelen);
+            endpoint_to_locator(senderEndpoint, remote_locator);
+
+            // Processes the data through the CDR Message interface.
+            if (receiver != nullptr)
+            {
+                receiver->OnDataReceived(data, length, input_locator, remote_locator);
+            }
+            else
+            {
+                logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+            }
+        }
+    }
+}
+#endif
+
+uint64_t UDPTransportInterface::dropped_datagrams() const
+{
+    std::unique_lock<std::recursive_mutex> scopedLock(mInputMapMutex);
+
+    uint64_t dropped = 0;
+    for (const auto& input_sockets : mInputSockets)
+    {
+        for (const UDPChannelResource* channel_resource : input_sockets.second)
+        {
+            dropped += channel_resource->dropped_datagrams();
+        }
+    }
+
+    return dropped;
+}
+
 bool UDPTransportInterface::Receive(UDPChannelResource* p_channel_resource, octet* receive_buffer,
     uint32_t receive_buffer_capacity, uint32_t& receive_buffer_size, Locator_t& remote_locator)
 {
@@ -552,6 +699,100 @@ bool UDPTransportInterface::send(
     return success;
 }
 
+bool UDPTransportInterface::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose)
+{
+#if defined(__linux__)
+    if (send_buffer_size > configuration()->sendBufferSize)
+    {
+        return false;
+    }
+
+    // Number of destinations handed to the kernel on each sendmmsg call.
+    static const size_t max_batch_size = 64;
+
+    asio::ip::udp::endpoint destinations[max_batch_size];
+    struct mmsghdr messages[max_batch_size];
+    struct iovec buffer;
+    buffer.iov_base = const_cast<octet*>(send_buffer);
+    buffer.iov_len = send_buffer_size;
+
+    bool success = false;
+    auto locator_it = remote_locators.begin();
+
+    while (locator_it != remote_locators.end())
+    {
+        size_t batch_size = 0;
+
+        for (; locator_it != remote_locators.end() && batch_size < max_batch_size; ++locator_it)
+        {
+            if (IsLocatorSupported(*locator_it) &&
+                    (!only_multicast_purpose || IPLocator::isMulticast(*locator_it)))
+            {
+                destinations[batch_size] = generate_endpoint(*locator_it, IPLocator::getPhysicalPort(*locator_it));
+
+                struct mmsghdr& message = messages[batch_size];
+                memset(&message, 0, sizeof(message));
+                message.msg_hdr.msg_name = destinations[batch_size].data();
+                message.msg_hdr.msg_namelen = static_cast<socklen_t>(destinations[batch_size].size());
+                message.msg_hdr.msg_iov = &buffer;
+                message.msg_hdr.msg_iovlen = 1;
+                ++batch_size;
+            }
+        }
+
+        size_t sent = 0;
+        while (sent < batch_size)
+        {
+            int result = ::sendmmsg(getSocketPtr(socket)->native_handle(), &messages[sent],
+                    static_cast<unsigned int>(batch_size - sent), 0);
+
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                // The datagram for this destination could not be sent. Go on with the rest.
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    logWarning(RTPS_MSG_OUT, "UDP send would have blocked. Packet is dropped.");
+                    success = true;
+                }
+                else
+                {
+                    logWarning(RTPS_MSG_OUT, "UDP send to " << destinations[sent] << " failed: " <<
+                        std::strerror(errno));
+                }
+                ++sent;
+                continue;
+            }
+
+            logInfo(RTPS_MSG_OUT, "UDPTransport: " << send_buffer_size << " bytes TO " << result <<
+                " endpoints FROM " << getSocketPtr(socket)->local_endpoint());
+            sent += static_cast<size_t>(result);
+            success = true;
+        }
+    }
+
+    return success;
+#else
+    bool success = false;
+
+    for (const Locator_t& remote_locator : remote_locators)
+    {
+        success |= send(send_buffer, send_buffer_size, socket, remote_locator, only_multicast_purpose);
+    }
+
+    return success;
+#endif
+}
+
 LocatorList_t UDPTransportInterface::ShrinkLocatorLists(const std::vector<LocatorList_t>& locatorLists)
 {
     LocatorList_t multicastResult, unicastResult;
@@ -0,0 +1,79 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHAREDMEM_SHAREDMEMCHANNELRESOURCE_HPP__
+#define __TRANSPORT_SHAREDMEM_SHAREDMEMCHANNELRESOURCE_HPP__
+
+#include <fastrtps/transport/ChannelResource.h>
+#include "SharedMemSegment.hpp"
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class TransportReceiverInterface;
+
+//! Listening side of a port of the shared-memory transport.
+class SharedMemChannelResource : public ChannelResource
+{
+public:
+
+    SharedMemChannelResource(
+            std::shared_ptr<SharedMemSegment> segment,
+            TransportReceiverInterface* receiver)
+        : ChannelResource(0)
+        , segment_(std::move(segment))
+        , message_receiver_(receiver)
+    {
+    }
+
+    virtual ~SharedMemChannelResource()
+    {
+        disable();
+        clear();
+    }
+
+    //! Stops the listening thread, which may be blocked waiting for messages.
+    inline virtual void disable() override
+    {
+        ChannelResource::disable();
+        segment_->wake_up();
+    }
+
+    inline SharedMemSegment& segment()
+    {
+        return *segment_;
+    }
+
+    inline TransportReceiverInterface* message_receiver()
+    {
+        return message_receiver_;
+    }
+
+private:
+
+    std::shared_ptr<SharedMemSegment> segment_;
+
+    TransportReceiverInterface* message_receiver_;
+
+    SharedMemChannelResource(const SharedMemChannelResource&) = delete;
+
+    SharedMemChannelResource& operator=(const SharedMemChannelResource&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHAREDMEM_SHAREDMEMCHANNELRESOURCE_HPP__
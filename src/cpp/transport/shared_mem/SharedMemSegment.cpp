@@ -0,0 +1,847 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedMemSegment.hpp"
+
+#include <fastrtps/log/Log.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+#endif
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+        "Shared-memory segments need address-free atomics");
+
+//! Identifies an initialized segment ("SHMR").
+static const uint32_t s_segment_magic = 0x53484D52;
+static const uint32_t s_record_alignment = 16;
+static const uint32_t s_minimum_capacity = 4096;
+static const uint32_t s_maximum_capacity = 1u << 30;
+static const uint32_t s_space_wait_ms = 100;
+//! Maximum time a blocking producer waits for the listener to free space.
+static const uint32_t s_max_space_wait_ms = 1000;
+//! Time after which the listener checks whether the producer of a record that is not published yet can be discarded.
+static const uint32_t s_reservation_timeout_ms = 500;
+//! Set on the stamp of a record claimed by its producer but not published yet.
+static const uint64_t s_stamp_claimed = 1ULL << 63;
+//! Set on the stamp of a claimed record once its size is written.
+static const uint64_t s_stamp_sized = 1ULL << 62;
+static const uint64_t s_stamp_lap_mask = 0x3FFFFFFF;
+//! Identifies an initialized host token ("SHMH").
+static const uint32_t s_host_token_magic = 0x53484D48;
+//! Time given to the creator of the host token to publish it.
+static const uint32_t s_host_token_wait_ms = 500;
+
+/**
+ * Control block at the beginning of each segment.
+ * The head and the tail are free-running positions, so the number of used bytes is always head - tail.
+ */
+struct SharedMemSegmentHeader
+{
+    //! Written last by the creator, once the rest of the header is initialized.
+    std::atomic<uint32_t> magic;
+    uint32_t capacity;
+    //! Process listening on the segment. 0 once it closes the segment.
+    std::atomic<int32_t> owner_pid;
+    //! Incremented on every push. The listener sleeps on it.
+    std::atomic<uint32_t> data_seq;
+    //! Incremented when the listener frees space while producers wait. Blocked producers sleep on it.
+    std::atomic<uint32_t> space_seq;
+    std::atomic<uint32_t> listener_waiting;
+    std::atomic<uint32_t> producers_waiting;
+#if !defined(_WIN32) && !defined(__linux__)
+    pthread_mutex_t mutex;
+    pthread_cond_t data_cond;
+    pthread_cond_t space_cond;
+#endif
+    //! Position where the next record will be reserved. Advanced by the producers.
+    alignas(64) std::atomic<uint64_t> head;
+    //! Position of the next record to consume. Advanced by the listener.
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+/**
+ * Header of each record of the ring.
+ * Only the lap of the position of a claimed record is kept on its stamp, as the position in the ring is implied by
+ * the location of the record.
+ */
+struct SharedMemRecordHeader
+{
+    /**
+     * Position of the record plus one, once published. Before that, s_stamp_claimed with the lap of the position and
+     * the pid of the producer, or with pid 0 when the listener discarded the record.
+     */
+    std::atomic<uint64_t> stamp;
+    //! Size of the message, or size of the whole record when it only pads the end of the ring.
+    uint32_t size;
+    //! Non-zero for records that only pad the end of the ring.
+    uint32_t padding;
+};
+
+static_assert(sizeof(SharedMemRecordHeader) == s_record_alignment, "Records must keep their headers aligned");
+
+//! Content of the shared-memory object that identifies the host.
+struct SharedMemHostToken
+{
+    //! Written last by the creator, once the token is set.
+    std::atomic<uint32_t> magic;
+    uint32_t token;
+};
+
+static const size_t s_data_offset = (sizeof(SharedMemSegmentHeader) + 63) & ~static_cast<size_t>(63);
+
+static uint64_t record_size(
+        uint32_t message_size)
+{
+    return (sizeof(SharedMemRecordHeader) + static_cast<uint64_t>(message_size) + s_record_alignment - 1) &
+           ~static_cast<uint64_t>(s_record_alignment - 1);
+}
+
+//! Stamp of a record claimed by a producer, or discarded by the listener when the pid is 0.
+static uint64_t claimed_stamp(
+        uint64_t lap,
+        int32_t pid)
+{
+    return s_stamp_claimed | ((lap & s_stamp_lap_mask) << 32) | static_cast<uint32_t>(pid);
+}
+
+static uint32_t round_up_capacity(
+        uint32_t capacity)
+{
+    uint32_t rounded = s_minimum_capacity;
+    while (rounded < capacity && rounded < s_maximum_capacity)
+    {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+static std::string segment_name(
+        uint16_t port)
+{
+    return "/fastrtps_port" + std::to_string(port);
+}
+
+#if defined(_WIN32)
+
+static int32_t current_pid()
+{
+    return 0;
+}
+
+static bool is_process_alive(
+        int32_t)
+{
+    return false;
+}
+
+static void wait_on(
+        SharedMemSegmentHeader*,
+        std::atomic<uint32_t>&,
+        uint32_t,
+        uint32_t)
+{
+}
+
+static void wake_on(
+        SharedMemSegmentHeader*,
+        std::atomic<uint32_t>&)
+{
+}
+
+#else
+
+static int32_t current_pid()
+{
+    return static_cast<int32_t>(getpid());
+}
+
+static bool is_process_alive(
+        int32_t pid)
+{
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+#if defined(__linux__)
+
+static void wait_on(
+        SharedMemSegmentHeader*,
+        std::atomic<uint32_t>& word,
+        uint32_t expected,
+        uint32_t timeout_ms)
+{
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000;
+
+    // Returns straight away when the word no longer holds the expected value.
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+static void wake_on(
+        SharedMemSegmentHeader*,
+        std::atomic<uint32_t>& word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+static pthread_cond_t* cond_of(
+        SharedMemSegmentHeader* header,
+        std::atomic<uint32_t>& word)
+{
+    return &word == &header->data_seq ? &header->data_cond : &header->space_cond;
+}
+
+static void wait_on(
+        SharedMemSegmentHeader* header,
+        std::atomic<uint32_t>& word,
+        uint32_t expected,
+        uint32_t timeout_ms)
+{
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    uint64_t nanoseconds = static_cast<uint64_t>(now.tv_usec) * 1000 + static_cast<uint64_t>(timeout_ms) * 1000000;
+    struct timespec deadline;
+    deadline.tv_sec = now.tv_sec + static_cast<time_t>(nanoseconds / 1000000000);
+    deadline.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+
+    pthread_mutex_lock(&header->mutex);
+    if (word.load() == expected)
+    {
+        pthread_cond_timedwait(cond_of(header, word), &header->mutex, &deadline);
+    }
+    pthread_mutex_unlock(&header->mutex);
+}
+
+static void wake_on(
+        SharedMemSegmentHeader* header,
+        std::atomic<uint32_t>& word)
+{
+    pthread_mutex_lock(&header->mutex);
+    pthread_cond_broadcast(cond_of(header, word));
+    pthread_mutex_unlock(&header->mutex);
+}
+
+#endif // if defined(__linux__)
+
+/**
+ * Maps a whole segment.
+ * @return Pointer to the header of the segment, or nullptr when the segment is smaller than its header.
+ */
+static SharedMemSegmentHeader* map_segment(
+        int fd,
+        size_t& mapped_size)
+{
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) <= s_data_offset)
+    {
+        return nullptr;
+    }
+
+    mapped_size = static_cast<size_t>(status.st_size);
+    void* address = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    return static_cast<SharedMemSegmentHeader*>(address);
+}
+
+static void initialize_header(
+        SharedMemSegmentHeader* header,
+        uint32_t capacity)
+{
+    // The memory of a new shared-memory object is zero-filled, so only non-zero fields are set.
+    header->capacity = capacity;
+    header->owner_pid.store(current_pid(), std::memory_order_relaxed);
+
+#if !defined(__linux__)
+    pthread_mutexattr_t mutex_attributes;
+    pthread_mutexattr_init(&mutex_attributes);
+    pthread_mutexattr_setpshared(&mutex_attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutex_init(&header->mutex, &mutex_attributes);
+    pthread_mutexattr_destroy(&mutex_attributes);
+
+    pthread_condattr_t cond_attributes;
+    pthread_condattr_init(&cond_attributes);
+    pthread_condattr_setpshared(&cond_attributes, PTHREAD_PROCESS_SHARED);
+    pthread_cond_init(&header->data_cond, &cond_attributes);
+    pthread_cond_init(&header->space_cond, &cond_attributes);
+    pthread_condattr_destroy(&cond_attributes);
+#endif
+
+    header->magic.store(s_segment_magic, std::memory_order_release);
+}
+
+#endif // if defined(_WIN32)
+
+SharedMemSegment::SharedMemSegment(
+        const std::string& name,
+        SharedMemSegmentHeader* header,
+        size_t mapped_size,
+        bool owner)
+    : name_(name)
+    , header_(header)
+    , data_(reinterpret_cast<octet*>(header) + s_data_offset)
+    , mapped_size_(mapped_size)
+    , capacity_(header->capacity)
+    , mask_(header->capacity - 1)
+    , owner_(owner)
+    , tail_(header->tail.load(std::memory_order_acquire))
+    , front_record_size_(0)
+    , stalled_tail_(~0ULL)
+    , stalled_since_()
+{
+}
+
+SharedMemSegment::~SharedMemSegment()
+{
+    if (owner_)
+    {
+        close();
+    }
+
+#if !defined(_WIN32)
+    munmap(header_, mapped_size_);
+#endif
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemSegment::create(
+        uint16_t port,
+        uint32_t capacity)
+{
+#if defined(_WIN32)
+    (void)port;
+    (void)capacity;
+    return nullptr;
+#else
+    std::string name = segment_name(port);
+    uint32_t ring_capacity = round_up_capacity(capacity);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0 && errno == EEXIST)
+    {
+        // Reclaim the segment only when the process that listened on it no longer exists.
+        int previous_fd = shm_open(name.c_str(), O_RDWR, 0666);
+        if (previous_fd < 0)
+        {
+            return nullptr;
+        }
+
+        size_t previous_size = 0;
+        SharedMemSegmentHeader* previous = map_segment(previous_fd, previous_size);
+        ::close(previous_fd);
+        if (previous == nullptr)
+        {
+            // Not initialized yet by its creator.
+            return nullptr;
+        }
+
+        bool in_use = previous->magic.load(std::memory_order_acquire) != s_segment_magic ||
+                is_process_alive(previous->owner_pid.load(std::memory_order_acquire));
+        munmap(previous, previous_size);
+        if (in_use)
+        {
+            return nullptr;
+        }
+
+        logInfo(RTPS_MSG_IN, "Reclaiming shared-memory segment " << name << " of a process that no longer exists");
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    }
+
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    // Permissions are not subject to the umask, so participants of other users can send to this port.
+    fchmod(fd, 0666);
+
+    size_t mapped_size = s_data_offset + ring_capacity;
+    SharedMemSegmentHeader* header = nullptr;
+    if (ftruncate(fd, static_cast<off_t>(mapped_size)) == 0)
+    {
+        header = map_segment(fd, mapped_size);
+    }
+    ::close(fd);
+
+    if (header == nullptr)
+    {
+        logWarning(RTPS_MSG_IN, "Cannot create shared-memory segment " << name << ": " << strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    initialize_header(header, ring_capacity);
+    return std::shared_ptr<SharedMemSegment>(new SharedMemSegment(name, header, mapped_size, true));
+#endif
+}
+
+std::shared_ptr<SharedMemSegment> SharedMemSegment::open(
+        uint16_t port)
+{
+#if defined(_WIN32)
+    (void)port;
+    return nullptr;
+#else
+    std::string name = segment_name(port);
+    int fd = shm_open(name.c_str(), O_RDWR, 0666);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    size_t mapped_size = 0;
+    SharedMemSegmentHeader* header = map_segment(fd, mapped_size);
+    ::close(fd);
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (header->magic.load(std::memory_order_acquire) != s_segment_magic ||
+            header->owner_pid.load(std::memory_order_acquire) == 0 ||
+            mapped_size != s_data_offset + header->capacity)
+    {
+        munmap(header, mapped_size);
+        return nullptr;
+    }
+
+    return std::shared_ptr<SharedMemSegment>(new SharedMemSegment(name, header, mapped_size, false));
+#endif
+}
+
+bool SharedMemSegment::is_supported()
+{
+#if defined(_WIN32)
+    return false;
+#else
+    std::string name = "/fastrtps_probe" + std::to_string(current_pid());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    ::close(fd);
+    shm_unlink(name.c_str());
+    return true;
+#endif
+}
+
+bool SharedMemSegment::host_token(
+        uint32_t& token)
+{
+#if defined(_WIN32)
+    (void)token;
+    return false;
+#else
+    static const char* name = "/fastrtps_host";
+
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd >= 0)
+        {
+            // Only the creator writes the token, the rest of the users of the host read it.
+            fchmod(fd, 0644);
+            void* address = MAP_FAILED;
+            if (ftruncate(fd, sizeof(SharedMemHostToken)) == 0)
+            {
+                address = mmap(nullptr, sizeof(SharedMemHostToken), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            ::close(fd);
+            if (address == MAP_FAILED)
+            {
+                shm_unlink(name);
+                return false;
+            }
+
+            std::random_device device;
+            std::mt19937 generator(device() ^
+                    static_cast<uint32_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()) ^
+                    static_cast<uint32_t>(current_pid()));
+            uint32_t value = 0;
+            while (value == 0)
+            {
+                value = generator();
+            }
+
+            SharedMemHostToken* host = static_cast<SharedMemHostToken*>(address);
+            host->token = value;
+            host->magic.store(s_host_token_magic, std::memory_order_release);
+            munmap(address, sizeof(SharedMemHostToken));
+            token = value;
+            return true;
+        }
+
+        if (errno != EEXIST)
+        {
+            return false;
+        }
+
+        fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+        {
+            continue;
+        }
+
+        // The creator may still be publishing the token.
+        void* address = MAP_FAILED;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(s_host_token_wait_ms);
+        do
+        {
+            struct stat status;
+            if (fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(SharedMemHostToken))
+            {
+                address = mmap(nullptr, sizeof(SharedMemHostToken), PROT_READ, MAP_SHARED, fd, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } while (std::chrono::steady_clock::now() < deadline);
+        ::close(fd);
+
+        if (address != MAP_FAILED)
+        {
+            const SharedMemHostToken* host = static_cast<const SharedMemHostToken*>(address);
+            while (host->magic.load(std::memory_order_acquire) != s_host_token_magic &&
+                    std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            bool valid = host->magic.load(std::memory_order_acquire) == s_host_token_magic && host->token != 0;
+            uint32_t value = host->token;
+            munmap(address, sizeof(SharedMemHostToken));
+            if (valid)
+            {
+                token = value;
+                return true;
+            }
+        }
+
+        // Left behind by a creator that died before publishing the token.
+        logWarning(RTPS_MSG_OUT, "Replacing the incomplete shared-memory object " << name);
+        shm_unlink(name);
+    }
+
+    return false;
+#endif
+}
+
+octet* SharedMemSegment::record_at(
+        uint64_t position) const
+{
+    return data_ + (position & mask_);
+}
+
+bool SharedMemSegment::push(
+        const octet* data,
+        uint32_t size,
+        bool blocking)
+{
+    const uint64_t size_of_record = record_size(size);
+    if (size_of_record > capacity_)
+    {
+        return false;
+    }
+
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    uint64_t padding = 0;
+    auto space_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(s_max_space_wait_ms);
+
+    for (;;)
+    {
+        if (header_->owner_pid.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+
+        // A record never wraps around the end of the ring. The remaining bytes are skipped with a padding record.
+        uint64_t contiguous = capacity_ - (head & mask_);
+        padding = size_of_record <= contiguous ? 0 : contiguous;
+
+        uint64_t tail = header_->tail.load(std::memory_order_acquire);
+        if (head + padding + size_of_record - tail > capacity_)
+        {
+            if (!blocking || std::chrono::steady_clock::now() >= space_deadline || !wait_for_space(tail))
+            {
+                return false;
+            }
+
+            head = header_->head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (header_->head.compare_exchange_weak(head, head + padding + size_of_record,
+                std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    // The records are claimed before writing anything on them. A claim fails when the listener gave up on them, and
+    // then the records reserved after them have been discarded too.
+    const int32_t pid = current_pid();
+    if (padding != 0)
+    {
+        SharedMemRecordHeader* padding_record = reinterpret_cast<SharedMemRecordHeader*>(record_at(head));
+        if (!claim_record(padding_record, head, pid, static_cast<uint32_t>(padding), 1) ||
+                !publish_record(padding_record, head, pid))
+        {
+            return false;
+        }
+        head += padding;
+    }
+
+    SharedMemRecordHeader* record = reinterpret_cast<SharedMemRecordHeader*>(record_at(head));
+    if (!claim_record(record, head, pid, size, 0))
+    {
+        return false;
+    }
+    memcpy(reinterpret_cast<octet*>(record + 1), data, size);
+    if (!publish_record(record, head, pid))
+    {
+        logWarning(RTPS_MSG_OUT, "Message to " << name_ << " discarded by the listener while it was being copied");
+        return false;
+    }
+
+    header_->data_seq.fetch_add(1, std::memory_order_seq_cst);
+    if (header_->listener_waiting.load(std::memory_order_seq_cst) != 0)
+    {
+        wake_on(header_, header_->data_seq);
+    }
+
+    return true;
+}
+
+bool SharedMemSegment::claim_record(
+        SharedMemRecordHeader* record,
+        uint64_t position,
+        int32_t pid,
+        uint32_t size,
+        uint32_t padding) const
+{
+    const uint64_t lap = position / capacity_;
+    const uint64_t discarded = claimed_stamp(lap, 0);
+    uint64_t claimed = claimed_stamp(lap, pid);
+
+    // The stamp still holds whatever a previous lap left there, unless the listener has discarded the record.
+    uint64_t stamp = record->stamp.load(std::memory_order_acquire);
+    do
+    {
+        if (stamp == discarded)
+        {
+            return false;
+        }
+    } while (!record->stamp.compare_exchange_weak(stamp, claimed, std::memory_order_acq_rel,
+            std::memory_order_acquire));
+
+    record->size = size;
+    record->padding = padding;
+    return record->stamp.compare_exchange_strong(claimed, claimed | s_stamp_sized, std::memory_order_release,
+                   std::memory_order_relaxed);
+}
+
+bool SharedMemSegment::publish_record(
+        SharedMemRecordHeader* record,
+        uint64_t position,
+        int32_t pid) const
+{
+    // The listener only goes past a record that is not published when it discards it.
+    if (header_->tail.load(std::memory_order_acquire) > position)
+    {
+        return false;
+    }
+
+    uint64_t sized = claimed_stamp(position / capacity_, pid) | s_stamp_sized;
+    return record->stamp.compare_exchange_strong(sized, position + 1, std::memory_order_release,
+                   std::memory_order_relaxed);
+}
+
+const octet* SharedMemSegment::front(
+        uint32_t& size)
+{
+    for (;;)
+    {
+        SharedMemRecordHeader* record = reinterpret_cast<SharedMemRecordHeader*>(record_at(tail_));
+        uint64_t stamp = record->stamp.load(std::memory_order_acquire);
+        if (stamp != tail_ + 1)
+        {
+            uint64_t head = header_->head.load(std::memory_order_acquire);
+            if (head == tail_)
+            {
+                return nullptr;
+            }
+
+            // The record is reserved. Its producer may still be copying the message, or may have died.
+            auto now = std::chrono::steady_clock::now();
+            if (stalled_tail_ != tail_)
+            {
+                stalled_tail_ = tail_;
+                stalled_since_ = now;
+                return nullptr;
+            }
+
+            if (now - stalled_since_ < std::chrono::milliseconds(s_reservation_timeout_ms))
+            {
+                return nullptr;
+            }
+
+            // A claimed record is only discarded once its producer no longer exists, as it would keep writing on it.
+            // A producer that did not claim its record yet will not write on it once discarded.
+            const uint64_t discarded = claimed_stamp(tail_ / capacity_, 0);
+            uint64_t discarded_size = head - tail_;
+            if ((stamp & ~(s_stamp_sized | 0xFFFFFFFFULL)) == (discarded & ~0xFFFFFFFFULL))
+            {
+                if (is_process_alive(static_cast<int32_t>(stamp & 0xFFFFFFFF)))
+                {
+                    return nullptr;
+                }
+
+                if ((stamp & s_stamp_sized) != 0)
+                {
+                    discarded_size = record->padding != 0 ? record->size : record_size(record->size);
+                }
+            }
+
+            if (!record->stamp.compare_exchange_strong(stamp, discarded, std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+            {
+                // The producer has just claimed or published the record.
+                continue;
+            }
+
+            // The size of a record that was not sized is unknown, so the records reserved after it are discarded too.
+            logWarning(RTPS_MSG_IN, "Discarding " << discarded_size << " bytes of " << name_ <<
+                    " reserved by a producer that did not publish them");
+            front_record_size_ = discarded_size;
+            pop();
+            continue;
+        }
+
+        if (record->padding == 0)
+        {
+            size = record->size;
+            front_record_size_ = record_size(record->size);
+            return reinterpret_cast<const octet*>(record + 1);
+        }
+
+        front_record_size_ = record->size;
+        pop();
+    }
+}
+
+void SharedMemSegment::pop()
+{
+    tail_ += front_record_size_;
+    front_record_size_ = 0;
+    header_->tail.store(tail_, std::memory_order_seq_cst);
+
+    if (header_->producers_waiting.load(std::memory_order_seq_cst) != 0)
+    {
+        header_->space_seq.fetch_add(1, std::memory_order_release);
+        wake_on(header_, header_->space_seq);
+    }
+}
+
+void SharedMemSegment::wait(
+        uint32_t timeout_ms)
+{
+    uint32_t seq = header_->data_seq.load(std::memory_order_acquire);
+    header_->listener_waiting.store(1, std::memory_order_seq_cst);
+
+    SharedMemRecordHeader* record = reinterpret_cast<SharedMemRecordHeader*>(record_at(tail_));
+    if (record->stamp.load(std::memory_order_seq_cst) != tail_ + 1)
+    {
+        wait_on(header_, header_->data_seq, seq, timeout_ms);
+    }
+
+    header_->listener_waiting.store(0, std::memory_order_relaxed);
+}
+
+void SharedMemSegment::wake_up()
+{
+    header_->data_seq.fetch_add(1, std::memory_order_release);
+    wake_on(header_, header_->data_seq);
+}
+
+bool SharedMemSegment::wait_for_space(
+        uint64_t observed_tail)
+{
+    uint32_t seq = header_->space_seq.load(std::memory_order_acquire);
+    header_->producers_waiting.fetch_add(1, std::memory_order_seq_cst);
+
+    if (header_->tail.load(std::memory_order_seq_cst) == observed_tail)
+    {
+        wait_on(header_, header_->space_seq, seq, s_space_wait_ms);
+    }
+
+    header_->producers_waiting.fetch_sub(1, std::memory_order_seq_cst);
+    return is_open();
+}
+
+void SharedMemSegment::close()
+{
+    if (!owner_ || header_->owner_pid.load(std::memory_order_relaxed) != current_pid())
+    {
+        return;
+    }
+
+    // The name is released first, so a new listener of the port never loses its segment.
+#if !defined(_WIN32)
+    shm_unlink(name_.c_str());
+#endif
+    header_->owner_pid.store(0, std::memory_order_release);
+
+    // Blocked producers give up.
+    header_->space_seq.fetch_add(1, std::memory_order_release);
+    wake_on(header_, header_->space_seq);
+}
+
+bool SharedMemSegment::is_open() const
+{
+    return is_process_alive(header_->owner_pid.load(std::memory_order_acquire));
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,225 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHAREDMEM_SHAREDMEMSEGMENT_HPP__
+#define __TRANSPORT_SHAREDMEM_SHAREDMEMSEGMENT_HPP__
+
+#include <fastrtps/rtps/common/Types.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+struct SharedMemSegmentHeader;
+struct SharedMemRecordHeader;
+
+/**
+ * Shared-memory segment through which the participants of a host send messages to one listening port.
+ *
+ * The segment is a POSIX shared-memory object holding a ring buffer of variable-size records. Any number of
+ * processes can push messages concurrently: each producer reserves its record with a CAS on the head of the ring,
+ * copies the message and then publishes the record by writing its stamp. Only the process listening on the port
+ * consumes the records, in order, directly from the shared memory.
+ *
+ * A sleeping consumer is woken up through a futex on Linux, and through a process-shared condition variable on other
+ * POSIX systems. Producers only issue the wake-up system call when the consumer is actually waiting.
+ *
+ * A producer that dies between reserving its record and publishing it would block the consumer forever. Right after
+ * the reservation, the producer claims the record by writing its pid on the stamp, along with the lap of the ring, and
+ * then the size of the record. The consumer only discards a claimed record that stays unpublished for a while when its
+ * producer no longer exists, skipping just that record when its size was written. A record that is not even claimed
+ * after a while is discarded along with every record reserved after it, as its size is unknown. Its producer finds
+ * out when claiming it and gives up before writing anything. Likewise, blocking producers give up when the consumer
+ * does not free space for a while, as happens when it is stopped.
+ *
+ * Some hazards remain. A producer that is stopped after claiming its record blocks the port until it resumes or dies.
+ * Producers whose pid cannot be checked from the consumer, as in another pid namespace, look dead, and a pid reused by
+ * another process looks alive. The producers of the records discarded after an unclaimed one, or of a record whose
+ * producer looked dead, may still be copying their messages. Their push() fails when they notice it before publishing,
+ * but if they are stalled for a whole lap of the ring meanwhile, they corrupt the records reserved on top of them.
+ *
+ * The segments are created with 0666 permissions, so the participants of other users can send to the port, and the
+ * consumer parses the messages in place. Hence any local user can write arbitrary data into them, or corrupt the
+ * ring buffer. Messages received through this transport are as trustworthy as unauthenticated UDP datagrams from
+ * the same host, and should be protected by the security plugins when that is not acceptable.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemSegment
+{
+public:
+
+    /**
+     * Creates the segment of a listening port.
+     * A segment left behind by a process that no longer exists is reclaimed.
+     * @param port Listening port.
+     * @param capacity Size in bytes of the ring buffer. It is rounded up to a power of two.
+     * @return The new segment, or nullptr when another live process listens on the port or the segment could not be
+     * created.
+     */
+    static std::shared_ptr<SharedMemSegment> create(
+            uint16_t port,
+            uint32_t capacity);
+
+    /**
+     * Opens the segment of a port on which a participant of this host listens.
+     * @param port Listening port.
+     * @return The segment, or nullptr when nobody listens on the port.
+     */
+    static std::shared_ptr<SharedMemSegment> open(
+            uint16_t port);
+
+    //! Checks whether the shared-memory objects can be created on this host.
+    static bool is_supported();
+
+    /**
+     * Gets the token that identifies the shared-memory namespace of this host on the locators.
+     * The first participant of the namespace publishes a random token in a well-known shared-memory object, and the
+     * rest read it from there. Hence, hosts or containers with the same name but a different namespace get different
+     * tokens, while the participants that can reach each other's segments share it.
+     * @param[out] token Non-zero token.
+     * @return False when the object of the token could not be created nor read.
+     */
+    static bool host_token(
+            uint32_t& token);
+
+    ~SharedMemSegment();
+
+    /**
+     * Copies a message into the ring buffer.
+     * @param data Message to push.
+     * @param size Size of the message.
+     * @param blocking Whether to wait, for a bounded time, until the listener frees enough space when the ring buffer
+     * is full.
+     * @return True when the message was pushed. False when the ring buffer is full and blocking is false or the
+     * listener did not free space in time, the message does not fit in the ring buffer or the listener has gone
+     * away.
+     */
+    bool push(
+            const octet* data,
+            uint32_t size,
+            bool blocking);
+
+    /**
+     * Accesses the next message of the ring buffer, without removing it. Only to be called by the listener.
+     * When the next record has been reserved but not published for too long, it is discarded if its producer did not
+     * claim it, along with every record reserved after it, or if its producer no longer exists.
+     * @param[out] size Size of the message.
+     * @return Pointer to the message in the shared memory, or nullptr when there are no published messages.
+     */
+    const octet* front(
+            uint32_t& size);
+
+    //! Removes the message returned by the last call to front(). Only to be called by the listener.
+    void pop();
+
+    /**
+     * Blocks the listener until a message is pushed, wake_up() is called or the timeout expires.
+     * @param timeout_ms Maximum time to wait, in milliseconds.
+     */
+    void wait(
+            uint32_t timeout_ms);
+
+    //! Wakes up the listener blocked in wait().
+    void wake_up();
+
+    //! Marks the segment as closed, so the producers open the new segment created for the same port, if any.
+    void close();
+
+    //! Checks whether the listener is still alive.
+    bool is_open() const;
+
+    uint32_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+
+    SharedMemSegment(
+            const std::string& name,
+            SharedMemSegmentHeader* header,
+            size_t mapped_size,
+            bool owner);
+
+    SharedMemSegment(const SharedMemSegment&) = delete;
+
+    SharedMemSegment& operator=(const SharedMemSegment&) = delete;
+
+    //! Blocks a producer until the listener advances the tail beyond the given value, or some time elapses.
+    bool wait_for_space(
+            uint64_t observed_tail);
+
+    /**
+     * Claims a reserved record for this process and writes its size.
+     * @return False when the listener has already discarded the record.
+     */
+    bool claim_record(
+            SharedMemRecordHeader* record,
+            uint64_t position,
+            int32_t pid,
+            uint32_t size,
+            uint32_t padding) const;
+
+    /**
+     * Publishes a claimed record to the listener.
+     * @return False when the listener has discarded the record.
+     */
+    bool publish_record(
+            SharedMemRecordHeader* record,
+            uint64_t position,
+            int32_t pid) const;
+
+    //! Returns the record at the given position of the ring.
+    octet* record_at(
+            uint64_t position) const;
+
+    std::string name_;
+
+    SharedMemSegmentHeader* header_;
+
+    octet* data_;
+
+    size_t mapped_size_;
+
+    uint32_t capacity_;
+
+    uint64_t mask_;
+
+    //! Whether this process created the segment and listens on it.
+    bool owner_;
+
+    //! Position of the next record to consume. Only used by the listener.
+    uint64_t tail_;
+
+    //! Size of the record returned by the last call to front().
+    uint64_t front_record_size_;
+
+    //! Position of the record found reserved but not published by the listener. Only used by the listener.
+    uint64_t stalled_tail_;
+
+    //! Time when the listener found the record at stalled_tail_ reserved but not published.
+    std::chrono::steady_clock::time_point stalled_since_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHAREDMEM_SHAREDMEMSEGMENT_HPP__
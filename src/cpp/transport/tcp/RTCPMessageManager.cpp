@@ -26,6 +26,13 @@
 #include <fastrtps/transport/TCPv4TransportDescriptor.h>
 #include <fastrtps/transport/TCPv6TransportDescriptor.h>
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RTCP_CRC_USE_SSE2 1
+#endif
 
 #define IDSTRING "(ID:" << std::this_thread::get_id() <<") "<<
 
@@ -166,6 +173,61 @@ uint32_t& RTCPMessageManager::addToCRC(
     return crc;
 }
 
+uint32_t RTCPMessageManager::addToCRC(
+        uint32_t crc,
+        const octet* data,
+        size_t size)
+{
+    // The CRC is the sum of the bytes with end-around carry, so the bytes can be added in any order and the carries
+    // folded back at the end.
+    uint64_t sum = 0;
+    size_t i = 0;
+
+#if RTCP_CRC_USE_SSE2
+    // Each step adds the sixteen bytes of a block into the two lanes of the accumulator.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lanes = _mm_setzero_si128();
+    for (; size - i >= 16; i += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        lanes = _mm_add_epi64(lanes, _mm_sad_epu8(block, zero));
+    }
+    uint64_t lane_sums[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_sums), lanes);
+    sum = lane_sums[0] + lane_sums[1];
+#endif
+
+    // Each step adds the eight bytes of a word into four 16 bit lanes, which cannot overflow in 128 steps.
+    const uint64_t byte_mask = 0x00FF00FF00FF00FFull;
+    const uint64_t half_mask = 0x0000FFFF0000FFFFull;
+    while (size - i >= 8)
+    {
+        size_t end = i + 8 * (std::min)((size - i) / 8, static_cast<size_t>(128));
+        uint64_t lanes16 = 0;
+        for (; i < end; i += 8)
+        {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            lanes16 += (word & byte_mask) + ((word >> 8) & byte_mask);
+        }
+        lanes16 = (lanes16 & half_mask) + ((lanes16 >> 16) & half_mask);
+        sum += (lanes16 & 0xFFFFFFFFull) + (lanes16 >> 32);
+    }
+
+    for (; i < size; ++i)
+    {
+        sum += data[i];
+    }
+
+    sum += crc;
+    while ((sum >> 32) != 0)
+    {
+        sum = (sum & 0xFFFFFFFFull) + (sum >> 32);
+    }
+
+    return static_cast<uint32_t>(sum);
+}
+
 void RTCPMessageManager::fillHeaders(
         TCPCPMKind kind,
         const TCPTransactionId &transaction_id,
@@ -210,35 +272,16 @@ void RTCPMessageManager::fillHeaders(
     uint32_t crc = 0;
     if (alive() && mTransport->configuration()->calculate_crc)
     {
-        octet* it = (octet*)&retCtrlHeader;
-        for (size_t i = 0; i < TCPControlMsgHeader::size(); ++i)
-        {
-            crc = addToCRC(crc, it[i]);
-        }
+        crc = addToCRC(crc, (octet*)&retCtrlHeader, TCPControlMsgHeader::size());
         if (respCode != nullptr)
         {
-            it = (octet*)respCode;
-            for (int i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, it[i]);
-            }
+            crc = addToCRC(crc, (octet*)respCode, 4);
         }
         if (payload != nullptr)
         {
-            octet* pay = (octet*)&(payload->encapsulation);
-            for (uint32_t i = 0; i < 2; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            pay = (octet*)&(payload->length);
-            for (uint32_t i = 0; i < 4; ++i)
-            {
-                crc = addToCRC(crc, pay[i]);
-            }
-            for (uint32_t i = 0; i < payload->length; ++i)
-            {
-                crc = addToCRC(crc, payload->data[i]);
-            }
+            crc = addToCRC(crc, (octet*)&(payload->encapsulation), 2);
+            crc = addToCRC(crc, (octet*)&(payload->length), 4);
+            crc = addToCRC(crc, payload->data, payload->length);
         }
     }
     header.crc = crc;
@@ -82,6 +82,23 @@ bool test_UDPv4Transport::send(
     }
 }
 
+bool test_UDPv4Transport::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        eProsimaUDPSocket& socket,
+        const LocatorList_t& remote_locators,
+        bool only_multicast_purpose)
+{
+    bool success = false;
+
+    for (const Locator_t& remote_locator : remote_locators)
+    {
+        success |= send(send_buffer, send_buffer_size, socket, remote_locator, only_multicast_purpose);
+    }
+
+    return success;
+}
+
 static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
 {
     if (msg.length - msg.pos < 4)
@@ -16,6 +16,7 @@
 #include <fastrtps/types/DynamicType.h>
 #include <fastrtps/types/DynamicPubSubType.h>
 #include <fastrtps/types/DynamicTypeBuilderFactory.h>
+#include <fastrtps/types/DynamicTypeLayout.h>
 #include <fastrtps/types/DynamicTypeMember.h>
 #include <fastrtps/types/TypeDescriptor.h>
 #include <fastrtps/types/DynamicDataFactory.h>
@@ -25,6 +26,7 @@
 
 #include <locale>
 #include <codecvt>
+#include <cstring>
 
 namespace eprosima {
 namespace fastrtps {
@@ -72,6 +74,9 @@ DynamicData::DynamicData()
     , char16_value_(0)
     , byte_value_(0)
     , bool_value_(false)
+#else
+    , flat_storage_(nullptr)
+    , flat_value_(false)
 #endif
     , key_element_(false)
     , default_array_value_(nullptr)
@@ -97,6 +102,9 @@ DynamicData::DynamicData(DynamicType_ptr pType)
     , char16_value_(0)
     , byte_value_(0)
     , bool_value_(false)
+#else
+    , flat_storage_(nullptr)
+    , flat_value_(false)
 #endif
     , key_element_(false)
     , default_array_value_(nullptr)
@@ -125,6 +133,9 @@ DynamicData::DynamicData(const DynamicData* pData)
     , bool_value_(pData->bool_value_)
     , string_value_(pData->string_value_)
     , wstring_value_(pData->wstring_value_)
+#else
+    , flat_storage_(nullptr)
+    , flat_value_(false)
 #endif
     , key_element_(pData->key_element_)
     , default_array_value_(pData->default_array_value_)
@@ -160,6 +171,7 @@ void DynamicData::create_members(const DynamicData* pData)
         {
             values_.insert(std::make_pair(it->first, DynamicDataFactory::get_instance()->create_copy((DynamicData*)it->second)));
         }
+        create_flat_storage();
     }
     else if (pData->descriptors_.size() > 0)
     {
@@ -244,6 +256,9 @@ void DynamicData::create_members(DynamicType_ptr pType)
                     set_union_id(descriptors_.begin()->first);
                 }
             }
+#ifndef DYNAMIC_TYPES_CHECKING
+            create_flat_storage();
+#endif
         }
         else
         {
@@ -628,6 +643,12 @@ void DynamicData::clean()
 
     clean_members();
 
+#ifndef DYNAMIC_TYPES_CHECKING
+    delete[] flat_storage_;
+    flat_storage_ = nullptr;
+    layout_.reset();
+#endif
+
     type_ = nullptr;
 
     for (auto it = descriptors_.begin(); it != descriptors_.end(); ++it)
@@ -637,6 +658,41 @@ void DynamicData::clean()
     descriptors_.clear();
 }
 
+#ifndef DYNAMIC_TYPES_CHECKING
+void DynamicData::create_flat_storage()
+{
+    if (flat_storage_ != nullptr || type_->layout_ == nullptr)
+    {
+        return;
+    }
+
+    layout_ = type_->layout_;
+    flat_storage_ = new octet[layout_->get_buffer_size()]();
+    for (const DynamicTypeLayout::FlatMember& member : layout_->get_flat_members())
+    {
+        auto it = values_.find(member.id);
+        if (it != values_.end())
+        {
+            ((DynamicData*)it->second)->bind_flat_value(flat_storage_ + member.offset, member.size);
+        }
+    }
+}
+
+void DynamicData::bind_flat_value(
+        octet* storage,
+        uint32_t size)
+{
+    auto it = values_.find(MEMBER_ID_INVALID);
+    if (it != values_.end())
+    {
+        memcpy(storage, it->second, size);
+        clean_members();
+        values_.insert(std::make_pair(MEMBER_ID_INVALID, storage));
+        flat_value_ = true;
+    }
+}
+#endif
+
 ResponseCode DynamicData::clear_all_values()
 {
     if (type_->is_complex_kind())
@@ -681,6 +737,13 @@ void DynamicData::clean_members()
     }
     complex_values_.clear();
 #else
+    if (flat_value_)
+    {
+        // The value belongs to the buffer of the structure.
+        values_.clear();
+        return;
+    }
+
     if (type_->has_children())
     {
         for (auto it = values_.begin(); it != values_.end(); ++it)
@@ -5428,6 +5491,11 @@ bool DynamicData::deserialize(eprosima::fastcdr::Cdr& cdr)
             }
         }
 #else
+        if (flat_storage_ != nullptr && cdr.endianness() == eprosima::fastcdr::Cdr::DEFAULT_ENDIAN)
+        {
+            return deserialize_flat(cdr);
+        }
+
         //uint32_t size(static_cast<uint32_t>(values_.size())), memberId(MEMBER_ID_INVALID);
         for (uint32_t i = 0; i < values_.size(); ++i)
         {
@@ -5822,6 +5890,12 @@ size_t DynamicData::getCdrSerializedSize(
         }
 
 #else
+        if (data->flat_storage_ != nullptr)
+        {
+            current_alignment += getFlatCdrSerializedSize(data, current_alignment);
+            break;
+        }
+
         //for (auto it = data->values_.begin(); it != data->values_.end(); ++it)
         //{
         //    current_alignment += getCdrSerializedSize((DynamicData*)it->second, current_alignment);
@@ -6314,6 +6388,12 @@ void DynamicData::serialize(eprosima::fastcdr::Cdr& cdr) const
             }
         }
 #else
+        if (flat_storage_ != nullptr && cdr.endianness() == eprosima::fastcdr::Cdr::DEFAULT_ENDIAN)
+        {
+            serialize_flat(cdr);
+            break;
+        }
+
         for (uint32_t idx = 0; idx < static_cast<uint32_t>(values_.size()); ++idx)
         {
             auto d_it = descriptors_.find(idx);
@@ -6380,6 +6460,167 @@ void DynamicData::serialize(eprosima::fastcdr::Cdr& cdr) const
 
 
 
+#ifndef DYNAMIC_TYPES_CHECKING
+static void serialize_flat_value(
+        eprosima::fastcdr::Cdr& cdr,
+        TypeKind kind,
+        const octet* value)
+{
+    switch (kind)
+    {
+    default:
+        break;
+    case TK_INT16:
+        cdr << *((const int16_t*)value);
+        break;
+    case TK_UINT16:
+        cdr << *((const uint16_t*)value);
+        break;
+    case TK_INT32:
+        cdr << *((const int32_t*)value);
+        break;
+    case TK_UINT32:
+        cdr << *((const uint32_t*)value);
+        break;
+    case TK_INT64:
+        cdr << *((const int64_t*)value);
+        break;
+    case TK_UINT64:
+        cdr << *((const uint64_t*)value);
+        break;
+    case TK_FLOAT32:
+        cdr << *((const float*)value);
+        break;
+    case TK_FLOAT64:
+        cdr << *((const double*)value);
+        break;
+    case TK_CHAR8:
+        cdr << *((const char*)value);
+        break;
+    case TK_BYTE:
+        cdr << *value;
+        break;
+    }
+}
+
+static void deserialize_flat_value(
+        eprosima::fastcdr::Cdr& cdr,
+        TypeKind kind,
+        octet* value)
+{
+    switch (kind)
+    {
+    default:
+        break;
+    case TK_INT16:
+        cdr >> *((int16_t*)value);
+        break;
+    case TK_UINT16:
+        cdr >> *((uint16_t*)value);
+        break;
+    case TK_INT32:
+        cdr >> *((int32_t*)value);
+        break;
+    case TK_UINT32:
+        cdr >> *((uint32_t*)value);
+        break;
+    case TK_INT64:
+        cdr >> *((int64_t*)value);
+        break;
+    case TK_UINT64:
+        cdr >> *((uint64_t*)value);
+        break;
+    case TK_FLOAT32:
+        cdr >> *((float*)value);
+        break;
+    case TK_FLOAT64:
+        cdr >> *((double*)value);
+        break;
+    case TK_CHAR8:
+        cdr >> *((char*)value);
+        break;
+    case TK_BYTE:
+        cdr >> *value;
+        break;
+    }
+}
+
+void DynamicData::serialize_flat(eprosima::fastcdr::Cdr& cdr) const
+{
+    for (const DynamicTypeLayout::Step& step : layout_->get_steps())
+    {
+        if (step.length == 0)
+        {
+            auto it = values_.find(step.id);
+            if (it != values_.end())
+            {
+                ((DynamicData*)it->second)->serialize(cdr);
+            }
+        }
+        else
+        {
+            // The first member aligns the stream, the rest of the run already has the padding of CDR.
+            const octet* run = flat_storage_ + step.offset;
+            serialize_flat_value(cdr, step.kind, run);
+            if (step.length > step.size)
+            {
+                cdr.serializeArray(run + step.size, step.length - step.size);
+            }
+        }
+    }
+}
+
+bool DynamicData::deserialize_flat(eprosima::fastcdr::Cdr& cdr)
+{
+    for (const DynamicTypeLayout::Step& step : layout_->get_steps())
+    {
+        if (step.length == 0)
+        {
+            auto it = values_.find(step.id);
+            if (it != values_.end())
+            {
+                ((DynamicData*)it->second)->deserialize(cdr);
+            }
+        }
+        else
+        {
+            octet* run = flat_storage_ + step.offset;
+            deserialize_flat_value(cdr, step.kind, run);
+            if (step.length > step.size)
+            {
+                cdr.deserializeArray(run + step.size, step.length - step.size);
+            }
+        }
+    }
+    return true;
+}
+
+size_t DynamicData::getFlatCdrSerializedSize(
+        const DynamicData* data,
+        size_t current_alignment)
+{
+    size_t initial_alignment = current_alignment;
+
+    for (const DynamicTypeLayout::Step& step : data->layout_->get_steps())
+    {
+        if (step.length == 0)
+        {
+            auto it = data->values_.find(step.id);
+            if (it != data->values_.end())
+            {
+                current_alignment += getCdrSerializedSize((DynamicData*)it->second, current_alignment);
+            }
+        }
+        else
+        {
+            current_alignment += step.length + eprosima::fastcdr::Cdr::alignment(current_alignment, step.size);
+        }
+    }
+
+    return current_alignment - initial_alignment;
+}
+#endif
+
 void DynamicData::serialize_discriminator(eprosima::fastcdr::Cdr& cdr) const
 {
     switch (get_kind())
@@ -124,6 +124,10 @@ ResponseCode DynamicType::apply_annotation_to_member(
         if (it != member_by_id_.end())
         {
             it->second->apply_annotation(descriptor);
+            if (layout_ != nullptr)
+            {
+                DynamicTypeBuilderFactory::get_instance()->build_layout(this);
+            }
             return ResponseCode::RETCODE_OK;
         }
         else
@@ -149,6 +153,10 @@ ResponseCode DynamicType::apply_annotation_to_member(
     if (it != member_by_id_.end())
     {
         it->second->apply_annotation(annotation_name, key, value);
+        if (layout_ != nullptr)
+        {
+            DynamicTypeBuilderFactory::get_instance()->build_layout(this);
+        }
         return ResponseCode::RETCODE_OK;
     }
     else
@@ -174,6 +182,7 @@ void DynamicType::clear()
     }
     member_by_id_.clear();
     member_by_name_.clear();
+    layout_.reset();
 }
 
 ResponseCode DynamicType::copy_from_builder(const DynamicTypeBuilder* other)
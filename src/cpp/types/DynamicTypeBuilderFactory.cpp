@@ -19,6 +19,7 @@
 #include <fastrtps/types/TypeObject.h>
 #include <fastrtps/types/DynamicType.h>
 #include <fastrtps/types/DynamicTypePtr.h>
+#include <fastrtps/types/DynamicTypeLayout.h>
 #include <fastrtps/types/DynamicTypeMember.h>
 #include <fastrtps/types/MemberDescriptor.h>
 #include <fastrtps/types/TypeNamesGenerator.h>
@@ -145,6 +146,57 @@ DynamicType_ptr DynamicTypeBuilderFactory::build_type(DynamicType_ptr other)
     return other;
 }
 
+void DynamicTypeBuilderFactory::build_layout(DynamicType* type) const
+{
+    type->layout_.reset();
+
+    // The members of the base type are created apart, so only structures without base type are supported.
+    if (type->get_kind() != TK_STRUCTURE || type->get_base_type() != nullptr)
+    {
+        return;
+    }
+
+    std::shared_ptr<DynamicTypeLayout> layout = std::make_shared<DynamicTypeLayout>();
+    MemberId expected_id = 0;
+    for (auto it = type->member_by_id_.begin(); it != type->member_by_id_.end(); ++it, ++expected_id)
+    {
+        // Structures are serialized in the order of the ids of their members, that must be consecutive.
+        if (it->first != expected_id)
+        {
+            return;
+        }
+
+        const MemberDescriptor* member = it->second->get_descriptor();
+        DynamicType_ptr member_type = member->type_;
+        while (member_type != nullptr && member_type->get_kind() == TK_ALIAS)
+        {
+            member_type = member_type->get_base_type();
+        }
+        if (member_type == nullptr)
+        {
+            return;
+        }
+
+        if (member->annotation_is_non_serialized() || member_type->get_descriptor()->annotation_is_non_serialized())
+        {
+            layout->add_non_serialized_member();
+        }
+        else if (DynamicTypeLayout::get_flat_size(member_type->get_kind()) > 0)
+        {
+            layout->add_flat_member(it->first, member_type->get_kind());
+        }
+        else
+        {
+            layout->add_member(it->first);
+        }
+    }
+
+    if (!layout->get_flat_members().empty())
+    {
+        type->layout_ = layout;
+    }
+}
+
 DynamicType_ptr DynamicTypeBuilderFactory::create_type(
         const TypeDescriptor* descriptor,
         const std::string& name)
@@ -170,6 +222,7 @@ DynamicType_ptr DynamicTypeBuilderFactory::create_type(const DynamicTypeBuilder*
     if (other != nullptr)
     {
         DynamicType_ptr pNewType = new DynamicType(other);
+        build_layout(pNewType.get());
         return pNewType;
     }
     else
@@ -0,0 +1,112 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/types/DynamicTypeLayout.h>
+#include <algorithm>
+
+namespace eprosima {
+namespace fastrtps {
+namespace types {
+
+static uint32_t align(
+        uint32_t offset,
+        uint32_t size)
+{
+    return (offset + size - 1) & ~(size - 1);
+}
+
+DynamicTypeLayout::DynamicTypeLayout()
+    : buffer_size_(0)
+    , run_open_(false)
+{
+}
+
+uint32_t DynamicTypeLayout::get_flat_size(TypeKind kind)
+{
+    switch (kind)
+    {
+    case TK_INT64:
+    case TK_UINT64:
+    case TK_FLOAT64:
+        return 8;
+    case TK_INT32:
+    case TK_UINT32:
+    case TK_FLOAT32:
+        return 4;
+    case TK_INT16:
+    case TK_UINT16:
+        return 2;
+    case TK_CHAR8:
+    case TK_BYTE:
+        return 1;
+    default:
+        // Booleans are validated when deserialized, wide chars and long doubles don't have the same size in CDR.
+        return 0;
+    }
+}
+
+const DynamicTypeLayout::FlatMember* DynamicTypeLayout::find_flat_member(MemberId id) const
+{
+    auto it = std::lower_bound(flat_members_.begin(), flat_members_.end(), id,
+            [](const FlatMember& member, MemberId member_id)
+            {
+                return member.id < member_id;
+            });
+    if (it != flat_members_.end() && it->id == id)
+    {
+        return &(*it);
+    }
+    return nullptr;
+}
+
+void DynamicTypeLayout::add_flat_member(
+        MemberId id,
+        TypeKind kind)
+{
+    uint32_t size = get_flat_size(kind);
+
+    // The padding inside a run doesn't depend on where the run starts as long as no member needs more alignment
+    // than the first one.
+    if (run_open_ && size <= steps_.back().size)
+    {
+        Step& run = steps_.back();
+        uint32_t offset = align(run.offset + run.length, size);
+        run.length = offset + size - run.offset;
+        flat_members_.push_back({id, kind, offset, size});
+        buffer_size_ = offset + size;
+    }
+    else
+    {
+        uint32_t offset = align(buffer_size_, size);
+        steps_.push_back({id, kind, offset, size, size});
+        flat_members_.push_back({id, kind, offset, size});
+        buffer_size_ = offset + size;
+        run_open_ = true;
+    }
+}
+
+void DynamicTypeLayout::add_member(MemberId id)
+{
+    steps_.push_back({id, TK_NONE, 0, 0, 0});
+    run_open_ = false;
+}
+
+void DynamicTypeLayout::add_non_serialized_member()
+{
+    run_open_ = false;
+}
+
+} // namespace types
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,223 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PartitionMatcher.cpp
+ *
+ */
+
+#include <fastrtps/utils/PartitionMatcher.h>
+#include <fastrtps/utils/StringMatching.h>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+/*
+ * The caches are emptied when they reach these sizes, so a system with many different lists of partitions does not
+ * make them grow without limit.
+ */
+static const size_t MAX_COMPILED_PARTITIONS = 4096;
+static const size_t MAX_CACHED_RESULTS = 65536;
+
+/*!
+ * Check whether a partition name can only match an equal name.
+ * On Windows the names are matched case insensitively, so all of them are handled as expressions.
+ */
+static bool is_literal(const std::string& name)
+{
+#if defined(_WIN32)
+    (void)name;
+    return false;
+#else
+    return name.find_first_of("*?[") == std::string::npos;
+#endif
+}
+
+/*!
+ * Check whether the only wildcard of an expression is a trailing '*'.
+ */
+static bool is_prefix(const std::string& expression)
+{
+#if defined(_WIN32)
+    (void)expression;
+    return false;
+#else
+    return expression.find_first_of("*?[") == expression.size() - 1 && expression.back() == '*';
+#endif
+}
+
+static bool starts_with(const std::string& name, const std::string& prefix_expression)
+{
+    size_t prefix_length = prefix_expression.size() - 1;
+    return name.size() >= prefix_length && name.compare(0, prefix_length, prefix_expression, 0, prefix_length) == 0;
+}
+
+PartitionMatcher::PartitionMatcher() :
+    next_id_(0)
+{
+}
+
+bool PartitionMatcher::match(const std::vector<std::string>& partitions1, const std::vector<std::string>& partitions2)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if(compiled_.size() >= MAX_COMPILED_PARTITIONS)
+    {
+        compiled_.clear();
+        results_.clear();
+    }
+    else if(results_.size() >= MAX_CACHED_RESULTS)
+    {
+        results_.clear();
+    }
+
+    // References to the elements of an unordered_map are not invalidated by insertions.
+    const CompiledPartitions& compiled1 = compile(partitions1);
+    const CompiledPartitions& compiled2 = compile(partitions2);
+
+    // Matching is symmetric, so the pair is stored ordered.
+    uint32_t low = compiled1.id < compiled2.id ? compiled1.id : compiled2.id;
+    uint32_t high = compiled1.id < compiled2.id ? compiled2.id : compiled1.id;
+    uint64_t key = (static_cast<uint64_t>(low) << 32) | high;
+
+    auto result = results_.find(key);
+    if(result != results_.end())
+    {
+        return result->second;
+    }
+
+    bool matched = match_compiled(compiled1, compiled2);
+    results_.emplace(key, matched);
+    return matched;
+}
+
+size_t PartitionMatcher::PartitionsHash::operator()(const std::vector<std::string>& partitions) const
+{
+    size_t hash = partitions.size();
+    for(const std::string& name : partitions)
+    {
+        hash = hash * 31 + std::hash<std::string>()(name);
+    }
+    return hash;
+}
+
+const PartitionMatcher::CompiledPartitions& PartitionMatcher::compile(const std::vector<std::string>& partitions)
+{
+    auto it = compiled_.find(partitions);
+    if(it != compiled_.end())
+    {
+        return it->second;
+    }
+
+    CompiledPartitions& compiled = compiled_[partitions];
+    compiled.id = next_id_++;
+    compiled.empty = partitions.empty();
+    compiled.has_empty_name = false;
+    for(const std::string& name : partitions)
+    {
+        if(name.empty())
+        {
+            compiled.has_empty_name = true;
+        }
+
+        if(is_literal(name))
+        {
+            compiled.literals.insert(name);
+        }
+        else
+        {
+            compiled.expressions.push_back({name, is_prefix(name)});
+        }
+    }
+
+    return compiled;
+}
+
+bool PartitionMatcher::match_expression(const Expression& expression, const std::string& name)
+{
+    if(expression.prefix)
+    {
+        return starts_with(name, expression.text);
+    }
+
+    return StringMatching::matchString(expression.text.c_str(), name.c_str());
+}
+
+bool PartitionMatcher::match_expressions(const Expression& expression1, const Expression& expression2)
+{
+    if(expression1.prefix && expression2.prefix)
+    {
+        return starts_with(expression2.text, expression1.text) || starts_with(expression1.text, expression2.text);
+    }
+
+    return StringMatching::matchString(expression1.text.c_str(), expression2.text.c_str());
+}
+
+bool PartitionMatcher::match_compiled(const CompiledPartitions& partitions1, const CompiledPartitions& partitions2)
+{
+    if(partitions1.empty || partitions2.empty)
+    {
+        return (partitions1.empty || partitions1.has_empty_name) &&
+            (partitions2.empty || partitions2.has_empty_name);
+    }
+
+    // Two literals only match when they are equal.
+    const CompiledPartitions& smaller = partitions1.literals.size() < partitions2.literals.size() ?
+        partitions1 : partitions2;
+    const CompiledPartitions& bigger = &smaller == &partitions1 ? partitions2 : partitions1;
+    for(const std::string& literal : smaller.literals)
+    {
+        if(bigger.literals.count(literal) != 0)
+        {
+            return true;
+        }
+    }
+
+    for(const Expression& expression : partitions1.expressions)
+    {
+        for(const std::string& literal : partitions2.literals)
+        {
+            if(match_expression(expression, literal))
+            {
+                return true;
+            }
+        }
+
+        for(const Expression& expression2 : partitions2.expressions)
+        {
+            if(match_expressions(expression, expression2))
+            {
+                return true;
+            }
+        }
+    }
+
+    for(const Expression& expression : partitions2.expressions)
+    {
+        for(const std::string& literal : partitions1.literals)
+        {
+            if(match_expression(expression, literal))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
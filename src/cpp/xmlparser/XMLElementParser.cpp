@@ -320,6 +320,8 @@ XMLP_ret XMLParser::getXMLThroughputController(tinyxml2::XMLElement *elem,
             <xs:all minOccurs="0">
                 <xs:element name="bytesPerPeriod" type="uint32Type" minOccurs="0"/>
                 <xs:element name="periodMillisecs" type="uint32Type" minOccurs="0"/>
+                <xs:element name="burstBytes" type="uint32Type" minOccurs="0"/>
+                <xs:element name="priority" type="uint32Type" minOccurs="0"/>
             </xs:all>
         </xs:complexType>
     */
@@ -341,6 +343,18 @@ XMLP_ret XMLParser::getXMLThroughputController(tinyxml2::XMLElement *elem,
             if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &throughputController.periodMillisecs, ident))
                 return XMLP_ret::XML_ERROR;
         }
+        else if (strcmp(name, BURST_BYTES) == 0)
+        {
+            // burstBytes - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &throughputController.burstBytes, ident))
+                return XMLP_ret::XML_ERROR;
+        }
+        else if (strcmp(name, PRIORITY) == 0)
+        {
+            // priority - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &throughputController.priority, ident))
+                return XMLP_ret::XML_ERROR;
+        }
         else
         {
             logError(XMLPARSER, "Invalid element found into 'portType'. Name: " << name);
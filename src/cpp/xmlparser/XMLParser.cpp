@@ -248,6 +248,7 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 <xs:element name="receiveBufferSize" type="int32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="TTL" type="uint8Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="non_blocking_send" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_batch_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxMessageSize" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxInitialPeersRange" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="interfaceWhiteList" type="stringListType" minOccurs="0" maxOccurs="1"/>
@@ -263,6 +264,7 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 <xs:element name="calculate_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="io_service_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
@@ -322,6 +324,14 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            // Receive batch size
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_BATCH_SIZE)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPDesc->receive_batch_size, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
         }
         else if (sType == TCPv4)
         {
@@ -475,7 +485,8 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp
             strcmp(name, LOGICAL_PORT_INCREMENT) == 0 || strcmp(name, LISTENING_PORTS) == 0 ||
             strcmp(name, CALCULATE_CRC) == 0 || strcmp(name, CHECK_CRC) == 0 ||
             strcmp(name, ENABLE_TCP_NODELAY) == 0 || strcmp(name, TLS) == 0 ||
-            strcmp(name, NON_BLOCKING_SEND) == 0 )
+            strcmp(name, NON_BLOCKING_SEND) == 0 || strcmp(name, RECEIVE_BATCH_SIZE) == 0 ||
+            strcmp(name, IO_SERVICE_THREADS) == 0)
         {
             // Parsed outside of this method
         }
@@ -506,6 +517,7 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(tinyxml2::XMLElement* p_root,
                 <xs:element name="calculate_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="io_service_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
@@ -597,6 +609,14 @@ XMLP_ret XMLParser::parseXMLCommonTCPTransportData(tinyxml2::XMLElement* p_root,
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            else if (strcmp(name, IO_SERVICE_THREADS) == 0)
+            {
+                // io_service_threads - uint32Type
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pTCPDesc->io_service_threads, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
             else if (strcmp(name, TLS) == 0)
             {
                 if (XMLP_ret::XML_OK != parse_tls_config(p_aux0, p_transport))
@@ -2623,6 +2643,7 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
                 <xs:element name="throughputController" type="throughputControllerType" minOccurs="0"/>
                 <xs:element name="userTransports" type="stringListType" minOccurs="0"/>
                 <xs:element name="useBuiltinTransports" type="boolType" minOccurs="0"/>
+                <xs:element name="asyncWriterThreads" type="uint32Type" minOccurs="0"/>
                 <xs:element name="propertiesPolicy" type="propertyPolicyType" minOccurs="0"/>
                 <xs:element name="name" type="stringType" minOccurs="0"/>
             </xs:all>
@@ -2719,6 +2740,12 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
             if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &participant_node.get()->rtps.useBuiltinTransports, ident))
                 return XMLP_ret::XML_ERROR;
         }
+        else if (strcmp(name, ASYNC_WRITER_THREADS) == 0)
+        {
+            // asyncWriterThreads - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &participant_node.get()->rtps.asyncWriterThreads, ident))
+                return XMLP_ret::XML_ERROR;
+        }
         else if (strcmp(name, PROPERTIES_POLICY) == 0)
         {
             // propertiesPolicy
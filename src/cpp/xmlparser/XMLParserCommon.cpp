@@ -41,6 +41,7 @@ const char* RECEIVE_BUFFER_SIZE = "receiveBufferSize";
 const char* SEND_BUFFER_SIZE = "sendBufferSize";
 const char* TTL = "TTL";
 const char* NON_BLOCKING_SEND = "non_blocking_send";
+const char* RECEIVE_BATCH_SIZE = "receive_batch_size";
 const char* WHITE_LIST = "interfaceWhiteList";
 const char* MAX_MESSAGE_SIZE = "maxMessageSize";
 const char* MAX_INITIAL_PEERS_RANGE = "maxInitialPeersRange";
@@ -54,6 +55,7 @@ const char* METADATA_LOGICAL_PORT = "metadata_logical_port";
 const char* LISTENING_PORTS = "listening_ports";
 const char* CALCULATE_CRC = "calculate_crc";
 const char* CHECK_CRC = "check_crc";
+const char* IO_SERVICE_THREADS = "io_service_threads";
 
 const char* QOS_PROFILE = "qos_profile";
 const char* APPLICATION = "application";
@@ -77,6 +79,7 @@ const char* PART_ID = "participantID";
 const char* THROUGHPUT_CONT = "throughputController";
 const char* USER_TRANS = "userTransports";
 const char* USE_BUILTIN_TRANS = "useBuiltinTransports";
+const char* ASYNC_WRITER_THREADS = "asyncWriterThreads";
 const char* PROPERTIES_POLICY = "propertiesPolicy";
 const char* NAME = "name";
 
@@ -194,6 +197,8 @@ const char* DEPTH = "depth";
 const char* ALLOCATED_SAMPLES = "allocated_samples";
 const char* BYTES_PER_SECOND = "bytesPerPeriod";
 const char* PERIOD_MILLISECS = "periodMillisecs";
+const char* BURST_BYTES = "burstBytes";
+const char* PRIORITY = "priority";
 const char* PORT_BASE = "portBase";
 const char* DOMAIN_ID_GAIN = "domainIDGain";
 const char* PARTICIPANT_ID_GAIN = "participantIDGain";
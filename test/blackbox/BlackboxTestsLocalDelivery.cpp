@@ -0,0 +1,188 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BlackboxTests.hpp"
+
+#include "PubSubWriterReader.hpp"
+
+#include <thread>
+
+// Changes of a writer are handed directly to the readers of its own participant.
+
+BLACKBOXTEST(BlackBox, LocalPubSubAsReliableHelloworld)
+{
+    PubSubWriterReader<HelloWorldType> wreader(TEST_TOPIC_NAME);
+
+    wreader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(wreader.isInitialized());
+
+    wreader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+
+    wreader.startReception(data);
+    // Send data
+    wreader.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block until reception finished.
+    wreader.block_for_all();
+}
+
+BLACKBOXTEST(BlackBox, LocalPubSubAsNonReliableHelloworld)
+{
+    PubSubWriterReader<HelloWorldType> wreader(TEST_TOPIC_NAME);
+
+    wreader.reliability(eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(wreader.isInitialized());
+
+    wreader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+
+    wreader.startReception(data);
+    // Send data
+    wreader.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block until reception finished.
+    wreader.block_for_at_least(2);
+}
+
+BLACKBOXTEST(BlackBox, LocalPubSubAsReliableTransientLocalLateJoiner)
+{
+    PubSubWriterReader<HelloWorldType> wreader(TEST_TOPIC_NAME);
+
+    wreader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        durability_kind(eprosima::fastrtps::TRANSIENT_LOCAL_DURABILITY_QOS).
+        history_depth(10).init(false);
+
+    ASSERT_TRUE(wreader.isInitialized());
+
+    auto data = default_helloworld_data_generator();
+    auto expected_data = data;
+
+    // Send data before the reader exists.
+    wreader.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+
+    ASSERT_TRUE(wreader.create_subscriber());
+    wreader.wait_discovery();
+
+    wreader.startReception(expected_data);
+    // The reader gets the history of the writer.
+    wreader.block_for_all();
+}
+
+BLACKBOXTEST(BlackBox, LocalPubSubAsNonReliableTransientLocalLateJoiner)
+{
+    PubSubWriterReader<HelloWorldType> wreader(TEST_TOPIC_NAME);
+
+    wreader.reliability(eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS).
+        durability_kind(eprosima::fastrtps::TRANSIENT_LOCAL_DURABILITY_QOS).
+        history_depth(10).init(false);
+
+    ASSERT_TRUE(wreader.isInitialized());
+
+    auto data = default_helloworld_data_generator();
+    auto expected_data = data;
+
+    // Send data before the reader exists.
+    wreader.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+
+    ASSERT_TRUE(wreader.create_subscriber());
+    wreader.wait_discovery();
+
+    wreader.startReception(expected_data);
+    // The reader gets the history of the writer.
+    wreader.block_for_all();
+}
+
+// The reader is deleted while a thread keeps writing. Neither the writer nor the deliveries pending for the reader
+// may use it once deleted.
+BLACKBOXTEST(BlackBox, LocalPubSubRemoveReaderWhileWriting)
+{
+    PubSubWriterReader<HelloWorldType> wreader(TEST_TOPIC_NAME);
+
+    wreader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        history_depth(100).init();
+
+    ASSERT_TRUE(wreader.isInitialized());
+
+    wreader.wait_discovery();
+
+    auto data = default_helloworld_data_generator(1000);
+
+    wreader.startReception(data);
+
+    std::thread sender([&wreader, &data]()
+            {
+                wreader.send(data);
+            });
+
+    wreader.block_for_at_least(10);
+    ASSERT_TRUE(wreader.remove_subscriber());
+
+    sender.join();
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+
+    // The writer keeps working without the reader.
+    auto more_data = default_helloworld_data_generator();
+    wreader.send(more_data);
+    ASSERT_TRUE(more_data.empty());
+}
+
+// The listener of the reader republishes through the writer that delivered the sample. Every sample is delivered
+// once the previous delivery finished, instead of from inside it.
+BLACKBOXTEST(BlackBox, LocalPubSubListenerRepublishes)
+{
+    PubSubWriterReader<HelloWorldType> wreader(TEST_TOPIC_NAME);
+
+    const uint16_t number_of_samples = 100;
+
+    wreader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        history_depth(number_of_samples).
+        on_receive([number_of_samples](eprosima::fastrtps::Publisher* publisher, const HelloWorld& sample)
+                {
+                    if(sample.index() < number_of_samples)
+                    {
+                        HelloWorld next;
+                        next.index(static_cast<uint16_t>(sample.index() + 1));
+                        std::stringstream ss;
+                        ss << "HelloWorld " << next.index();
+                        next.message(ss.str());
+                        ASSERT_TRUE(publisher->write((void*)&next));
+                    }
+                }).init();
+
+    ASSERT_TRUE(wreader.isInitialized());
+
+    wreader.wait_discovery();
+
+    auto data = default_helloworld_data_generator(number_of_samples);
+    std::list<HelloWorld> first_sample(1, data.front());
+
+    wreader.startReception(data);
+    // Send only the first sample. The listener sends the rest.
+    wreader.send(first_sample);
+    ASSERT_TRUE(first_sample.empty());
+    // Block until reception finished.
+    wreader.block_for_all();
+}
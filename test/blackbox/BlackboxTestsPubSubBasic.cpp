@@ -111,6 +111,51 @@ BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworld)
     reader.block_for_all();
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldMultipleReaders)
+{
+    const size_t num_readers = 5;
+    std::vector<std::unique_ptr<PubSubReader<HelloWorldType>>> readers;
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    for (size_t i = 0; i < num_readers; ++i)
+    {
+        readers.emplace_back(new PubSubReader<HelloWorldType>(TEST_TOPIC_NAME));
+        readers.back()->history_depth(100).
+            reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+        ASSERT_TRUE(readers.back()->isInitialized());
+    }
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    ASSERT_TRUE(writer.wait_discovery(num_readers, std::chrono::seconds(10)));
+    for (auto& reader : readers)
+    {
+        reader->wait_discovery();
+    }
+
+    auto data = default_helloworld_data_generator();
+
+    for (auto& reader : readers)
+    {
+        reader->startReception(data);
+    }
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block readers until reception finished or timeout.
+    for (auto& reader : readers)
+    {
+        reader->block_for_all();
+    }
+    // All readers acknowledged all samples
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(5)));
+}
+
 BLACKBOXTEST(BlackBox, AsyncPubSubAsReliableHelloworld)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
@@ -225,6 +270,145 @@ BLACKBOXTEST(BlackBox, PubSubMoreThan256Unacknowledged)
     reader.block_for_all();
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableLoanedSamples)
+{
+    PubSubReader<FixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<FixedSizedType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_fixed_sized_data_generator();
+
+    reader.startReception(data);
+
+    // A discarded sample is not sent
+    void* sample = nullptr;
+    ASSERT_TRUE(writer.loan_sample(sample));
+    ASSERT_NE(sample, nullptr);
+    ASSERT_TRUE(writer.discard_loan(sample));
+    ASSERT_EQ(sample, nullptr);
+    ASSERT_FALSE(writer.discard_loan(sample));
+
+    // Fill the CDR representation of each sample in place
+    for(auto& fixed_sized : data)
+    {
+        ASSERT_TRUE(writer.loan_sample(sample));
+        uint16_t index = fixed_sized.index();
+        memcpy(sample, &index, sizeof(index));
+        ASSERT_TRUE(writer.send_loaned_sample(sample));
+        ASSERT_EQ(sample, nullptr);
+    }
+
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+
+    // A sample still loaned is returned to the history when the publisher is destroyed
+    ASSERT_TRUE(writer.loan_sample(sample));
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableTakeLoanedSamples)
+{
+    PubSubReader<FixedSizedType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<FixedSizedType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_fixed_sized_data_generator();
+    size_t num_samples = data.size();
+
+    // Samples stay in the reader history, as reception is not started.
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(5)));
+    ASSERT_EQ(reader.get_unread_count(), num_samples);
+
+    // Read some samples, which remain in the history
+    eprosima::fastrtps::LoanedSamples samples;
+    ASSERT_TRUE(reader.read_loaned(samples, 4));
+    ASSERT_EQ(samples.size(), 4u);
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+        ASSERT_EQ(samples.info(i).sampleKind, eprosima::fastrtps::rtps::ALIVE);
+        ASSERT_NE(samples.sample(i), nullptr);
+        uint16_t index = 0;
+        memcpy(&index, samples.sample(i), sizeof(index));
+        ASSERT_EQ(index, i + 1);
+    }
+    ASSERT_FALSE(reader.take_loaned(samples));
+    ASSERT_EQ(reader.get_unread_count(), num_samples - 4);
+
+    // Take all the samples while the read ones are still loaned
+    eprosima::fastrtps::LoanedSamples taken;
+    ASSERT_TRUE(reader.take_loaned(taken));
+    ASSERT_EQ(taken.size(), num_samples);
+    ASSERT_TRUE(reader.return_loan(samples));
+    ASSERT_TRUE(samples.empty());
+    for(size_t i = 0; i < taken.size(); ++i)
+    {
+        FixedSized fixed_sized;
+        eprosima::fastrtps::rtps::SerializedPayload_t payload(taken.payload(i).length);
+        payload.copy(&taken.payload(i));
+        FixedSizedType type;
+        ASSERT_TRUE(type.deserialize(&payload, &fixed_sized));
+        ASSERT_EQ(fixed_sized.index(), i + 1);
+    }
+    ASSERT_TRUE(reader.return_loan(taken));
+    ASSERT_FALSE(reader.return_loan(taken));
+
+    ASSERT_FALSE(reader.take_loaned(taken));
+    ASSERT_EQ(reader.get_unread_count(), 0u);
+
+    // A loan is moved with its sequence and returned when the sequence is destroyed
+    data = default_fixed_sized_data_generator();
+    writer.send(data);
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(5)));
+    {
+        eprosima::fastrtps::LoanedSamples scoped;
+        ASSERT_TRUE(reader.take_loaned(scoped, 1));
+        eprosima::fastrtps::LoanedSamples moved(std::move(scoped));
+        ASSERT_TRUE(scoped.empty());
+        ASSERT_EQ(moved.size(), 1u);
+        ASSERT_FALSE(reader.return_loan(scoped));
+    }
+    ASSERT_EQ(reader.get_unread_count(), num_samples - 1);
+    ASSERT_TRUE(reader.take_loaned(taken));
+}
+
+BLACKBOXTEST(BlackBox, PubSubLoanNotPlainType)
+{
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    writer.init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    void* sample = nullptr;
+    ASSERT_FALSE(writer.loan_sample(sample));
+    ASSERT_EQ(sample, nullptr);
+}
+
 BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldMulticastDisabled)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
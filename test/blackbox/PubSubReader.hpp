@@ -29,6 +29,7 @@
 #include <fastrtps/subscriber/SubscriberListener.h>
 #include <fastrtps/attributes/SubscriberAttributes.h>
 #include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/subscriber/LoanedSamples.h>
 #include <fastrtps/xmlparser/XMLParser.h>
 #include <fastrtps/xmlparser/XMLTree.h>
 #include <fastrtps/utils/IPLocator.h>
@@ -695,6 +696,26 @@ public:
         return false;
     }
 
+    bool read_loaned(eprosima::fastrtps::LoanedSamples& samples, size_t max_samples = 0)
+    {
+        return subscriber_->read_loaned(samples, max_samples);
+    }
+
+    bool take_loaned(eprosima::fastrtps::LoanedSamples& samples, size_t max_samples = 0)
+    {
+        return subscriber_->take_loaned(samples, max_samples);
+    }
+
+    bool return_loan(eprosima::fastrtps::LoanedSamples& samples)
+    {
+        return subscriber_->return_loan(samples);
+    }
+
+    uint64_t get_unread_count() const
+    {
+        return subscriber_->getUnreadCount();
+    }
+
     unsigned int missed_deadlines() const
     {
         return listener_.missed_deadlines();
@@ -294,6 +294,21 @@ class PubSubWriter
         return publisher_->write((void*)&msg);
     }
 
+    bool loan_sample(void*& sample)
+    {
+        return publisher_->loan_sample(sample);
+    }
+
+    bool send_loaned_sample(void*& sample)
+    {
+        return publisher_->write_loan(sample);
+    }
+
+    bool discard_loan(void*& sample)
+    {
+        return publisher_->discard_loan(sample);
+    }
+
     void wait_discovery(std::chrono::seconds timeout = std::chrono::seconds::zero())
     {
         std::unique_lock<std::mutex> lock(mutexDiscovery_);
@@ -312,6 +327,20 @@ class PubSubWriter
         std::cout << "Writer discovery finished..." << std::endl;
     }
 
+    bool wait_discovery(
+            unsigned int expected_match,
+            std::chrono::seconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutexDiscovery_);
+
+        std::cout << "Writer is waiting discovery of " << expected_match << " readers..." << std::endl;
+
+        bool ret = cv_.wait_for(lock, timeout, [&](){return matched_ >= expected_match;});
+
+        std::cout << "Writer discovery finished..." << std::endl;
+        return ret;
+    }
+
     void wait_participant_undiscovery()
     {
         std::unique_lock<std::mutex> lock(mutexDiscovery_);
@@ -184,7 +184,7 @@ class PubSubWriterReader
             eprosima::fastrtps::Domain::removeParticipant(participant_);
     }
 
-    void init()
+    void init(bool with_subscriber = true)
     {
         //Create participant
         participant_attr_.rtps.builtin.domainId = (uint32_t)GET_PID() % 230;
@@ -200,10 +200,7 @@ class PubSubWriterReader
 
             if(publisher_ != nullptr)
             {
-                //Create subscribe r
-                subscriber_ = eprosima::fastrtps::Domain::createSubscriber(participant_, subscriber_attr_, &sub_listener_);
-
-                if(subscriber_ != nullptr)
+                if(!with_subscriber || create_subscriber())
                 {
                     initialized_ = true;
                     return;
@@ -211,9 +208,23 @@ class PubSubWriterReader
             }
 
             eprosima::fastrtps::Domain::removeParticipant(participant_);
+            participant_ = nullptr;
         }
     }
 
+    bool create_subscriber()
+    {
+        subscriber_ = eprosima::fastrtps::Domain::createSubscriber(participant_, subscriber_attr_, &sub_listener_);
+        return subscriber_ != nullptr;
+    }
+
+    bool remove_subscriber()
+    {
+        eprosima::fastrtps::Subscriber* subscriber = subscriber_;
+        subscriber_ = nullptr;
+        return eprosima::fastrtps::Domain::removeSubscriber(subscriber);
+    }
+
     bool isInitialized() const { return initialized_; }
 
     void destroy()
@@ -277,6 +288,14 @@ class PubSubWriterReader
                 });
     }
 
+    size_t block_for_at_least(size_t at_least)
+    {
+        block([this, at_least]() -> bool {
+                return current_received_count_ >= at_least;
+                });
+        return current_received_count_;
+    }
+
     void block(std::function<bool()> checker)
     {
         std::unique_lock<std::mutex> lock(mutex_);
@@ -337,6 +356,37 @@ class PubSubWriterReader
     }
 #endif
 
+    PubSubWriterReader& reliability(const eprosima::fastrtps::ReliabilityQosPolicyKind kind)
+    {
+        publisher_attr_.qos.m_reliability.kind = kind;
+        subscriber_attr_.qos.m_reliability.kind = kind;
+        return *this;
+    }
+
+    PubSubWriterReader& durability_kind(const eprosima::fastrtps::DurabilityQosPolicyKind kind)
+    {
+        publisher_attr_.qos.m_durability.kind = kind;
+        subscriber_attr_.qos.m_durability.kind = kind;
+        return *this;
+    }
+
+    PubSubWriterReader& history_depth(const int32_t depth)
+    {
+        publisher_attr_.topic.historyQos.depth = depth;
+        subscriber_attr_.topic.historyQos.depth = depth;
+        return *this;
+    }
+
+    /**
+     * Sets a function called from the listener of the subscriber with each sample received.
+     * It gets the publisher, so samples can be republished from the listener.
+     */
+    PubSubWriterReader& on_receive(std::function<void(eprosima::fastrtps::Publisher*, const type&)> callback)
+    {
+        on_receive_ = callback;
+        return *this;
+    }
+
     PubSubWriterReader& property_policy(const eprosima::fastrtps::rtps::PropertyPolicy property_policy)
     {
         participant_attr_.rtps.properties = property_policy;
@@ -381,6 +431,12 @@ class PubSubWriterReader
                 ++current_received_count_;
                 default_receive_print<type>(data);
                 cv_.notify_one();
+
+                if(on_receive_)
+                {
+                    lock.unlock();
+                    on_receive_(publisher_, data);
+                }
             }
         }
     }
@@ -438,6 +494,7 @@ class PubSubWriterReader
 	eprosima::fastrtps::rtps::SequenceNumber_t last_seq;
     size_t current_received_count_;
     size_t number_samples_expected_;
+    std::function<void(eprosima::fastrtps::Publisher*, const type&)> on_receive_;
 #if HAVE_SECURITY
     std::mutex mutexAuthentication_;
     std::condition_variable cvAuthentication_;
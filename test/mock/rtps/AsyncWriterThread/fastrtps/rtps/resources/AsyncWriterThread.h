@@ -19,6 +19,9 @@
 #ifndef _RTPS_RESOURCES_ASYNCWRITERTHREAD_H_
 #define _RTPS_RESOURCES_ASYNCWRITERTHREAD_H_
 
+#include <mutex>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -33,6 +36,35 @@ class AsyncWriterThread
         static void wakeUp(const RTPSParticipantImpl*) {}
 
         static void wakeUp(const RTPSWriter*) {}
+
+        static void wakeUp(const RTPSParticipantImpl*, const RTPSWriter* writer)
+        {
+            std::lock_guard<std::mutex> guard(woken_mutex());
+            woken_writers_nts().push_back(writer);
+        }
+
+        //! Returns the writers woken up through a participant since the last call, in the order they were woken up.
+        static std::vector<const RTPSWriter*> take_woken_writers()
+        {
+            std::lock_guard<std::mutex> guard(woken_mutex());
+            std::vector<const RTPSWriter*> woken;
+            woken.swap(woken_writers_nts());
+            return woken;
+        }
+
+    private:
+
+        static std::mutex& woken_mutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        static std::vector<const RTPSWriter*>& woken_writers_nts()
+        {
+            static std::vector<const RTPSWriter*> woken;
+            return woken;
+        }
 };
 
 } // namespace rtps
@@ -34,6 +34,16 @@
 #define logWarning(cat,msg) logInfo(cat,msg)
 #define logError(cat,msg) logInfo(cat,msg)
 
+#define logInfoDeferred(cat, ...)                                                                       \
+    {                                                                                                   \
+        NulStreambuf null_buffer;                                                                       \
+        std::ostream null_stream(&null_buffer);                                                         \
+        eprosima::fastrtps::LogMockStream(null_stream, __VA_ARGS__);                                    \
+    }
+
+#define logWarningDeferred(cat, ...) logInfoDeferred(cat, __VA_ARGS__)
+#define logErrorDeferred(cat, ...) logInfoDeferred(cat, __VA_ARGS__)
+
 class NulStreambuf : public std::streambuf
 {
 protected:
@@ -50,6 +60,13 @@ class LogConsumer
         virtual ~LogConsumer() {}
 };
 
+template<typename... Args>
+void LogMockStream(std::ostream& stream, const Args&... args)
+{
+    int expand[] = {0, ((void)(stream << args), 0)...};
+    (void)expand;
+}
+
 class Log
 {
     public:
@@ -45,6 +45,10 @@ class RTPSReader : public Endpoint
 
         MOCK_CONST_METHOD0(getGuid, const GUID_t&());
 
+        MOCK_METHOD2(reserveCache, bool(CacheChange_t**, uint32_t));
+
+        MOCK_METHOD1(releaseCache, void(CacheChange_t*));
+
         ReaderHistory* getHistory()
         {
             getHistory_mock();
@@ -47,6 +47,8 @@ class RTPSWriter : public Endpoint
 			
 		MOCK_METHOD1(set_separate_sending, void(bool));
 
+        MOCK_CONST_METHOD0(getFlowControllerPriority, uint32_t());
+
         WriterHistory* history_;
 };
 
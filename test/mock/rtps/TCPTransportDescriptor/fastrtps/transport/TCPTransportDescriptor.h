@@ -162,6 +162,7 @@ typedef struct TCPTransportDescriptor : public SocketTransportDescriptor
     bool calculate_crc;
     bool check_crc;
     bool apply_security;
+    uint32_t io_service_threads;
 
     TLSConfig tls_config;
 
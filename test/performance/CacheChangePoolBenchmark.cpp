@@ -0,0 +1,166 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CacheChangePoolBenchmark.cpp
+ *
+ * Measures the cost of reserving and releasing changes from the pool of a history, for each memory management
+ * policy. A number of changes is kept reserved while changes in random positions are released and new changes,
+ * with random payload sizes, are reserved.
+ */
+
+#include <fastrtps/rtps/RTPSDomain.h>
+#include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/history/ReaderHistory.h>
+#include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastrtps/rtps/attributes/ReaderAttributes.h>
+#include <fastrtps/rtps/attributes/HistoryAttributes.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static const uint32_t OPERATIONS = 200000;
+static const uint32_t MIN_PAYLOAD_SIZE = 16;
+static const uint32_t MAX_PAYLOAD_SIZE = 4096;
+
+struct PoolResult
+{
+    //! Mean time, in nanoseconds, spent on reserving each of the outstanding changes.
+    double fill;
+    //! Mean time, in nanoseconds, spent on each release/reserve pair once the outstanding changes are reserved.
+    double steady;
+};
+
+/**
+ * Runs the benchmark on the pool of a history.
+ * @param history History to use. It must be empty.
+ * @param outstanding Number of changes kept reserved.
+ * @param result Returned results.
+ * @return True if all the changes could be reserved.
+ */
+static bool run_pool(
+        ReaderHistory& history,
+        uint32_t outstanding,
+        PoolResult& result)
+{
+    std::mt19937 gen(outstanding);
+    std::uniform_int_distribution<uint32_t> payload_size(MIN_PAYLOAD_SIZE, MAX_PAYLOAD_SIZE);
+    std::uniform_int_distribution<uint32_t> position(0, outstanding - 1);
+    std::vector<CacheChange_t*> changes(outstanding, nullptr);
+    bool ret = true;
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < outstanding && ret; ++i)
+    {
+        ret = history.reserve_Cache(&changes[i], payload_size(gen));
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.fill = std::chrono::duration<double, std::nano>(end - start).count() / outstanding;
+
+    start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < OPERATIONS && ret; ++i)
+    {
+        CacheChange_t*& change = changes[position(gen)];
+        history.release_Cache(change);
+        ret = history.reserve_Cache(&change, payload_size(gen));
+    }
+    end = std::chrono::steady_clock::now();
+    result.steady = std::chrono::duration<double, std::nano>(end - start).count() / OPERATIONS;
+
+    for(CacheChange_t* change : changes)
+    {
+        if(change != nullptr)
+        {
+            history.release_Cache(change);
+        }
+    }
+
+    return ret;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t outstanding = 10000;
+    if(argc > 1)
+    {
+        outstanding = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if(outstanding == 0)
+    {
+        std::cout << "Number of outstanding changes must be greater than 0" << std::endl;
+        return 1;
+    }
+
+    RTPSParticipantAttributes pattr;
+    pattr.builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol = false;
+    pattr.builtin.use_SIMPLE_EndpointDiscoveryProtocol = false;
+    pattr.builtin.use_WriterLivelinessProtocol = false;
+    RTPSParticipant* participant = RTPSDomain::createParticipant(pattr);
+    if(participant == nullptr)
+    {
+        std::cout << "Error creating participant" << std::endl;
+        return 1;
+    }
+
+    const MemoryManagementPolicy_t policies[] = {PREALLOCATED_MEMORY_MODE, PREALLOCATED_WITH_REALLOC_MEMORY_MODE,
+        DYNAMIC_RESERVE_MEMORY_MODE};
+    const char* policy_names[] = {"PREALLOCATED", "PREALLOCATED_WITH_REALLOC", "DYNAMIC_RESERVE"};
+
+    std::cout << "Outstanding changes: " << outstanding << std::endl;
+    std::cout << std::setw(28) << "Policy" << std::setw(16) << "Fill (ns)" << std::setw(24) <<
+        "Release/reserve (ns)" << std::endl;
+    for(size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); ++p)
+    {
+        // Preallocated policies reserve the maximum payload size and the number of outstanding changes up front.
+        uint32_t initial_payload = policies[p] == PREALLOCATED_MEMORY_MODE ? MAX_PAYLOAD_SIZE : MIN_PAYLOAD_SIZE;
+        HistoryAttributes hatt(policies[p], initial_payload, static_cast<int32_t>(outstanding), 0);
+        ReaderHistory* history = new ReaderHistory(hatt);
+        ReaderAttributes ratt;
+        RTPSReader* reader = RTPSDomain::createRTPSReader(participant, ratt, history);
+        if(reader == nullptr)
+        {
+            std::cout << "Error creating reader" << std::endl;
+            delete history;
+            continue;
+        }
+
+        PoolResult result;
+        if(run_pool(*history, outstanding, result))
+        {
+            std::cout << std::setw(28) << policy_names[p] << std::setw(16) << std::fixed << std::setprecision(1) <<
+                result.fill << std::setw(24) << result.steady << std::endl;
+        }
+        else
+        {
+            std::cout << std::setw(28) << policy_names[p] << "    Error reserving changes" << std::endl;
+        }
+
+        RTPSDomain::removeRTPSReader(reader);
+        delete history;
+    }
+
+    RTPSDomain::removeRTPSParticipant(participant);
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DynamicTypesBenchmark.cpp
+ *
+ * Measures the cost of serializing and deserializing a structure of primitive members and a string, as a static
+ * type with the code that fastrtpsgen generates, and as a DynamicData through DynamicPubSubType.
+ */
+
+#include <fastrtps/types/DynamicDataFactory.h>
+#include <fastrtps/types/DynamicPubSubType.h>
+#include <fastrtps/types/DynamicTypeBuilderFactory.h>
+#include <fastrtps/types/DynamicTypeBuilderPtr.h>
+#include <fastrtps/types/DynamicType.h>
+#include <fastrtps/types/DynamicData.h>
+#include <fastrtps/rtps/common/SerializedPayload.h>
+
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastBuffer.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+using namespace eprosima::fastrtps::types;
+
+static const uint32_t FLAT_MEMBERS = 16;
+
+//! Equivalent to the code generated for a structure with the same members.
+struct StaticStruct
+{
+    int32_t ids[FLAT_MEMBERS / 2];
+    double values[FLAT_MEMBERS / 2];
+    std::string name;
+
+    void serialize(eprosima::fastcdr::Cdr& cdr) const
+    {
+        for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i)
+        {
+            cdr << ids[i];
+        }
+        for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i)
+        {
+            cdr << values[i];
+        }
+        cdr << name;
+    }
+
+    void deserialize(eprosima::fastcdr::Cdr& cdr)
+    {
+        for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i)
+        {
+            cdr >> ids[i];
+        }
+        for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i)
+        {
+            cdr >> values[i];
+        }
+        cdr >> name;
+    }
+};
+
+static DynamicType_ptr create_type()
+{
+    DynamicTypeBuilderFactory* factory = DynamicTypeBuilderFactory::get_instance();
+    DynamicTypeBuilder_ptr builder = factory->create_struct_builder();
+    MemberId id = 0;
+    for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i, ++id)
+    {
+        builder->add_member(id, "id_" + std::to_string(i), factory->create_int32_type());
+    }
+    for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i, ++id)
+    {
+        builder->add_member(id, "value_" + std::to_string(i), factory->create_float64_type());
+    }
+    builder->add_member(id, "name", factory->create_string_type());
+    builder->set_name("BenchmarkStruct");
+    return builder->build();
+}
+
+template<typename Operation>
+static double run(
+        uint32_t iterations,
+        Operation operation)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < iterations; ++i)
+    {
+        operation();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t iterations = 1000000;
+    if(argc > 1)
+    {
+        iterations = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    StaticStruct static_data;
+    for(uint32_t i = 0; i < FLAT_MEMBERS / 2; ++i)
+    {
+        static_data.ids[i] = static_cast<int32_t>(i * 1000);
+        static_data.values[i] = i * 0.5;
+    }
+    static_data.name = "benchmark";
+
+    DynamicType_ptr type = create_type();
+    DynamicData* dynamic_data = DynamicDataFactory::get_instance()->create_data(type);
+    for(MemberId i = 0; i < FLAT_MEMBERS / 2; ++i)
+    {
+        dynamic_data->set_int32_value(static_data.ids[i], i);
+        dynamic_data->set_float64_value(static_data.values[i], FLAT_MEMBERS / 2 + i);
+    }
+    dynamic_data->set_string_value(static_data.name, FLAT_MEMBERS);
+    DynamicData* dynamic_result = DynamicDataFactory::get_instance()->create_data(type);
+    DynamicPubSubType pubsub_type(type);
+
+    SerializedPayload_t static_payload(512);
+    SerializedPayload_t dynamic_payload(512);
+    StaticStruct static_result;
+
+    auto static_serialize = [&]()
+    {
+        eprosima::fastcdr::FastBuffer fastbuffer((char*)static_payload.data, static_payload.max_size);
+        eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
+            eprosima::fastcdr::Cdr::DDS_CDR);
+        ser.serialize_encapsulation();
+        static_data.serialize(ser);
+        static_payload.length = static_cast<uint32_t>(ser.getSerializedDataLength());
+    };
+    auto static_deserialize = [&]()
+    {
+        eprosima::fastcdr::FastBuffer fastbuffer((char*)static_payload.data, static_payload.length);
+        eprosima::fastcdr::Cdr deser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
+            eprosima::fastcdr::Cdr::DDS_CDR);
+        deser.read_encapsulation();
+        static_result.deserialize(deser);
+    };
+    auto dynamic_serialize = [&]()
+    {
+        pubsub_type.serialize(dynamic_data, &dynamic_payload);
+    };
+    auto dynamic_deserialize = [&]()
+    {
+        pubsub_type.deserialize(&dynamic_payload, dynamic_result);
+    };
+
+    double static_ser = run(iterations, static_serialize);
+    double static_deser = run(iterations, static_deserialize);
+    double dynamic_ser = run(iterations, dynamic_serialize);
+    double dynamic_deser = run(iterations, dynamic_deserialize);
+
+    if(static_payload.length != dynamic_payload.length ||
+            memcmp(static_payload.data, dynamic_payload.data, static_payload.length) != 0 ||
+            !dynamic_result->equals(dynamic_data))
+    {
+        std::cout << "Error: the static and dynamic types don't serialize the same stream" << std::endl;
+        return 1;
+    }
+
+    std::cout << FLAT_MEMBERS << " primitive members and a string, " << static_payload.length << " bytes, " <<
+        iterations << " iterations" << std::endl;
+    std::cout << std::setw(10) << "Type" << std::setw(16) << "serialize ns" << std::setw(18) << "deserialize ns" <<
+        std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(10) << "static" << std::setw(16) << static_ser << std::setw(18) << static_deser << std::endl;
+    std::cout << std::setw(10) << "dynamic" << std::setw(16) << dynamic_ser << std::setw(18) << dynamic_deser <<
+        std::endl;
+
+    DynamicDataFactory::get_instance()->delete_data(dynamic_data);
+    DynamicDataFactory::get_instance()->delete_data(dynamic_result);
+    return 0;
+}
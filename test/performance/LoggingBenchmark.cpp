@@ -0,0 +1,138 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoggingBenchmark.cpp
+ *
+ * Measures the cost for the calling threads of logging a warning similar to the ones of the receive path, when it is
+ * discarded by the verbosity level or the category filter, and when it is logged formatting the message in the calling
+ * thread or deferring the formatting to the logging thread. The consumer discards the entries, and the number of them
+ * that were logged, instead of dropped because the queue was full, is also reported.
+ */
+
+#include <fastrtps/log/Log.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+
+static std::atomic<uint64_t> consumed_entries(0);
+
+class NullConsumer : public LogConsumer
+{
+    public:
+
+        void Consume(const Log::Entry& entry) override
+        {
+            if(entry.context.category != std::string("LOG"))
+            {
+                ++consumed_entries;
+            }
+        }
+};
+
+static void report(
+        const char* name,
+        double ns_per_message)
+{
+    // Wait for the logging thread to consume all the entries.
+    Log::ClearConsumers();
+    std::cout << std::setw(26) << name << std::setw(20) << ns_per_message << std::setw(16) <<
+        consumed_entries.exchange(0) << std::endl;
+    Log::RegisterConsumer(std::unique_ptr<LogConsumer>(new NullConsumer));
+}
+
+enum class Mode
+{
+    EAGER,
+    DEFERRED
+};
+
+static double run(
+        uint32_t threads,
+        uint32_t messages,
+        Mode mode)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for(uint32_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([messages, mode]()
+        {
+            for(uint32_t i = 0; i < messages; ++i)
+            {
+                if(mode == Mode::EAGER)
+                {
+                    logWarning(BENCHMARK, "(ID:" << std::this_thread::get_id() <<
+                        ") No Reader accepts this message (directed to: " << i << ")");
+                }
+                else
+                {
+                    logWarningDeferred(BENCHMARK, "(ID:", std::this_thread::get_id(),
+                        ") No Reader accepts this message (directed to: ", i, ")");
+                }
+            }
+        });
+    }
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / messages;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t messages = 100000;
+    uint32_t threads = 4;
+    if(argc > 1)
+    {
+        messages = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if(argc > 2)
+    {
+        threads = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    }
+
+    Log::ClearConsumers();
+    Log::RegisterConsumer(std::unique_ptr<LogConsumer>(new NullConsumer));
+
+    std::cout << threads << " threads, " << messages << " messages each" << std::endl;
+    std::cout << std::setw(26) << "Mode" << std::setw(20) << "ns/message" << std::setw(16) << "logged" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    Log::SetVerbosity(Log::Error);
+    report("disabled by verbosity", run(threads, messages, Mode::EAGER));
+
+    Log::SetVerbosity(Log::Warning);
+    Log::SetCategoryFilter(std::regex("(RTPS_)"));
+    report("disabled by category", run(threads, messages, Mode::EAGER));
+
+    Log::SetCategoryFilter(std::regex("(BENCHMARK)"));
+    report("formatted by caller", run(threads, messages, Mode::EAGER));
+    report("deferred", run(threads, messages, Mode::DEFERRED));
+    Log::ClearConsumers();
+
+    return 0;
+}
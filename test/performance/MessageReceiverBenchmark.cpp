@@ -0,0 +1,219 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MessageReceiverBenchmark.cpp
+ *
+ * Measures the cost of dispatching inbound DATA submessages depending on the number of endpoints hosted by the
+ * receiving participant. Datagrams carrying many DATA submessages directed to one reader are sent to the
+ * participant through the loopback interface, while the number of other readers sharing the same listening
+ * locator grows.
+ */
+
+#include <fastrtps/rtps/RTPSDomain.h>
+#include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/reader/ReaderListener.h>
+#include <fastrtps/rtps/history/ReaderHistory.h>
+#include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastrtps/rtps/attributes/ReaderAttributes.h>
+#include <fastrtps/rtps/attributes/HistoryAttributes.h>
+#include <fastrtps/rtps/messages/CDRMessage.h>
+#include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+#include <fastrtps/utils/IPLocator.h>
+
+#include <asio.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static const uint16_t LISTENING_PORT = 27411;
+static const uint32_t DATAGRAMS_PER_STEP = 2000;
+static const uint32_t SUBMESSAGES_PER_DATAGRAM = 64;
+static const uint32_t PAYLOAD_SIZE = 16;
+
+class CountingListener : public ReaderListener
+{
+public:
+
+    void onNewCacheChangeAdded(
+            RTPSReader* reader,
+            const CacheChange_t* const change) override
+    {
+        reader->getHistory()->remove_change(const_cast<CacheChange_t*>(change));
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        ++received_;
+        cv_.notify_one();
+    }
+
+    bool wait_for(
+            uint64_t expected)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(1), [&]() { return received_ >= expected; });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t received_ = 0;
+};
+
+struct BenchmarkReader
+{
+    ReaderHistory* history;
+    RTPSReader* reader;
+};
+
+static bool create_reader(
+        RTPSParticipant* participant,
+        const Locator_t& locator,
+        ReaderListener* listener,
+        std::vector<BenchmarkReader>& readers)
+{
+    HistoryAttributes hatt(PREALLOCATED_MEMORY_MODE, PAYLOAD_SIZE + 4, 4, 0);
+    ReaderAttributes ratt;
+    ratt.endpoint.unicastLocatorList.push_back(locator);
+
+    BenchmarkReader entry;
+    entry.history = new ReaderHistory(hatt);
+    entry.reader = RTPSDomain::createRTPSReader(participant, ratt, entry.history, listener);
+    if(entry.reader == nullptr)
+    {
+        delete entry.history;
+        return false;
+    }
+
+    readers.push_back(entry);
+    return true;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t max_endpoints = 1000;
+    if(argc > 1)
+    {
+        max_endpoints = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    RTPSParticipantAttributes pattr;
+    pattr.builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol = false;
+    pattr.builtin.use_SIMPLE_EndpointDiscoveryProtocol = false;
+    pattr.builtin.use_WriterLivelinessProtocol = false;
+    RTPSParticipant* participant = RTPSDomain::createParticipant(pattr);
+    if(participant == nullptr)
+    {
+        std::cout << "Error creating participant" << std::endl;
+        return 1;
+    }
+
+    Locator_t locator;
+    IPLocator::setIPv4(locator, 127, 0, 0, 1);
+    locator.port = LISTENING_PORT;
+
+    // The first reader is the destination of every submessage. The rest are only there to populate the receiver.
+    CountingListener listener;
+    std::vector<BenchmarkReader> readers;
+    if(!create_reader(participant, locator, &listener, readers))
+    {
+        std::cout << "Error creating reader" << std::endl;
+        RTPSDomain::removeRTPSParticipant(participant);
+        return 1;
+    }
+
+    GuidPrefix_t writer_prefix;
+    writer_prefix.value[0] = 0xAA;
+    GUID_t writer_guid(writer_prefix, 0x00000102);
+
+    RemoteWriterAttributes watt;
+    watt.guid = writer_guid;
+    readers.front().reader->matched_writer_add(watt);
+
+    asio::io_service io_service;
+    asio::ip::udp::socket socket(io_service, asio::ip::udp::endpoint(asio::ip::udp::v4(), 0));
+    asio::ip::udp::endpoint destination(asio::ip::address_v4::loopback(), LISTENING_PORT);
+
+    CacheChange_t change(PAYLOAD_SIZE);
+    change.writerGUID = writer_guid;
+    change.serializedPayload.length = PAYLOAD_SIZE;
+    memset(change.serializedPayload.data, 0, PAYLOAD_SIZE);
+
+    CDRMessage_t msg(RTPSMESSAGE_DEFAULT_SIZE);
+    uint64_t expected = 0;
+
+    std::cout << std::setw(12) << "Endpoints" << std::setw(24) << "ns per DATA submessage" << std::endl;
+    for(uint32_t endpoints = 1; endpoints <= max_endpoints; endpoints *= 10)
+    {
+        while(readers.size() < endpoints)
+        {
+            if(!create_reader(participant, locator, nullptr, readers))
+            {
+                std::cout << "Error creating reader" << std::endl;
+                break;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for(uint32_t d = 0; d < DATAGRAMS_PER_STEP; ++d)
+        {
+            CDRMessage::initCDRMsg(&msg);
+            RTPSMessageCreator::addHeader(&msg, writer_prefix);
+            for(uint32_t s = 0; s < SUBMESSAGES_PER_DATAGRAM; ++s)
+            {
+                ++change.sequenceNumber;
+                RTPSMessageCreator::addSubmessageData(&msg, &change, NO_KEY, readers.front().reader->getGuid().entityId,
+                        false, nullptr);
+            }
+
+            socket.send_to(asio::buffer(msg.buffer, msg.length), destination);
+
+            // Wait for the datagram to be processed so no datagram is lost in the socket.
+            expected += SUBMESSAGES_PER_DATAGRAM;
+            if(!listener.wait_for(expected))
+            {
+                std::cout << "Timeout waiting for datagram " << d << std::endl;
+                break;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << std::setw(12) << readers.size() << std::setw(24) << std::fixed << std::setprecision(1) <<
+            std::chrono::duration<double, std::nano>(end - start).count() /
+            (DATAGRAMS_PER_STEP * SUBMESSAGES_PER_DATAGRAM) << std::endl;
+    }
+
+    for(BenchmarkReader& entry : readers)
+    {
+        RTPSDomain::removeRTPSReader(entry.reader);
+    }
+    RTPSDomain::removeRTPSParticipant(participant);
+    for(BenchmarkReader& entry : readers)
+    {
+        delete entry.history;
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PartitionMatchingBenchmark.cpp
+ *
+ * Measures the cost of matching the partitions of every writer against the partitions of every reader, as done
+ * during endpoint discovery. Each endpoint uses one of a number of different lists of several partitions, taken from
+ * a common set of names where some of them are expressions with wildcards. The names are compared pairwise with
+ * StringMatching, and with a PartitionMatcher, both when its caches are empty and when they already hold the results.
+ */
+
+#include <fastrtps/utils/PartitionMatcher.h>
+#include <fastrtps/utils/StringMatching.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+using Partitions = std::vector<std::string>;
+
+static const uint32_t PARTITIONS_PER_ENDPOINT = 4;
+static const uint32_t PARTITION_NAMES = 64;
+static const uint32_t DISTINCT_LISTS = 128;
+//! One in this number of partition names is an expression.
+static const uint32_t EXPRESSION_RATIO = 8;
+
+static bool pairwise_match(const Partitions& partitions1, const Partitions& partitions2)
+{
+    for(const std::string& name1 : partitions1)
+    {
+        for(const std::string& name2 : partitions2)
+        {
+            if(StringMatching::matchString(name1.c_str(), name2.c_str()))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static std::vector<Partitions> create_endpoints(
+        uint32_t count,
+        std::mt19937& gen)
+{
+    std::vector<std::string> names;
+    for(uint32_t i = 0; i < PARTITION_NAMES; ++i)
+    {
+        if(i % EXPRESSION_RATIO == 0)
+        {
+            names.push_back("area_" + std::to_string(i) + "/*");
+        }
+        else
+        {
+            names.push_back("area_" + std::to_string(i) + "/zone_" + std::to_string(i * 7));
+        }
+    }
+
+    std::uniform_int_distribution<uint32_t> name(0, PARTITION_NAMES - 1);
+    std::vector<Partitions> lists(DISTINCT_LISTS);
+    for(Partitions& partitions : lists)
+    {
+        for(uint32_t i = 0; i < PARTITIONS_PER_ENDPOINT; ++i)
+        {
+            partitions.push_back(names[name(gen)]);
+        }
+    }
+
+    std::uniform_int_distribution<uint32_t> list(0, DISTINCT_LISTS - 1);
+    std::vector<Partitions> endpoints(count);
+    for(Partitions& partitions : endpoints)
+    {
+        partitions = lists[list(gen)];
+    }
+
+    return endpoints;
+}
+
+template<typename Matcher>
+static double run(
+        const std::vector<Partitions>& writers,
+        const std::vector<Partitions>& readers,
+        Matcher matcher,
+        uint32_t& matches)
+{
+    matches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(const Partitions& writer : writers)
+    {
+        for(const Partitions& reader : readers)
+        {
+            if(matcher(writer, reader))
+            {
+                ++matches;
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (writers.size() * readers.size());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t endpoints = 2000;
+    if(argc > 1)
+    {
+        endpoints = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    std::mt19937 gen(endpoints);
+    std::vector<Partitions> writers = create_endpoints(endpoints / 2, gen);
+    std::vector<Partitions> readers = create_endpoints(endpoints / 2, gen);
+
+    PartitionMatcher partition_matcher;
+    auto cached_matcher = [&partition_matcher](const Partitions& writer, const Partitions& reader)
+    {
+        return partition_matcher.match(writer, reader);
+    };
+
+    uint32_t pairwise_matches = 0;
+    uint32_t cold_matches = 0;
+    uint32_t warm_matches = 0;
+    double pairwise = run(writers, readers, pairwise_match, pairwise_matches);
+    double cold = run(writers, readers, cached_matcher, cold_matches);
+    double warm = run(writers, readers, cached_matcher, warm_matches);
+
+    if(pairwise_matches != cold_matches || pairwise_matches != warm_matches)
+    {
+        std::cout << "Error: different number of matches" << std::endl;
+        return 1;
+    }
+
+    std::cout << writers.size() << " writers x " << readers.size() << " readers, " << PARTITIONS_PER_ENDPOINT <<
+        " partitions each, " << DISTINCT_LISTS << " different lists, " << pairwise_matches << " matches" << std::endl;
+    std::cout << std::setw(26) << "Method" << std::setw(20) << "ns/match attempt" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(26) << "pairwise matchString" << std::setw(20) << pairwise << std::endl;
+    std::cout << std::setw(26) << "PartitionMatcher (cold)" << std::setw(20) << cold << std::endl;
+    std::cout << std::setw(26) << "PartitionMatcher (cached)" << std::setw(20) << warm << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PersistenceBenchmark.cpp
+ *
+ * Measures the rate at which the SQLite3 persistence service stores writer changes and reader sequence numbers,
+ * committing every operation on its own or grouping them in transactions, with different journal modes and
+ * synchronous levels. The time includes flushing all the operations to the database.
+ */
+
+#include "rtps/persistence/PersistenceService.h"
+#include <fastrtps/rtps/attributes/PropertyPolicy.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace eprosima::fastrtps::rtps;
+
+static const char* DATABASE_FILE = "persistence_benchmark.db";
+static const uint32_t PAYLOAD_SIZE = 256;
+
+struct BenchmarkMode
+{
+    const char* name;
+    const char* batch_size;
+    const char* journal_mode;
+    const char* synchronous;
+};
+
+static void remove_database()
+{
+    std::remove(DATABASE_FILE);
+    std::remove((std::string(DATABASE_FILE) + "-wal").c_str());
+    std::remove((std::string(DATABASE_FILE) + "-shm").c_str());
+}
+
+static IPersistenceService* create_service(
+        const BenchmarkMode& mode)
+{
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", DATABASE_FILE);
+    policy.properties().emplace_back("dds.persistence.sqlite3.batch_size", mode.batch_size);
+    policy.properties().emplace_back("dds.persistence.sqlite3.batch_period_ms", "10");
+    if(mode.journal_mode != nullptr)
+    {
+        policy.properties().emplace_back("dds.persistence.sqlite3.journal_mode", mode.journal_mode);
+    }
+    if(mode.synchronous != nullptr)
+    {
+        policy.properties().emplace_back("dds.persistence.sqlite3.synchronous", mode.synchronous);
+    }
+
+    return PersistenceFactory::create_persistence_service(policy);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t operations = 2000;
+    if(argc > 1)
+    {
+        operations = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    const BenchmarkMode modes[] =
+    {
+        {"immediate", "1", nullptr, nullptr},
+        {"immediate WAL NORMAL", "1", "WAL", "NORMAL"},
+        {"batched 128", "128", nullptr, nullptr},
+        {"batched 128 WAL NORMAL", "128", "WAL", "NORMAL"},
+    };
+
+    CacheChange_t change(PAYLOAD_SIZE);
+    change.kind = ALIVE;
+    change.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1U);
+    change.serializedPayload.length = PAYLOAD_SIZE;
+    memset(change.serializedPayload.data, 0xAA, PAYLOAD_SIZE);
+
+    std::cout << std::setw(26) << "Mode" << std::setw(20) << "Writer changes/s" << std::setw(20) <<
+        "Reader updates/s" << std::endl;
+
+    for(const BenchmarkMode& mode : modes)
+    {
+        remove_database();
+        IPersistenceService* service = create_service(mode);
+        if(service == nullptr)
+        {
+            std::cout << "Error creating persistence service" << std::endl;
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for(uint32_t i = 1; i <= operations; ++i)
+        {
+            change.sequenceNumber = SequenceNumber_t(0, i);
+            service->add_writer_change_to_storage("BENCHMARK_WRITER", change);
+        }
+        service->flush();
+        auto end = std::chrono::steady_clock::now();
+        double writer_rate = operations / std::chrono::duration<double>(end - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for(uint32_t i = 1; i <= operations; ++i)
+        {
+            service->update_writer_seq_on_storage("BENCHMARK_READER", change.writerGUID, SequenceNumber_t(0, i));
+        }
+        service->flush();
+        end = std::chrono::steady_clock::now();
+        double reader_rate = operations / std::chrono::duration<double>(end - start).count();
+
+        delete service;
+
+        std::cout << std::setw(26) << mode.name << std::setw(20) << std::fixed << std::setprecision(0) <<
+            writer_rate << std::setw(20) << reader_rate << std::endl;
+    }
+
+    remove_database();
+
+    return 0;
+}
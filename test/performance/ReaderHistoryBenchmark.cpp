@@ -0,0 +1,159 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReaderHistoryBenchmark.cpp
+ *
+ * Measures the cost of inserting a sample in a ReaderHistory depending on the history depth.
+ * The history is kept at a constant depth by removing the oldest sample after each insertion.
+ */
+
+#include <fastrtps/rtps/RTPSDomain.h>
+#include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/history/ReaderHistory.h>
+#include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastrtps/rtps/attributes/ReaderAttributes.h>
+#include <fastrtps/rtps/attributes/HistoryAttributes.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static const uint32_t SAMPLES_PER_DEPTH = 20000;
+
+static bool add_sample(
+        ReaderHistory& history,
+        const GUID_t& writer_guid,
+        SequenceNumber_t& seq,
+        int64_t timestamp)
+{
+    CacheChange_t* change = nullptr;
+    if(!history.reserve_Cache(&change, 64))
+    {
+        return false;
+    }
+
+    change->writerGUID = writer_guid;
+    change->sequenceNumber = ++seq;
+    change->sourceTimestamp = rtps::Time_t(static_cast<int32_t>(timestamp >> 32), static_cast<uint32_t>(timestamp));
+    change->serializedPayload.length = 64;
+
+    if(!history.add_change(change))
+    {
+        history.release_Cache(change);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the mean time, in nanoseconds, spent on each add_change/remove_change pair.
+ * @param history History to use. It must be empty.
+ * @param depth Number of samples kept in the history.
+ * @param out_of_order Whether some samples arrive with a timestamp older than the last one.
+ */
+static double run_depth(
+        ReaderHistory& history,
+        uint32_t depth,
+        bool out_of_order)
+{
+    GUID_t writer_guid;
+    writer_guid.guidPrefix.value[0] = 1;
+    writer_guid.entityId = c_EntityId_Unknown;
+    writer_guid.entityId.value[3] = 0x03;
+
+    std::mt19937 gen(depth);
+    std::uniform_int_distribution<int64_t> jitter(0, 50);
+    SequenceNumber_t seq;
+    int64_t timestamp = 1000000;
+
+    for(uint32_t i = 0; i < depth; ++i)
+    {
+        add_sample(history, writer_guid, seq, timestamp += 100);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < SAMPLES_PER_DEPTH; ++i)
+    {
+        timestamp += 100;
+        add_sample(history, writer_guid, seq, out_of_order && (i % 4) == 0 ? timestamp - jitter(gen) * 100 : timestamp);
+
+        CacheChange_t* oldest = nullptr;
+        if(history.get_earliest_change(&oldest))
+        {
+            history.remove_change(oldest);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    history.remove_all_changes();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / SAMPLES_PER_DEPTH;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t max_depth = 50000;
+    if(argc > 1)
+    {
+        max_depth = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    RTPSParticipantAttributes pattr;
+    pattr.builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol = false;
+    pattr.builtin.use_SIMPLE_EndpointDiscoveryProtocol = false;
+    pattr.builtin.use_WriterLivelinessProtocol = false;
+    RTPSParticipant* participant = RTPSDomain::createParticipant(pattr);
+    if(participant == nullptr)
+    {
+        std::cout << "Error creating participant" << std::endl;
+        return 1;
+    }
+
+    HistoryAttributes hatt(DYNAMIC_RESERVE_MEMORY_MODE, 64, 0, 0);
+    ReaderHistory* history = new ReaderHistory(hatt);
+    ReaderAttributes ratt;
+    RTPSReader* reader = RTPSDomain::createRTPSReader(participant, ratt, history);
+    if(reader == nullptr)
+    {
+        std::cout << "Error creating reader" << std::endl;
+        RTPSDomain::removeRTPSParticipant(participant);
+        delete history;
+        return 1;
+    }
+
+    std::cout << std::setw(10) << "Depth" << std::setw(20) << "In order (ns)" << std::setw(20) <<
+        "Out of order (ns)" << std::endl;
+    for(uint32_t depth = 10; depth <= max_depth; depth *= 10)
+    {
+        double in_order = run_depth(*history, depth, false);
+        double out_of_order = run_depth(*history, depth, true);
+        std::cout << std::setw(10) << depth << std::setw(20) << std::fixed << std::setprecision(1) << in_order <<
+            std::setw(20) << out_of_order << std::endl;
+    }
+
+    RTPSDomain::removeRTPSReader(reader);
+    RTPSDomain::removeRTPSParticipant(participant);
+    delete history;
+
+    return 0;
+}
@@ -0,0 +1,362 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SharedMemTransportBenchmark.cpp
+ *
+ * Compares the throughput and the round-trip latency of UDPv4Transport over the loopback interface with the ones
+ * of SharedMemTransport, for payloads from 64 bytes to 4 MB. Payloads bigger than a message are split in messages
+ * of FRAGMENT_SIZE bytes, as the writers do with fragmented samples.
+ */
+
+#include <fastrtps/transport/UDPv4Transport.h>
+#include <fastrtps/transport/UDPv4TransportDescriptor.h>
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
+#include <fastrtps/rtps/network/SenderResource.h>
+#include <fastrtps/utils/IPLocator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static const uint16_t UDP_PING_PORT = 27511;
+static const uint16_t UDP_PONG_PORT = 27512;
+static const uint16_t SHM_PING_PORT = 27513;
+static const uint16_t SHM_PONG_PORT = 27514;
+static const uint32_t FRAGMENT_SIZE = 64000;
+static const uint32_t SOCKET_BUFFER_SIZE = 4 * 1024 * 1024;
+static const uint64_t BYTES_PER_STEP = 64ull * 1024 * 1024;
+static const std::chrono::milliseconds RECEPTION_TIMEOUT(500);
+
+/**
+ * Side of the benchmark listening on a port.
+ * Each message starts with the number of the payload it belongs to, so the messages of payloads given up as lost
+ * do not count for the following ones.
+ */
+class Peer : public TransportReceiverInterface
+{
+public:
+
+    void OnDataReceived(
+            const octet* data,
+            const uint32_t size,
+            const Locator_t&,
+            const Locator_t&) override
+    {
+        uint32_t payload = 0;
+        memcpy(&payload, data, sizeof(payload));
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        total_bytes_ += size;
+        last_reception_ = std::chrono::steady_clock::now();
+
+        if (payload != current_payload_)
+        {
+            current_payload_ = payload;
+            current_bytes_ = 0;
+        }
+        current_bytes_ += size;
+
+        if (current_bytes_ == payload_size_)
+        {
+            last_completed_payload_ = payload;
+            current_bytes_ = 0;
+            if (echo_ != nullptr)
+            {
+                // Answers with the whole payload, from the listening thread.
+                SenderResource* echo = echo_;
+                Locator_t echo_locator = echo_locator_;
+                uint32_t payload_size = payload_size_;
+                lock.unlock();
+                send_payload(*echo, echo_locator, payload, payload_size);
+                return;
+            }
+        }
+        cv_.notify_one();
+    }
+
+    void reset(
+            uint32_t payload_size)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        payload_size_ = payload_size;
+        current_payload_ = UINT32_MAX;
+        current_bytes_ = 0;
+        last_completed_payload_ = UINT32_MAX;
+        total_bytes_ = 0;
+    }
+
+    //! Makes this peer answer every complete payload to the given locator.
+    void echo_to(
+            SenderResource* sender,
+            const Locator_t& locator)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        echo_ = sender;
+        echo_locator_ = locator;
+    }
+
+    //! Waits until the given payload has been completed.
+    bool wait_payload(
+            uint32_t payload)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, RECEPTION_TIMEOUT, [&]() { return last_completed_payload_ == payload; });
+    }
+
+    //! Waits until no message arrives for a while, and returns the bytes received and the time of the last one.
+    uint64_t wait_silence(
+            std::chrono::steady_clock::time_point& last_reception)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint64_t bytes = total_bytes_;
+        do
+        {
+            bytes = total_bytes_;
+            cv_.wait_for(lock, RECEPTION_TIMEOUT);
+        } while (bytes != total_bytes_);
+
+        last_reception = last_reception_;
+        return total_bytes_;
+    }
+
+    static void send_payload(
+            SenderResource& sender,
+            const Locator_t& destination,
+            uint32_t payload,
+            uint32_t payload_size)
+    {
+        static thread_local std::vector<octet> buffer(FRAGMENT_SIZE);
+        memcpy(buffer.data(), &payload, sizeof(payload));
+
+        for (uint32_t offset = 0; offset < payload_size; offset += FRAGMENT_SIZE)
+        {
+            uint32_t size = std::min(FRAGMENT_SIZE, payload_size - offset);
+            sender.send(buffer.data(), size, destination);
+        }
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t payload_size_ = 0;
+    uint32_t current_payload_ = UINT32_MAX;
+    uint32_t current_bytes_ = 0;
+    uint32_t last_completed_payload_ = UINT32_MAX;
+    uint64_t total_bytes_ = 0;
+    std::chrono::steady_clock::time_point last_reception_;
+    SenderResource* echo_ = nullptr;
+    Locator_t echo_locator_;
+};
+
+/**
+ * A ping transport and a pong transport of the same kind, each one listening on its port.
+ */
+struct Bench
+{
+    const char* name;
+    std::unique_ptr<TransportInterface> ping;
+    std::unique_ptr<TransportInterface> pong;
+    Locator_t ping_locator;
+    Locator_t pong_locator;
+    SendResourceList ping_senders;
+    SendResourceList pong_senders;
+    Peer ping_peer;
+    Peer pong_peer;
+
+    bool open()
+    {
+        if (!ping->init() || !pong->init())
+        {
+            std::cout << "Cannot initialize the " << name << " transports" << std::endl;
+            return false;
+        }
+
+        ping_locator = *ping->NormalizeLocator(ping_locator).begin();
+        pong_locator = *pong->NormalizeLocator(pong_locator).begin();
+        uint32_t max_message_size = ping->get_configuration()->max_message_size();
+        if (!ping->OpenInputChannel(ping_locator, &ping_peer, max_message_size) ||
+                !pong->OpenInputChannel(pong_locator, &pong_peer, max_message_size) ||
+                !ping->OpenOutputChannel(ping_senders, pong_locator) ||
+                !pong->OpenOutputChannel(pong_senders, ping_locator) ||
+                ping_senders.empty() || pong_senders.empty())
+        {
+            std::cout << "Cannot open the " << name << " transports" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        ping_senders.clear();
+        pong_senders.clear();
+        ping->CloseInputChannel(ping_locator);
+        pong->CloseInputChannel(pong_locator);
+    }
+};
+
+static uint32_t iterations(
+        uint32_t payload_size,
+        uint32_t minimum,
+        uint32_t maximum)
+{
+    return static_cast<uint32_t>(std::max<uint64_t>(minimum, std::min<uint64_t>(maximum,
+           BYTES_PER_STEP / payload_size)));
+}
+
+static void run_throughput(
+        Bench& bench,
+        uint32_t payload_size)
+{
+    uint32_t payloads = iterations(payload_size, 20, 20000);
+    bench.pong_peer.echo_to(nullptr, Locator_t());
+    bench.pong_peer.reset(payload_size);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t payload = 0; payload < payloads; ++payload)
+    {
+        Peer::send_payload(*bench.ping_senders.front(), bench.pong_locator, payload, payload_size);
+    }
+
+    std::chrono::steady_clock::time_point last_reception;
+    uint64_t received = bench.pong_peer.wait_silence(last_reception);
+    uint64_t sent = static_cast<uint64_t>(payloads) * payload_size;
+    double seconds = received == 0 ? 0.0 : std::chrono::duration<double>(last_reception - start).count();
+
+    std::cout << std::setw(6) << bench.name << std::setw(10) << payload_size;
+    if (seconds > 0.0)
+    {
+        std::cout << std::setw(14) << std::fixed << std::setprecision(0) <<
+            (static_cast<double>(received) / payload_size) / seconds <<
+            std::setw(12) << std::setprecision(1) << (static_cast<double>(received) / (1024 * 1024)) / seconds;
+    }
+    else
+    {
+        std::cout << std::setw(14) << "-" << std::setw(12) << "-";
+    }
+    std::cout << std::setw(9) << std::setprecision(2) <<
+        100.0 * static_cast<double>(sent - std::min(sent, received)) / sent << std::endl;
+}
+
+static void run_latency(
+        Bench& bench,
+        uint32_t payload_size)
+{
+    uint32_t rounds = iterations(payload_size, 20, 1000);
+    bench.pong_peer.echo_to(bench.pong_senders.front().get(), bench.ping_locator);
+    bench.pong_peer.reset(payload_size);
+    bench.ping_peer.reset(payload_size);
+
+    std::vector<double> round_trips;
+    round_trips.reserve(rounds);
+    uint32_t lost = 0;
+
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Peer::send_payload(*bench.ping_senders.front(), bench.pong_locator, round, payload_size);
+        if (bench.ping_peer.wait_payload(round))
+        {
+            round_trips.push_back(std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start).count());
+        }
+        else
+        {
+            ++lost;
+        }
+    }
+    bench.pong_peer.echo_to(nullptr, Locator_t());
+
+    std::cout << std::setw(6) << bench.name << std::setw(10) << payload_size;
+    if (round_trips.empty())
+    {
+        std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-";
+    }
+    else
+    {
+        std::sort(round_trips.begin(), round_trips.end());
+        std::cout << std::fixed << std::setprecision(1) <<
+            std::setw(12) << round_trips.front() / 2 <<
+            std::setw(12) << round_trips[round_trips.size() / 2] / 2 <<
+            std::setw(12) << round_trips[(round_trips.size() * 99) / 100] / 2;
+    }
+    std::cout << std::setw(8) << lost << std::endl;
+}
+
+int main()
+{
+    const std::vector<uint32_t> payload_sizes = { 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304 };
+
+    UDPv4TransportDescriptor udp_descriptor;
+    udp_descriptor.sendBufferSize = SOCKET_BUFFER_SIZE;
+    udp_descriptor.receiveBufferSize = SOCKET_BUFFER_SIZE;
+
+    SharedMemTransportDescriptor shm_descriptor;
+    shm_descriptor.segment_size = SOCKET_BUFFER_SIZE;
+
+    Bench udp;
+    udp.name = "UDPv4";
+    udp.ping.reset(new UDPv4Transport(udp_descriptor));
+    udp.pong.reset(new UDPv4Transport(udp_descriptor));
+    IPLocator::createLocator(LOCATOR_KIND_UDPv4, "127.0.0.1", UDP_PING_PORT, udp.ping_locator);
+    IPLocator::createLocator(LOCATOR_KIND_UDPv4, "127.0.0.1", UDP_PONG_PORT, udp.pong_locator);
+
+    Bench shm;
+    shm.name = "SHM";
+    shm.ping.reset(new SharedMemTransport(shm_descriptor));
+    shm.pong.reset(new SharedMemTransport(shm_descriptor));
+    shm.ping_locator.kind = LOCATOR_KIND_SHM;
+    shm.ping_locator.port = SHM_PING_PORT;
+    shm.pong_locator.kind = LOCATOR_KIND_SHM;
+    shm.pong_locator.port = SHM_PONG_PORT;
+
+    if (!udp.open() || !shm.open())
+    {
+        return 1;
+    }
+
+    std::cout << "Throughput, " << FRAGMENT_SIZE << " bytes per message" << std::endl;
+    std::cout << std::setw(6) << "Kind" << std::setw(10) << "Payload" << std::setw(14) << "Payloads/s" <<
+        std::setw(12) << "MB/s" << std::setw(9) << "Loss %" << std::endl;
+    for (uint32_t payload_size : payload_sizes)
+    {
+        run_throughput(udp, payload_size);
+        run_throughput(shm, payload_size);
+    }
+
+    std::cout << std::endl << "One-way latency (us), half of the round trip" << std::endl;
+    std::cout << std::setw(6) << "Kind" << std::setw(10) << "Payload" << std::setw(12) << "Min" <<
+        std::setw(12) << "Median" << std::setw(12) << "99%" << std::setw(8) << "Lost" << std::endl;
+    for (uint32_t payload_size : payload_sizes)
+    {
+        run_latency(udp, payload_size);
+        run_latency(shm, payload_size);
+    }
+
+    udp.close();
+    shm.close();
+    return 0;
+}
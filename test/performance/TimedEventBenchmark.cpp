@@ -0,0 +1,308 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TimedEventBenchmark.cpp
+ *
+ * Compares timed events served by the timer wheel of the IO service with one asio timer per event, as many events
+ * as matched proxies in a participant. It measures the rate of restarts and cancellations while the events are
+ * waiting, and how late the events are executed when all of them expire in a short window of time. The IO service is
+ * run by a single thread, as the one of a participant.
+ */
+
+#include <fastrtps/rtps/resources/TimedEvent.h>
+
+#include <asio.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+static const uint32_t CHURN_ROUNDS = 20;
+static const double CHURN_INTERVAL_MS = 1000.0;
+static const uint32_t FIRE_WINDOW_MS = 100;
+static const uint32_t FIRE_DELAY_MS = 50;
+
+//! Accumulates the execution lateness of the events of a run.
+struct LatenessStats
+{
+    std::atomic<uint32_t> executed{0};
+    std::atomic<uint64_t> total_us{0};
+    std::atomic<uint64_t> max_us{0};
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint32_t expected = 0;
+
+    void add(std::chrono::steady_clock::time_point due)
+    {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t lateness = now > due ?
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - due).count()) : 0;
+        total_us.fetch_add(lateness);
+
+        uint64_t max = max_us.load();
+        while(lateness > max && !max_us.compare_exchange_weak(max, lateness))
+        {
+        }
+
+        if(executed.fetch_add(1) + 1 == expected)
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            cond.notify_all();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait_for(lock, std::chrono::seconds(10), [this]() { return executed.load() >= expected; });
+    }
+};
+
+//! Event on the timer wheel, as the events of the proxies.
+class WheelEvent : public TimedEvent
+{
+public:
+
+    WheelEvent(asio::io_service& service, const std::thread& thread, double milliseconds, LatenessStats& stats)
+        : TimedEvent(service, thread, milliseconds)
+        , stats_(stats)
+    {
+    }
+
+    virtual ~WheelEvent()
+    {
+        destroy();
+    }
+
+    void start()
+    {
+        due_ = std::chrono::steady_clock::now() + std::chrono::microseconds(
+                static_cast<int64_t>(getIntervalMilliSec() * 1000));
+        restart_timer();
+    }
+
+    void event(EventCode code, const char*) override
+    {
+        if(code == EVENT_SUCCESS)
+        {
+            stats_.add(due_);
+        }
+    }
+
+private:
+
+    LatenessStats& stats_;
+    std::chrono::steady_clock::time_point due_;
+};
+
+//! Event with its own asio timer and mutex.
+class AsioTimerEvent
+{
+public:
+
+    AsioTimerEvent(asio::io_service& service, double milliseconds, LatenessStats& stats)
+        : timer_(service)
+        , interval_(static_cast<int64_t>(milliseconds * 1000))
+        , stats_(stats)
+    {
+    }
+
+    void start()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        due_ = std::chrono::steady_clock::now() + interval_;
+        timer_.expires_from_now(interval_);
+        timer_.async_wait([this](const asio::error_code& ec)
+                {
+                    if(!ec)
+                    {
+                        stats_.add(due_);
+                    }
+                });
+    }
+
+    void cancel()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        timer_.cancel();
+    }
+
+private:
+
+    asio::steady_timer timer_;
+    std::chrono::microseconds interval_;
+    std::mutex mutex_;
+    LatenessStats& stats_;
+    std::chrono::steady_clock::time_point due_;
+};
+
+//! IO service run by a single thread during a benchmark.
+struct ServiceRunner
+{
+    ServiceRunner()
+        : work(service)
+        , thread([this]() { service.run(); })
+    {
+    }
+
+    ~ServiceRunner()
+    {
+        service.stop();
+        thread.join();
+    }
+
+    asio::io_service service;
+    asio::io_service::work work;
+    std::thread thread;
+};
+
+template<typename Event>
+static void cancel_event(Event& event)
+{
+    event.cancel();
+}
+
+template<>
+void cancel_event<WheelEvent>(WheelEvent& event)
+{
+    event.cancel_timer();
+}
+
+//! Restarts and cancels all the events several times, as the proxies do on each heartbeat or acknack.
+template<typename Event>
+static double churn(std::vector<std::unique_ptr<Event>>& events)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t round = 0; round < CHURN_ROUNDS; ++round)
+    {
+        for(auto& event : events)
+        {
+            event->start();
+        }
+        for(auto& event : events)
+        {
+            cancel_event(*event);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return (2.0 * CHURN_ROUNDS * events.size()) / std::chrono::duration<double>(end - start).count();
+}
+
+//! Starts all the events and waits until all of them are executed.
+template<typename Event>
+static void fire(std::vector<std::unique_ptr<Event>>& events, LatenessStats& stats)
+{
+    stats.expected = static_cast<uint32_t>(events.size());
+    for(auto& event : events)
+    {
+        event->start();
+    }
+    stats.wait();
+}
+
+static void print_row(const char* name, double churn_rate, const LatenessStats& stats)
+{
+    uint32_t executed = stats.executed.load();
+    double mean_us = executed > 0 ? static_cast<double>(stats.total_us.load()) / executed : 0.0;
+
+    std::cout << std::setw(14) << name << std::setw(18) << std::fixed <<
+        std::setprecision(0) << churn_rate << std::setw(11) << executed << std::setw(16) <<
+        std::setprecision(1) << mean_us << std::setw(15) << stats.max_us.load() << std::endl;
+}
+
+static void run_asio_timers(uint32_t proxies)
+{
+    ServiceRunner runner;
+    LatenessStats churn_stats;
+    LatenessStats fire_stats;
+    double churn_rate = 0;
+
+    {
+        std::vector<std::unique_ptr<AsioTimerEvent>> events;
+        for(uint32_t i = 0; i < proxies; ++i)
+        {
+            events.emplace_back(new AsioTimerEvent(runner.service, CHURN_INTERVAL_MS, churn_stats));
+        }
+        churn_rate = churn(events);
+    }
+
+    std::vector<std::unique_ptr<AsioTimerEvent>> events;
+    for(uint32_t i = 0; i < proxies; ++i)
+    {
+        events.emplace_back(new AsioTimerEvent(runner.service, FIRE_DELAY_MS + (i % FIRE_WINDOW_MS), fire_stats));
+    }
+    fire(events, fire_stats);
+
+    print_row("asio timers", churn_rate, fire_stats);
+}
+
+static void run_timer_wheel(uint32_t proxies)
+{
+    ServiceRunner runner;
+    LatenessStats churn_stats;
+    LatenessStats fire_stats;
+    double churn_rate = 0;
+
+    {
+        std::vector<std::unique_ptr<WheelEvent>> events;
+        for(uint32_t i = 0; i < proxies; ++i)
+        {
+            events.emplace_back(new WheelEvent(runner.service, runner.thread, CHURN_INTERVAL_MS, churn_stats));
+        }
+        churn_rate = churn(events);
+    }
+
+    std::vector<std::unique_ptr<WheelEvent>> events;
+    for(uint32_t i = 0; i < proxies; ++i)
+    {
+        events.emplace_back(new WheelEvent(runner.service, runner.thread, FIRE_DELAY_MS + (i % FIRE_WINDOW_MS),
+                fire_stats));
+    }
+    fire(events, fire_stats);
+
+    print_row("timer wheel", churn_rate, fire_stats);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    uint32_t proxies = 10000;
+    if(argc > 1)
+    {
+        proxies = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    std::cout << "Events: " << proxies << " (firing spread over " << FIRE_WINDOW_MS << " ms)" << std::endl;
+    std::cout << std::setw(14) << "Timers" << std::setw(18) << "Restart+cancel/s" <<
+        std::setw(11) << "Executed" << std::setw(16) << "Mean late (us)" << std::setw(15) << "Max late (us)" <<
+        std::endl;
+
+    run_asio_timers(proxies);
+    run_timer_wheel(proxies);
+
+    return 0;
+}
@@ -28,6 +28,7 @@
 #include <fastrtps/types/DynamicData.h>
 #include <fastrtps/types/TypeObjectFactory.h>
 #include <fastrtps/log/Log.h>
+#include <fastcdr/Cdr.h>
 
 #include "idl/Test.h"
 #include "idl/TestPubSubTypes.h"
@@ -2214,6 +2215,82 @@ TEST_F(DynamicComplexTypesTests, Data_Comparison_with_Keys)
     DynamicDataFactory::get_instance()->delete_data(dynDataFromDynamic);
 }
 
+TEST_F(DynamicComplexTypesTests, Flat_Layout_Serialization)
+{
+    // Runs of primitive members, broken by a member that needs more alignment, a string and a boolean.
+    DynamicTypeBuilder_ptr struct_builder = m_factory->create_struct_builder();
+    struct_builder->add_member(0, "my_int16", m_factory->create_int16_type());
+    struct_builder->add_member(1, "my_int64", m_factory->create_int64_type());
+    struct_builder->add_member(2, "my_int32", m_factory->create_int32_type());
+    struct_builder->add_member(3, "my_char", m_factory->create_char8_type());
+    struct_builder->add_member(4, "my_uint16", m_factory->create_uint16_type());
+    struct_builder->add_member(5, "my_string", m_factory->create_string_type());
+    struct_builder->add_member(6, "my_octet", m_factory->create_byte_type());
+    struct_builder->add_member(7, "my_bool", m_factory->create_bool_type());
+    struct_builder->add_member(8, "my_float32", m_factory->create_float32_type());
+    struct_builder->add_member(9, "my_float64", m_factory->create_float64_type());
+    struct_builder->set_name("FlatStruct");
+    DynamicType_ptr struct_type = struct_builder->build();
+
+    DynamicData* data = DynamicDataFactory::get_instance()->create_data(struct_type);
+    ASSERT_TRUE(data->set_int16_value(-12000, 0) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_int64_value(-1200000000, 1) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_int32_value(-12000000, 2) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_char8_value('O', 3) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_uint16_value(12000, 4) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_string_value("G It's", 5) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_byte_value(100, 6) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_bool_value(true, 7) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_float32_value(5.5f, 8) == ResponseCode::RETCODE_OK);
+    ASSERT_TRUE(data->set_float64_value(8.888, 9) == ResponseCode::RETCODE_OK);
+
+    int16_t int16_value = 0;
+    ASSERT_TRUE(data->get_int16_value(int16_value, 0) == ResponseCode::RETCODE_OK);
+    ASSERT_EQ(int16_value, -12000);
+    std::string string_value;
+    ASSERT_TRUE(data->get_string_value(string_value, 5) == ResponseCode::RETCODE_OK);
+    ASSERT_EQ(string_value, "G It's");
+
+    DynamicPubSubType pubsubType(struct_type);
+    for (auto endianness : {eprosima::fastcdr::Cdr::LITTLE_ENDIANNESS, eprosima::fastcdr::Cdr::BIG_ENDIANNESS})
+    {
+        // The same stream that a generated type would write.
+        SerializedPayload_t expected(128);
+        eprosima::fastcdr::FastBuffer expected_fastbuffer((char*)expected.data, expected.max_size);
+        eprosima::fastcdr::Cdr expected_cdr(expected_fastbuffer, endianness, eprosima::fastcdr::Cdr::DDS_CDR);
+        expected_cdr.serialize_encapsulation();
+        expected_cdr << static_cast<int16_t>(-12000) << static_cast<int64_t>(-1200000000) <<
+            static_cast<int32_t>(-12000000) << 'O' << static_cast<uint16_t>(12000) << std::string("G It's") <<
+            static_cast<octet>(100) << true << 5.5f << 8.888;
+        expected.length = static_cast<uint32_t>(expected_cdr.getSerializedDataLength());
+
+        if (endianness == eprosima::fastcdr::Cdr::DEFAULT_ENDIAN)
+        {
+            uint32_t payloadSize = static_cast<uint32_t>(pubsubType.getSerializedSizeProvider(data)());
+            ASSERT_EQ(payloadSize, expected.length);
+            SerializedPayload_t payload(payloadSize);
+            ASSERT_TRUE(pubsubType.serialize(data, &payload));
+            ASSERT_EQ(payload.length, expected.length);
+            ASSERT_EQ(memcmp(payload.data, expected.data, expected.length), 0);
+        }
+
+        DynamicData* data2 = DynamicDataFactory::get_instance()->create_data(struct_type);
+        ASSERT_TRUE(pubsubType.deserialize(&expected, data2));
+        ASSERT_TRUE(data2->equals(data));
+
+        // Copies keep their own buffer.
+        DynamicData* copy = DynamicDataFactory::get_instance()->create_copy(data2);
+        ASSERT_TRUE(data2->set_int32_value(1, 2) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(copy->equals(data));
+        ASSERT_FALSE(data2->equals(data));
+
+        DynamicDataFactory::get_instance()->delete_data(copy);
+        DynamicDataFactory::get_instance()->delete_data(data2);
+    }
+
+    DynamicDataFactory::get_instance()->delete_data(data);
+}
+
 int main(int argc, char **argv)
 {
     Log::SetVerbosity(Log::Info);
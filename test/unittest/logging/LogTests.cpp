@@ -17,6 +17,7 @@
 #include <fastrtps/log/StdoutConsumer.h>
 #include "mock/MockConsumer.h"
 #include <gtest/gtest.h>
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <chrono>
@@ -143,6 +144,83 @@ TEST_F(LogTests, multiple_verbosity_levels)
     ASSERT_EQ(3u, consumedEntries.size());
 }
 
+TEST_F(LogTests, deferred_logging)
+{
+    std::string name = "deferred";
+    logWarningDeferred(Deferred, "Message ", 1, " of ", name, ' ', 2.5);
+    name = "changed";
+    logErrorDeferred(Deferred, std::string(300, 'x'));
+    logErrorDeferred(Deferred, "Arguments bigger than an entry ", std::string(100, 'y'), std::string(100, 'z'),
+            std::string(100, 'w'), std::string(100, 'v'), std::string(100, 'u'), std::string(100, 't'));
+    auto consumedEntries = HELPER_WaitForEntries(3);
+    ASSERT_EQ(3u, consumedEntries.size());
+    ASSERT_EQ("Message 1 of deferred 2.5", consumedEntries[0].message);
+    ASSERT_EQ(std::string(300, 'x'), consumedEntries[1].message);
+    ASSERT_EQ(631u, consumedEntries[2].message.size());
+    ASSERT_STREQ("Deferred", consumedEntries[0].context.category);
+}
+
+static int FormattedMessages = 0;
+
+static std::string HELPER_CountFormat(const char* message)
+{
+    ++FormattedMessages;
+    return message;
+}
+
+TEST_F(LogTests, filtered_messages_are_not_formatted)
+{
+    FormattedMessages = 0;
+    Log::SetCategoryFilter(std::regex("(Good)"));
+    logError(BadFormatCategory, HELPER_CountFormat("If you're seeing this, something went wrong"));
+    logWarning(GoodFormatCategory, HELPER_CountFormat("This should be logged"));
+
+    Log::SetVerbosity(Log::Error);
+    logWarning(GoodFormatCategory, HELPER_CountFormat("If you're seeing this, something went wrong"));
+
+    auto consumedEntries = HELPER_WaitForEntries(2);
+    ASSERT_EQ(1u, consumedEntries.size());
+    ASSERT_EQ(1, FormattedMessages);
+
+    Log::SetCategoryFilter(std::regex("(Bad)"));
+    logError(BadFormatCategory, HELPER_CountFormat("This should be logged after changing the filter"));
+    consumedEntries = HELPER_WaitForEntries(2);
+    ASSERT_EQ(2u, consumedEntries.size());
+    ASSERT_EQ(2, FormattedMessages);
+}
+
+//! Consumer that counts the entries on a counter that outlives it, taking some time on each of them.
+class SlowCountingConsumer : public LogConsumer
+{
+    public:
+    SlowCountingConsumer(std::atomic<uint32_t>& counter) : mCounter(counter) {}
+
+    virtual void Consume(const Log::Entry&)
+    {
+        this_thread::sleep_for(chrono::milliseconds(5));
+        ++mCounter;
+    }
+
+    private:
+    std::atomic<uint32_t>& mCounter;
+};
+
+TEST_F(LogTests, clear_consumers_waits_for_consumption)
+{
+    std::atomic<uint32_t> counter(0);
+    Log::RegisterConsumer(std::unique_ptr<LogConsumer>(new SlowCountingConsumer(counter)));
+
+    const uint32_t entries = 10;
+    for (uint32_t i = 0; i < entries; ++i)
+    {
+        logError(ClearConsumers, "Entry " << i);
+    }
+
+    // All the queued entries, including the last one, should reach the consumers before they are removed.
+    Log::ClearConsumers();
+    ASSERT_EQ(entries, counter.load());
+}
+
 std::vector<Log::Entry> LogTests::HELPER_WaitForEntries(uint32_t amount)
 {
     size_t entries = 0;
@@ -0,0 +1,102 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/common/SerializedPayload.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+/*!
+ * @fn TEST(SerializedPayload, CopySharedBuffer)
+ * @brief This test checks that copying a payload held in a shared buffer shares the buffer instead of copying it.
+ */
+TEST(SerializedPayload, CopySharedBuffer)
+{
+    octet raw[4] = { 1, 2, 3, 4 };
+    SerializedPayload_t source;
+    SharedPayloadBuffer* buffer = SharedPayloadBuffer::create(raw, sizeof(raw));
+    source.share(buffer);
+    buffer->release();
+
+    SerializedPayload_t first(16);
+    SerializedPayload_t second(16);
+    octet* first_owned_data = first.data;
+
+    ASSERT_TRUE(first.copy(&source));
+    ASSERT_TRUE(second.copy(&source));
+    ASSERT_TRUE(first.is_shared());
+    ASSERT_TRUE(second.is_shared());
+    ASSERT_EQ(first.data, source.data);
+    ASSERT_EQ(second.data, source.data);
+    ASSERT_EQ(first.length, 4u);
+    ASSERT_EQ(0, memcmp(first.data, raw, sizeof(raw)));
+
+    // The buffer is kept alive while any payload is sharing it.
+    source.stop_sharing();
+    first.stop_sharing();
+    ASSERT_FALSE(first.is_shared());
+    ASSERT_EQ(first.data, first_owned_data);
+    ASSERT_EQ(first.max_size, 16u);
+    ASSERT_EQ(0, memcmp(second.data, raw, sizeof(raw)));
+}
+
+/*!
+ * @fn TEST(SerializedPayload, CopySharedBufferWithLimit)
+ * @brief This test checks that the size limit is still applied when sharing a buffer.
+ */
+TEST(SerializedPayload, CopySharedBufferWithLimit)
+{
+    octet raw[32] = { 0 };
+    SerializedPayload_t source;
+    SharedPayloadBuffer* buffer = SharedPayloadBuffer::create(raw, sizeof(raw));
+    source.share(buffer);
+    buffer->release();
+
+    SerializedPayload_t limited(16);
+    ASSERT_FALSE(limited.copy(&source, true));
+    ASSERT_FALSE(limited.is_shared());
+    ASSERT_TRUE(limited.copy(&source, false));
+    ASSERT_TRUE(limited.is_shared());
+}
+
+/*!
+ * @fn TEST(SerializedPayload, CopyIntoSharingPayload)
+ * @brief This test checks that copying into a payload that is sharing a buffer does not modify the shared data.
+ */
+TEST(SerializedPayload, CopyIntoSharingPayload)
+{
+    octet raw[4] = { 1, 2, 3, 4 };
+    SerializedPayload_t source;
+    SharedPayloadBuffer* buffer = SharedPayloadBuffer::create(raw, sizeof(raw));
+    source.share(buffer);
+    buffer->release();
+
+    SerializedPayload_t destination(16);
+    ASSERT_TRUE(destination.copy(&source));
+
+    SerializedPayload_t other(4);
+    memset(other.data, 9, 4);
+    other.length = 4;
+    ASSERT_TRUE(destination.copy(&other));
+    ASSERT_FALSE(destination.is_shared());
+    ASSERT_EQ(0, memcmp(source.data, raw, sizeof(raw)));
+    ASSERT_EQ(0, memcmp(destination.data, other.data, 4));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
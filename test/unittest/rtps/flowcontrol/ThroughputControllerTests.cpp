@@ -14,11 +14,15 @@
 
 #include <rtps/flowcontrol/ThroughputController.h>
 #include <fastrtps/rtps/writer/ReaderLocator.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/rtps/resources/AsyncWriterThread.h>
 
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
 using namespace std;
 using namespace eprosima::fastrtps::rtps;
+using ::testing::Return;
 
 static const unsigned int testPayloadSize = 1000;
 static const unsigned int controllerSize = 5500;
@@ -141,6 +145,114 @@ TEST_F(ThroughputControllerTests, throughput_controller_resets_completely_after_
    std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
 }
 
+TEST_F(ThroughputControllerTests, throughput_controller_lets_a_burst_through_and_refills_one_period_at_a_time)
+{
+   // Given
+   ThroughputControllerDescriptor burstDescriptor = testDescriptor;
+   burstDescriptor.burstBytes = numberOfTestChanges * testPayloadSize;
+   ThroughputController burstController(burstDescriptor, (const RTPSWriter*)nullptr);
+
+   // When
+   burstController(testChangesForUse);
+
+   // Then
+   ASSERT_EQ(numberOfTestChanges, testChangesForUse.size());
+
+   // The bucket is refilled with only 'bytesPerPeriod' bytes after a period
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+   burstController(otherChangesForUse);
+   EXPECT_EQ(controllerSize/testPayloadSize, otherChangesForUse.size());
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+}
+
+class PriorityWriter : public RTPSWriter
+{
+   public:
+
+   PriorityWriter(uint32_t priority)
+   {
+      EXPECT_CALL(*this, getFlowControllerPriority()).WillRepeatedly(Return(priority));
+   }
+
+   bool matched_reader_add(RemoteReaderAttributes&) override { return true; }
+
+   bool matched_reader_remove(RemoteReaderAttributes&) override { return true; }
+};
+
+class ThroughputControllerPriorityTests: public ThroughputControllerTests
+{
+   public:
+
+   ThroughputControllerPriorityTests():
+      highPriorityWriter(10),
+      lowPriorityWriter(1),
+      // The participant is only an identifier for the mocked AsyncWriterThread.
+      participant(reinterpret_cast<const RTPSParticipantImpl*>(&participantToken))
+   {
+      AsyncWriterThread::take_woken_writers();
+   }
+
+   PriorityWriter highPriorityWriter;
+   PriorityWriter lowPriorityWriter;
+   int participantToken = 0;
+   const RTPSParticipantImpl* participant;
+};
+
+TEST_F(ThroughputControllerPriorityTests, throughput_controller_wakes_lower_priority_writers_when_the_reserving_one_goes_idle)
+{
+   // Given
+   ThroughputController participantController(testDescriptor, participant);
+   participantController(testChangesForUse, &highPriorityWriter);
+   ASSERT_EQ(controllerSize/testPayloadSize, testChangesForUse.size());
+
+   // The refill fills the bucket and reserves it for the high priority writer, which is woken up and goes idle.
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+   std::vector<const RTPSWriter*> woken = AsyncWriterThread::take_woken_writers();
+   ASSERT_EQ(1u, woken.size());
+   EXPECT_EQ(&highPriorityWriter, woken.front());
+
+   // When
+   participantController(otherChangesForUse, &lowPriorityWriter);
+
+   // Then
+   EXPECT_EQ(controllerSize/testPayloadSize, otherChangesForUse.size());
+
+   // The low priority writer is woken up for the rest of its changes.
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+   woken = AsyncWriterThread::take_woken_writers();
+   ASSERT_EQ(1u, woken.size());
+   EXPECT_EQ(&lowPriorityWriter, woken.front());
+}
+
+TEST_F(ThroughputControllerPriorityTests, throughput_controller_drops_the_reservation_when_the_writer_has_nothing_to_send)
+{
+   // Given a bucket that is not full after a refill
+   ThroughputControllerDescriptor burstDescriptor = testDescriptor;
+   burstDescriptor.burstBytes = (numberOfTestChanges + 2) * testPayloadSize;
+   ThroughputController participantController(burstDescriptor, participant);
+   participantController(testChangesForUse, &highPriorityWriter);
+   ASSERT_EQ(numberOfTestChanges, testChangesForUse.size());
+   participantController(otherChangesForUse, &highPriorityWriter);
+   ASSERT_EQ(2u, otherChangesForUse.size());
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+   ASSERT_EQ(1u, AsyncWriterThread::take_woken_writers().size());
+
+   // When the high priority writer is woken up with nothing to send
+   RTPSWriterCollector<ReaderLocator*> nothingToSend;
+   participantController(nothingToSend, &highPriorityWriter);
+
+   // Then the low priority writer takes the tokens
+   testChangesForUse.clear();
+   for(auto& change : testChanges)
+   {
+      testChangesForUse.add_change(change.get(), &mock, FragmentNumberSet_t());
+   }
+   participantController(testChangesForUse, &lowPriorityWriter);
+   EXPECT_EQ(controllerSize/testPayloadSize, testChangesForUse.size());
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
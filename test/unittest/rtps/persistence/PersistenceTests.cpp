@@ -164,6 +164,85 @@ TEST_F(PersistenceTest, Reader)
     ASSERT_EQ(seq_map_loaded, seq_map);
 }
 
+/*!
+* @fn TEST_F(PersistenceTest, Batched)
+* @brief This test checks operations are committed in batched mode, both on flush and when the service is destroyed.
+*/
+TEST_F(PersistenceTest, Batched)
+{
+    const std::string writer_guid("TEST_WRITER");
+    const std::string reader_guid("TEST_READER");
+
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    policy.properties().emplace_back("dds.persistence.sqlite3.batch_size", "16");
+    policy.properties().emplace_back("dds.persistence.sqlite3.batch_period_ms", "10000");
+    policy.properties().emplace_back("dds.persistence.sqlite3.journal_mode", "WAL");
+    policy.properties().emplace_back("dds.persistence.sqlite3.synchronous", "NORMAL");
+
+    // Get service from factory
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    CacheChangePool pool(10, 128, 0, MemoryManagementPolicy_t::PREALLOCATED_MEMORY_MODE);
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    std::map<GUID_t, SequenceNumber_t> seq_map_loaded;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    // Add three changes, remove one of them and update the reader before the batch is full
+    for (uint32_t i = 1; i <= 3; ++i)
+    {
+        change.sequenceNumber.low = i;
+        ASSERT_TRUE(service->add_writer_change_to_storage(writer_guid, change));
+    }
+    change.sequenceNumber.low = 2;
+    ASSERT_TRUE(service->remove_writer_change_from_storage(writer_guid, change));
+    ASSERT_TRUE(service->update_writer_seq_on_storage(reader_guid, guid, SequenceNumber_t(0, 3)));
+
+    // Flushing should commit them
+    ASSERT_TRUE(service->flush());
+    ASSERT_TRUE(service->load_writer_from_storage(writer_guid, guid, changes, &pool));
+    ASSERT_EQ(changes.size(), 2u);
+    ASSERT_TRUE(service->load_reader_from_storage(reader_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded[guid], SequenceNumber_t(0, 3));
+    for (CacheChange_t* loaded : changes)
+    {
+        pool.release_Cache(loaded);
+    }
+
+    // A duplicated change should be reported on flush
+    change.sequenceNumber.low = 1;
+    ASSERT_TRUE(service->add_writer_change_to_storage(writer_guid, change));
+    ASSERT_FALSE(service->flush());
+    ASSERT_TRUE(service->flush());
+
+    // A failed commit should still be reported by flush after a load
+    ASSERT_TRUE(service->add_writer_change_to_storage(writer_guid, change));
+    ASSERT_TRUE(service->load_reader_from_storage(reader_guid, seq_map_loaded));
+    ASSERT_FALSE(service->flush());
+    ASSERT_TRUE(service->flush());
+
+    // Operations queued when the service is destroyed should be committed
+    change.sequenceNumber.low = 4;
+    ASSERT_TRUE(service->add_writer_change_to_storage(writer_guid, change));
+    delete service;
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    changes.clear();
+    ASSERT_TRUE(service->load_writer_from_storage(writer_guid, guid, changes, &pool));
+    ASSERT_EQ(changes.size(), 3u);
+    for (CacheChange_t* loaded : changes)
+    {
+        pool.release_Cache(loaded);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
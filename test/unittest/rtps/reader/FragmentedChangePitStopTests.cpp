@@ -0,0 +1,212 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <rtps/reader/FragmentedChangePitStop.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+using ::testing::_;
+using ::testing::Invoke;
+
+static const uint16_t FRAGMENT_SIZE = 100;
+
+class ReaderMock : public RTPSReader
+{
+    public:
+
+        bool matched_writer_add(RemoteWriterAttributes&) override { return true; }
+
+        bool matched_writer_remove(RemoteWriterAttributes&) override { return true; }
+};
+
+class FragmentedChangePitStopTests : public ::testing::Test
+{
+    public:
+
+        FragmentedChangePitStopTests()
+            : pit_stop_(&reader_)
+        {
+            writer_guid_.guidPrefix.value[0] = 1;
+            writer_guid_.entityId = 2;
+
+            ON_CALL(reader_, reserveCache(_, _)).WillByDefault(Invoke([this](CacheChange_t** change, uint32_t size)
+            {
+                changes_.emplace_back(new CacheChange_t(size));
+                *change = changes_.back().get();
+                return true;
+            }));
+        }
+
+        //! Sends the fragments [first, first + count) of a sample of the given size, as a DATA_FRAG would do.
+        CacheChange_t* send_fragments(
+                const SequenceNumber_t& sequence_number,
+                uint32_t sample_size,
+                uint32_t first,
+                uint32_t count)
+        {
+            uint32_t offset = (first - 1) * FRAGMENT_SIZE;
+            std::vector<octet> sample = sample_of(sample_size);
+            std::vector<octet> data(sample.begin() + offset,
+                    sample.begin() + std::min(sample_size, offset + count * FRAGMENT_SIZE));
+
+            CacheChange_t incoming;
+            incoming.writerGUID = writer_guid_;
+            incoming.sequenceNumber = sequence_number;
+            incoming.serializedPayload.data = data.data();
+            incoming.serializedPayload.length = static_cast<uint32_t>(data.size());
+            incoming.setFragmentSize(FRAGMENT_SIZE, count);
+
+            CacheChange_t* completed = pit_stop_.process(&incoming, sample_size, first);
+            incoming.serializedPayload.data = nullptr;
+            return completed;
+        }
+
+        static std::vector<octet> sample_of(uint32_t sample_size)
+        {
+            std::vector<octet> sample(sample_size);
+            for (uint32_t i = 0; i < sample_size; ++i)
+            {
+                sample[i] = static_cast<octet>(i * 7);
+            }
+            return sample;
+        }
+
+        static bool has_sample(const CacheChange_t* change, uint32_t sample_size)
+        {
+            std::vector<octet> sample = sample_of(sample_size);
+            return change->serializedPayload.length == sample_size &&
+                std::equal(sample.begin(), sample.end(), change->serializedPayload.data);
+        }
+
+        ::testing::NiceMock<ReaderMock> reader_;
+        FragmentedChangePitStop pit_stop_;
+        GUID_t writer_guid_;
+        std::vector<std::unique_ptr<CacheChange_t>> changes_;
+};
+
+TEST_F(FragmentedChangePitStopTests, fragments_in_order_complete_the_sample)
+{
+    const uint32_t sample_size = 1050;
+
+    EXPECT_CALL(reader_, reserveCache(_, sample_size)).Times(1);
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 1, 4), nullptr);
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 5, 4), nullptr);
+
+    CacheChange_t* change = pit_stop_.find(SequenceNumber_t(0, 1), writer_guid_);
+    ASSERT_NE(change, nullptr);
+    EXPECT_EQ(change->getFragmentCount(), 11u);
+    EXPECT_EQ(change->first_missing_fragment(), 8u);
+
+    CacheChange_t* completed = send_fragments(SequenceNumber_t(0, 1), sample_size, 9, 3);
+    ASSERT_EQ(completed, change);
+    EXPECT_TRUE(has_sample(completed, sample_size));
+    EXPECT_EQ(pit_stop_.find(SequenceNumber_t(0, 1), writer_guid_), nullptr);
+}
+
+TEST_F(FragmentedChangePitStopTests, fragments_out_of_order_and_repeated_complete_the_sample)
+{
+    const uint32_t sample_size = 1000;
+
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 7, 4), nullptr);
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 3, 2), nullptr);
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 3, 3), nullptr);
+
+    CacheChange_t* change = pit_stop_.find(SequenceNumber_t(0, 1), writer_guid_);
+    ASSERT_NE(change, nullptr);
+    EXPECT_EQ(change->first_missing_fragment(), 0u);
+    EXPECT_FALSE(change->is_fragment_received(5));
+    EXPECT_TRUE(change->is_fragment_received(6));
+
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 1, 2), nullptr);
+    EXPECT_EQ(change->first_missing_fragment(), 5u);
+
+    CacheChange_t* completed = send_fragments(SequenceNumber_t(0, 1), sample_size, 6, 1);
+    ASSERT_EQ(completed, change);
+    EXPECT_TRUE(has_sample(completed, sample_size));
+}
+
+TEST_F(FragmentedChangePitStopTests, samples_of_different_writers_are_kept_apart)
+{
+    const uint32_t sample_size = 300;
+    GUID_t other_writer = writer_guid_;
+    other_writer.entityId = 3;
+
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 1, 1), nullptr);
+    writer_guid_ = other_writer;
+    EXPECT_EQ(send_fragments(SequenceNumber_t(0, 1), sample_size, 1, 2), nullptr);
+
+    CacheChange_t* first = pit_stop_.find(SequenceNumber_t(0, 1), changes_.front()->writerGUID);
+    CacheChange_t* second = pit_stop_.find(SequenceNumber_t(0, 1), other_writer);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first->first_missing_fragment(), 1u);
+    EXPECT_EQ(second->first_missing_fragment(), 2u);
+}
+
+TEST_F(FragmentedChangePitStopTests, try_to_remove_until_releases_older_samples_of_the_writer)
+{
+    const uint32_t sample_size = 300;
+
+    for (uint32_t sequence = 1; sequence <= 4; ++sequence)
+    {
+        EXPECT_EQ(send_fragments(SequenceNumber_t(0, sequence), sample_size, 1, 1), nullptr);
+    }
+
+    EXPECT_CALL(reader_, releaseCache(_)).Times(2);
+    EXPECT_TRUE(pit_stop_.try_to_remove_until(SequenceNumber_t(0, 3), writer_guid_));
+    EXPECT_FALSE(pit_stop_.try_to_remove_until(SequenceNumber_t(0, 3), writer_guid_));
+    EXPECT_EQ(pit_stop_.find(SequenceNumber_t(0, 2), writer_guid_), nullptr);
+    EXPECT_NE(pit_stop_.find(SequenceNumber_t(0, 3), writer_guid_), nullptr);
+
+    EXPECT_CALL(reader_, releaseCache(_)).Times(1);
+    EXPECT_TRUE(pit_stop_.try_to_remove(SequenceNumber_t(0, 4), writer_guid_));
+    EXPECT_FALSE(pit_stop_.try_to_remove(SequenceNumber_t(0, 4), writer_guid_));
+
+    // The remaining sample is still completed.
+    ASSERT_NE(send_fragments(SequenceNumber_t(0, 3), sample_size, 2, 2), nullptr);
+}
+
+TEST_F(FragmentedChangePitStopTests, truncated_submessages_are_ignored)
+{
+    const uint32_t sample_size = 300;
+
+    CacheChange_t incoming;
+    std::vector<octet> data(150);
+    incoming.writerGUID = writer_guid_;
+    incoming.sequenceNumber = SequenceNumber_t(0, 1);
+    incoming.serializedPayload.data = data.data();
+    incoming.serializedPayload.length = static_cast<uint32_t>(data.size());
+    incoming.setFragmentSize(FRAGMENT_SIZE, 2);
+
+    EXPECT_EQ(pit_stop_.process(&incoming, sample_size, 1), nullptr);
+    incoming.serializedPayload.data = nullptr;
+
+    CacheChange_t* change = pit_stop_.find(SequenceNumber_t(0, 1), writer_guid_);
+    ASSERT_NE(change, nullptr);
+    EXPECT_EQ(change->first_missing_fragment(), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
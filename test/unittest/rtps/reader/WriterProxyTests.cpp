@@ -19,7 +19,8 @@
     FRIEND_TEST(WriterProxyTests, MissingChangesUpdate); \
     FRIEND_TEST(WriterProxyTests, LostChangesUpdate); \
     FRIEND_TEST(WriterProxyTests, ReceivedChangeSet); \
-    FRIEND_TEST(WriterProxyTests, IrrelevantChangeSet);
+    FRIEND_TEST(WriterProxyTests, IrrelevantChangeSet); \
+    FRIEND_TEST(WriterProxyTests, ReceivedChangesWindow);
 
 #include <fastrtps/rtps/reader/WriterProxy.h>
 #include <fastrtps/rtps/reader/StatefulReader.h>
@@ -41,24 +42,23 @@ namespace eprosima
                 // Update MISSING changes util sequence number 3.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 3u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::MISSING);
 
                 // Add two UNKNOWN with sequence numberes 4 and 5.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,5)));
+                wproxy.changes_from_writer_max_ = SequenceNumber_t(0, 5);
 
                 // Update MISSING changes util sequence number 5.
                 wproxy.missing_changes_update(SequenceNumber_t(0,5));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 5u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::MISSING);
 
                 // Set all as received.
                 wproxy.received_change_set(SequenceNumber_t(0, 1));
@@ -67,39 +67,36 @@ namespace eprosima
                 wproxy.received_change_set(SequenceNumber_t(0, 4));
                 wproxy.received_change_set(SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
 
                 // Try to update MISSING changes util sequence number 4.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
 
                 // Add three UNKNOWN changes with sequence number 6, 7 and 9.
                 // Add one RECEIVED change with sequence number 8.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 6)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 7)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 8)));
                 wproxy.received_change_set(SequenceNumber_t(0, 8));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 9)));
+                wproxy.changes_from_writer_max_ = SequenceNumber_t(0, 9);
 
                 // Update MISSING changes util sequence number 8.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 8));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 4u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 9))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 4u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 9)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update MISSING changes util sequence number 10.
                 wproxy.missing_changes_update(SequenceNumber_t(0, 10));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 5));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 9))->getStatus(), ChangeFromWriterStatus_t::MISSING);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 10))->getStatus(), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 5u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 9)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 10)), ChangeFromWriterStatus_t::MISSING);
             }
 
             TEST(WriterProxyTests, LostChangesUpdate)
@@ -111,43 +108,38 @@ namespace eprosima
                 // Update LOST changes util sequence number 3.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 2));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
 
                 // Add two UNKNOWN with sequence numberes 3 and 4.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,3)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
+                wproxy.changes_from_writer_max_ = SequenceNumber_t(0, 4);
 
                 // Update LOST changes util sequence number 5.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
 
                 // Try to update LOST changes util sequence number 4.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
 
-                // Add two UNKNOWN changes with sequence number 5 and 8.
-                // Add one MISSING change with sequence number 6.
+                // Add one UNKNOWN change with sequence number 8.
+                // Add two MISSING changes with sequence numbers 5 and 6.
                 // Add one RECEIVED change with sequence number 7.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 5)));
-                ChangeFromWriter_t missing_aux_change_from_w(SequenceNumber_t(0, 6));
-                missing_aux_change_from_w.setStatus(ChangeFromWriterStatus_t::MISSING);
-                wproxy.m_changesFromW.insert(missing_aux_change_from_w);
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 7)));
+                wproxy.missing_changes_max_ = SequenceNumber_t(0, 6);
                 wproxy.received_change_set(SequenceNumber_t(0, 7));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0, 8)));
+                wproxy.changes_from_writer_max_ = SequenceNumber_t(0, 8);
 
                 // Update LOST changes util sequence number 8.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 8));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 7));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 1u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 1u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Update LOST changes util sequence number 10.
                 wproxy.lost_changes_update(SequenceNumber_t(0, 10));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 9));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
             }
 
             TEST(WriterProxyTests, ReceivedChangeSet)
@@ -159,77 +151,76 @@ namespace eprosima
                 // Set received change with sequence number 3.
                 wproxy.received_change_set(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 3u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add two UNKNOWN with sequence numberes 4 and 5.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,5)));
+                wproxy.changes_from_writer_max_ = SequenceNumber_t(0, 5);
 
                 // Set received change with sequence number 2
                 wproxy.received_change_set(SequenceNumber_t(0, 2));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 5u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Set received change with sequence number 1
                 wproxy.received_change_set(SequenceNumber_t(0, 1));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 2u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Try to update LOST changes util sequence number 3.
                 wproxy.received_change_set(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 2u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Add received change with sequence number 6
                 wproxy.received_change_set(SequenceNumber_t(0, 6));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 3u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 8
                 wproxy.received_change_set(SequenceNumber_t(0, 8));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 5u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 4
                 wproxy.received_change_set(SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 4u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 4u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 5
                 wproxy.received_change_set(SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 6));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 2u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add received change with sequence number 7
                 wproxy.received_change_set(SequenceNumber_t(0, 7));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 8));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
             }
 
             TEST(WriterProxyTests, IrrelevantChangeSet)
@@ -241,86 +232,132 @@ namespace eprosima
                 // Set irrelevant change with sequence number 3.
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->isRelevant(), false);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 3u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add two UNKNOWN with sequence numberes 4 and 5.
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,4)));
-                wproxy.m_changesFromW.insert(ChangeFromWriter_t(SequenceNumber_t(0,5)));
+                wproxy.changes_from_writer_max_ = SequenceNumber_t(0, 5);
 
                 // Set irrelevant change with sequence number 2
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 2));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 1))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 2))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 3))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 5u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 1)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 2)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 3)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Set irrelevant change with sequence number 1
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 1));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 2u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Try to update LOST changes util sequence number 3.
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 3));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 2u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
 
                 // Add irrelevant change with sequence number 6
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 6));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 3u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->isRelevant(), false);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 3u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add irrelevant change with sequence number 8
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 8));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 3));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 5u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 4))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->isRelevant(), false);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 5u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 4)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add irrelevant change with sequence number 4
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 4));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 4));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 4u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 5))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 6))->isRelevant(), false);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->isRelevant(), false);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 4u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 5)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 6)), ChangeFromWriterStatus_t::RECEIVED);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add irrelevant change with sequence number 5
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 5));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 6));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 2u);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 7))->getStatus(), ChangeFromWriterStatus_t::UNKNOWN);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->getStatus(), ChangeFromWriterStatus_t::RECEIVED);
-                ASSERT_EQ(wproxy.m_changesFromW.find(SequenceNumber_t(0, 8))->isRelevant(), false);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 2u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 7)), ChangeFromWriterStatus_t::UNKNOWN);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 8)), ChangeFromWriterStatus_t::RECEIVED);
 
                 // Add irrelevant change with sequence number 7
                 wproxy.irrelevant_change_set(SequenceNumber_t(0, 7));
                 ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 8));
-                ASSERT_EQ(wproxy.m_changesFromW.size(), 0u);
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
+            }
+
+            TEST(WriterProxyTests, ReceivedChangesWindow)
+            {
+                RemoteWriterAttributes wattr;
+                StatefulReader readerMock;
+                WriterProxy wproxy(wattr, &readerMock);
+
+                // Receive changes in different words of the window, growing it.
+                ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, 2)));
+                ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, 40)));
+                ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, 300)));
+                ASSERT_FALSE(wproxy.received_change_set(SequenceNumber_t(0, 40)));
+                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 0));
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 300u);
+                ASSERT_TRUE(wproxy.change_was_received(SequenceNumber_t(0, 300)));
+                ASSERT_FALSE(wproxy.change_was_received(SequenceNumber_t(0, 299)));
+                ASSERT_FALSE(wproxy.areThereMissing());
+
+                // Update MISSING changes util sequence number 300.
+                wproxy.missing_changes_update(SequenceNumber_t(0, 300));
+                ASSERT_TRUE(wproxy.areThereMissing());
+                std::vector<SequenceNumber_t> missing;
+                wproxy.for_each_missing_change([&](const SequenceNumber_t& seq_num)
+                {
+                    missing.push_back(seq_num);
+                });
+                ASSERT_EQ(missing.size(), 297u);
+                ASSERT_EQ(missing.front(), SequenceNumber_t(0, 1));
+                ASSERT_EQ(missing[1], SequenceNumber_t(0, 3));
+                ASSERT_EQ(missing[37], SequenceNumber_t(0, 39));
+                ASSERT_EQ(missing[38], SequenceNumber_t(0, 41));
+                ASSERT_EQ(missing.back(), SequenceNumber_t(0, 299));
+                ASSERT_EQ(wproxy.unknown_missing_changes_up_to(SequenceNumber_t(0, 41)), 38u);
+
+                // Received change 1 moves the low mark over change 2.
+                ASSERT_TRUE(wproxy.received_change_set(SequenceNumber_t(0, 1)));
+                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 2));
+
+                // Changes before 40 are lost, and 40 was received.
+                wproxy.lost_changes_update(SequenceNumber_t(0, 40));
+                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 40));
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 260u);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 41)), ChangeFromWriterStatus_t::MISSING);
+                ASSERT_EQ(wproxy.change_status_nts(SequenceNumber_t(0, 300)), ChangeFromWriterStatus_t::RECEIVED);
+
+                // Receive the rest of the changes.
+                for(SequenceNumber_t seq(0, 41); seq < SequenceNumber_t(0, 300); ++seq)
+                {
+                    ASSERT_TRUE(wproxy.received_change_set(seq));
+                }
+                ASSERT_EQ(wproxy.changesFromWLowMark_, SequenceNumber_t(0, 300));
+                ASSERT_EQ(wproxy.numberOfChangeFromWriter(), 0u);
+                ASSERT_FALSE(wproxy.areThereMissing());
+                ASSERT_TRUE(wproxy.change_was_received(SequenceNumber_t(0, 299)));
+                ASSERT_FALSE(wproxy.change_was_received(SequenceNumber_t(0, 301)));
             }
 
         } // namespace rtps
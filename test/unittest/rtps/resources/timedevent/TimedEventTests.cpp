@@ -16,6 +16,8 @@
 #include "mock/MockParentEvent.h"
 #include <thread>
 #include <random>
+#include <memory>
+#include <vector>
 #include <gtest/gtest.h>
 
 class TimedEventEnvironment : public ::testing::Environment
@@ -459,6 +461,60 @@ TEST(TimedEvent, ParentEventNonAutoDestruc_InternallyDeleteEventNonAutoDestruct)
     ASSERT_EQ(MockEvent::destructed_, 1);
 }
 
+/*!
+ * @fn TEST(TimedEvent, EventNonAutoDestruc_ManyEventsDifferentIntervals)
+ * This test checks several events sharing the timer wheel of the service expire once and not before their intervals.
+ * This test launches events with intervals that are spread over several levels of the wheel, and cancels some of them.
+ */
+TEST(TimedEvent, EventNonAutoDestruc_ManyEventsDifferentIntervals)
+{
+    const unsigned int num_events = 200;
+    std::vector<std::unique_ptr<MockEvent>> events;
+
+    // Only events with long intervals are cancelled, so they cannot expire before.
+    auto is_cancelled = [num_events](unsigned int i) { return i >= num_events / 2 && i % 4 == 0; };
+
+    for(unsigned int i = 0; i < num_events; ++i)
+    {
+        // Intervals from 1ms to 597ms.
+        events.emplace_back(new MockEvent(env->service_, *env->thread_, 1 + (i * 3), false));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(auto& event : events)
+    {
+        event->restart_timer();
+    }
+
+    for(unsigned int i = 0; i < num_events; ++i)
+    {
+        if(is_cancelled(i))
+            events[i]->cancel_timer();
+    }
+
+    for(unsigned int i = 0; i < num_events; ++i)
+    {
+        ASSERT_TRUE(events[i]->wait(2000));
+
+        if(!is_cancelled(i))
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start);
+            ASSERT_GE(elapsed.count(), static_cast<int64_t>(1 + (i * 3)));
+        }
+    }
+
+    for(unsigned int i = 0; i < num_events; ++i)
+    {
+        int successed = events[i]->successed_.load(std::memory_order_relaxed);
+        int cancelled = events[i]->cancelled_.load(std::memory_order_relaxed);
+
+        ASSERT_EQ(successed, is_cancelled(i) ? 0 : 1);
+        ASSERT_EQ(cancelled, is_cancelled(i) ? 1 : 0);
+    }
+}
+
 /*!
  * @brief Auxyliary function to be run in multithread tests.
  * It restarts an event in a loop.
@@ -24,6 +24,7 @@
 #include <openssl/rand.h>
 #include <cstdlib>
 #include <cstring>
+#include <set>
 
 class CryptographyPluginTest : public ::testing::Test
 {
@@ -914,6 +915,138 @@ TEST_F(CryptographyPluginTest, transform_SerializedPayload)
 
 }
 
+TEST_F(CryptographyPluginTest, transform_SessionKeyRotation)
+{
+    // Participant A owns Reader
+    // Participant B owns Writer
+    eprosima::fastrtps::rtps::security::PKIIdentityHandle* i_handle = new eprosima::fastrtps::rtps::security::PKIIdentityHandle();
+    eprosima::fastrtps::rtps::security::AccessPermissionsHandle* perm_handle = new eprosima::fastrtps::rtps::security::AccessPermissionsHandle();
+    eprosima::fastrtps::rtps::PropertySeq prop_handle;
+    eprosima::fastrtps::rtps::security::ParticipantSecurityAttributes part_sec_attr;
+    eprosima::fastrtps::rtps::security::EndpointSecurityAttributes sec_attrs;
+    eprosima::fastrtps::rtps::security::SharedSecretHandle* shared_secret = new eprosima::fastrtps::rtps::security::SharedSecretHandle();
+
+    eprosima::fastrtps::rtps::security::SecurityException exception;
+
+    sec_attrs.is_payload_protected = true;
+    sec_attrs.plugin_endpoint_attributes = PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED;
+
+    // Small sessions, so the session key changes several times
+    eprosima::fastrtps::rtps::Property prop;
+    prop.name("dds.sec.crypto.maxblockspersession");
+    prop.value("16");
+    prop_handle.push_back(prop);
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *participant_A = CryptoPlugin->keyfactory()->register_local_participant(*i_handle, *perm_handle, prop_handle, part_sec_attr, exception);
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *participant_B = CryptoPlugin->keyfactory()->register_local_participant(*i_handle, *perm_handle, prop_handle, part_sec_attr, exception);
+
+    eprosima::fastrtps::rtps::security::DatareaderCryptoHandle *reader = CryptoPlugin->keyfactory()->register_local_datareader(*participant_A, prop_handle, sec_attrs, exception);
+    eprosima::fastrtps::rtps::security::DatawriterCryptoHandle *writer = CryptoPlugin->keyfactory()->register_local_datawriter(*participant_B, prop_handle, sec_attrs, exception);
+
+    //Fill shared secret with dummy values
+    std::vector<uint8_t> dummy_data, challenge_1, challenge_2;
+    eprosima::fastrtps::rtps::security::SharedSecret::BinaryData binary_data;
+    challenge_1.resize(8);
+    challenge_2.resize(8);
+
+    RAND_bytes(challenge_1.data(),8);
+    binary_data.name("Challenge1");
+    binary_data.value(challenge_1);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    RAND_bytes(challenge_2.data(),8);
+    binary_data.name("Challenge2");
+    binary_data.value(challenge_2);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    dummy_data.resize(32);
+    RAND_bytes(dummy_data.data(),32);
+    binary_data.name("SharedSecret");
+    binary_data.value(dummy_data);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantA_remote =CryptoPlugin->keyfactory()->register_matched_remote_participant(*participant_A,*i_handle,*perm_handle,*shared_secret, exception);
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantB_remote =CryptoPlugin->keyfactory()->register_matched_remote_participant(*participant_B,*i_handle,*perm_handle,*shared_secret, exception);
+
+    eprosima::fastrtps::rtps::security::DatareaderCryptoHandle *remote_reader = CryptoPlugin->keyfactory()->register_matched_remote_datareader(*writer, *ParticipantB_remote, *shared_secret, false, exception);
+    eprosima::fastrtps::rtps::security::DatawriterCryptoHandle *remote_writer = CryptoPlugin->keyfactory()->register_matched_remote_datawriter(*reader, *ParticipantA_remote, *shared_secret, exception);
+
+    eprosima::fastrtps::rtps::security::DatawriterCryptoTokenSeq Writer_CryptoTokens, Reader_CryptoTokens;
+
+    CryptoPlugin->keyexchange()->create_local_datawriter_crypto_tokens(Writer_CryptoTokens, *writer, *remote_reader, exception);
+    CryptoPlugin->keyexchange()->create_local_datareader_crypto_tokens(Reader_CryptoTokens, *reader, *remote_writer, exception);
+
+    CryptoPlugin->keyexchange()->set_remote_datareader_crypto_tokens(*writer, *remote_reader, Reader_CryptoTokens, exception);
+    CryptoPlugin->keyexchange()->set_remote_datawriter_crypto_tokens(*reader, *remote_writer, Writer_CryptoTokens, exception);
+
+    // Encode samples along ten sessions
+    const size_t num_samples = 160;
+    std::vector<eprosima::fastrtps::rtps::SerializedPayload_t> encoded_payloads(num_samples);
+    std::set<std::vector<uint8_t>> nonces;
+    std::vector<uint8_t> inline_qos;
+
+    for(size_t i = 0; i < num_samples; ++i)
+    {
+        eprosima::fastrtps::rtps::SerializedPayload_t plain_payload(sizeof(uint32_t));
+        uint32_t value = static_cast<uint32_t>(i);
+        memcpy(plain_payload.data, &value, sizeof(uint32_t));
+        plain_payload.length = sizeof(uint32_t);
+
+        encoded_payloads[i].reserve(100);
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->encode_serialized_payload(encoded_payloads[i], inline_qos,
+                    plain_payload, *writer, exception));
+
+        // Session id and initialization vector suffix never repeat
+        std::vector<uint8_t> nonce(encoded_payloads[i].data + 8, encoded_payloads[i].data + 20);
+        ASSERT_TRUE(nonces.insert(nonce).second);
+    }
+
+    // In order, then samples from a session older than the cached ones, then from the last session again
+    std::vector<size_t> order;
+    for(size_t i = 0; i < num_samples; ++i)
+    {
+        order.push_back(i);
+    }
+    order.push_back(3);
+    order.push_back(num_samples - 1);
+    order.push_back(17);
+    order.push_back(num_samples - 2);
+
+    for(size_t i : order)
+    {
+        eprosima::fastrtps::rtps::SerializedPayload_t decoded_payload(100);
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->decode_serialized_payload(decoded_payload, encoded_payloads[i],
+                    inline_qos, *reader, *remote_writer, exception));
+        ASSERT_EQ(sizeof(uint32_t), decoded_payload.length);
+        uint32_t value = 0;
+        memcpy(&value, decoded_payload.data, sizeof(uint32_t));
+        ASSERT_EQ(i, value);
+    }
+
+    // A tampered sample is rejected, and does not corrupt the cached keys
+    eprosima::fastrtps::rtps::SerializedPayload_t decoded_payload(100);
+    encoded_payloads[20].data[24] ^= 0x01;
+    ASSERT_FALSE(CryptoPlugin->cryptotransform()->decode_serialized_payload(decoded_payload, encoded_payloads[20],
+                inline_qos, *reader, *remote_writer, exception));
+    ASSERT_TRUE(CryptoPlugin->cryptotransform()->decode_serialized_payload(decoded_payload, encoded_payloads[21],
+                inline_qos, *reader, *remote_writer, exception));
+
+    CryptoPlugin->keyfactory()->unregister_datawriter(writer,exception);
+    CryptoPlugin->keyfactory()->unregister_datawriter(remote_writer,exception);
+
+    CryptoPlugin->keyfactory()->unregister_datareader(reader,exception);
+    CryptoPlugin->keyfactory()->unregister_datareader(remote_reader,exception);
+
+    CryptoPlugin->keyfactory()->unregister_participant(participant_A, exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantA_remote, exception);
+    CryptoPlugin->keyfactory()->unregister_participant(participant_B, exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantB_remote, exception);
+
+    delete i_handle;
+    delete perm_handle;
+    delete shared_secret;
+}
+
 TEST_F(CryptographyPluginTest, transform_Writer_Submesage)
 {
 
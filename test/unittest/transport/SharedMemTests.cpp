@@ -0,0 +1,401 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/log/Log.h>
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define GET_PID _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define GET_PID getpid
+#endif
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static uint16_t g_default_port = 0;
+
+uint16_t get_port()
+{
+    uint16_t port = static_cast<uint16_t>(GET_PID());
+
+    if(4000 > port)
+    {
+        port += 4000;
+    }
+
+    return port;
+}
+
+//! Stores a copy of every message received.
+class ReceiverStore : public TransportReceiverInterface
+{
+public:
+
+    void OnDataReceived(const octet* data, const uint32_t size,
+        const Locator_t&, const Locator_t& remote_locator) override
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        messages_.emplace_back(data, data + size);
+        remote_kind_ = remote_locator.kind;
+        cv_.notify_all();
+    }
+
+    bool wait_messages(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(5), [&]() { return messages_.size() >= count; });
+    }
+
+    std::vector<std::vector<octet>> messages_;
+    int32_t remote_kind_ = LOCATOR_KIND_INVALID;
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+class SharedMemTests: public ::testing::Test
+{
+    public:
+
+        SharedMemTests()
+        {
+            descriptor.segment_size = 64 * 1024;
+            descriptor.maxMessageSize = 16 * 1024;
+        }
+
+        //! Returns a locator of this host for the given port.
+        Locator_t local_locator(SharedMemTransport& transport, uint32_t port)
+        {
+            Locator_t locator;
+            locator.kind = LOCATOR_KIND_SHM;
+            locator.port = port;
+            return *transport.NormalizeLocator(locator).begin();
+        }
+
+        SharedMemTransportDescriptor descriptor;
+};
+
+TEST_F(SharedMemTests, locators_with_kind_shm_supported)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t supportedLocator;
+    supportedLocator.kind = LOCATOR_KIND_SHM;
+    Locator_t unsupportedLocator;
+    unsupportedLocator.kind = LOCATOR_KIND_UDPv4;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.IsLocatorSupported(supportedLocator));
+    ASSERT_FALSE(transportUnderTest.IsLocatorSupported(unsupportedLocator));
+}
+
+TEST_F(SharedMemTests, locators_of_other_hosts_are_not_local)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t localLocator = local_locator(transportUnderTest, g_default_port);
+    Locator_t remoteLocator(localLocator);
+    remoteLocator.address[15] ^= 0xFF;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.is_local_locator(localLocator));
+    ASSERT_TRUE(transportUnderTest.is_locator_allowed(localLocator));
+    ASSERT_FALSE(transportUnderTest.is_local_locator(remoteLocator));
+    ASSERT_FALSE(transportUnderTest.is_locator_allowed(remoteLocator));
+}
+
+TEST_F(SharedMemTests, transports_of_the_same_host_share_the_host_address)
+{
+    // Given
+    SharedMemTransport firstTransport(descriptor);
+    ASSERT_TRUE(firstTransport.init());
+    SharedMemTransport secondTransport(descriptor);
+    ASSERT_TRUE(secondTransport.init());
+
+    // Then
+    Locator_t firstLocator = local_locator(firstTransport, g_default_port);
+    ASSERT_TRUE(secondTransport.is_local_locator(firstLocator));
+    ASSERT_EQ(firstLocator, local_locator(secondTransport, g_default_port));
+}
+
+#if !defined(_WIN32)
+TEST_F(SharedMemTests, incomplete_host_token_is_replaced)
+{
+    // Given an object of the host token left behind by a creator that did not publish the token
+    shm_unlink("/fastrtps_host");
+    int fd = shm_open("/fastrtps_host", O_CREAT | O_EXCL | O_RDWR, 0644);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    // When
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    // Then the new token is used by the next transports
+    SharedMemTransport secondTransport(descriptor);
+    ASSERT_TRUE(secondTransport.init());
+    ASSERT_TRUE(secondTransport.is_local_locator(local_locator(transportUnderTest, g_default_port)));
+}
+#endif
+
+TEST_F(SharedMemTests, opening_and_closing_input_channel)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t inputLocator = local_locator(transportUnderTest, g_default_port);
+    ReceiverStore receiver;
+
+    // Then
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+    ASSERT_TRUE  (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_TRUE  (transportUnderTest.CloseInputChannel(inputLocator));
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(inputLocator));
+    ASSERT_FALSE (transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, port_in_use_cannot_be_opened)
+{
+    // Given
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+    SharedMemTransport otherTransport(descriptor);
+    ASSERT_TRUE(otherTransport.init());
+
+    Locator_t inputLocator = local_locator(transportUnderTest, g_default_port);
+    ReceiverStore receiver;
+
+    // Then
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+    ASSERT_FALSE(otherTransport.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+    ASSERT_TRUE(otherTransport.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+    ASSERT_TRUE(otherTransport.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, send_and_receive_between_transports)
+{
+    SharedMemTransport receiverTransport(descriptor);
+    ASSERT_TRUE(receiverTransport.init());
+    SharedMemTransport senderTransport(descriptor);
+    ASSERT_TRUE(senderTransport.init());
+
+    Locator_t inputLocator = local_locator(receiverTransport, g_default_port);
+    ReceiverStore receiver;
+    ASSERT_TRUE(receiverTransport.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_EQ(send_resource_list.size(), 1u);
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(send_resource_list, inputLocator));
+    ASSERT_EQ(send_resource_list.size(), 1u);
+
+    octet message[5] = { 'H','e','l','l','o' };
+    ASSERT_TRUE(send_resource_list.at(0)->send(message, 5, inputLocator));
+    ASSERT_TRUE(receiver.wait_messages(1));
+    ASSERT_EQ(receiver.messages_[0], std::vector<octet>(message, message + 5));
+    ASSERT_EQ(receiver.remote_kind_, LOCATOR_KIND_SHM);
+
+    ASSERT_TRUE(receiverTransport.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, send_is_rejected_if_nobody_listens_or_locator_is_remote)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t destinationLocator = local_locator(transportUnderTest, g_default_port + 1);
+    Locator_t remoteLocator(destinationLocator);
+    remoteLocator.address[15] ^= 0xFF;
+
+    ReceiverStore receiver;
+    Locator_t inputLocator = local_locator(transportUnderTest, g_default_port);
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+
+    octet message[5] = { 'H','e','l','l','o' };
+    ASSERT_FALSE(transportUnderTest.send(message, 5, destinationLocator));
+    remoteLocator.port = inputLocator.port;
+    ASSERT_FALSE(transportUnderTest.send(message, 5, remoteLocator));
+
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    ReceiverStore receiver;
+    Locator_t inputLocator = local_locator(transportUnderTest, g_default_port);
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+
+    std::vector<octet> message(descriptor.maxMessageSize + 1);
+    ASSERT_FALSE(transportUnderTest.send(message.data(), static_cast<uint32_t>(message.size()), inputLocator));
+    ASSERT_TRUE(transportUnderTest.send(message.data(), descriptor.maxMessageSize, inputLocator));
+    ASSERT_TRUE(receiver.wait_messages(1));
+
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, messages_keep_order_across_the_end_of_the_ring)
+{
+    // Producers wait for the listener instead of dropping the messages.
+    descriptor.non_blocking_send = false;
+    SharedMemTransport receiverTransport(descriptor);
+    ASSERT_TRUE(receiverTransport.init());
+
+    Locator_t inputLocator = local_locator(receiverTransport, g_default_port);
+    ReceiverStore receiver;
+    ASSERT_TRUE(receiverTransport.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+
+    // Several producers fill the ring many times, with sizes that force padding at its end.
+    const uint32_t num_senders = 4;
+    const uint32_t messages_per_sender = 500;
+    std::vector<std::thread> senders;
+    for (uint32_t sender = 0; sender < num_senders; ++sender)
+    {
+        senders.emplace_back([&, sender]()
+        {
+            SharedMemTransport senderTransport(descriptor);
+            ASSERT_TRUE(senderTransport.init());
+
+            for (uint32_t i = 0; i < messages_per_sender; ++i)
+            {
+                std::vector<octet> message(8 + (i * 977) % (descriptor.maxMessageSize - 8), static_cast<octet>(i));
+                memcpy(message.data(), &sender, sizeof(sender));
+                memcpy(message.data() + 4, &i, sizeof(i));
+                EXPECT_TRUE(senderTransport.send(message.data(), static_cast<uint32_t>(message.size()), inputLocator));
+            }
+        });
+    }
+
+    for (std::thread& sender : senders)
+    {
+        sender.join();
+    }
+
+    ASSERT_TRUE(receiver.wait_messages(num_senders * messages_per_sender));
+    ASSERT_TRUE(receiverTransport.CloseInputChannel(inputLocator));
+
+    std::vector<uint32_t> next_of_sender(num_senders, 0);
+    for (const std::vector<octet>& message : receiver.messages_)
+    {
+        uint32_t sender = 0;
+        uint32_t i = 0;
+        memcpy(&sender, message.data(), sizeof(sender));
+        memcpy(&i, message.data() + 4, sizeof(i));
+        ASSERT_LT(sender, num_senders);
+        ASSERT_EQ(i, next_of_sender[sender]++);
+        ASSERT_EQ(message.size(), 8 + (i * 977) % (descriptor.maxMessageSize - 8));
+        ASSERT_TRUE(message.size() == 8 || message.back() == static_cast<octet>(i));
+    }
+}
+
+TEST_F(SharedMemTests, non_blocking_send_drops_messages_when_ring_is_full)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    // The listener is blocked while processing the first message.
+    std::mutex mutex;
+    std::unique_lock<std::mutex> block(mutex);
+    class BlockingReceiver : public TransportReceiverInterface
+    {
+    public:
+        explicit BlockingReceiver(std::mutex& m) : mutex_(m) {}
+        void OnDataReceived(const octet*, const uint32_t, const Locator_t&, const Locator_t&) override
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+        }
+        std::mutex& mutex_;
+    } receiver(mutex);
+
+    Locator_t inputLocator = local_locator(transportUnderTest, g_default_port);
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+
+    std::vector<octet> message(descriptor.maxMessageSize);
+    uint32_t sent = 0;
+    while (sent < 100 && transportUnderTest.send(message.data(), descriptor.maxMessageSize, inputLocator))
+    {
+        ++sent;
+    }
+    ASSERT_LT(sent, 100u);
+    ASSERT_GE(sent, descriptor.segment_size / descriptor.maxMessageSize - 1);
+
+    block.unlock();
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+TEST_F(SharedMemTests, blocking_send_gives_up_when_listener_does_not_free_space)
+{
+    descriptor.non_blocking_send = false;
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    // The listener is blocked while processing the first message, as if it had been stopped.
+    std::mutex mutex;
+    std::unique_lock<std::mutex> block(mutex);
+    class BlockingReceiver : public TransportReceiverInterface
+    {
+    public:
+        explicit BlockingReceiver(std::mutex& m) : mutex_(m) {}
+        void OnDataReceived(const octet*, const uint32_t, const Locator_t&, const Locator_t&) override
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+        }
+        std::mutex& mutex_;
+    } receiver(mutex);
+
+    Locator_t inputLocator = local_locator(transportUnderTest, g_default_port);
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(inputLocator, &receiver, descriptor.maxMessageSize));
+
+    std::vector<octet> message(descriptor.maxMessageSize);
+    uint32_t sent = 0;
+    while (sent < 100 && transportUnderTest.send(message.data(), descriptor.maxMessageSize, inputLocator))
+    {
+        ++sent;
+    }
+    ASSERT_LT(sent, 100u);
+
+    block.unlock();
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(inputLocator));
+}
+
+int main(int argc, char **argv)
+{
+    Log::SetVerbosity(Log::Warning);
+    g_default_port = get_port();
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
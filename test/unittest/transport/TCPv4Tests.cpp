@@ -234,6 +234,68 @@ TEST_F(TCPv4Tests, send_and_receive_between_ports)
     senderThread->join();
     sem.wait();
 }
+
+TEST_F(TCPv4Tests, send_and_receive_between_ports_with_several_io_service_threads)
+{
+    TCPv4TransportDescriptor recvDescriptor;
+    recvDescriptor.add_listener_port(g_default_port);
+    recvDescriptor.wait_for_tcp_negotiation = true;
+    recvDescriptor.io_service_threads = 4;
+    TCPv4Transport receiveTransportUnderTest(recvDescriptor);
+    receiveTransportUnderTest.init();
+
+    TCPv4TransportDescriptor sendDescriptor;
+    sendDescriptor.wait_for_tcp_negotiation = true;
+    sendDescriptor.io_service_threads = 4;
+    TCPv4Transport sendTransportUnderTest(sendDescriptor);
+    sendTransportUnderTest.init();
+
+    Locator_t inputLocator;
+    inputLocator.kind = LOCATOR_KIND_TCPv4;
+    inputLocator.port = g_default_port;
+    IPLocator::setIPv4(inputLocator, 127, 0, 0, 1);
+    IPLocator::setLogicalPort(inputLocator, 7410);
+
+    Locator_t outputLocator;
+    outputLocator.kind = LOCATOR_KIND_TCPv4;
+    IPLocator::setIPv4(outputLocator, 127, 0, 0, 1);
+    outputLocator.port = g_default_port;
+    IPLocator::setLogicalPort(outputLocator, 7410);
+
+    MockReceiverResource receiver(receiveTransportUnderTest, inputLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+    ASSERT_TRUE(receiveTransportUnderTest.IsInputChannelOpen(inputLocator));
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(sendTransportUnderTest.OpenOutputChannel(send_resource_list, outputLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, 5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        bool sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+        while (!sent)
+        {
+            sent = send_resource_list.at(0)->send(message, 5, inputLocator);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        EXPECT_TRUE(sent);
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+}
 #endif
 
 TEST_F(TCPv4Tests, send_is_rejected_if_buffer_size_is_bigger_to_size_specified_in_descriptor)
@@ -1443,6 +1505,42 @@ TEST_F(TCPv4Tests, shrink_locator_lists)
     send_resource_list.clear();
 }
 
+TEST_F(TCPv4Tests, crc_of_block_matches_byte_by_byte_crc)
+{
+    std::vector<octet> data(4096 + 64);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<octet>((i * 2654435761u) >> 13);
+    }
+
+    // Unaligned starts and sizes around the block lengths, with all bytes set to force carries.
+    const size_t sizes[] = { 0, 1, 7, 8, 15, 16, 17, 31, 33, 1023, 1024, 1025, 4096 };
+    for (size_t offset = 0; offset < 3; ++offset)
+    {
+        for (size_t size : sizes)
+        {
+            for (uint32_t initial : { 0u, 0xFFFFFF00u })
+            {
+                uint32_t expected = initial;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    RTCPMessageManager::addToCRC(expected, data[offset + i]);
+                }
+
+                ASSERT_EQ(RTCPMessageManager::addToCRC(initial, &data[offset], size), expected);
+            }
+        }
+    }
+
+    std::fill(data.begin(), data.end(), static_cast<octet>(0xFF));
+    uint32_t expected = 0xFFFFFFFFu;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        RTCPMessageManager::addToCRC(expected, data[i]);
+    }
+    ASSERT_EQ(RTCPMessageManager::addToCRC(0xFFFFFFFFu, data.data(), data.size()), expected);
+}
+
 void TCPv4Tests::HELPER_SetDescriptorDefaults()
 {
     descriptor.add_listener_port(g_default_port);
@@ -0,0 +1,130 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/PartitionMatcher.h>
+#include <fastrtps/utils/StringMatching.h>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+using Partitions = std::vector<std::string>;
+
+/*!
+ * Partition matching as it was done pairwise by EDP::validMatching.
+ */
+static bool pairwise_match(const Partitions& partitions1, const Partitions& partitions2)
+{
+    if(partitions1.empty() && partitions2.empty())
+    {
+        return true;
+    }
+
+    if(partitions1.empty() || partitions2.empty())
+    {
+        const Partitions& not_empty = partitions1.empty() ? partitions2 : partitions1;
+        for(const std::string& name : not_empty)
+        {
+            if(name.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for(const std::string& name1 : partitions1)
+    {
+        for(const std::string& name2 : partitions2)
+        {
+            if(StringMatching::matchString(name1.c_str(), name2.c_str()))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+class PartitionMatcherTests: public ::testing::Test
+{
+    public:
+
+        PartitionMatcher matcher;
+
+        const std::vector<Partitions> lists =
+        {
+            {},
+            {""},
+            {"*"},
+            {"A"},
+            {"B"},
+            {"A", "B"},
+            {"C", "D", "E"},
+            {"", "C"},
+            {"A*"},
+            {"AB"},
+            {"?B"},
+            {"[AC]"},
+            {"foo/bar/baz"},
+            {"foo/*/baz", "qux"},
+            {"*baz", "A"},
+            {"foo\\bar"},
+            {"foo*"},
+            {"foo/*"},
+            {"fo*", "B"},
+            {"foo/bar/*z"},
+        };
+};
+
+TEST_F(PartitionMatcherTests, same_results_as_pairwise_matching)
+{
+    // Run twice so the second time the results come from the cache.
+    for(int i = 0; i < 2; ++i)
+    {
+        for(const Partitions& partitions1 : lists)
+        {
+            for(const Partitions& partitions2 : lists)
+            {
+                EXPECT_EQ(pairwise_match(partitions1, partitions2), matcher.match(partitions1, partitions2));
+            }
+        }
+    }
+}
+
+TEST_F(PartitionMatcherTests, empty_lists)
+{
+    ASSERT_TRUE(matcher.match({}, {}));
+    ASSERT_TRUE(matcher.match({}, {""}));
+    ASSERT_TRUE(matcher.match({"", "A"}, {}));
+    ASSERT_FALSE(matcher.match({}, {"A"}));
+    ASSERT_FALSE(matcher.match({"*"}, {}));
+    ASSERT_TRUE(matcher.match({"*"}, {""}));
+}
+
+TEST_F(PartitionMatcherTests, literals_and_expressions)
+{
+    ASSERT_TRUE(matcher.match({"A", "B"}, {"C", "B"}));
+    ASSERT_FALSE(matcher.match({"A", "B"}, {"C", "D"}));
+    ASSERT_TRUE(matcher.match({"A*"}, {"C", "AB"}));
+    ASSERT_TRUE(matcher.match({"C", "AB"}, {"A*"}));
+    ASSERT_TRUE(matcher.match({"A*"}, {"*"}));
+    ASSERT_FALSE(matcher.match({"A?"}, {"B*"}));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}